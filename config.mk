@@ -4,7 +4,6 @@ _APP_SYS_SOURCE = $(MONT_STATION_PROJ_HOME)/src/system
 _COMMON_C_ENTRY_FILE = src/station.c
 
 _COMMON_C_HEADERS = \
-    include/station_aircond_track.h \
     include/station_app_msg.h \
     include/station_config.h \
     include/station_daylight_track.h \
@@ -14,8 +13,11 @@ _COMMON_C_HEADERS = \
     include/station_io.h \
     include/station_monitor.h \
     include/station_network.h \
-    include/station_soilcond_track.h \
+    include/station_sensor_pipeline.h \
     include/station_types.h \
+    include/station_trace.h \
+    include/station_profile.h \
+    include/station_evt_latency.h \
     include/station_util.h \
 	include/system/middleware/ESP_AT_parser/FreeRTOSConfig.h \
 	include/system/middleware/ESP_AT_parser/esp_config.h \
@@ -27,10 +29,16 @@ _COMMON_C_HEADERS = \
 
 _COMMON_C_SOURCES_FUNC = \
     src/util.c \
+    src/trace.c \
+    src/profile.c \
+    src/evt_latency.c \
     src/daylight_track.c \
-    src/aircond_track.c \
-    src/soilcond_track.c \
+    src/sensor_pipeline.c \
+    src/sensor_sched.c \
     src/netconn.c \
+    src/netconn_backlog.c \
+    src/netconn_pubwin.c \
+    src/netconn_adaptive.c \
     src/app_msg/inbound.c \
     src/app_msg/outbound.c \
     src/app_msg/misc.c \
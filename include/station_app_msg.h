@@ -24,6 +24,8 @@ gMonStatus staAppMsgInit(gardenMonitor_t *);
 gMonStatus staAppMsgDeinit(gardenMonitor_t *);
 
 gMonStatus staAppMsgOutResetAllRecords(gardenMonitor_t *);
+gMonStatus staAppMsgOutResetDetachedRecords(gardenMonitor_t *);
+gMonStatus staAppMsgOutDetachRecords(gardenMonitor_t *);
 gMonStatus staAppMsgReallocBuffer(gardenMonitor_t *);
 
 gMonStatus
@@ -37,6 +39,8 @@ gMonStatus staAppMsgSerializeFloat(
 );
 
 gmonAppMsgOutflightResult_t staGetAppMsgOutflight(gardenMonitor_t *);
+gmonAppMsgOutflightResult_t staGetAppMsgOutflightDetached(gardenMonitor_t *);
+void                        staAppMsgOutAcked(gardenMonitor_t *);
 
 gmonStr_t *staGetAppMsgInflight(gardenMonitor_t *);
 
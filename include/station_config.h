@@ -15,6 +15,40 @@ extern "C" {
 #define GMON_CFG_SENSOR_READ_INTERVAL_MS 3000
 // Time interval (in milliseconds) to establish network connection for user/senser data exchange.
 #define GMON_CFG_NETCONN_START_INTERVAL_MS 60000 // 60 seconds
+// keep MQTT session open across network cycles, receive user control as soon as it arrives
+// #define GMON_CFG_NETCONN_PERSISTENT
+// number of unsent log messages kept in RAM while the broker is unreachable, and max number of them
+// sent in one network cycle once the connection recovers
+#define GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS   4
+#define GMON_CFG_NETCONN_BACKLOG_DRAIN_BATCH 8
+// max number of QoS 1 log messages published without PUBACK yet, while draining the backlog
+#define GMON_CFG_NETCONN_PUB_WINDOW_SZ 4
+// publish log messages without waiting for each PUBACK. The MQTT library has to provide split PUBLISH
+// encoder / writer (`mqttEncodePktPublish()`, `mqttPktWrite()`), packet ID allocator (`mqttGetPktID()`),
+// and hand back PUBLISH received while waiting for PUBACK in `mqttClientWaitPkt()`. Without this option
+// each log message is acknowledged before the next one is published, whatever the window size is.
+// #define GMON_CFG_MQTT_PIPELINED_PUBLISH
+// report sooner when actuators change state or aggregated sensor data cross thresholds, and back off
+// toward the maximum interval while readings are stable
+// #define GMON_CFG_NETCONN_ADAPTIVE_INTERVAL
+// #define GMON_CFG_NETCONN_ADAPTIVE_MAX_INTERVAL_MS 900000 // 15 minutes
+// leave sensor types and actuators out of log message if they moved less than the deadband since the last
+// acknowledged message, a full message is still sent every `GMON_CFG_APPMSG_FULL_REPORT_EVERY` messages
+// #define GMON_CFG_APPMSG_REPORT_BY_EXCEPTION
+// append runtime health of the station (stack, heap, event pool, message boxes, network cycle) to full
+// log messages
+// #define GMON_CFG_APPMSG_SYS_HEALTH
+// spill the oldest unsent log messages to storage provided by the platform, when RAM slots are full
+// #define GMON_CFG_NETCONN_BACKLOG_SPILL
+// record timing of the tasks to trace ring in RAM, which can be dumped and viewed as Chrome / Perfetto trace
+// #define GMON_CFG_ENABLE_TRACE
+// measure how long each call site of `stationSysEnterCritical()` stays in the critical section
+// #define GMON_CFG_ENABLE_CRITSECT_PROFILE
+// measure latency from acquisition of sensor samples to each stage up to acknowledgement of log message,
+// summary of the latency is appended to full log messages periodically
+// #define GMON_CFG_ENABLE_EVENT_LATENCY
+// measure number of calls, maximum and average duration of the hot functions marked by `GMON_PROF_SCOPE()`
+// #define GMON_CFG_ENABLE_PROF_SCOPE
 
 // enable input sensors or output device if any kind of sensor is applied to user's garden
 #define GMON_CFG_ENABLE_SENSOR_SOIL_MOIST
@@ -32,6 +66,9 @@ extern "C" {
 #define GMON_CFG_SOIL_SENSOR_NUM_OVERSAMPLE  3
 #define GMON_CFG_LIGHT_SENSOR_NUM_OVERSAMPLE 2
 #define GMON_CFG_AIR_SENSOR_NUM_OVERSAMPLE   2
+// issue start signal to all air sensors together and capture their responses in parallel, instead of
+// reading the sensors one after another
+#define GMON_CFG_AIR_SENSOR_CONCURRENT_READ
 
 #define GMON_CFG_ACTUATOR_TRIG_THRESHOLD_PUMP 890
 #define GMON_CFG_ACTUATOR_SENSOR_MASK_PUMP    0b00000001
@@ -9,8 +9,6 @@ gMonStatus staDaylightTrackInit(gardenMonitor_t *gmon);
 
 gMonStatus staSetRequiredDaylenTicks(gardenMonitor_t *gmon, unsigned int light_length);
 
-void lightControllerTaskFn(void *params);
-
 #ifdef __cplusplus
 }
 #endif
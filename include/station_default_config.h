@@ -35,6 +35,80 @@ extern "C" {
     #error "GMON_CFG_NETCONN_START_INTERVAL_MS must NOT be lesser than 60 seconds."
 #endif // end of GMON_CFG_NETCONN_START_INTERVAL_MS
 
+#ifdef GMON_CFG_NETCONN_PERSISTENT
+    #ifndef GMON_CFG_NETCONN_KEEPALIVE_SEC
+        #define GMON_CFG_NETCONN_KEEPALIVE_SEC 60
+    #elif (GMON_CFG_NETCONN_KEEPALIVE_SEC < 10) || (GMON_CFG_NETCONN_KEEPALIVE_SEC > 0xffff)
+        #error "GMON_CFG_NETCONN_KEEPALIVE_SEC must be in range of 10 to 65535 seconds."
+    #endif
+    // how often network task wakes up to check user control message and keep-alive
+    #ifndef GMON_CFG_NETCONN_POLL_INTERVAL_MS
+        #define GMON_CFG_NETCONN_POLL_INTERVAL_MS 1000
+    #elif (GMON_CFG_NETCONN_POLL_INTERVAL_MS * 2 > GMON_CFG_NETCONN_KEEPALIVE_SEC * 1000)
+        #error "GMON_CFG_NETCONN_POLL_INTERVAL_MS must NOT be greater than half of keep-alive interval."
+    #endif
+    #ifndef GMON_CFG_NETCONN_RECONN_MIN_BACKOFF_MS
+        #define GMON_CFG_NETCONN_RECONN_MIN_BACKOFF_MS 2000
+    #endif
+    #ifndef GMON_CFG_NETCONN_RECONN_MAX_BACKOFF_MS
+        #define GMON_CFG_NETCONN_RECONN_MAX_BACKOFF_MS 300000 // 5 minutes
+    #endif
+    #if (GMON_CFG_NETCONN_RECONN_MIN_BACKOFF_MS > GMON_CFG_NETCONN_RECONN_MAX_BACKOFF_MS)
+        #error "GMON_CFG_NETCONN_RECONN_MIN_BACKOFF_MS must NOT be greater than the max backoff."
+    #endif
+#endif // end of GMON_CFG_NETCONN_PERSISTENT
+
+// policy applied when the backlog of unsent log messages is full
+#define GMON_NETCONN_BACKLOG_DROP_OLDEST 0
+#define GMON_NETCONN_BACKLOG_DROP_NEWEST 1
+
+#ifndef GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS
+    #define GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS 4
+#elif (GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS < 1) || (GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS > 32)
+    #error "GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS must be in range of 1 to 32."
+#endif
+#ifndef GMON_CFG_NETCONN_BACKLOG_DRAIN_BATCH
+    #define GMON_CFG_NETCONN_BACKLOG_DRAIN_BATCH 2
+#elif (GMON_CFG_NETCONN_BACKLOG_DRAIN_BATCH < 1)
+    #error "GMON_CFG_NETCONN_BACKLOG_DRAIN_BATCH must NOT be lesser than 1."
+#endif
+#ifndef GMON_CFG_NETCONN_BACKLOG_DROP_POLICY
+    #define GMON_CFG_NETCONN_BACKLOG_DROP_POLICY GMON_NETCONN_BACKLOG_DROP_OLDEST
+#endif
+#ifdef GMON_CFG_NETCONN_ADAPTIVE_INTERVAL
+    #ifndef GMON_CFG_NETCONN_ADAPTIVE_MAX_INTERVAL_MS
+        #define GMON_CFG_NETCONN_ADAPTIVE_MAX_INTERVAL_MS (GMON_CFG_NETCONN_START_INTERVAL_MS << 2)
+    #elif (GMON_CFG_NETCONN_ADAPTIVE_MAX_INTERVAL_MS > GMON_MAX_NETCONN_START_INTERVAL_MS)
+        #error "GMON_CFG_NETCONN_ADAPTIVE_MAX_INTERVAL_MS must NOT be greater than the max network interval."
+    #endif
+    // minimum time between two reports, when a report is triggered by state change
+    #ifndef GMON_CFG_NETCONN_ADAPTIVE_MIN_GAP_MS
+        #define GMON_CFG_NETCONN_ADAPTIVE_MIN_GAP_MS 15000
+    #elif (GMON_CFG_NETCONN_ADAPTIVE_MIN_GAP_MS > GMON_MIN_NETCONN_START_INTERVAL_MS)
+        #error "GMON_CFG_NETCONN_ADAPTIVE_MIN_GAP_MS must NOT be greater than the min network interval."
+    #endif
+    // readings are regarded as stable if aggregated data of each actuator moves less than this
+    // percentage of its threshold between two reports
+    #ifndef GMON_CFG_NETCONN_ADAPTIVE_STABLE_PERCENT
+        #define GMON_CFG_NETCONN_ADAPTIVE_STABLE_PERCENT 5
+    #endif
+#endif // end of GMON_CFG_NETCONN_ADAPTIVE_INTERVAL
+#ifdef GMON_CFG_ENABLE_TRACE
+    #ifndef GMON_CFG_TRACE_NUM_ENTRIES
+        #define GMON_CFG_TRACE_NUM_ENTRIES 256
+    #elif (GMON_CFG_TRACE_NUM_ENTRIES & (GMON_CFG_TRACE_NUM_ENTRIES - 1)) != 0
+        #error "GMON_CFG_TRACE_NUM_ENTRIES must be power of 2."
+    #elif (GMON_CFG_TRACE_NUM_ENTRIES > 0x8000)
+        #error "GMON_CFG_TRACE_NUM_ENTRIES must NOT be greater than 32768."
+    #endif
+#endif // end of GMON_CFG_ENABLE_TRACE
+
+#ifndef GMON_CFG_NETCONN_PUB_WINDOW_SZ
+    #define GMON_CFG_NETCONN_PUB_WINDOW_SZ 1
+#elif (GMON_CFG_NETCONN_PUB_WINDOW_SZ < 1) || (GMON_CFG_NETCONN_PUB_WINDOW_SZ > 16)
+    #error "GMON_CFG_NETCONN_PUB_WINDOW_SZ must be in range of 1 to 16."
+#endif
+
 #ifdef GMON_CFG_ENABLE_SENSOR_SOIL_MOIST
     #define GMON_SENSOR_INIT_FN_SOIL_MOIST(s)          staSensorInitSoilMoist(s)
     #define GMON_SENSOR_DEINIT_FN_SOIL_MOIST(s)        staSensorDeInitSoilMoist(s)
@@ -177,19 +251,21 @@ extern "C" {
 #endif
 
 #ifdef GMON_CFG_ENABLE_DISPLAY
-    #define GMON_DISPLAY_DEV_INIT_FN()                  staDisplayDevInit()
-    #define GMON_DISPLAY_DEV_DEINIT_FN()                staDisplayDevDeInit()
-    #define GMON_DISPLAY_DEV_GET_SCR_WIDTH()            staDisplayDevGetScreenWidth()
-    #define GMON_DISPLAY_DEV_GET_SCR_HEIGHT()           staDisplayDevGetScreenHeight()
-    #define GMON_DISPLAY_DEV_REFRESH_SCREEN_FN()        staDisplayRefreshScreen()
-    #define GMON_DISPLAY_DEV_PRINT_STRING_FN(printinfo) staDiplayDevPrintString((printinfo))
+    #define GMON_DISPLAY_DEV_INIT_FN(dev, arena)             staDisplayDevInit((dev), (arena))
+    #define GMON_DISPLAY_DEV_DEINIT_FN(dev, arena)           staDisplayDevDeInit((dev), (arena))
+    #define GMON_DISPLAY_DEV_GET_SCR_WIDTH(dev)              staDisplayDevGetScreenWidth((dev))
+    #define GMON_DISPLAY_DEV_GET_SCR_HEIGHT(dev)             staDisplayDevGetScreenHeight((dev))
+    #define GMON_DISPLAY_DEV_REFRESH_SCREEN_FN(dev)          staDisplayRefreshScreen((dev))
+    #define GMON_DISPLAY_DEV_CLEAR_SCREEN_FN(dev)            staDisplayDevClearScreen((dev))
+    #define GMON_DISPLAY_DEV_PRINT_STRING_FN(dev, printinfo) staDiplayDevPrintString((dev), (printinfo))
 #else
-    #define GMON_DISPLAY_DEV_INIT_FN()                  GMON_RESP_OK
-    #define GMON_DISPLAY_DEV_DEINIT_FN()                GMON_RESP_OK
-    #define GMON_DISPLAY_DEV_GET_SCR_WIDTH()            GMON_RESP_OK
-    #define GMON_DISPLAY_DEV_GET_SCR_HEIGHT()           GMON_RESP_OK
-    #define GMON_DISPLAY_DEV_REFRESH_SCREEN_FN()        GMON_RESP_OK
-    #define GMON_DISPLAY_DEV_PRINT_STRING_FN(printinfo) GMON_RESP_OK
+    #define GMON_DISPLAY_DEV_INIT_FN(dev, arena)             GMON_RESP_OK
+    #define GMON_DISPLAY_DEV_DEINIT_FN(dev, arena)           GMON_RESP_OK
+    #define GMON_DISPLAY_DEV_GET_SCR_WIDTH(dev)              GMON_RESP_OK
+    #define GMON_DISPLAY_DEV_GET_SCR_HEIGHT(dev)             GMON_RESP_OK
+    #define GMON_DISPLAY_DEV_REFRESH_SCREEN_FN(dev)          GMON_RESP_OK
+    #define GMON_DISPLAY_DEV_CLEAR_SCREEN_FN(dev)            GMON_RESP_OK
+    #define GMON_DISPLAY_DEV_PRINT_STRING_FN(dev, printinfo) GMON_RESP_OK
 #endif // end of GMON_CFG_ENABLE_DISPLAY
 
 #define GMON_MAX_ACTUATOR_EMA_LAMBDA 99
@@ -362,12 +438,61 @@ extern "C" {
         "GMON_CFG_NUM_LIGHT_SENSOR_RECORDS_KEEP shouldn't be greater than GMON_LIMIT_MAXNUM_SENSOR_RECORDS, recheck your configuration"
 #endif
 
+#ifdef GMON_CFG_APPMSG_REPORT_BY_EXCEPTION
+    // raw ADC reading of soil moisture and light sensors
+    #ifndef GMON_CFG_APPMSG_DEADBAND_SOILMOIST
+        #define GMON_CFG_APPMSG_DEADBAND_SOILMOIST 8
+    #endif
+    #ifndef GMON_CFG_APPMSG_DEADBAND_LIGHT
+        #define GMON_CFG_APPMSG_DEADBAND_LIGHT 16
+    #endif
+    // in Celsius degree, and in percent of relative humidity
+    #ifndef GMON_CFG_APPMSG_DEADBAND_AIRTEMP
+        #define GMON_CFG_APPMSG_DEADBAND_AIRTEMP 0.5f
+    #endif
+    #ifndef GMON_CFG_APPMSG_DEADBAND_AIRHUMID
+        #define GMON_CFG_APPMSG_DEADBAND_AIRHUMID 2.0f
+    #endif
+    // working time or rest time of actuators, their state changes are always reported
+    #ifndef GMON_CFG_APPMSG_DEADBAND_WORKTIME_MS
+        #define GMON_CFG_APPMSG_DEADBAND_WORKTIME_MS 60000
+    #endif
+    #ifndef GMON_CFG_APPMSG_FULL_REPORT_EVERY
+        #define GMON_CFG_APPMSG_FULL_REPORT_EVERY 10
+    #elif (GMON_CFG_APPMSG_FULL_REPORT_EVERY < 1) || (GMON_CFG_APPMSG_FULL_REPORT_EVERY > 255)
+        #error "GMON_CFG_APPMSG_FULL_REPORT_EVERY must be in range of 1 to 255."
+    #endif
+#endif // end of GMON_CFG_APPMSG_REPORT_BY_EXCEPTION
+
+// size of static region for long-lived objects created at initialization (event pool, sensor records,
+// JSON tokens, display strings, device and network contexts), initialization fails if it is too small.
+// The station context is placed in the same region on top of this size. `make netbench` prints the
+// usage : 3864 bytes with default options, 4096 bytes with report by exception, system health, event
+// latency, adaptive interval and pipelined publish all enabled. The default keeps about 2 KB headroom
+// for more sensors (GMON_CFG_NUM_*_SENSORS) and records (GMON_CFG_NUM_*_RECORDS_KEEP).
+#ifndef GMON_CFG_INIT_ARENA_NBYTES
+    #define GMON_CFG_INIT_ARENA_NBYTES 6144
+#elif (GMON_CFG_INIT_ARENA_NBYTES < 1024) || (GMON_CFG_INIT_ARENA_NBYTES > 65535)
+    #error "GMON_CFG_INIT_ARENA_NBYTES must be in range of 1024 to 65535."
+#endif
+
+#ifdef GMON_CFG_ENABLE_EVENT_LATENCY
+    // number of full log messages in a window of latency histograms
+    #ifndef GMON_CFG_EVENT_LATENCY_REPORT_EVERY
+        #define GMON_CFG_EVENT_LATENCY_REPORT_EVERY 5
+    #elif (GMON_CFG_EVENT_LATENCY_REPORT_EVERY < 1) || (GMON_CFG_EVENT_LATENCY_REPORT_EVERY > 255)
+        #error "GMON_CFG_EVENT_LATENCY_REPORT_EVERY must be in range of 1 to 255."
+    #endif
+#endif // end of GMON_CFG_ENABLE_EVENT_LATENCY
+
 #define GMON_SENSOR_READ_INTERVAL_MS_PUMP_ON \
     (GMON_CFG_SENSOR_READ_INTERVAL_MS < 400 ? GMON_CFG_SENSOR_READ_INTERVAL_MS : 400)
 #define GMON_SENSOR_READ_INTERVAL_MS_FAN_ON \
     (GMON_CFG_SENSOR_READ_INTERVAL_MS < 1500 ? GMON_CFG_SENSOR_READ_INTERVAL_MS : 1500)
 
 #define GMON_DISPLAY_NUM_PRINT_STRINGS 6
+// number of fonts registered to display context, sorted from the largest to the smallest one
+#define GMON_DISPLAY_NUM_FONTS 2
 
 #ifndef GMON_CFG_DISPLAY_SCREEN_REFRESH_TIME_MS
     #define GMON_CFG_DISPLAY_SCREEN_REFRESH_TIME_MS 100
@@ -5,10 +5,17 @@
 extern "C" {
 #endif
 
+// all fonts cover printable ASCII characters from space (0x20) to tilde (0x7E)
+#define GMON_DISPLAY_FONT_FIRST_CHR  0x20
+#define GMON_DISPLAY_FONT_LAST_CHR   0x7E
+#define GMON_DISPLAY_FONT_NUM_GLYPHS (GMON_DISPLAY_FONT_LAST_CHR - GMON_DISPLAY_FONT_FIRST_CHR + 1)
+
 typedef struct {
     unsigned short        width;
     unsigned short        height;
     const unsigned short *bitmap;
+    // advance width of each glyph in pixels, NULL means monospace font (each glyph takes `width` pixels)
+    const unsigned char  *advance;
 } gmonPrintFont_t;
 
 typedef struct {
@@ -38,13 +45,24 @@ typedef struct {
 } gMonDisplayBlock_t;
 
 typedef struct {
+    void              *dev; // low-level display device, owned by the driver
     gMonDisplayBlock_t blocks[GMON_DISPLAY_NUM_PRINT_STRINGS];
     unsigned short     num_blocks;
-    gmonPrintFont_t    fonts[1]; // TODO, Support multiple fonts
+    gmonPrintFont_t    fonts[GMON_DISPLAY_NUM_FONTS];
     struct {
         unsigned int scroll_speed;
         unsigned int refresh_rate_ms;
     } config;
+    struct { // state of screen refresh loop, kept across iterations
+        unsigned short screen_width;
+        unsigned short switch_lines_cnt;
+        unsigned char  num_scrolling;
+        unsigned char  redraw : 1;
+        // bumped whenever text lines owned by other tasks (network status, actuator threshold) are
+        // rendered, the screen is redrawn once the display task sees a different value
+        unsigned short num_updates;
+        unsigned short num_updates_shown;
+    } refresh;
 } gMonDisplayContext_t;
 
 typedef struct {
@@ -55,16 +73,24 @@ typedef struct {
 } gMonDisplayFailure_t;
 
 // ----------------------------
-gMonStatus     staDisplayDevInit(void);
-gMonStatus     staDisplayDevDeInit(void);
-gMonStatus     staDisplayRefreshScreen(void);
-unsigned short staDisplayDevGetScreenWidth(void);
-unsigned short staDisplayDevGetScreenHeight(void);
-gMonStatus     staDiplayDevPrintString(gmonPrintInfo_t *);
+// the driver allocates state of each display device, so more than one station can run in the same process
+gMonStatus     staDisplayDevInit(void **dev, gMonArena_t *);
+gMonStatus     staDisplayDevDeInit(void *dev, gMonArena_t *);
+gMonStatus     staDisplayRefreshScreen(void *dev);
+gMonStatus     staDisplayDevClearScreen(void *dev);
+unsigned short staDisplayDevGetScreenWidth(void *dev);
+unsigned short staDisplayDevGetScreenHeight(void *dev);
+gMonStatus     staDiplayDevPrintString(void *dev, gmonPrintInfo_t *);
+
+unsigned short staDisplayGlyphAdvance(const gmonPrintFont_t *, unsigned char chr);
+unsigned int   staDisplayStrPixelWidth(const gmonPrintFont_t *, const gmonStr_t *);
+gMonStatus     staDisplayLayoutBlock(gMonDisplayContext_t *, gmonPrintInfo_t *, unsigned short scr_width);
 
 gMonStatus staDisplayInit(struct gardenMonitor_s *);
 gMonStatus staDisplayDeInit(struct gardenMonitor_s *);
 gMonStatus staDisplayFailure(gMonDisplayContext_t *, gMonDisplayFailure_t);
+gMonStatus staDisplayRefreshStart(gMonDisplayContext_t *);
+gMonStatus staDisplayRefreshIteration(struct gardenMonitor_s *);
 
 void stationDisplayTaskFn(void *params);
 
@@ -0,0 +1,48 @@
+#ifndef STATION_EVT_LATENCY_H
+#define STATION_EVT_LATENCY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Latency of sensor events. If `GMON_CFG_ENABLE_EVENT_LATENCY` is defined, each event records system
+// time when its samples were acquired, and time elapsed until each stage (see `gmonEventStage_t`) while
+// the sensor pipeline and data logger task process it. Network handler task adds latency of all stages
+// of the serialized events to the histograms of their sensor type, and latency of the oldest serialized
+// event to the histogram of acknowledgement stage, once all log messages are acknowledged.
+
+// summary of a histogram, `p50_ms` is upper bound of the bucket where the median falls in
+typedef struct {
+    unsigned int num_events; // number of events serialized
+    unsigned int p50_ms[GMON_EVT_NUM_STAGES];
+    unsigned int max_ms[GMON_EVT_NUM_STAGES];
+} gMonEvtLatencyStat_t;
+
+void staEvtLatencyAdd(gMonEvtLatencyHist_t *, gmonEventStage_t, unsigned int latency_ms);
+void staEvtLatencySummary(const gMonEvtLatencyHist_t *, gMonEvtLatencyStat_t *out);
+
+#ifdef GMON_CFG_ENABLE_EVENT_LATENCY
+void staEvtLatencyBegin(gmonEvent_t *, unsigned int acquired_ms, unsigned int detected_ms);
+void staEvtLatencyStamp(gmonEvent_t *, gmonEventStage_t);
+// add all events in the record to histogram of the sensor type `item`
+void staEvtLatencyOnSerialized(
+    gMonEvtLatency_t *, gMonAppMsgItem_t item, const gmonSensorRecord_t *, unsigned int now_ms
+);
+void staEvtLatencyOnAcked(gMonEvtLatency_t *, unsigned int now_ms);
+// start next window, events not acknowledged yet are still tracked
+void staEvtLatencyReset(gMonEvtLatency_t *);
+
+    #define GMON_EVT_LATENCY_NOW_MS() (stationSysGetTickCount() * GMON_NUM_MILLISECONDS_PER_TICK)
+    #define GMON_EVT_LATENCY_BEGIN(evt, acquired_ms, detected_ms) \
+        staEvtLatencyBegin((evt), (acquired_ms), (detected_ms))
+    #define GMON_EVT_LATENCY_STAMP(evt, stage) staEvtLatencyStamp((evt), (stage))
+#else
+    #define GMON_EVT_LATENCY_NOW_MS()                             0
+    #define GMON_EVT_LATENCY_BEGIN(evt, acquired_ms, detected_ms) (void)(acquired_ms), (void)(detected_ms)
+    #define GMON_EVT_LATENCY_STAMP(evt, stage)
+#endif // end of GMON_CFG_ENABLE_EVENT_LATENCY
+
+#ifdef __cplusplus
+}
+#endif
+#endif // end of STATION_EVT_LATENCY_H
@@ -16,9 +16,11 @@ extern "C" {
 #include "station_app_msg.h"
 #include "station_io.h"
 #include "station_util.h"
+#include "station_trace.h"
+#include "station_profile.h"
+#include "station_evt_latency.h"
+#include "station_sensor_pipeline.h"
 #include "station_daylight_track.h"
-#include "station_aircond_track.h"
-#include "station_soilcond_track.h"
 
 #ifdef __cplusplus
 }
@@ -15,6 +15,12 @@ typedef struct {
     unsigned short      total_nbytes;
 } gmonSensorSamples_t;
 
+// data types of sensor samples, each of them comes with its own noise detection and aggregation
+// functions in sensor_sample.c, X(function suffix, data type, type of single sample)
+#define GMON_SENSOR_DATA_TYPES(X) \
+    X(U32, GMON_SENSOR_DATA_TYPE_U32, unsigned int) \
+    X(AirCond, GMON_SENSOR_DATA_TYPE_AIRCOND, gmonAirCond_t)
+
 gMonStatus stationIOinit(gardenMonitor_t *);
 gMonStatus stationIOdeinit(gardenMonitor_t *);
 
@@ -33,6 +39,7 @@ gMonStatus staSetNumResamplesSoilSensor(gMonSensorMeta_t *, unsigned char new_va
 
 gMonStatus staSensorInitAirTemp(gMonSensorMeta_t *);
 gMonStatus staSensorDeInitAirTemp(gMonSensorMeta_t *);
+// returns GMON_RESP_SKIP without reading the sensors until they warm up after initialization
 gMonStatus staSensorReadAirTemp(gMonSensorMeta_t *, gmonSensorSample_t *);
 gMonStatus staSetNumAirSensor(gMonSensorMeta_t *, unsigned char new_val);
 gMonStatus staSetNumResamplesAirSensor(gMonSensorMeta_t *, unsigned char new_val);
@@ -56,6 +63,13 @@ char         staSensorPollEnabled(gMonSoilSensorMeta_t *, unsigned short idx);
 gMonStatus staSensorDetectNoise(gMonSensorMeta_t *, gmonSensorSample_t *);
 gMonStatus staSensorSampleToEvent(gmonEvent_t *, gmonSensorSample_t *);
 
+#define GMON_SENSOR_DTYPE_FN_DECLARE(sfx, type_id, elm_t) \
+    gmonSensorSamples_t staAllocSensorSampleBuffer##sfx(gmonSensorSamples_t, gMonSensorMeta_t *); \
+    gMonStatus          staSensorDetectNoise##sfx(gMonSensorMeta_t *, gmonSensorSample_t *); \
+    gMonStatus          staSensorSampleToEvent##sfx(gmonEvent_t *, gmonSensorSample_t *);
+GMON_SENSOR_DATA_TYPES(GMON_SENSOR_DTYPE_FN_DECLARE)
+#undef GMON_SENSOR_DTYPE_FN_DECLARE
+
 // ------ actuators ------
 gMonStatus staActuatorInitPump(gMonActuator_t *);
 gMonStatus staActuatorDeinitPump(void);
@@ -8,13 +8,96 @@ extern "C" {
 struct gMonMsgPipe_t {
     stationSysMsgbox_t sensor2display;
     stationSysMsgbox_t sensor2net;
+    // number of the oldest events abandoned because the message box was full
+    struct {
+        unsigned int sensor2display;
+        unsigned int sensor2net;
+    } num_dropped;
 };
 
+// items which can be left out of log message, the order is the same as in serialized message
+typedef enum {
+    GMON_APPMSG_ITEM_SOILMOIST = 0,
+    GMON_APPMSG_ITEM_AIRTEMP,
+    GMON_APPMSG_ITEM_LIGHT,
+    GMON_APPMSG_ITEM_PUMP,
+    GMON_APPMSG_ITEM_FAN,
+    GMON_APPMSG_ITEM_BULB,
+    GMON_APPMSG_NUM_ITEMS,
+} gMonAppMsgItem_t;
+
+#define GMON_APPMSG_NUM_ACTUATORS (GMON_APPMSG_NUM_ITEMS - GMON_APPMSG_ITEM_PUMP)
+
+// the latest values of sensors and actuators serialized to log message
+typedef struct {
+    unsigned int  soilmoist[GMON_MAXNUM_SOIL_SENSORS];
+    gmonAirCond_t aircond[GMON_MAXNUM_AIR_SENSORS];
+    unsigned int  light[GMON_MAXNUM_LIGHT_SENSORS];
+    unsigned char qty[GMON_APPMSG_ITEM_PUMP]; // number of sensors for each sensor type
+    struct {
+        unsigned int  worktime;
+        unsigned char status;
+    } actuator[GMON_APPMSG_NUM_ACTUATORS];
+    unsigned char valid; // bit flag for each item in `gMonAppMsgItem_t`
+} gMonAppMsgSnapshot_t;
+
+// report by exception, an item is serialized only if it moved beyond the deadband since `acked`,
+// which are the values the remote user received. `pending` also includes the values in the messages
+// not acknowledged yet, it becomes `acked` once all of them are delivered.
+typedef struct {
+    gMonAppMsgSnapshot_t acked;
+    gMonAppMsgSnapshot_t pending;
+    unsigned char        num_since_full; // number of messages serialized since last full message
+    struct {
+        unsigned int num_full;
+        unsigned int num_omitted; // total number of items left out of messages
+    } stats;
+} gMonAppMsgDeadband_t;
+
+typedef struct {
+    gmonSensorRecord_t soilmoist;
+    gmonSensorRecord_t aircond;
+    gmonSensorRecord_t light;
+} gMonSensorRecords_t;
+
+// records detached from `latest_logs` with state of the actuators at the same moment, they are serialized
+// to outflight message while the sensor tasks keep logging new events to `latest_logs`
+typedef struct {
+    gMonSensorRecords_t logs;
+    gMonActuator_t      actuators[GMON_APPMSG_NUM_ACTUATORS]; // pump, fan, bulb
+} gMonAppMsgDetached_t;
+
+#define GMON_EVT_LATENCY_NUM_BUCKETS 20
+
+// log2 histogram of latency from acquisition of samples to each stage, for one sensor type. Bucket 0
+// counts latency below 1 ms, bucket `n` counts latency in range [2^(n-1), 2^n) ms, the last bucket also
+// counts anything longer.
+typedef struct {
+    unsigned short counts[GMON_EVT_NUM_STAGES][GMON_EVT_LATENCY_NUM_BUCKETS];
+    unsigned int   max_ms[GMON_EVT_NUM_STAGES];
+} gMonEvtLatencyHist_t;
+
+// histograms are collected by network handler task in a window of several full log messages, then
+// reported in the message closing the window
+typedef struct {
+    gMonEvtLatencyHist_t hist[GMON_APPMSG_ITEM_PUMP]; // for each sensor type
+    // acquisition time of the oldest event serialized since the last acknowledgement
+    unsigned int  oldest_unacked_ms[GMON_APPMSG_ITEM_PUMP];
+    unsigned char unacked; // bit flag for each sensor type
+    unsigned char num_full_since_report;
+} gMonEvtLatency_t;
+
 typedef struct {
-    gmonStr_t outflight;
-    gmonStr_t inflight;
-    void     *jsn_decoded_token;
-    void     *jsn_decoder;
+    gmonStr_t            outflight;
+    gmonStr_t            inflight;
+    void                *jsn_decoded_token;
+    void                *jsn_decoder;
+    // report by exception, only for outflight message
+    gMonAppMsgDeadband_t deadband;
+    gMonAppMsgDetached_t detached;
+#ifdef GMON_CFG_ENABLE_EVENT_LATENCY
+    gMonEvtLatency_t latency;
+#endif
 } gMonRawMsg_t;
 
 // collecting all information, network handling objects in this application
@@ -25,9 +108,7 @@ typedef struct gardenMonitor_s {
         gMonActuator_t fan;
     } actuator;
     struct {
-        void *pump_controller; // New task for pump control and soil moisture
-        void *air_quality_monitor;
-        void *light_controller;
+        void *sensor_sched; // runs pipelines of all sensor types
         void *netconn_handler;
         void *sensor_data_aggregator_net;
         void *display_handler;
@@ -39,11 +120,7 @@ typedef struct gardenMonitor_s {
         gMonSensorMeta_t     light;
         gMonEvtPool_t        event;
     } sensors;
-    struct {
-        gmonSensorRecord_t soilmoist;
-        gmonSensorRecord_t aircond;
-        gmonSensorRecord_t light;
-    } latest_logs;
+    gMonSensorRecords_t latest_logs;
     struct {
         struct {
             struct {
@@ -67,6 +144,7 @@ typedef struct gardenMonitor_s {
     gMonNet_t            netconn;
     gmonTick_t           tick;
     gMonRawMsg_t         rawmsg;
+    gMonArena_t          arena; // long-lived objects created at initialization
 } gardenMonitor_t;
 
 #ifdef __cplusplus
@@ -5,6 +5,71 @@
 extern "C" {
 #endif
 
+// storage where the backlog spills its oldest messages once RAM slots are full (e.g. external flash),
+// entries are kept in FIFO order.
+// * `push` returns GMON_RESP_ERRMEM when the storage is full
+// * `peek` copies the oldest entry to `out`, returns GMON_RESP_SKIP when the storage is empty, or
+//   GMON_RESP_ERRMEM with size of the entry in `out->nbytes_written` if `out->len` is not enough
+typedef struct {
+    gMonStatus (*push)(void *ctx, const gmonStr_t *msg);
+    gMonStatus (*peek)(void *ctx, gmonStr_t *out);
+    gMonStatus (*pop)(void *ctx);
+    unsigned short (*count)(void *ctx);
+} gMonNetBacklogStorage_t;
+
+// bounded store-and-forward queue of log messages which could not be published
+typedef struct {
+    gmonStr_t                      slots[GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS];
+    gmonStr_t                      xfer; // buffer for message loaded from spill storage
+    const gMonNetBacklogStorage_t *storage;
+    void                          *storage_ctx;
+    unsigned char                  rd_ptr;
+    unsigned char                  num_used;
+    unsigned char                  drop_policy;
+    unsigned char                  xfer_loaded : 1;
+    struct {
+        unsigned int   num_queued;
+        unsigned int   num_spilled;
+        unsigned int   num_dropped;
+        unsigned int   num_drained;
+        unsigned short peak;
+    } stats;
+} gMonNetBacklog_t;
+
+// QoS 1 log message published to the broker, kept until its PUBACK arrives
+typedef struct {
+    gmonStr_t      msg;
+    unsigned short pkt_id;
+    unsigned char  dup : 1; // published before the connection was lost
+} gMonNetPubWinEntry_t;
+
+// window of log messages in flight (published but not acknowledged yet), PUBACKs are expected in the
+// same order as the messages were published
+typedef struct {
+    gMonNetPubWinEntry_t entries[GMON_CFG_NETCONN_PUB_WINDOW_SZ];
+    unsigned char        rd_ptr;
+    unsigned char        num_used;
+    unsigned char        num_sent; // number of entries (from the oldest) published in current connection
+    unsigned char        window;   // also limited by receive maximum of the broker
+    struct {
+        unsigned int  num_retransmit;
+        unsigned char peak;
+    } stats;
+} gMonNetPubWindow_t;
+
+#define GMON_NETCONN_ADAPTIVE_NUM_ACTUATORS 3
+
+// adaptive reporting, state of the actuators (bulb, pump, fan) when the last log message was prepared
+typedef struct {
+    // current reporting interval, between `gMonNet_t.interval_ms` and configured maximum interval
+    unsigned int  interval_ms;
+    int           aggregated[GMON_NETCONN_ADAPTIVE_NUM_ACTUATORS];
+    unsigned char status[GMON_NETCONN_ADAPTIVE_NUM_ACTUATORS];
+    unsigned char above_threshold; // bit flag for each actuator
+    unsigned char snapshot_valid : 1;
+    unsigned int  num_early; // number of reports triggered by state change before the interval elapsed
+} gMonNetAdaptive_t;
+
 typedef struct {
     // abstract low-level connection handle object
     void *lowlvl;
@@ -16,20 +81,85 @@ typedef struct {
         gMonStatus sent;
         gMonStatus recv;
     } status;
+    // state of persistent session to MQTT broker, all time values are in milliseconds
+    struct {
+        unsigned int  last_publish_ms; // also used in non-persistent mode, for reporting interval
+        unsigned int  last_sent_ms; // last time any packet sent to the broker, for keep-alive
+        unsigned int  reconn_at_ms; // earliest time to reconnect after the session is lost
+        unsigned int  backoff_ms;   // current delay between reconnections, 0 means connected
+        unsigned int  num_reconn;
+        unsigned char connected : 1;
+    } session;
+    // duration of the network cycles which published log message, in milliseconds
+    struct {
+        unsigned int last_ms;
+        unsigned int max_ms;
+    } cycle;
+    gMonNetBacklog_t   backlog;
+    gMonNetPubWindow_t pub_win;
+    gMonNetAdaptive_t  adaptive;
 } gMonNet_t;
 
-gMonStatus stationNetConnInit(gMonNet_t *);
-gMonStatus stationNetConnDeinit(gMonNet_t *);
+// context of the low-level network stack is allocated from the arena
+gMonStatus stationNetConnInit(gMonNet_t *, gMonArena_t *);
+gMonStatus stationNetConnDeinit(gMonNet_t *, gMonArena_t *);
 
 gMonStatus stationNetConnEstablish(gMonNet_t *);
 gMonStatus stationNetConnClose(gMonNet_t *);
 
 gMonStatus stationNetConnSend(gMonNet_t *, gmonStr_t *app_msg);
+// packet ID for stationNetConnPublish(), reserved from the same pool as the network stack, 0 on error
+unsigned short stationNetConnReservePktId(gMonNet_t *);
+// publish QoS 1 message without waiting for PUBACK, `dup` is set if it is retransmitted
+gMonStatus stationNetConnPublish(gMonNet_t *, gmonStr_t *app_msg, unsigned short pkt_id, unsigned char dup);
+// GMON_RESP_SKIP means user control message arrived first and was copied to `ctrl_msg`
+gMonStatus stationNetConnWaitPubAck(gMonNet_t *, unsigned short pkt_id, gmonStr_t *ctrl_msg);
 gMonStatus stationNetConnRecv(gMonNet_t *, gmonStr_t *app_msg);
 
+gMonStatus   stationNetConnSubscribe(gMonNet_t *);
+gMonStatus   stationNetConnPoll(gMonNet_t *, gmonStr_t *app_msg, unsigned int timeout_ms);
+gMonStatus   stationNetConnPing(gMonNet_t *);
+unsigned int staNetConnNextBackoff(unsigned int curr_backoff_ms);
+
 gMonStatus staSetNetConnTaskInterval(gMonNet_t *, unsigned int new_interval);
 
-void stationNetConnHandlerTaskFn(void *params);
+// `storage` can be NULL, then only RAM slots are used
+gMonStatus     staNetConnBacklogInit(gMonNetBacklog_t *, const gMonNetBacklogStorage_t *storage, void *ctx);
+gMonStatus     staNetConnBacklogDeinit(gMonNetBacklog_t *);
+gMonStatus     staNetConnBacklogPush(gMonNetBacklog_t *, const gmonStr_t *msg);
+gmonStr_t     *staNetConnBacklogPeek(gMonNetBacklog_t *);
+gMonStatus     staNetConnBacklogPop(gMonNetBacklog_t *);
+unsigned short staNetConnBacklogCount(gMonNetBacklog_t *);
+
+// `peer_recv_max` is receive maximum announced by the broker, 0 means not announced
+gMonStatus            staNetConnPubWinInit(gMonNetPubWindow_t *);
+gMonStatus            staNetConnPubWinDeinit(gMonNetPubWindow_t *);
+void                  staNetConnPubWinSetWindow(gMonNetPubWindow_t *, unsigned short peer_recv_max);
+gMonNetPubWinEntry_t *staNetConnPubWinAdd(gMonNetPubWindow_t *, const gmonStr_t *msg, unsigned short pkt_id);
+gMonNetPubWinEntry_t *staNetConnPubWinNextUnsent(gMonNetPubWindow_t *);
+void                  staNetConnPubWinMarkSent(gMonNetPubWindow_t *);
+gMonNetPubWinEntry_t *staNetConnPubWinOldest(gMonNetPubWindow_t *);
+gMonStatus            staNetConnPubWinAck(gMonNetPubWindow_t *, unsigned short pkt_id);
+void                  staNetConnPubWinRewind(gMonNetPubWindow_t *);
+unsigned char         staNetConnPubWinCount(gMonNetPubWindow_t *);
+#ifdef GMON_CFG_NETCONN_BACKLOG_SPILL
+// implemented in platform code, return storage for spilled log messages and its context
+const gMonNetBacklogStorage_t *staPlatformGetNetBacklogStorage(void **ctx);
+#endif
+
+// reporting interval falls back to `interval_ms` if GMON_CFG_NETCONN_ADAPTIVE_INTERVAL is disabled
+void          staNetConnAdaptiveReset(gMonNet_t *);
+unsigned char staNetConnReportDue(struct gardenMonitor_s *, unsigned int now_ms);
+void          staNetConnReportStamp(gMonNet_t *, unsigned int now_ms);
+void          staNetConnAdaptiveOnReport(struct gardenMonitor_s *);
+unsigned int  staNetConnCheckIntervalMs(gMonNet_t *);
+unsigned int  staNetConnReportIntervalMs(gMonNet_t *);
+
+// network handler task is a loop of the iterations below, it's split up so the network stack
+// can be exercised without the task scheduler
+gMonStatus stationNetConnHandlerStart(gMonNet_t *);
+gMonStatus stationNetConnHandlerIteration(struct gardenMonitor_s *);
+void       stationNetConnHandlerTaskFn(void *params);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,52 @@
+#ifndef STATION_PROFILE_H
+#define STATION_PROFILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Critical-section profiler. If `GMON_CFG_ENABLE_CRITSECT_PROFILE` is defined, every call site of
+// `stationSysEnterCritical()` gets its own statistics : number of entries, maximum and total time spent
+// until the matching `stationSysExitCritical()`, which is how long interrupts are disabled on target
+// board (or the process-wide lock is held on host). Nested critical sections are measured separately,
+// each of them includes time spent in the inner ones.
+//
+// Durations are measured by CPU cycle counter of the platform (`stationSysGetCycleCount()`), and the
+// bookkeeping itself is protected by the critical section being measured, so no extra lock is needed.
+
+// up to this level of nesting are measured, deeper critical sections still work but are not recorded
+#define GMON_CRITSECT_PROF_MAX_NESTING 8
+
+// cycle counter of platforms without it falls back to system tick, 1 cycle per microsecond
+#ifndef stationSysGetCycleCount
+    #define stationSysGetCycleCount() \
+        ((uint32_t)(stationSysGetTickCount() * GMON_NUM_MILLISECONDS_PER_TICK * 1000))
+    #define stationSysCyclesPerUs() 1
+#endif
+
+// head of list of all call sites entered so far, for debugger (`p *gmon_critsect_sites`)
+extern gMonProfSite_t *gmon_critsect_sites;
+
+void staCritSectProfEnter(gMonProfSite_t *);
+void staCritSectProfExit(void);
+// copy statistics of the sites entered since last reset, longest maximum duration first, returns
+// number of sites copied
+unsigned int staCritSectProfReport(gMonProfStat_t *out, unsigned int max_sites);
+void         staCritSectProfReset(void);
+
+// the profiler itself calls critical section functions of the middleware without the wrappers
+#if defined(GMON_CFG_ENABLE_CRITSECT_PROFILE) && !defined(GMON_CRITSECT_PROF_INTERNAL)
+    #undef stationSysEnterCritical
+    #undef stationSysExitCritical
+    #define stationSysEnterCritical() \
+        do { \
+            static gMonProfSite_t critsect_site = {.func = __func__, .line = __LINE__}; \
+            staCritSectProfEnter(&critsect_site); \
+        } while (0)
+    #define stationSysExitCritical() staCritSectProfExit()
+#endif // end of GMON_CFG_ENABLE_CRITSECT_PROFILE
+
+#ifdef __cplusplus
+}
+#endif
+#endif // end of STATION_PROFILE_H
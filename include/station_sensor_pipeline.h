@@ -0,0 +1,93 @@
+#ifndef STATION_SENSOR_PIPELINE_H
+#define STATION_SENSOR_PIPELINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Each sensor type is periodically read by its own pipeline, which detects noise (optional), aggregates
+// the samples into an event, triggers the actuator, then passes the event to other tasks. Functions of
+// each pipeline are generated from a row below with the data-type specific functions in sensor_sample.c,
+// new sensor type only needs a new row and the hooks it requires.
+//
+// X(name, type of sensor meta, sensor field, base sensor field, data type suffix, event type,
+//   detect noise, read function, actuator field, trigger function, read interval, hook)
+#define GMON_SENSOR_PIPELINES(X) \
+    X(SoilMoist, gMonSoilSensorMeta_t, soil_moist, soil_moist.super, U32, GMON_EVENT_SOIL_MOISTURE_UPDATED, \
+      0, GMON_SENSOR_READ_FN_SOIL_MOIST, pump, GMON_ACTUATOR_TRIG_FN_PUMP, \
+      GMON_SENSOR_PIPE_INTERVAL_SOIL_MOIST, GMON_SENSOR_PIPE_HOOK_SOIL_MOIST) \
+    X(AirTemp, gMonSensorMeta_t, air_temp, air_temp, AirCond, GMON_EVENT_AIR_TEMP_UPDATED, 1, \
+      GMON_SENSOR_READ_FN_AIR_TEMP, fan, GMON_ACTUATOR_TRIG_FN_FAN, GMON_SENSOR_PIPE_INTERVAL, \
+      GMON_SENSOR_PIPE_NO_HOOK) \
+    X(Light, gMonSensorMeta_t, light, light, U32, GMON_EVENT_LIGHTNESS_UPDATED, 0, \
+      GMON_SENSOR_READ_FN_LIGHT, bulb, GMON_ACTUATOR_TRIG_FN_BULB, GMON_SENSOR_PIPE_INTERVAL, \
+      GMON_SENSOR_PIPE_HOOK_LIGHT)
+
+// The interval will be updated by network handling task during runtime
+#define GMON_SENSOR_PIPE_INTERVAL(gmon, s)            ((s)->read_interval_ms)
+#define GMON_SENSOR_PIPE_INTERVAL_SOIL_MOIST(gmon, s) staSensorReadInterval(s)
+// hooks are invoked before reading from the sensors
+#define GMON_SENSOR_PIPE_NO_HOOK(gmon, s)         (void)(s)
+#define GMON_SENSOR_PIPE_HOOK_SOIL_MOIST(gmon, s) staSensorRefreshFastPollRatio(s)
+// TODO, redesign how to determine max work time of artifical light
+#define GMON_SENSOR_PIPE_HOOK_LIGHT(gmon, s) (gmon)->actuator.bulb.max_worktime = 1230
+
+#define GMON_SENSOR_PIPELINE_COUNT(...) +1
+#define GMON_NUM_SENSOR_PIPELINES       (0 GMON_SENSOR_PIPELINES(GMON_SENSOR_PIPELINE_COUNT))
+
+// staSensorPipeline<name>() runs the pipeline once, staSensorPipeInterval<name>() returns time to
+// wait until next run
+#define GMON_SENSOR_PIPELINE_DECLARE(name, ...) \
+    gMonStatus   staSensorPipeline##name(gardenMonitor_t *, gmonSensorSamples_t *read_vals); \
+    unsigned int staSensorPipeInterval##name(gardenMonitor_t *);
+GMON_SENSOR_PIPELINES(GMON_SENSOR_PIPELINE_DECLARE)
+#undef GMON_SENSOR_PIPELINE_DECLARE
+
+typedef struct {
+    gMonStatus (*run)(gardenMonitor_t *, gmonSensorSamples_t *read_vals);
+    unsigned int (*interval_ms)(gardenMonitor_t *);
+} gMonSensorPipeline_t;
+
+// all the pipelines generated from the table above
+extern const gMonSensorPipeline_t gmon_sensor_pipelines[];
+
+// All sensor pipelines are run by single task, the scheduler keeps next read time of each pipeline in
+// a min-heap, and sleeps until the earliest one. Pipelines listed earlier in the table above have higher
+// priority when several of them are due.
+typedef struct {
+    unsigned int  due_ms;
+    unsigned int  interval_ms; // used to schedule `due_ms`
+    unsigned char idx;         // index to the pipeline and its read buffer
+} gMonSensorSchedEntry_t;
+
+// the scheduler task wakes up at least this often to pick up read interval changed by remote user
+#define GMON_SENSOR_SCHED_MAX_SLEEP_MS 1000
+
+typedef struct {
+    const gMonSensorPipeline_t *pipelines;
+    gmonSensorSamples_t         read_vals[GMON_NUM_SENSOR_PIPELINES];
+    gMonSensorSchedEntry_t      heap[GMON_NUM_SENSOR_PIPELINES];
+    unsigned char               len;
+    struct {
+        unsigned int num_runs;
+        // number of times a pipeline was behind its schedule by whole interval, missed reads are skipped
+        unsigned int num_late;
+        // max delay from deadline to start of each pipeline, e.g. blocked by other pipeline
+        unsigned int max_lag_ms[GMON_NUM_SENSOR_PIPELINES];
+    } stats;
+} gMonSensorSched_t;
+
+gMonStatus staSensorSchedInit(
+    gMonSensorSched_t *, gardenMonitor_t *, const gMonSensorPipeline_t *, unsigned char num_pipelines,
+    unsigned int now_ms
+);
+void         staSensorSchedDeinit(gMonSensorSched_t *);
+unsigned int staSensorSchedRunDue(gMonSensorSched_t *, gardenMonitor_t *, unsigned int now_ms);
+unsigned int staSensorSchedWaitMs(gMonSensorSched_t *, unsigned int now_ms);
+
+void stationSensorSchedTaskFn(void *params);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // end of STATION_SENSOR_PIPELINE_H
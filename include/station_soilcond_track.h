@@ -1,13 +0,0 @@
-#ifndef STATION_SOILCOND_TRACK_H
-#define STATION_SOILCOND_TRACK_H
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-void pumpControllerTaskFn(void *params);
-
-#ifdef __cplusplus
-}
-#endif
-#endif // end of STATION_SOILCOND_TRACK_H
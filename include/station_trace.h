@@ -0,0 +1,124 @@
+#ifndef STATION_TRACE_H
+#define STATION_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdatomic.h>
+
+// Fixed-size trace ring recording timing of the tasks. Writers (tasks or ISRs) claim a slot with one
+// atomic increment and never wait for each other, the oldest entries are overwritten once the ring is
+// full. An entry is valid only after its sequence number is published, so the ring can be dumped at any
+// time, e.g. by debugger (`dump binary value trace.bin gmon_trace_mem`) or at exit of the simulator,
+// then converted to Chrome / Perfetto trace JSON by host tool (see `make trace2json`).
+//
+// Layout of the ring is the same on target and host (32-bit fields, little endian), bump
+// `GMON_TRACE_RING_VERSION` whenever it changes.
+
+#define GMON_TRACE_RING_MAGIC   0x52544d47 // "GMTR" in memory
+#define GMON_TRACE_RING_VERSION 1
+
+// task which recorded the entry, thread ID in exported trace
+typedef enum {
+    GMON_TRACE_TASK_SENSOR = 1,
+    GMON_TRACE_TASK_DATALOG,
+    GMON_TRACE_TASK_NETCONN,
+    GMON_TRACE_TASK_DISPLAY,
+    GMON_TRACE_NUM_TASKS,
+} gMonTraceTask_t;
+
+// events come in begin / end pairs for duration of a stage, or as single instant
+typedef enum {
+    GMON_TRACE_EVT_SENSOR_PIPELINE_BEGIN = 1, // arg : index of the pipeline
+    GMON_TRACE_EVT_SENSOR_PIPELINE_END,       // arg : status returned by the pipeline
+    GMON_TRACE_EVT_SENSOR_NOTIFY,             // instant, arg : event type
+    GMON_TRACE_EVT_DATALOG_BEGIN,             // arg : event type
+    GMON_TRACE_EVT_DATALOG_END,               // arg : non-zero if the oldest record was discarded
+    GMON_TRACE_EVT_NETCONN_BEGIN,             // arg : non-zero if log message is sent in this cycle
+    GMON_TRACE_EVT_NETCONN_END,               // arg : send status
+    GMON_TRACE_EVT_DISPLAY_REFRESH_BEGIN,     // arg : non-zero if entire screen is redrawn
+    GMON_TRACE_EVT_DISPLAY_REFRESH_END,       // arg : status of screen refresh
+    GMON_TRACE_NUM_EVENTS,
+} gMonTraceEvent_t;
+
+typedef struct {
+    uint32_t seq;   // position in the ring plus one, zero means the slot is being written
+    uint32_t ts_us; // wraps around in about 71 minutes
+    int16_t  arg;
+    uint8_t  task_id;
+    uint8_t  event_id;
+} gmonTraceEntry_t;
+
+typedef struct {
+    uint32_t         magic;
+    uint16_t         version;
+    uint16_t         capacity; // power of 2
+    atomic_uint      head;     // total number of entries recorded
+    gmonTraceEntry_t entries[];
+} gMonTraceRing_t;
+
+// number of 32-bit words for ring of given capacity, for static storage
+#define GMON_TRACE_RING_NWORDS(capacity) \
+    ((sizeof(gMonTraceRing_t) + sizeof(gmonTraceEntry_t) * (capacity) + 3) >> 2)
+
+// microseconds, from cycle counter of the platform if there is one, otherwise from system tick
+#ifndef GMON_TRACE_TIMESTAMP_US
+    #ifdef stationSysGetCycleCount
+        #define GMON_TRACE_TIMESTAMP_US() \
+            staTraceCyclesToUs(stationSysGetCycleCount(), stationSysCyclesPerUs())
+        #define GMON_TRACE_CYCLE_CLOCK
+    #else
+        #define GMON_TRACE_TIMESTAMP_US() \
+            ((uint32_t)(stationSysGetTickCount() * GMON_NUM_MILLISECONDS_PER_TICK * 1000))
+    #endif
+#endif
+
+gMonStatus staTraceRingInit(gMonTraceRing_t *, unsigned int nbytes);
+void       staTraceRingRecord(gMonTraceRing_t *, uint8_t task_id, uint8_t event_id, int16_t arg);
+// copy valid entries in the order they were recorded, from the oldest, returns number of entries copied
+unsigned int staTraceRingSnapshot(gMonTraceRing_t *, gmonTraceEntry_t *out, unsigned int max_entries);
+unsigned int staTraceRingDumpSize(const gMonTraceRing_t *);
+// 32-bit cycle counter wraps around in a few seconds (e.g. 23.8 sec at 180 MHz), it is extended by
+// counting the wraps, provided that the counter is sampled at least once every quarter of the period
+// (5.9 sec at 180 MHz). A timestamp taken later than that, the first one since the top bit of the
+// counter flipped, is taken as stale and lands one period too early. Besides the timestamps, sensor
+// scheduler task samples the counter with staTraceCyclesTrack() each time it wakes up, which is at
+// least once every second, so quiet periods without any trace record are covered.
+uint32_t staTraceCyclesToUs(uint32_t cycles, unsigned int cycles_per_us);
+void     staTraceCyclesTrack(uint32_t cycles);
+// for exported trace, NULL if the ID is unknown
+const char *staTraceTaskName(uint8_t task_id);
+const char *staTraceEventName(uint8_t event_id);
+// 'B' or 'E' for begin / end of duration event, 'i' for instant event
+char staTraceEventPhase(uint8_t event_id);
+
+#ifdef GMON_CFG_ENABLE_TRACE
+extern uint32_t gmon_trace_mem[];
+
+    #define GMON_TRACE_INIT() \
+        staTraceRingInit( \
+            (gMonTraceRing_t *)gmon_trace_mem, \
+            sizeof(uint32_t) * GMON_TRACE_RING_NWORDS(GMON_CFG_TRACE_NUM_ENTRIES) \
+        )
+    #define GMON_TRACE(task, evt, arg) \
+        staTraceRingRecord( \
+            (gMonTraceRing_t *)gmon_trace_mem, GMON_TRACE_TASK_##task, GMON_TRACE_EVT_##evt, (int16_t)(arg) \
+        )
+    #define GMON_TRACE_RING() ((gMonTraceRing_t *)gmon_trace_mem)
+    #ifdef GMON_TRACE_CYCLE_CLOCK
+        #define GMON_TRACE_CLOCK_UPDATE() staTraceCyclesTrack(stationSysGetCycleCount())
+    #else
+        #define GMON_TRACE_CLOCK_UPDATE() (void)0
+    #endif
+#else
+    #define GMON_TRACE_INIT()          GMON_RESP_SKIP
+    #define GMON_TRACE(task, evt, arg) (void)(arg)
+    #define GMON_TRACE_RING()          NULL
+    #define GMON_TRACE_CLOCK_UPDATE()  (void)0
+#endif // end of GMON_CFG_ENABLE_TRACE
+
+#ifdef __cplusplus
+}
+#endif
+#endif // end of STATION_TRACE_H
@@ -73,6 +73,20 @@ typedef enum {
     GMON_EVENT_LIGHTNESS_UPDATED,
 } gmonEventType_t;
 
+// stages which a sensor event goes through after its samples are acquired, the latency from acquisition to
+// each stage is measured if `GMON_CFG_ENABLE_EVENT_LATENCY` is enabled. Time of the stages before
+// serialization is stamped to the event itself.
+typedef enum {
+    GMON_EVT_STAGE_DETECT = 0, // noise of the samples detected
+    GMON_EVT_STAGE_AGGREGATE,  // samples aggregated to the event
+    GMON_EVT_STAGE_TRIGGER,    // actuator triggered by the event
+    GMON_EVT_STAGE_LOGGED,     // event logged to the records by data logger task
+    GMON_EVT_NUM_STAMPED_STAGES,
+    GMON_EVT_STAGE_SERIALIZED = GMON_EVT_NUM_STAMPED_STAGES, // serialized to log message
+    GMON_EVT_STAGE_ACKED, // log message acknowledged by the broker
+    GMON_EVT_NUM_STAGES,
+} gmonEventStage_t;
+
 typedef struct {
     gmonEventType_t event_type         : 4;
     unsigned char   num_active_sensors : 4;
@@ -84,6 +98,12 @@ typedef struct {
     } flgs;
     unsigned int curr_ticks;
     unsigned int curr_days;
+#ifdef GMON_CFG_ENABLE_EVENT_LATENCY
+    // system time in milliseconds when the samples were acquired, and time elapsed since then until each
+    // stage, saturated at 0xffff
+    unsigned int   acquired_ms;
+    unsigned short stage_ms[GMON_EVT_NUM_STAMPED_STAGES];
+#endif
     // depend on `event_type`, this field points to array of one of following types :
     // - `unsigned int`, if `GMON_EVENT_SOIL_MOISTURE_UPDATED` or `GMON_EVENT_LIGHTNESS_UPDATED`
     // - `gmonAirCond_t`, if `GMON_EVENT_AIR_TEMP_UPDATED`
@@ -103,8 +123,10 @@ typedef struct {
 } gmonSensorRecord_t;
 
 typedef struct {
-    gmonEvent_t *pool;
-    unsigned int len;
+    gmonEvent_t   *pool;
+    unsigned int   len;
+    unsigned short num_used;
+    unsigned short peak; // high-water mark of `num_used`
 } gMonEvtPool_t;
 
 // metadata for a sensor type
@@ -180,6 +202,13 @@ typedef struct {
     unsigned int last_read;
 } gmonTick_t;
 
+// bump allocator of long-lived objects created at initialization, see `staArenaCalloc()`
+typedef struct {
+    unsigned char *mem;
+    unsigned int   len;
+    unsigned int   used; // number of bytes allocated, including padding for alignment
+} gMonArena_t;
+
 // forware declaration
 struct gardenMonitor_s;
 
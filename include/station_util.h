@@ -5,6 +5,8 @@
 extern "C" {
 #endif
 
+#include <stdatomic.h>
+
 #define GMON_NUM_MILLISECONDS_PER_TICK (GMON_SYS_TICK_RATE_HZ / 1000)
 
 #define GMON_NUM_TICKS_PER_DAY (GMON_NUM_MILLISECONDS_PER_DAY / GMON_NUM_MILLISECONDS_PER_TICK)
@@ -24,6 +26,8 @@ char staGetBitFlag(unsigned char *list, unsigned short idx);
 unsigned int stationGetTicksPerDay(gmonTick_t *);
 // get number of days since the target hardware platform started working
 unsigned int stationGetDays(gmonTick_t *);
+// used by delay-until primitive of the middleware, see `stationSysDelayUntilMs()`
+unsigned int staNextWakeupMs(unsigned int *prev_wake_ms, unsigned int period_ms, unsigned int now_ms);
 
 void staReverseString(unsigned char *str, unsigned int sz);
 
@@ -48,6 +52,71 @@ gMonStatus staSetFloatInRange(float *target, float new_val, float max, float min
 
 gMonStatus staEnsureStrBufferSize(gmonStr_t *, unsigned short new_required_len);
 
+// Arena for long-lived objects created at initialization. Memory is taken from the given region in
+// order, objects are never released one by one, the whole region is reclaimed by `staArenaReset()`, so
+// boot is deterministic and the heap is not fragmented. If an arena has no region (e.g. the station
+// context in unit tests), the functions fall back to heap. Not thread-safe, meant for initialization.
+#define GMON_ARENA_ALIGN 8
+
+gMonStatus staArenaInit(gMonArena_t *, void *mem, unsigned int len);
+// zero-initialized, NULL if the arena is exhausted
+void *staArenaCalloc(gMonArena_t *, unsigned int num, unsigned int size);
+// memory in the arena is left as it is, otherwise it returns to heap
+void staArenaFree(gMonArena_t *, void *ptr);
+void staArenaReset(gMonArena_t *);
+
+// statistics of a profiled call site, statically allocated at the call site and linked to the list of
+// all sites of the same profiler on first use, see also critical-section profiler in station_profile.h .
+// Statistics are updated by atomic operations, total cycles are split into 32-bit halves since 64-bit
+// atomics are not lock-free on Cortex-M4
+typedef struct gMonProfSite_s {
+    const char            *func;
+    uint16_t               line;
+    atomic_uchar           registered;
+    atomic_uint            count;
+    atomic_uint            max_cycles;
+    atomic_uint            total_cycles_lo;
+    atomic_uint            total_cycles_hi;
+    struct gMonProfSite_s *next;
+} gMonProfSite_t;
+
+typedef struct {
+    const char  *func;
+    unsigned int line;
+    unsigned int count;
+    unsigned int max_ns;
+    unsigned int avg_ns;
+} gMonProfStat_t;
+
+// Scope profiler. If `GMON_CFG_ENABLE_PROF_SCOPE` is defined, `GMON_PROF_SCOPE()` placed at the top of a
+// function measures CPU cycles spent from there until the function returns (by any return statement),
+// using cycle counter of the platform (`stationSysGetCycleCount()`) : DWT on STM32, `clock_gettime()` on
+// host. Nested scopes are measured separately, the outer one includes time spent in the inner ones.
+typedef struct {
+    gMonProfSite_t *site;
+    uint32_t        start;
+} gMonProfScope_t;
+
+// head of list of all profiled scopes entered so far, for debugger (`p *gmon_prof_scope_sites`). Scopes
+// are pushed to the list without lock, and never removed from it
+extern gMonProfSite_t *_Atomic gmon_prof_scope_sites;
+
+gMonProfScope_t staProfScopeBegin(gMonProfSite_t *);
+void            staProfScopeEnd(gMonProfScope_t *);
+// copy statistics of the scopes entered since last reset, longest maximum duration first, returns number
+// of scopes copied
+unsigned int staProfScopeReport(gMonProfStat_t *out, unsigned int max_sites);
+void         staProfScopeReset(void);
+
+#ifdef GMON_CFG_ENABLE_PROF_SCOPE
+    #define GMON_PROF_SCOPE() \
+        static gMonProfSite_t prof_scope_site = {.func = __func__, .line = __LINE__}; \
+        gMonProfScope_t       prof_scope __attribute__((cleanup(staProfScopeEnd))) = \
+            staProfScopeBegin(&prof_scope_site)
+#else
+    #define GMON_PROF_SCOPE()
+#endif // end of GMON_CFG_ENABLE_PROF_SCOPE
+
 #ifdef __cplusplus
 }
 #endif
@@ -132,7 +132,7 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelete            1
 #define INCLUDE_vTaskCleanUpResources  0
 #define INCLUDE_vTaskSuspend           1
-#define INCLUDE_vTaskDelayUntil        0
+#define INCLUDE_vTaskDelayUntil        1
 #define INCLUDE_vTaskDelay             1
 #define INCLUDE_xTaskGetSchedulerState 1
 // manually added for integration tests
@@ -46,6 +46,10 @@ extern "C" {
 
 #define stationSysGetTickCount() uiESPsysGetTickCount()
 
+#define stationSysGetCycleCount() staPlatformGetCycleCount()
+
+#define stationSysCyclesPerUs() staPlatformCyclesPerUs()
+
 #define stationSysDelayMs(time_ms) vESPsysDelay(time_ms)
 
 #define stationSysTaskWaitUntilExit(task_p, return_p)
@@ -77,10 +81,18 @@ gMonStatus stationSysCreateTask(
 
 gMonStatus stationSysTaskDelete(stationSysTask_t *task_ptr);
 
+// minimum amount of stack (in words) left to the task since it started
+unsigned int stationSysGetTaskStackFree(stationSysTask_t task);
+// free heap in bytes, current and minimum ever since boot
+unsigned int stationSysGetHeapFree(void);
+unsigned int stationSysGetHeapMinFree(void);
+
 gMonStatus stationSysInit(void);
 
 gMonStatus stationSysDelayUs(unsigned short time_us);
 
+gMonStatus stationSysDelayUntilMs(unsigned int *prev_wake_ms, unsigned int period_ms);
+
 gMonStatus staSysCvtResp(int resp_in);
 
 #ifdef __cplusplus
@@ -0,0 +1,121 @@
+#ifndef STATION_MIDDLEWARE_H
+#define STATION_MIDDLEWARE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// POSIX port of the middleware layer, for running the entire station on a workstation (see `make sim`),
+// each task is a thread of the host process.
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+
+#define XMALLOC(size)       malloc(size)
+#define XCALLOC             calloc
+#define XREALLOC            realloc
+#define XMEMFREE(ptr)       free(ptr)
+#define XASSERT(cond)       assert(cond)
+#define XMEMSET(d, v, n)    memset((d), (v), (n))
+#define XMEMCPY(d, s, n)    memcpy((d), (s), (n))
+#define XSTRLEN(s)          strlen((const char *)(s))
+#define XSTRNCMP(s1, s2, n) strncmp((const char *)(s1), (const char *)(s2), (n))
+
+#define configASSERT(x) assert(x)
+
+// priority is passed to the host scheduler only as a hint, see `stationSysCreateTask()`
+#define GMON_TASKS_PRIO_MIN 1
+
+#define GMON_MAX_BLOCKTIME_SYS_MSGBOX 0xffffffff
+
+#define GMON_SYS_TICK_RATE_HZ 1000
+
+#define stationSysEnterCritical() staSysEnterCritical()
+
+#define stationSysExitCritical() staSysExitCritical()
+
+#define stationSysGetTickCount() staSysGetTickCount()
+
+#define GMON_TRACE_TIMESTAMP_US() staSysGetTimestampUs()
+
+#define stationSysGetCycleCount() staSysGetCycleCount()
+
+#define stationSysCyclesPerUs() 1000
+
+#define stationSysDelayMs(time_ms) staSysDelayMs(time_ms)
+
+#define stationSysTaskWaitUntilExit(task_p, return_p) staSysTaskWaitUntilExit((task_p), (return_p))
+
+#define staSysMsgBoxCreate(length) staSysMboxCreate(length)
+
+#define staSysMsgBoxDelete(msgbuf) staSysMboxDelete(msgbuf)
+
+#define staSysMsgBoxGet(msgbuf, msg, block_time) staSysMboxGet((msgbuf), (msg), (block_time))
+
+#define staSysMsgBoxPut(msgbuf, msg, block_time) staSysMboxPut((msgbuf), (msg), (block_time))
+
+#define staCvtUNumToStr(outstr, num) staSysCvtUNumToStr((unsigned char *)(outstr), (num), 10)
+
+#define staCvtUNumToHexStr(outstr, num) staSysCvtUNumToStr((unsigned char *)(outstr), (num), 16)
+
+typedef struct staSysTask_s *stationSysTask_t;
+
+typedef void (*stationSysTaskFn_t)(void *);
+
+typedef struct staSysMsgbox_s *stationSysMsgbox_t;
+
+// `stack_sz` is in words as in RTOS port, it is scaled up to minimum stack size of the host threads
+gMonStatus stationSysCreateTask(
+    const char *task_name, stationSysTaskFn_t task_fp, void *const args, size_t stack_sz, uint32_t prio,
+    uint8_t isPrivileged, stationSysTask_t *task_ptr
+);
+
+// NULL deletes the calling task
+gMonStatus stationSysTaskDelete(stationSysTask_t *task_ptr);
+
+// stack and heap of the host process are not measured, these always return zero
+unsigned int stationSysGetTaskStackFree(stationSysTask_t task);
+unsigned int stationSysGetHeapFree(void);
+unsigned int stationSysGetHeapMinFree(void);
+
+// the caller is never resumed once the scheduler of RTOS port started, the caller of this function
+// (main thread) is parked in the same way until run time of the simulation (environment variable
+// `GMON_SIM_RUN_SEC`, forever if not set) elapsed, then the whole process exits. The run time is counted
+// in virtual time if time-warp mode is enabled (environment variable `GMON_SIM_TIME_WARP`).
+void staSysTaskWaitUntilExit(stationSysTask_t *task_ptr, void **return_p);
+
+gMonStatus stationSysInit(void);
+
+void staSysEnterCritical(void);
+
+void staSysExitCritical(void);
+
+// milliseconds since the first call, read from virtual clock in time-warp mode
+uint32_t staSysGetTickCount(void);
+// microseconds, for trace entries, wraps around in the same way as tick counter
+uint32_t staSysGetTimestampUs(void);
+// nanoseconds of host clock which is not adjusted by NTP, as CPU cycle counter of target board for
+// profilers, always read from wall clock because it measures computation, not waiting
+uint32_t staSysGetCycleCount(void);
+
+void staSysDelayMs(unsigned int time_ms);
+
+gMonStatus stationSysDelayUs(unsigned short time_us);
+
+gMonStatus stationSysDelayUntilMs(unsigned int *prev_wake_ms, unsigned int period_ms);
+
+// `block_time` is in milliseconds, zero returns immediately, `GMON_MAX_BLOCKTIME_SYS_MSGBOX` waits forever
+stationSysMsgbox_t staSysMboxCreate(size_t length);
+void               staSysMboxDelete(stationSysMsgbox_t *msgbuf_ptr);
+gMonStatus         staSysMboxGet(stationSysMsgbox_t msgbuf, void **msg, uint32_t block_time);
+gMonStatus         staSysMboxPut(stationSysMsgbox_t msgbuf, void *msg, uint32_t block_time);
+
+// number of characters written to `outstr`, without NULL terminator
+unsigned int staSysCvtUNumToStr(unsigned char *outstr, unsigned int num, unsigned char base);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // end of STATION_MIDDLEWARE_H
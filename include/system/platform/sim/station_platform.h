@@ -0,0 +1,75 @@
+#ifndef STATION_PLATFORM_H
+#define STATION_PLATFORM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// simulated hardware platform for host build (see `make sim`), sensors read from a simple model of the
+// garden which responds to the actuators, the display and the network link are stand-ins without
+// real devices.
+#include <stdint.h>
+
+#define GMON_PLATFORM_PIN_DIRECTION_OUT 1 // from host microcontroller to wired sensor
+#define GMON_PLATFORM_PIN_DIRECTION_IN  2 // from wired sensor to host microcontroller
+
+#define GMON_PLATFORM_DISPLAY_SPI 1
+#define GMON_PLATFORM_DISPLAY_I2C 2
+
+// one signal pin for each air sensor, also upper bound of the number of air sensors
+#define GMON_PLATFORM_NUM_AIR_SENSOR_PINS 3
+
+#define GMON_PLATFORM_PIN_RESET 0
+#define GMON_PLATFORM_PIN_SET   1
+
+// ---- functions that interface hardware implementation from application domain ----
+
+gMonStatus stationPlatformInit(void);
+// also reports activity of the simulated devices to standard output
+gMonStatus stationPlatformDeinit(void);
+
+gMonStatus staSensorPlatformInitSoilMoist(gMonSensorMeta_t *);
+gMonStatus staSensorPlatformDeInitSoilMoist(gMonSensorMeta_t *);
+gMonStatus staPlatformReadSoilMoistSensor(gMonSensorMeta_t *, gmonSensorSample_t *);
+
+gMonStatus staSensorPlatformInitAirTemp(gMonSensorMeta_t *);
+gMonStatus staSensorPlatformDeInitAirTemp(gMonSensorMeta_t *);
+
+gMonStatus staSensorPlatformInitLight(gMonSensorMeta_t *);
+gMonStatus staSensorPlatformDeInitLight(gMonSensorMeta_t *);
+gMonStatus staPlatformReadLightSensor(gMonSensorMeta_t *, gmonSensorSample_t *);
+
+gMonStatus staActuatorPlatformInitPump(void **pinstruct);
+gMonStatus staActuatorPlatformInitFan(void **pinstruct);
+gMonStatus staActuatorPlatformInitBulb(void **pinstruct);
+
+gMonStatus staDisplayPlatformInit(uint8_t comm_protocal_id, void **pinstruct);
+gMonStatus staDisplayPlatformDeinit(void *pinstruct);
+
+gMonStatus staPlatformPinSetDirection(void *pinstruct, uint8_t direction);
+gMonStatus staPlatformSPItransmit(void *pinstruct, unsigned char *pData, unsigned short sz);
+
+gMonStatus staPlatformWritePin(void *pinstruct, uint8_t new_state);
+uint8_t    staPlatformReadPin(void *pinstruct);
+
+gMonStatus staPlatformDelayUs(uint16_t us);
+
+// frames of air sensors are generated from the garden model, the caller is blocked for time length of
+// the longest frame, see station_platform.h of STM32 port for detail
+gMonStatus
+staPlatformCaptureEdges(void *pinstruct, uint16_t *edges_us, uint16_t num_edges, uint16_t timeout_ms);
+gMonStatus staPlatformCaptureEdgesMulti(
+    void **pinstructs, uint8_t num_pins, uint16_t *edges_us, uint16_t num_edges, uint16_t timeout_ms,
+    gMonStatus *pin_status
+);
+
+void *staPlatformiGetDisplayRstPin(void);
+void *staPlatformiGetDisplayDataCmdPin(void);
+
+// number of log messages and bytes published to the broker stand-in, see net_loopback.c
+void staPlatformSimNetStats(unsigned int *num_published, unsigned int *nbytes_published);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // end of STATION_PLATFORM_H
@@ -15,8 +15,16 @@ extern "C" {
 #define HW_LIGHT_SENSOR_ADC_CH1 ADC_CHANNEL_7
 #define HW_LIGHT_SENSOR_ADC_CH2 ADC_CHANNEL_9
 
-#define HW_AIRTEMP_PORT GPIOB
-#define HW_AIRTEMP_PIN  GPIO_PIN_8
+// signal pins of air sensors, each is mapped to input capture channel of timer 4
+#define HW_AIRTEMP_PORT    GPIOB
+#define HW_AIRTEMP_AF      GPIO_AF2_TIM4
+#define HW_AIRTEMP_TIM     TIM4
+#define HW_AIRTEMP1_PIN    GPIO_PIN_8 // PB8 ------> TIM4_CH3
+#define HW_AIRTEMP1_TIM_CH TIM_CHANNEL_3
+#define HW_AIRTEMP2_PIN    GPIO_PIN_6 // PB6 ------> TIM4_CH1
+#define HW_AIRTEMP2_TIM_CH TIM_CHANNEL_1
+#define HW_AIRTEMP3_PIN    GPIO_PIN_7 // PB7 ------> TIM4_CH2
+#define HW_AIRTEMP3_TIM_CH TIM_CHANNEL_2
 
 // Actuator Pin Assignments
 #define HW_PUMP_PORT GPIOC
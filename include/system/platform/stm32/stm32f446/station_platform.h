@@ -15,9 +15,16 @@ extern "C" {
 #define GMON_PLATFORM_DISPLAY_SPI 1
 #define GMON_PLATFORM_DISPLAY_I2C 2
 
+// one signal pin for each air sensor, also upper bound of the number of air sensors
+#define GMON_PLATFORM_NUM_AIR_SENSOR_PINS 3
+
 #define GMON_PLATFORM_PIN_RESET GPIO_PIN_RESET
 #define GMON_PLATFORM_PIN_SET   GPIO_PIN_SET
 
+// free-running cycle counter of Cortex-M4 core (DWT), started in `stationPlatformInit()`
+#define staPlatformGetCycleCount() (DWT->CYCCNT)
+#define staPlatformCyclesPerUs()   (SystemCoreClock / 1000000)
+
 // ---- functions that interface hardware implementation from application domain ----
 
 gMonStatus stationPlatformInit(void);
@@ -49,11 +56,20 @@ uint8_t    staPlatformReadPin(void *pinstruct);
 
 gMonStatus staPlatformDelayUs(uint16_t us);
 
-// direction :
-// - 1: transition from LOW to HIGH
-// - 0: transition from HIGH to LOW
-// us : pulse length in microseconds
-gMonStatus staPlatformMeasurePulse(void *pinstruct, uint8_t *direction, uint16_t *us);
+// release the bus then record timestamps of `num_edges` edges (both rising and falling) on the pin
+// in microseconds, caller task is blocked until all edges are captured or `timeout_ms` elapsed. The
+// caller keeps the bus LOW before this call, capture is armed before the bus is released, so the
+// first timestamp is always the rising edge of the release, edges driven by the device follow it.
+// timestamps come from 16-bit counter which might wrap around within the captured edges.
+gMonStatus
+staPlatformCaptureEdges(void *pinstruct, uint16_t *edges_us, uint16_t num_edges, uint16_t timeout_ms);
+// same as above, the bus of all the given pins are released together and captured in parallel,
+// `edges_us` is split into `num_pins` consecutive blocks of `num_edges` timestamps, one for each pin,
+// result of each pin is written to `pin_status`
+gMonStatus staPlatformCaptureEdgesMulti(
+    void **pinstructs, uint8_t num_pins, uint16_t *edges_us, uint16_t num_edges, uint16_t timeout_ms,
+    gMonStatus *pin_status
+);
 
 void *staPlatformiGetDisplayRstPin(void);
 void *staPlatformiGetDisplayDataCmdPin(void);
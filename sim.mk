@@ -0,0 +1,50 @@
+# build the entire station as host program, tasks run as POSIX threads on top of simulated platform,
+# e.g. for profiling with perf or checking with sanitizers.
+SIM_BUILD_DIR = $(BUILD_DIR_TOP)/sim
+
+# extra compiler flags for sanitizers, e.g. SIM_SANITIZE=-fsanitize=address,undefined
+SIM_SANITIZE ?=
+
+SIM_C_HEADERS = \
+	include/system/middleware/posix/station_middleware.h \
+	include/system/platform/sim/station_platform.h
+
+SIM_C_SOURCES_3PTY = \
+	src/system/middleware/posix/middleware.c \
+	src/system/platform/sim/iodev.c \
+	src/system/platform/sim/net_loopback.c
+
+# network stand-in replaces MQTT client, which depends on the ESP8266 AT parser
+SIM_SRC = $(_COMMON_C_ENTRY_FILE) $(filter-out src/network/mqtt_client.c, $(_COMMON_C_SOURCES_FUNC)) \
+		  $(SIM_C_SOURCES_3PTY)
+
+SIM_OBJS = $(patsubst %.c, $(SIM_BUILD_DIR)/%.o, $(SIM_SRC))
+
+SIM_CFLAGS = -Wall -Wextra -std=c2x -g -O2 -fno-omit-frame-pointer -pthread $(SIM_SANITIZE)
+SIM_CFLAGS += -I$(MONT_STATION_PROJ_HOME)/include
+SIM_CFLAGS += -I$(MONT_STATION_PROJ_HOME)/include/system/middleware/posix
+SIM_CFLAGS += -I$(MONT_STATION_PROJ_HOME)/include/system/platform/sim
+SIM_CFLAGS += -I$(JSMN_ROOT)
+
+SIM_LDFLAGS = -pthread -lm $(SIM_SANITIZE)
+
+SIM_EXE = $(SIM_BUILD_DIR)/station_sim.out
+
+.PHONY: sim sim_clean
+
+sim: $(SIM_EXE)
+	@echo "Running station simulator..."
+	@$(SIM_EXE)
+
+$(SIM_EXE): $(SIM_OBJS)
+	@mkdir -p $(@D)
+	@$(CC) $(SIM_OBJS) -o $@ $(SIM_LDFLAGS)
+	@echo "Station simulator built: $@"
+
+$(SIM_BUILD_DIR)/%.o: %.c
+	@mkdir -p $(dir $@)
+	@$(CC) $(SIM_CFLAGS) -c $< -o $@
+
+sim_clean:
+	@echo "Cleaning station simulator build artifacts..."
+	@$(RM) -r $(SIM_BUILD_DIR)
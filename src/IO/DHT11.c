@@ -1,11 +1,22 @@
 #include "station_include.h"
 
+// each air sensor takes one signal pin, the platform may wire fewer pins than the application supports
+#if (GMON_PLATFORM_NUM_AIR_SENSOR_PINS < GMON_MAXNUM_AIR_SENSORS)
+    #define GMON_DHT11_MAXNUM_SENSORS GMON_PLATFORM_NUM_AIR_SENSOR_PINS
+#else
+    #define GMON_DHT11_MAXNUM_SENSORS GMON_MAXNUM_AIR_SENSORS
+#endif
+#if (GMON_CFG_NUM_AIR_SENSORS > GMON_DHT11_MAXNUM_SENSORS)
+    #error "GMON_CFG_NUM_AIR_SENSORS must NOT be greater than number of air sensor pins on the platform."
+#endif
+
 gMonStatus staSetNumAirSensor(gMonSensorMeta_t *s, unsigned char new_val) {
     if (s == NULL)
         return GMON_RESP_ERRARGS;
     unsigned int temp_num_items = 0;
-    gMonStatus   status =
-        staSetUintInRange(&temp_num_items, (unsigned int)new_val, (unsigned int)GMON_MAXNUM_AIR_SENSORS, 0U);
+    gMonStatus   status = staSetUintInRange(
+        &temp_num_items, (unsigned int)new_val, (unsigned int)GMON_DHT11_MAXNUM_SENSORS, 0U
+    );
     if (status == GMON_RESP_OK)
         s->num_items = (unsigned char)temp_num_items;
     return status;
@@ -22,6 +33,14 @@ gMonStatus staSetNumResamplesAirSensor(gMonSensorMeta_t *s, unsigned char new_va
     return status;
 }
 
+// DHT11 does not respond within 1 second after power on. The warm-up happens once, reads requested
+// before it ends are skipped instead of blocking the task which also runs the other sensor pipelines.
+#define GMON_DHT11_POWER_ON_MS 1000
+static unsigned int  dht11_ready_ms = 0;
+static unsigned char dht11_warming_up = 0;
+
+static unsigned int sensorAirNowMs(void) { return stationSysGetTickCount() * GMON_NUM_MILLISECONDS_PER_TICK; }
+
 gMonStatus staSensorInitAirTemp(gMonSensorMeta_t *s) {
     gMonStatus status = staSensorSetReadInterval(s, GMON_CFG_SENSOR_READ_INTERVAL_MS);
     if (status != GMON_RESP_OK)
@@ -38,75 +57,77 @@ gMonStatus staSensorInitAirTemp(gMonSensorMeta_t *s) {
     status = staSensorSetMinMAD(s, GMON_AIR_SENSOR_MAD_THRESHOLD);
     if (status != GMON_RESP_OK)
         return status;
-    return staSensorPlatformInitAirTemp(s);
+    status = staSensorPlatformInitAirTemp(s);
+    if (status == GMON_RESP_OK) {
+        dht11_ready_ms = sensorAirNowMs() + GMON_DHT11_POWER_ON_MS;
+        dht11_warming_up = 1;
+    }
+    return status;
 }
 
 gMonStatus staSensorDeInitAirTemp(gMonSensorMeta_t *s) { return staSensorPlatformDeInitAirTemp(s); }
 
-// Helper function to measure the duration of a pin state
+// Edges of a DHT11 frame, captured after MCU releases the bus :
+// - falling, rising, falling edges of 80us LOW / 80us HIGH acknowledgment pulses
+// - rising, falling edges of each data bit, 50us LOW followed by HIGH pulse of variable length
+// - rising edge at the end of final 50us LOW pulse
+#define GMON_DHT11_NUM_FRAME_EDGES (3 + (40 << 1) + 1)
+// the platform also records rising edge of the bus released by MCU, before the frame
+#define GMON_DHT11_NUM_CAPTURE_EDGES (1 + GMON_DHT11_NUM_FRAME_EDGES)
+// entire frame takes about 4-5 ms
+#define GMON_DHT11_FRAME_TIMEOUT_MS 10
+
+// Helper function to verify the duration between 2 captured edges, the timer counter might wrap around
 static gMonStatus measureVerifyPulse(
-    void *signal_pin, uint8_t expect_init_state, uint16_t refpoint_pulse_us, uint16_t deviation_us,
+    const uint16_t *edges_us, uint16_t idx, uint16_t refpoint_pulse_us, uint16_t deviation_us,
     uint16_t *actual_pulse_us
 ) {
-    uint16_t pulse_us_read = 0;
-    uint8_t  state_low2high = 0, state_expected = 0, pulse_range_fit = 0;
     XASSERT(refpoint_pulse_us > deviation_us);
-    gMonStatus status = staPlatformMeasurePulse(signal_pin, &state_low2high, &pulse_us_read);
-    if (status == GMON_RESP_OK) {
-        uint16_t maxlimit = refpoint_pulse_us + deviation_us;
-        uint16_t minlimit = refpoint_pulse_us - deviation_us;
-        state_expected = (expect_init_state != state_low2high);
-        pulse_range_fit = (pulse_us_read >= minlimit && pulse_us_read <= maxlimit);
-        if (state_expected && pulse_range_fit) {
-            if (actual_pulse_us) {
-                *actual_pulse_us = pulse_us_read;
-            }
-        } else {
-            status = GMON_RESP_ERR_MSG_DECODE;
-        }
-    }
-    return status;
+    uint16_t pulse_us = (uint16_t)(edges_us[idx + 1] - edges_us[idx]);
+    uint16_t maxlimit = refpoint_pulse_us + deviation_us;
+    uint16_t minlimit = refpoint_pulse_us - deviation_us;
+    if (pulse_us < minlimit || pulse_us > maxlimit)
+        return GMON_RESP_ERR_MSG_DECODE;
+    if (actual_pulse_us)
+        *actual_pulse_us = pulse_us;
+    return GMON_RESP_OK;
 }
 
 /**
- * @brief Reads 40-bit data from the DHT11 sensor.
+ * @brief Decodes 40-bit data from edges captured on DHT11 signal pin.
  *
- * This function interacts with the DHT11 sensor through the `signal_pin`
- * to read the 40-bit data stream (5 bytes). It measures the duration of
- * HIGH pulses to differentiate between '0' and '1' bits according to the
- * DHT11 protocol.
+ * Timestamps of all the edges in a frame are recorded by the platform (e.g. timer input capture),
+ * this function measures the duration of HIGH pulses between the edges in one pass, to differentiate
+ * between '0' and '1' bits according to the DHT11 protocol.
  *
+ * @param edges_us Timestamps of `GMON_DHT11_NUM_FRAME_EDGES` edges in microseconds, the first one is
+ *                 falling edge of the LOW acknowledgment pulse.
  * @param data A 5-element array of uint8_t to store the received 5 bytes of data.
  *             The array will be filled with humidity integer, humidity decimal,
  *             temperature integer, temperature decimal, and checksum bytes.
- * @return GMON_RESP_OK if data is read successfully,
- *         GMON_RESP_TIMEOUT if a signal transition timeout occurs,
- *         or other gMonStatus error codes from platform functions.
+ * @return GMON_RESP_OK if data is decoded successfully,
+ *         GMON_RESP_ERR_MSG_DECODE if any pulse is out of the expected range,
+ *         GMON_RESP_SENSOR_FAIL if HIGH pulse of a data bit cannot be recognized.
  */
-static gMonStatus readDht11SensorData(void *signal_pin, uint8_t data[5]) {
-    // After MCU pulls the line HIGH for 20-40us and releases it (sets pin to input mode),
-    // the DHT11 should respond by pulling the line LOW for ~80us.
+static gMonStatus decodeDht11SensorData(const uint16_t *edges_us, uint8_t data[5]) {
     gMonStatus status = GMON_RESP_OK;
     uint16_t   pulse_us = 0, idx;
-    // 1. check whether to sample DHT11's LOW acknowledgment pulse with
-    // positive-integer length time.
-    status = measureVerifyPulse(signal_pin, GMON_PLATFORM_PIN_RESET, 80, 40, NULL);
+    // 1. DHT11's LOW acknowledgment pulse, ~80us
+    status = measureVerifyPulse(edges_us, 0, 80, 40, NULL);
     if (status != GMON_RESP_OK)
         return status;
-
-    // 2. Check for DHT11's 80us HIGH acknowledgment pulse
-    status = measureVerifyPulse(signal_pin, GMON_PLATFORM_PIN_SET, 80, 8, NULL);
+    // 2. DHT11's 80us HIGH acknowledgment pulse
+    status = measureVerifyPulse(edges_us, 1, 80, 8, NULL);
     if (status != GMON_RESP_OK)
         return status;
-
-    // 3. Read 40 bits of data
+    // 3. 40 bits of data
     for (idx = 0; idx < 40; idx++) {
         // Each data bit transmission starts with a 50us LOW pulse
-        status = measureVerifyPulse(signal_pin, GMON_PLATFORM_PIN_RESET, 50, 7, NULL);
+        status = measureVerifyPulse(edges_us, 2 + (idx << 1), 50, 7, NULL);
         if (status != GMON_RESP_OK)
             return status;
         // The length of the subsequent HIGH pulse determines the bit value
-        status = measureVerifyPulse(signal_pin, GMON_PLATFORM_PIN_SET, 45, 35, &pulse_us);
+        status = measureVerifyPulse(edges_us, 3 + (idx << 1), 45, 35, &pulse_us);
         if (status != GMON_RESP_OK)
             return status;
         // Decode bit based on HIGH pulse duration:
@@ -121,51 +142,94 @@ static gMonStatus readDht11SensorData(void *signal_pin, uint8_t data[5]) {
             return GMON_RESP_SENSOR_FAIL;
         }
     }
-    // 4. Check for final 50us LOW pulse from DHT11 at the end of transmission
-    status = measureVerifyPulse(signal_pin, GMON_PLATFORM_PIN_RESET, 50, 7, NULL);
+    // 4. final 50us LOW pulse from DHT11 at the end of transmission
     // After this, the bus is passively pulled HIGH by a resistor.
-    return status;
-} // end of readDht11SensorData
+    return measureVerifyPulse(edges_us, GMON_DHT11_NUM_FRAME_EDGES - 2, 50, 7, NULL);
+} // end of decodeDht11SensorData
 
-static gMonStatus sensorReadAirIteration(void *signal_pin, gmonAirCond_t *out) {
-    gMonStatus status = GMON_RESP_OK;
+// issue start signal from MCU on all the given pins together. The bus is left LOW, it is released by
+// the platform in staPlatformCaptureEdges() after the capture is armed, so the sensor cannot respond
+// before its first edge can be recorded, even if this task is preempted in between.
+static void sensorAirStartSignal(void **signal_pins, unsigned char num_pins) {
+    unsigned char idx = 0;
+    for (idx = 0; idx < num_pins; idx++) {
+        staPlatformPinSetDirection(signal_pins[idx], GMON_PLATFORM_PIN_DIRECTION_OUT);
+        staPlatformWritePin(signal_pins[idx], GMON_PLATFORM_PIN_RESET);
+    }
+    stationSysDelayMs(18); // keep start-out signal from MCU for at least 18 ms
+}
+
+static gMonStatus sensorAirDecodeFrame(const uint16_t *edges_us, gmonAirCond_t *out) {
     uint16_t   sum_data_bits = 0;
     uint8_t    record_dht_data[5] = {0};
-    // Cast data pointer to gmonAirCond_t for storing humidity and temperature
-    if (out == NULL)
-        return GMON_RESP_ERRMEM;
-    staPlatformPinSetDirection(signal_pin, GMON_PLATFORM_PIN_DIRECTION_OUT);
-    staPlatformWritePin(signal_pin, GMON_PLATFORM_PIN_RESET);
-    stationSysDelayMs(18); // keep start-out signal from MCU for at least 18 ms
-    // setup critical section, in order to prevent the running task from being preempted
-    // (or time tick interrupt since using up its time)
-    stationSysEnterCritical();
-    {
-        staPlatformWritePin(signal_pin, GMON_PLATFORM_PIN_SET);
-        // datasheet suggests 20 to 40us waiting time on MCU side, but DHT can still acknowledgment
-        // shorter high-voltage pulse and respond. TODO: test the behavior
-        stationSysDelayUs(2);
-        status = staPlatformPinSetDirection(signal_pin, GMON_PLATFORM_PIN_DIRECTION_IN);
-        if (status != GMON_RESP_OK)
-            goto done;
-        // check response signal from DHT11
-        status = readDht11SensorData(signal_pin, record_dht_data);
-        if (status != GMON_RESP_OK)
-            goto done;
+    gMonStatus status = decodeDht11SensorData(edges_us, record_dht_data);
+    if (status != GMON_RESP_OK)
+        return status;
+    sum_data_bits =
+        (record_dht_data[0] + record_dht_data[1] + record_dht_data[2] + record_dht_data[3]) & 0xff;
+    if (sum_data_bits != record_dht_data[4])
+        return GMON_RESP_SENSOR_FAIL;
+    out->humidity = record_dht_data[0] + record_dht_data[1] / 10.f;
+    out->temporature = record_dht_data[2] + record_dht_data[3] / 10.f;
+    return status;
+}
 
-        sum_data_bits =
-            (record_dht_data[0] + record_dht_data[1] + record_dht_data[2] + record_dht_data[3]) & 0xff;
-        if (sum_data_bits != record_dht_data[4]) {
-            status = GMON_RESP_SENSOR_FAIL;
-            goto done;
-        }
-        out->humidity = record_dht_data[0] + record_dht_data[1] / 10.f;
-        out->temporature = record_dht_data[2] + record_dht_data[3] / 10.f;
+#ifdef GMON_CFG_AIR_SENSOR_CONCURRENT_READ
+    #define GMON_DHT11_NUM_CAPTURE_PINS GMON_DHT11_MAXNUM_SENSORS
+#else
+    #define GMON_DHT11_NUM_CAPTURE_PINS 1
+#endif
+// only accessed by the task reading the air sensors, kept out of its stack
+static uint16_t dht11_edges_us[GMON_DHT11_NUM_CAPTURE_PINS][GMON_DHT11_NUM_CAPTURE_EDGES];
+
+// A sample which failed in any of the rounds is left unchanged in `out`, `item_status` keeps the first
+// error of each sensor, so the read is not reported as successful with stale sample in the middle.
+#ifdef GMON_CFG_AIR_SENSOR_CONCURRENT_READ
+// Start signal is issued on all the sensor pins together, their responses are captured in parallel by
+// the platform, so time spent in one round does not depend on number of sensors.
+static void sensorReadAirRound(
+    void **signal_pins, unsigned char num_pins, gmonSensorSample_t *out, unsigned char resample_idx,
+    gMonStatus *item_status
+) {
+    gMonStatus    status = GMON_RESP_OK, round_status[GMON_DHT11_MAXNUM_SENSORS] = {0};
+    unsigned char idx = 0;
+    sensorAirStartSignal(signal_pins, num_pins);
+    status = staPlatformCaptureEdgesMulti(
+        signal_pins, num_pins, &dht11_edges_us[0][0], GMON_DHT11_NUM_CAPTURE_EDGES,
+        GMON_DHT11_FRAME_TIMEOUT_MS, round_status
+    );
+    for (idx = 0; idx < num_pins; idx++) {
+        if (status != GMON_RESP_OK)
+            round_status[idx] = status;
+        else if (round_status[idx] == GMON_RESP_OK)
+            round_status[idx] = sensorAirDecodeFrame(
+                &dht11_edges_us[idx][1], &((gmonAirCond_t *)out[idx].data)[resample_idx]
+            );
+        if (item_status[idx] == GMON_RESP_OK)
+            item_status[idx] = round_status[idx];
+    }
+}
+#else
+static void sensorReadAirRound(
+    void **signal_pins, unsigned char num_pins, gmonSensorSample_t *out, unsigned char resample_idx,
+    gMonStatus *item_status
+) {
+    gMonStatus status = GMON_RESP_OK;
+    for (unsigned char idx = 0; idx < num_pins; idx++) {
+        sensorAirStartSignal(&signal_pins[idx], 1);
+        // the platform releases the bus and timestamps every edge of the response in hardware, the task
+        // sleeps until entire frame is captured, so the frame is no longer read in critical section
+        status = staPlatformCaptureEdges(
+            signal_pins[idx], dht11_edges_us[0], GMON_DHT11_NUM_CAPTURE_EDGES, GMON_DHT11_FRAME_TIMEOUT_MS
+        );
+        if (status == GMON_RESP_OK)
+            status =
+                sensorAirDecodeFrame(&dht11_edges_us[0][1], &((gmonAirCond_t *)out[idx].data)[resample_idx]);
+        if (item_status[idx] == GMON_RESP_OK)
+            item_status[idx] = status;
     }
-done:
-    stationSysExitCritical();
-    return status;
 }
+#endif // end of GMON_CFG_AIR_SENSOR_CONCURRENT_READ
 
 // TODO, FIXME :
 // - modify function signature for introducing external reliable reference positive-integer
@@ -174,28 +238,32 @@ done:
 gMonStatus staSensorReadAirTemp(gMonSensorMeta_t *sensor, gmonSensorSample_t *out) {
     if (sensor == NULL || sensor->lowlvl == NULL || sensor->num_items == 0 || out == NULL)
         return GMON_RESP_ERRARGS;
-    gMonStatus final_status = GMON_RESP_OK;
-    void      *signal_pin = sensor->lowlvl;
-    stationSysDelayMs(1000); // Wait 1 second after power on without sending any data
-    // Iterate through each 'air sensor' item (if num_items > 1)
-    for (unsigned char item_idx = 0; item_idx < sensor->num_items; ++item_idx) {
+    if (sensor->num_items > GMON_DHT11_MAXNUM_SENSORS)
+        return GMON_RESP_ERRARGS;
+    gMonStatus    item_status[GMON_DHT11_MAXNUM_SENSORS] = {0};
+    void        **signal_pins = (void **)sensor->lowlvl; // one signal pin for each sensor
+    unsigned char item_idx = 0, resample_idx = 0;
+    for (item_idx = 0; item_idx < sensor->num_items; ++item_idx) {
         // Ensure the data buffer for this specific sample is allocated
         // and is of the expected type (gmonAirCond_t) with sufficient length
         if (out[item_idx].data == NULL || out[item_idx].dtype != GMON_SENSOR_DATA_TYPE_AIRCOND ||
             out[item_idx].len < 1) {
             return GMON_RESP_ERRMEM;
         }
-        gMonStatus current_item_status = GMON_RESP_SENSOR_FAIL;
-        // Perform resampling for the current sensor item
-        for (unsigned char resample_idx = 0; resample_idx < sensor->num_resamples; ++resample_idx) {
-            current_item_status =
-                sensorReadAirIteration(signal_pin, &((gmonAirCond_t *)out[item_idx].data)[resample_idx]);
-        }
-        if (current_item_status != GMON_RESP_OK) {
-            // If after all resamples, this item still failed, propagate the error.
-            final_status = current_item_status;
-            break; // No need to try other items if one failed persistently
-        }
     }
-    return final_status;
+    if (dht11_warming_up) {
+        // no data is sent to the sensors until the warm-up ends, the flag is cleared so the comparison
+        // is not repeated after the tick counter wraps around
+        if ((int)(dht11_ready_ms - sensorAirNowMs()) > 0)
+            return GMON_RESP_SKIP;
+        dht11_warming_up = 0;
+    }
+    for (resample_idx = 0; resample_idx < sensor->num_resamples; ++resample_idx)
+        sensorReadAirRound(signal_pins, sensor->num_items, out, resample_idx, item_status);
+    // If any item failed in any of the resamples, propagate the error.
+    for (item_idx = 0; item_idx < sensor->num_items; ++item_idx) {
+        if (item_status[item_idx] != GMON_RESP_OK)
+            return item_status[item_idx];
+    }
+    return GMON_RESP_OK;
 } // end of staSensorReadAirTemp
@@ -1,13 +1,5 @@
 #include "station_include.h"
 
-// The parameters below are used to store default maximum continuously working time of user's bulb
-// , since the maximum working time of a bulb would be adjust every 24 hours for unstable natural light
-// environment e.g. the plant you grow need 7 hours growing light every day but your garden can only provide 4
-// hours natural
-//      light per day
-// TODO, recheck if It's necessary to use this
-static unsigned int gmon_bulb_max_worktime_default;
-
 gMonStatus staActuatorInitGenericPump(gMonActuator_t *dev) {
     if (dev == NULL)
         return GMON_RESP_ERRARGS;
@@ -49,8 +41,6 @@ gMonStatus staActuatorInitGenericBulb(gMonActuator_t *dev) {
     dev->min_resttime = GMON_CFG_ACTUATOR_MIN_RESTTIME_BULB;
     dev->sensor_id_mask = GMON_CFG_ACTUATOR_SENSOR_MASK_BULB;
     dev->ema.lambda_fixp = GMON_CFG_ACTUATOR_EMA_LAMBDA_BULB;
-    // blub device is mapped to light sensor, which is read in about every 10 to 30 minutes
-    gmon_bulb_max_worktime_default = GMON_CFG_ACTUATOR_MAX_WORKTIME_BULB;
     return GMON_RESP_OK;
 }
 
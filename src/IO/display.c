@@ -37,6 +37,9 @@
 #define GMON_PRINT_WORDS_PAUSE        "PAUSE"
 
 extern const unsigned short gmon_txt_font_bitmap_11x18[];
+extern const unsigned char  gmon_txt_font_advance_11x18[];
+extern const unsigned short gmon_txt_font_bitmap_6x8[];
+extern const unsigned char  gmon_txt_font_advance_6x8[];
 
 static uint16_t
 displayVerticalScroll(uint16_t curr_cnt, uint16_t max_cnt, gMonDisplayBlock_t *dblks, size_t len) {
@@ -53,14 +56,69 @@ displayVerticalScroll(uint16_t curr_cnt, uint16_t max_cnt, gMonDisplayBlock_t *d
     }
 }
 
-static void displayHorizontalScroll(gmonPrintInfo_t *info, uint16_t scr_width, uint16_t pxl_move) {
-    int end_pos_x = info->font->width * info->str.len + info->posx;
-    if (end_pos_x > 0) {
+// return non-zero if the text line has to scroll in current frame
+static uint8_t
+displayHorizontalScroll(void *dev, gmonPrintInfo_t *info, uint16_t scr_width, uint16_t pxl_move) {
+    uint8_t scrolled = 1;
+    int     txt_width = (int)staDisplayStrPixelWidth(info->font, &info->str);
+    if (txt_width <= scr_width) { // entire text line fits the screen, no need to scroll
+        info->posx = 0;
+        scrolled = 0;
+    } else if ((txt_width + info->posx) > 0) {
         info->posx -= pxl_move;
     } else { // go back & print beginning of the text lines again
         info->posx = scr_width;
     }
-    GMON_DISPLAY_DEV_PRINT_STRING_FN(info);
+    GMON_DISPLAY_DEV_PRINT_STRING_FN(dev, info);
+    return scrolled;
+}
+
+unsigned short staDisplayGlyphAdvance(const gmonPrintFont_t *font, unsigned char chr) {
+    if (font == NULL || chr < GMON_DISPLAY_FONT_FIRST_CHR || chr > GMON_DISPLAY_FONT_LAST_CHR)
+        return 0;
+    if (font->advance == NULL)
+        return font->width;
+    return font->advance[chr - GMON_DISPLAY_FONT_FIRST_CHR];
+}
+
+// width of the text in pixels, counting stops at the first non-printable character (e.g. NULL terminator)
+unsigned int staDisplayStrPixelWidth(const gmonPrintFont_t *font, const gmonStr_t *str) {
+    unsigned int   out = 0;
+    unsigned short adv = 0, idx = 0;
+    if (font == NULL || str == NULL || str->data == NULL)
+        return 0;
+    for (idx = 0; idx < str->len; idx++) {
+        adv = staDisplayGlyphAdvance(font, str->data[idx]);
+        if (adv == 0)
+            break;
+        out += adv;
+    }
+    return out;
+}
+
+// layout pass of a text block, pick the largest font which can print entire text within the screen width
+// , so the block doesn't have to scroll horizontally. If none of the fonts fits, the smallest one is
+// selected, which still shortens the scrolling distance.
+gMonStatus
+staDisplayLayoutBlock(gMonDisplayContext_t *ctx, gmonPrintInfo_t *info, unsigned short scr_width) {
+    gmonPrintFont_t *chosen = NULL;
+    uint8_t          idx = 0;
+    if (ctx == NULL || info == NULL)
+        return GMON_RESP_ERRARGS;
+    for (idx = 0; idx < GMON_DISPLAY_NUM_FONTS; idx++) {
+        if (ctx->fonts[idx].bitmap == NULL)
+            continue;
+        chosen = &ctx->fonts[idx];
+        if (staDisplayStrPixelWidth(chosen, &info->str) <= scr_width)
+            break;
+    }
+    if (chosen == NULL)
+        return GMON_RESP_ERR;
+    if (info->font != chosen) {
+        info->font = chosen;
+        info->posx = 0;
+    }
+    return GMON_RESP_OK;
 }
 
 static void staInitPrintTxtVarPtr(gmonStr_t *str, const short *fx_content_idx, unsigned char **out) {
@@ -311,6 +369,7 @@ static gMonStatus staUpdatePrintStrActuatorThreshold(
         XMEMSET(dst_buf, 0x20, fix_content_idx[5]);
         num_chr = staCvtUNumToStr(dst_buf, (unsigned int)gmon->actuator.bulb.threshold);
         XASSERT(num_chr <= fix_content_idx[5]);
+        gmon->display.refresh.num_updates++;
     }
     stationSysExitCritical();
     return GMON_RESP_OK;
@@ -415,6 +474,7 @@ static gMonStatus staUpdatePrintStrNetConn(gmonPrintInfo_t *content, void *app_c
         time_tmp = gmon->user_ctrl.last_update.days;
         num_chr = staCvtUNumToStr(dst_buf, time_tmp);
         XASSERT(num_chr <= fix_content_idx[7]);
+        gmon->display.refresh.num_updates++;
     }
     stationSysExitCritical();
     return GMON_RESP_OK;
@@ -471,6 +531,11 @@ gMonStatus staDisplayInit(gardenMonitor_t *gmon) {
     display_ctx->fonts[0].width = 11;
     display_ctx->fonts[0].height = 18;
     display_ctx->fonts[0].bitmap = gmon_txt_font_bitmap_11x18;
+    display_ctx->fonts[0].advance = gmon_txt_font_advance_11x18;
+    display_ctx->fonts[1].width = 6;
+    display_ctx->fonts[1].height = 8;
+    display_ctx->fonts[1].bitmap = gmon_txt_font_bitmap_6x8;
+    display_ctx->fonts[1].advance = gmon_txt_font_advance_6x8;
 
     display_ctx->config.refresh_rate_ms = GMON_CFG_DISPLAY_SCREEN_REFRESH_TIME_MS;
     display_ctx->config.scroll_speed = 4;                     // As per instruction
@@ -497,12 +562,13 @@ gMonStatus staDisplayInit(gardenMonitor_t *gmon) {
             break;
         default: // GMON_BLOCK_ACTUATOR_THRESHOLD, GMON_BLOCK_ACTUATOR_STATUS, GMON_BLOCK_NETCONN_STATUS
             dblk->content.str.len = XSTRLEN(print_info[idx].template_str);
-            dblk->content.str.data = XMALLOC(dblk->content.str.len + 1); // +1 for null terminator
+            // +1 for null terminator
+            dblk->content.str.data = staArenaCalloc(&gmon->arena, dblk->content.str.len + 1, 1);
             if (dblk->content.str.data == NULL) {
                 // Handle error: Free any already allocated buffers and return
                 for (uint8_t i = 0; i < idx; ++i) {
                     if (display_ctx->blocks[i].content.str.data != NULL) {
-                        XMEMFREE(display_ctx->blocks[i].content.str.data);
+                        staArenaFree(&gmon->arena, display_ctx->blocks[i].content.str.data);
                     }
                 }
                 return GMON_RESP_ERRMEM;
@@ -514,7 +580,7 @@ gMonStatus staDisplayInit(gardenMonitor_t *gmon) {
     }
     dblk = &display_ctx->blocks[GMON_BLOCK_ACTUATOR_THRESHOLD];
     dblk->render(&dblk->content, gmon);
-    return GMON_DISPLAY_DEV_INIT_FN();
+    return GMON_DISPLAY_DEV_INIT_FN(&display_ctx->dev, &gmon->arena);
 #else
     return GMON_RESP_SKIP;
 #endif // end of GMON_CFG_ENABLE_DISPLAY
@@ -527,11 +593,16 @@ gMonStatus staDisplayDeInit(gardenMonitor_t *gmon) {
     uint8_t idx;
     for (idx = 0; idx < GMON_DISPLAY_NUM_PRINT_STRINGS; idx++) {
         if (gmon->display.blocks[idx].content.str.data != NULL) {
-            XMEMFREE(gmon->display.blocks[idx].content.str.data);
+            // buffers of sensor records are resized at runtime, they return to heap
+            staArenaFree(&gmon->arena, gmon->display.blocks[idx].content.str.data);
             gmon->display.blocks[idx].content.str.data = NULL; // Prevent double-free issues
         }
     }
-    return GMON_DISPLAY_DEV_DEINIT_FN();
+    if (gmon->display.dev == NULL)
+        return GMON_RESP_OK;
+    gMonStatus status = GMON_DISPLAY_DEV_DEINIT_FN(gmon->display.dev, &gmon->arena);
+    gmon->display.dev = NULL;
+    return status;
 #else
     return GMON_RESP_SKIP;
 #endif
@@ -608,69 +679,117 @@ gMonStatus staDisplayFailure(gMonDisplayContext_t *ctx, gMonDisplayFailure_t c)
         info2->posy = ctx->fonts[0].height + 2;
         info3->posy = (ctx->fonts[0].height << 1) + 2;
         info1->posx = info2->posx = info3->posx = 0;
-        displayHorizontalScroll(info1, 0, 0);
-        displayHorizontalScroll(info2, 0, 0);
-        displayHorizontalScroll(info3, 0, 0);
+        displayHorizontalScroll(ctx->dev, info1, 0, 0);
+        displayHorizontalScroll(ctx->dev, info2, 0, 0);
+        displayHorizontalScroll(ctx->dev, info3, 0, 0);
     }
-    GMON_DISPLAY_DEV_REFRESH_SCREEN_FN();
+    GMON_DISPLAY_DEV_REFRESH_SCREEN_FN(ctx->dev);
     return GMON_RESP_OK;
 #else
     return GMON_RESP_SKIP;
 #endif
 } // end of staDisplayFailure
 
-void stationDisplayTaskFn(void *params) {
+// Get screen size of low-level display device, figure out number of lines of string
+// can be printed on the screen every time.
+gMonStatus staDisplayRefreshStart(gMonDisplayContext_t *display_ctx) {
+    uint16_t screen_width = 0;
+    uint8_t  idx = 0;
+    if (display_ctx == NULL)
+        return GMON_RESP_ERRARGS;
+    screen_width = GMON_DISPLAY_DEV_GET_SCR_WIDTH(display_ctx->dev);
+    display_ctx->refresh.screen_width = screen_width;
+    display_ctx->refresh.switch_lines_cnt = 0;
+    display_ctx->refresh.num_scrolling = 0;
+    display_ctx->refresh.redraw = 1;
+    display_ctx->refresh.num_updates_shown = display_ctx->refresh.num_updates;
+    for (idx = 0; idx < display_ctx->num_blocks; idx++)
+        staDisplayLayoutBlock(display_ctx, &display_ctx->blocks[idx].content, screen_width);
+    return GMON_RESP_OK;
+}
+
+// one round of the screen refresh loop, the caller is responsible for the delay between rounds
+gMonStatus staDisplayRefreshIteration(gardenMonitor_t *gmon) {
     gmonEvent_t *new_evt = NULL;
     gMonStatus   status = GMON_RESP_OK;
-    uint16_t     screen_width = 0, switch_lines_cnt = 0;
     uint8_t      idx = 0;
 
-    const uint32_t        block_time = 0; // GMON_MAX_BLOCKTIME_SYS_MSGBOX;
-    const uint16_t        maxnum_lines_cnt = 1000;
-    gardenMonitor_t      *gmon = (gardenMonitor_t *)params;
+    const uint32_t block_time = 0; // GMON_MAX_BLOCKTIME_SYS_MSGBOX;
+    const uint16_t maxnum_lines_cnt = 1000;
+    if (gmon == NULL)
+        return GMON_RESP_ERRARGS;
     gMonDisplayContext_t *display_ctx = &gmon->display;
     gMonDisplayBlock_t   *dblk = NULL;
-
-    // Get screen size of low-level display device, figure out number of lines of string
-    // can be printed on the screen every time.
-    screen_width = GMON_DISPLAY_DEV_GET_SCR_WIDTH();
-
-    while (1) {
-        status = staSysMsgBoxGet(gmon->msgpipe.sensor2display, (void **)&new_evt, block_time);
-        if (status == GMON_RESP_OK && new_evt != NULL) {
-            if (new_evt->data != NULL) { // FIXME , figure out why event data is lost
-                // Invoke rendering functions for relevant sensor blocks based on event type
-                switch (new_evt->event_type) {
-                case GMON_EVENT_SOIL_MOISTURE_UPDATED:
-                    dblk = &display_ctx->blocks[GMON_BLOCK_SENSOR_SOIL_RECORD];
-                    dblk->render(&dblk->content, new_evt);
-                    break;
-                case GMON_EVENT_AIR_TEMP_UPDATED:
-                    dblk = &display_ctx->blocks[GMON_BLOCK_SENSOR_AIR_RECORD];
-                    dblk->render(&dblk->content, new_evt);
-                    break;
-                case GMON_EVENT_LIGHTNESS_UPDATED:
-                    dblk = &display_ctx->blocks[GMON_BLOCK_SENSOR_LIGHT_RECORD];
-                    dblk->render(&dblk->content, new_evt);
-                    break;
-                default:
-                    break;
-                }
-            } // FIXME , figure out why event data is lost
-            dblk = &display_ctx->blocks[GMON_BLOCK_ACTUATOR_STATUS];
-            dblk->render(&dblk->content, gmon);
-            staFreeSensorEvent(&gmon->sensors.event, new_evt);
-            new_evt = NULL;
-        }
-        switch_lines_cnt = displayVerticalScroll(
-            switch_lines_cnt, maxnum_lines_cnt, display_ctx->blocks, display_ctx->num_blocks
-        );
+    uint16_t              screen_width = display_ctx->refresh.screen_width;
+
+    status = staSysMsgBoxGet(gmon->msgpipe.sensor2display, (void **)&new_evt, block_time);
+    if (status == GMON_RESP_OK && new_evt != NULL) {
+        if (new_evt->data != NULL) { // FIXME , figure out why event data is lost
+            // Invoke rendering functions for relevant sensor blocks based on event type
+            switch (new_evt->event_type) {
+            case GMON_EVENT_SOIL_MOISTURE_UPDATED:
+                dblk = &display_ctx->blocks[GMON_BLOCK_SENSOR_SOIL_RECORD];
+                dblk->render(&dblk->content, new_evt);
+                break;
+            case GMON_EVENT_AIR_TEMP_UPDATED:
+                dblk = &display_ctx->blocks[GMON_BLOCK_SENSOR_AIR_RECORD];
+                dblk->render(&dblk->content, new_evt);
+                break;
+            case GMON_EVENT_LIGHTNESS_UPDATED:
+                dblk = &display_ctx->blocks[GMON_BLOCK_SENSOR_LIGHT_RECORD];
+                dblk->render(&dblk->content, new_evt);
+                break;
+            default:
+                dblk = NULL;
+                break;
+            }
+            if (dblk != NULL) // length of sensor log may vary, font might be switched
+                staDisplayLayoutBlock(display_ctx, &dblk->content, screen_width);
+        } // FIXME , figure out why event data is lost
+        dblk = &display_ctx->blocks[GMON_BLOCK_ACTUATOR_STATUS];
+        dblk->render(&dblk->content, gmon);
+        staFreeSensorEvent(&gmon->sensors.event, new_evt);
+        new_evt = NULL;
+        display_ctx->refresh.redraw = 1;
+    }
+    display_ctx->refresh.switch_lines_cnt = displayVerticalScroll(
+        display_ctx->refresh.switch_lines_cnt, maxnum_lines_cnt, display_ctx->blocks, display_ctx->num_blocks
+    );
+    if (display_ctx->refresh.switch_lines_cnt == 0)
+        display_ctx->refresh.redraw = 1;
+    // text lines rendered by network handler task
+    stationSysEnterCritical();
+    if (display_ctx->refresh.num_updates_shown != display_ctx->refresh.num_updates) {
+        display_ctx->refresh.num_updates_shown = display_ctx->refresh.num_updates;
+        display_ctx->refresh.redraw = 1;
+    }
+    stationSysExitCritical();
+    // skip printing and SPI transfer if all text lines fit the screen and nothing changed
+    status = GMON_RESP_SKIP;
+    if (display_ctx->refresh.redraw || display_ctx->refresh.num_scrolling > 0) {
+        GMON_TRACE(DISPLAY, DISPLAY_REFRESH_BEGIN, display_ctx->refresh.redraw);
+        // clear leftover of text lines printed with different font or position
+        if (display_ctx->refresh.redraw)
+            GMON_DISPLAY_DEV_CLEAR_SCREEN_FN(display_ctx->dev);
+        display_ctx->refresh.num_scrolling = 0;
         for (idx = 0; idx < display_ctx->num_blocks; idx++) {
-            displayHorizontalScroll(
-                &display_ctx->blocks[idx].content, screen_width, display_ctx->config.scroll_speed
+            display_ctx->refresh.num_scrolling += displayHorizontalScroll(
+                display_ctx->dev, &display_ctx->blocks[idx].content, screen_width,
+                display_ctx->config.scroll_speed
             );
         }
-        GMON_DISPLAY_DEV_REFRESH_SCREEN_FN();
-        stationSysDelayMs(display_ctx->config.refresh_rate_ms);
-    } // end of while loop
+        status = GMON_DISPLAY_DEV_REFRESH_SCREEN_FN(display_ctx->dev);
+        display_ctx->refresh.redraw = 0;
+        GMON_TRACE(DISPLAY, DISPLAY_REFRESH_END, status);
+    }
+    return status;
+} // end of staDisplayRefreshIteration
+
+void stationDisplayTaskFn(void *params) {
+    gardenMonitor_t *gmon = (gardenMonitor_t *)params;
+    staDisplayRefreshStart(&gmon->display);
+    while (1) {
+        staDisplayRefreshIteration(gmon);
+        stationSysDelayMs(gmon->display.config.refresh_rate_ms);
+    }
 } // end of stationDisplayTaskFn
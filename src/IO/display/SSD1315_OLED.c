@@ -8,21 +8,20 @@
 #define OLED_SSD1315_SCREEN_FRAMEBUF_NBYTES \
     ((GMON_CFG_OLED_SSD1315_SCREEN_WIDTH * GMON_CFG_OLED_SSD1315_SCREEN_HEIGHT) >> 3)
 
+// one for each display device, allocated in `staDisplayDevInit()`
 typedef struct {
-    uint16_t screen_width;
-    uint16_t screen_height;
-    short    curr_x;
-    short    curr_y;
-    uint8_t  inverted    : 1;
-    uint8_t  initialized : 1;
+    unsigned char framebuf[OLED_SSD1315_SCREEN_FRAMEBUF_NBYTES];
+    void         *pin_spi;
+    void         *pin_rst;
+    void         *pin_dc;
+    uint16_t      screen_width;
+    uint16_t      screen_height;
+    short         curr_x;
+    short         curr_y;
+    uint8_t       inverted    : 1;
+    uint8_t       initialized : 1;
 } oled_t;
 
-static unsigned char gmon_ssd1315_framebuf[OLED_SSD1315_SCREEN_FRAMEBUF_NBYTES];
-static void         *ssd1315_display_pin_spi;
-static void         *ssd1315_display_pin_rst;
-static void         *ssd1315_display_pin_dc;
-static oled_t        oled_dev;
-
 static gMonStatus staDisplaySetGPIOpin(void *pinstruct, uint8_t pin_state) {
     gMonStatus status = GMON_RESP_SKIP;
     if (pinstruct) {
@@ -31,53 +30,57 @@ static gMonStatus staDisplaySetGPIOpin(void *pinstruct, uint8_t pin_state) {
     return status;
 }
 
-static gMonStatus staOLEDsendCmd(unsigned char cmdbyte) {
+static gMonStatus staOLEDsendCmd(oled_t *oled, unsigned char cmdbyte) {
     unsigned short datasize = 0x1;
     gMonStatus     status = GMON_RESP_SKIP;
-    status = staDisplaySetGPIOpin(ssd1315_display_pin_dc, GMON_PLATFORM_PIN_RESET);
+    status = staDisplaySetGPIOpin(oled->pin_dc, GMON_PLATFORM_PIN_RESET);
     if (status < 0) {
         goto done;
     }
-    status = staPlatformSPItransmit(ssd1315_display_pin_spi, &cmdbyte, datasize);
+    status = staPlatformSPItransmit(oled->pin_spi, &cmdbyte, datasize);
 done:
     return status;
 }
 
-static gMonStatus staOLEDsendData(unsigned char *pdata, unsigned short datasize) {
+static gMonStatus staOLEDsendData(oled_t *oled, unsigned char *pdata, unsigned short datasize) {
     gMonStatus status = GMON_RESP_SKIP;
-    status = staDisplaySetGPIOpin(ssd1315_display_pin_dc, GMON_PLATFORM_PIN_SET);
+    status = staDisplaySetGPIOpin(oled->pin_dc, GMON_PLATFORM_PIN_SET);
     if (status < 0) {
         goto done;
     }
-    status = staPlatformSPItransmit(ssd1315_display_pin_spi, pdata, datasize);
+    status = staPlatformSPItransmit(oled->pin_spi, pdata, datasize);
 done:
     return status;
 }
 
-static void staOLEDsetCursor(short x, short y) {
-    oled_dev.curr_x = x;
-    oled_dev.curr_y = y;
+static void staOLEDsetCursor(oled_t *oled, short x, short y) {
+    oled->curr_x = x;
+    oled->curr_y = y;
 }
 
-static void staDisplayDevFill(uint8_t pixel_on) {
+static void staDisplayDevFill(oled_t *oled, uint8_t pixel_on) {
     uint8_t setvalue = 0;
     setvalue = (pixel_on == 0) ? 0x00 : 0xFF;
-    XMEMSET(&gmon_ssd1315_framebuf[0], setvalue, sizeof(char) * OLED_SSD1315_SCREEN_FRAMEBUF_NBYTES);
+    XMEMSET(&oled->framebuf[0], setvalue, sizeof(char) * OLED_SSD1315_SCREEN_FRAMEBUF_NBYTES);
 }
 
-gMonStatus staDisplayRefreshScreen(void) {
+gMonStatus staDisplayRefreshScreen(void *dev) {
+    GMON_PROF_SCOPE();
+    oled_t    *oled = (oled_t *)dev;
     gMonStatus status = GMON_RESP_SKIP;
     uint8_t    idx = 0;
+    if (oled == NULL)
+        return GMON_RESP_ERRARGS;
     stationSysEnterCritical();
     for (idx = 0; idx < 8; idx++) {
         // this command potiions "page start address" from PAGE0 ~ PAGE7 in GDDRAM
-        status = staOLEDsendCmd(0xB0 + idx);
-        status |= staOLEDsendCmd(0x00);
-        status |= staOLEDsendCmd(0x10);
+        status = staOLEDsendCmd(oled, 0xB0 + idx);
+        status |= staOLEDsendCmd(oled, 0x00);
+        status |= staOLEDsendCmd(oled, 0x10);
         if (status < 0)
             break;
         staOLEDsendData(
-            &gmon_ssd1315_framebuf[(GMON_CFG_OLED_SSD1315_SCREEN_WIDTH * idx)],
+            oled, &oled->framebuf[(GMON_CFG_OLED_SSD1315_SCREEN_WIDTH * idx)],
             (size_t)GMON_CFG_OLED_SSD1315_SCREEN_WIDTH
         );
         if (status < 0)
@@ -87,232 +90,269 @@ gMonStatus staDisplayRefreshScreen(void) {
     return status;
 } // end of staDisplayRefreshScreen
 
-static gMonStatus staOLEDcmdInit(void) {
+static gMonStatus staOLEDcmdInit(oled_t *oled) {
     gMonStatus status = GMON_RESP_OK;
-    status = staDisplaySetGPIOpin(ssd1315_display_pin_rst, GMON_PLATFORM_PIN_RESET);
+    status = staDisplaySetGPIOpin(oled->pin_rst, GMON_PLATFORM_PIN_RESET);
     if (status < 0)
         goto done;
     stationSysDelayUs(6); // wait for at least 3 us after reset assertion
-    status = staDisplaySetGPIOpin(ssd1315_display_pin_rst, GMON_PLATFORM_PIN_SET);
+    status = staDisplaySetGPIOpin(oled->pin_rst, GMON_PLATFORM_PIN_SET);
     if (status < 0)
         goto done;
-    status = staOLEDsendCmd(0xAE); // display OFF, go to sleep mode to modify configuration
+    status = staOLEDsendCmd(oled, 0xAE); // display OFF, go to sleep mode to modify configuration
     if (status < 0)
         goto done;
     // set memory addressing mode, LSB 2 bit is for specifying address mode ...
     // 2'b00 : Horizontal Addressing Mode, 2'b01 : Vertical Addressing Mode, 2'b10 : Page Addressing Mode
-    status = staOLEDsendCmd(0x20); // <-- Horizontal Addressing Mode is selected at here
+    status = staOLEDsendCmd(oled, 0x20); // <-- Horizontal Addressing Mode is selected at here
     if (status < 0)
         goto done;
     // set low column address, TODO: recheck if it's necessary to set it at here.
-    status = staOLEDsendCmd(0x10);
+    status = staOLEDsendCmd(oled, 0x10);
     if (status < 0)
         goto done;
-    status = staOLEDsendCmd(0xB0); // set Page Start Address (in this case, start address is set to PAGE 0)
+    // set Page Start Address (in this case, start address is set to PAGE 0)
+    status = staOLEDsendCmd(oled, 0xB0);
     if (status < 0)
         goto done;
-    status = staOLEDsendCmd(0xC8); // set COM output scan direction, TODO: figure out difference from 0xC0
+    // set COM output scan direction, TODO: figure out difference from 0xC0
+    status = staOLEDsendCmd(oled, 0xC8);
     if (status < 0)
         goto done;
-    status = staOLEDsendCmd(0x00); // set low column address (in this case, starting column is set to COL0)
+    // set low column address (in this case, starting column is set to COL0)
+    status = staOLEDsendCmd(oled, 0x00);
     if (status < 0)
         goto done;
-    status = staOLEDsendCmd(0x10); // set high column address TODO: figure out its usage and necessary.
+    status = staOLEDsendCmd(oled, 0x10); // set high column address TODO: figure out its usage and necessary.
     if (status < 0)
         goto done;
     // set Display Start Line, LSB 6 bits are determined which RAM row is mapped to
     // COM0 , which is in PAGE0 (in this case, (GDD)RAM row 0 is mapped to COM0)
-    status = staOLEDsendCmd(0x40);
+    status = staOLEDsendCmd(oled, 0x40);
     if (status < 0)
         goto done;
-    status = staOLEDsendCmd(0x81); // set contrast control for BANK0
+    status = staOLEDsendCmd(oled, 0x81); // set contrast control for BANK0
     if (status < 0)
         goto done;
-    status = staOLEDsendCmd(0xFF); // dummy byte, TODO: figure out the usage
+    status = staOLEDsendCmd(oled, 0xFF); // dummy byte, TODO: figure out the usage
     if (status < 0)
         goto done;
-    status = staOLEDsendCmd(0xA1); // set segment re-map (column address 127, COL127 is mapped to SEG0)
+    status = staOLEDsendCmd(oled, 0xA1); // set segment re-map (column address 127, COL127 is mapped to SEG0)
     if (status < 0)
         goto done;
     // set normal display, bit 1 of RAM data means "pixel ON" (otherwise bit 0 means pixel ON)
-    status = staOLEDsendCmd(0xA6);
+    status = staOLEDsendCmd(oled, 0xA6);
     if (status < 0)
         goto done;
-    status = staOLEDsendCmd(0xA8); // set multiplex ratio
+    status = staOLEDsendCmd(oled, 0xA8); // set multiplex ratio
     if (status < 0)
         goto done;
 #if (GMON_CFG_OLED_SSD1315_SCREEN_HEIGHT == 32)
-    status = staOLEDsendCmd(0x1F); // set high column address to row 31
+    status = staOLEDsendCmd(oled, 0x1F); // set high column address to row 31
 #elif (GMON_CFG_OLED_SSD1315_SCREEN_HEIGHT == 64)
-    status = staOLEDsendCmd(0x3F); // set high column address to row 63
+    status = staOLEDsendCmd(oled, 0x3F); // set high column address to row 63
 #else
     #error "ONLY 32 or 64 rows of height is supported. Recheck your configuration."
 #endif // end of GMON_CFG_OLED_SSD1315_SCREEN_HEIGHT
     if (status < 0)
         goto done;
-    status = staOLEDsendCmd(0xA4); // display outputs according to (GDD)RAM content.
+    status = staOLEDsendCmd(oled, 0xA4); // display outputs according to (GDD)RAM content.
     if (status < 0)
         goto done;
-    status = staOLEDsendCmd(0xD3); // double-byte command: set display offset to COM0 (mapped to RAM row 0)
-    status = staOLEDsendCmd(0x00);
+    // double-byte command: set display offset to COM0 (mapped to RAM row 0)
+    status = staOLEDsendCmd(oled, 0xD3);
+    status = staOLEDsendCmd(oled, 0x00);
     if (status < 0)
         goto done;
     // double-byte command: set display clock divide ratio / Oscillator Frequency to internal DCLK
-    status = staOLEDsendCmd(0xD5);
-    status = staOLEDsendCmd(0xF0); // in this case, do not divide DCLK freq. (LSB 4 bits = 0x0), maximize
-                                   // Oscillator Frequency (MSB 4 bits = 0xf)
+    status = staOLEDsendCmd(oled, 0xD5);
+    // in this case, do not divide DCLK freq. (LSB 4 bits = 0x0), maximize Oscillator Frequency
+    // (MSB 4 bits = 0xf)
+    status = staOLEDsendCmd(oled, 0xF0);
     if (status < 0)
         goto done;
-    status = staOLEDsendCmd(0xD9); // set pre-charged period
+    status = staOLEDsendCmd(oled, 0xD9); // set pre-charged period
     // phase 1 period : 2 DCLK, phase 2 period : 2 DCLK, TODO: figure out the usage
-    status = staOLEDsendCmd(0x22);
+    status = staOLEDsendCmd(oled, 0x22);
     if (status < 0)
         goto done;
     // set COM pins hardware configuration, see Table 10-3 of SSD1306 spec for detail
-    status = staOLEDsendCmd(0xDA);
+    status = staOLEDsendCmd(oled, 0xDA);
 #if (GMON_CFG_OLED_SSD1315_SCREEN_HEIGHT == 32)
-    status = staOLEDsendCmd(0x02);
+    status = staOLEDsendCmd(oled, 0x02);
 #elif (GMON_CFG_OLED_SSD1315_SCREEN_HEIGHT == 64)
-    status = staOLEDsendCmd(0x12); // bit 5 = 0, disable COM left/right remap, bit 4 = 1
+    status = staOLEDsendCmd(oled, 0x12); // bit 5 = 0, disable COM left/right remap, bit 4 = 1
 #else
     #error "ONLY 32 or 64 rows of height is supported. Recheck your configuration."
 #endif // end of GMON_CFG_OLED_SSD1315_SCREEN_HEIGHT
     if (status < 0)
         goto done;
-    status = staOLEDsendCmd(0xDB); // set V_comh deselect level (DBh)
-    status = staOLEDsendCmd(0x20);
+    status = staOLEDsendCmd(oled, 0xDB); // set V_comh deselect level (DBh)
+    status = staOLEDsendCmd(oled, 0x20);
     if (status < 0)
         goto done;
-    status = staOLEDsendCmd(0x8D);
-    status = staOLEDsendCmd(0x14);
-    status = staOLEDsendCmd(0xAF); // display ON, go to normal mode
+    status = staOLEDsendCmd(oled, 0x8D);
+    status = staOLEDsendCmd(oled, 0x14);
+    status = staOLEDsendCmd(oled, 0xAF); // display ON, go to normal mode
     if (status < 0)
         goto done;
-    staDisplayDevFill(0x0);
-    status = staDisplayRefreshScreen();
+    staDisplayDevFill(oled, 0x0);
+    status = staDisplayRefreshScreen(oled);
 done:
     return status;
 } // end of staOLEDcmdInit
 
-gMonStatus staDisplayDevInit(void) {
+gMonStatus staDisplayDevInit(void **dev, gMonArena_t *arena) {
     gMonStatus status = GMON_RESP_OK;
-    ssd1315_display_pin_spi = NULL;
-    ssd1315_display_pin_rst = NULL;
-    ssd1315_display_pin_dc = NULL;
-    status = staDisplayPlatformInit(GMON_PLATFORM_DISPLAY_SPI, &ssd1315_display_pin_spi);
-    XASSERT(ssd1315_display_pin_spi != NULL);
+    oled_t    *oled = NULL;
+    if (dev == NULL)
+        return GMON_RESP_ERRARGS;
+    oled = staArenaCalloc(arena, 1, sizeof(oled_t));
+    if (oled == NULL)
+        return GMON_RESP_ERRMEM;
+    status = staDisplayPlatformInit(GMON_PLATFORM_DISPLAY_SPI, &oled->pin_spi);
+    XASSERT(oled->pin_spi != NULL);
     // Note: some OLED devices may not have RST pin / DC pin
-    ssd1315_display_pin_rst = staPlatformiGetDisplayRstPin();
-    ssd1315_display_pin_dc = staPlatformiGetDisplayDataCmdPin();
-    if (ssd1315_display_pin_rst != NULL) {
-        status = staPlatformPinSetDirection(ssd1315_display_pin_rst, GMON_PLATFORM_PIN_DIRECTION_OUT);
+    oled->pin_rst = staPlatformiGetDisplayRstPin();
+    oled->pin_dc = staPlatformiGetDisplayDataCmdPin();
+    if (oled->pin_rst != NULL) {
+        status = staPlatformPinSetDirection(oled->pin_rst, GMON_PLATFORM_PIN_DIRECTION_OUT);
         if (status != GMON_RESP_OK)
             goto done;
     }
-    if (ssd1315_display_pin_dc != NULL) {
-        status = staPlatformPinSetDirection(ssd1315_display_pin_dc, GMON_PLATFORM_PIN_DIRECTION_OUT);
+    if (oled->pin_dc != NULL) {
+        status = staPlatformPinSetDirection(oled->pin_dc, GMON_PLATFORM_PIN_DIRECTION_OUT);
         if (status != GMON_RESP_OK)
             goto done;
     }
-    status = staOLEDcmdInit();
+    status = staOLEDcmdInit(oled);
     if (status != GMON_RESP_OK)
         goto done;
-    oled_dev.inverted = 0;
-    oled_dev.initialized = 1;
-    oled_dev.screen_width = GMON_CFG_OLED_SSD1315_SCREEN_WIDTH;
-    oled_dev.screen_height = GMON_CFG_OLED_SSD1315_SCREEN_HEIGHT;
+    oled->inverted = 0;
+    oled->initialized = 1;
+    oled->screen_width = GMON_CFG_OLED_SSD1315_SCREEN_WIDTH;
+    oled->screen_height = GMON_CFG_OLED_SSD1315_SCREEN_HEIGHT;
 done:
+    // the device is still handed over on failure, for the caller to release it by `staDisplayDevDeInit()`
+    *dev = (void *)oled;
     return status;
 } // end of staDisplayDevInit
 
-gMonStatus staDisplayDevDeInit(void) {
+gMonStatus staDisplayDevDeInit(void *dev, gMonArena_t *arena) {
+    oled_t    *oled = (oled_t *)dev;
     gMonStatus status = GMON_RESP_OK;
-    status = staDisplayPlatformDeinit(ssd1315_display_pin_spi);
-    ssd1315_display_pin_spi = NULL;
+    if (oled == NULL)
+        return GMON_RESP_ERRARGS;
+    status = staDisplayPlatformDeinit(oled->pin_spi);
+    staArenaFree(arena, oled);
     return status;
 }
 
-unsigned short staDisplayDevGetScreenWidth(void) { return oled_dev.screen_width; }
+unsigned short staDisplayDevGetScreenWidth(void *dev) { return ((oled_t *)dev)->screen_width; }
 
-unsigned short staDisplayDevGetScreenHeight(void) { return oled_dev.screen_height; }
+unsigned short staDisplayDevGetScreenHeight(void *dev) { return ((oled_t *)dev)->screen_height; }
 
-static gMonStatus staDiplayDrawPixel(uint16_t x, uint16_t y, uint8_t color) {
+static gMonStatus staDiplayDrawPixel(oled_t *oled, uint16_t x, uint16_t y, uint8_t color) {
     gMonStatus status = GMON_RESP_OK;
     if ((GMON_CFG_OLED_SSD1315_SCREEN_WIDTH <= x) || (GMON_CFG_OLED_SSD1315_SCREEN_HEIGHT <= y)) {
         status = GMON_RESP_ERRMEM;
     } else {
         if (color != 0x0) {
-            gmon_ssd1315_framebuf[x + (y >> 3) * GMON_CFG_OLED_SSD1315_SCREEN_WIDTH] |= (1 << (y % 8));
+            oled->framebuf[x + (y >> 3) * GMON_CFG_OLED_SSD1315_SCREEN_WIDTH] |= (1 << (y % 8));
         } else {
-            gmon_ssd1315_framebuf[x + (y >> 3) * GMON_CFG_OLED_SSD1315_SCREEN_WIDTH] &= ~(1 << (y % 8));
+            oled->framebuf[x + (y >> 3) * GMON_CFG_OLED_SSD1315_SCREEN_WIDTH] &= ~(1 << (y % 8));
         }
     }
     return status;
 }
 
-static gMonStatus staDiplayDevPrintChar(char chr, uint16_t start_x, uint16_t start_y, gmonPrintFont_t *font) {
-    uint16_t   idx = 0, jdx = 0, rowpattern;
+gMonStatus staDisplayDevClearScreen(void *dev) {
+    if (dev == NULL)
+        return GMON_RESP_ERRARGS;
+    staDisplayDevFill((oled_t *)dev, 0x0);
+    return GMON_RESP_OK;
+}
+
+static gMonStatus
+staDiplayDevPrintChar(oled_t *oled, char chr, uint16_t start_x, uint16_t start_y, gmonPrintFont_t *font) {
+    uint16_t   idx = 0, jdx = 0, rowpattern, advance = 0;
     uint8_t    color = 0x1;
     gMonStatus status = GMON_RESP_OK;
 
-    if (chr < 0x20 || font == NULL) {
+    advance = staDisplayGlyphAdvance(font, (unsigned char)chr);
+    if (advance == 0) {
         status = GMON_RESP_ERRARGS;
         goto done;
-    } else if ((start_x > font->width) || (start_y > font->height)) {
+    } else if ((start_x > advance) || (start_y > font->height)) {
         status = GMON_RESP_ERRARGS;
         goto done;
     }
 
     for (idx = 0; idx < (font->height - start_y); idx++) {
-        rowpattern = font->bitmap[(chr - 0x20) * font->height + idx];
+        // rest of the glyph is below bottom edge of the screen, the line is partially visible
+        if (GMON_CFG_OLED_SSD1315_SCREEN_HEIGHT <= (oled->curr_y + idx))
+            break;
+        rowpattern = font->bitmap[(chr - GMON_DISPLAY_FONT_FIRST_CHR) * font->height + idx];
         rowpattern <<= start_x;
-        for (jdx = 0; jdx < (font->width - start_x); jdx++) {
-            if (GMON_CFG_OLED_SSD1315_SCREEN_WIDTH <= (oled_dev.curr_x + jdx + 1)) {
+        for (jdx = 0; jdx < (advance - start_x); jdx++) {
+            if (GMON_CFG_OLED_SSD1315_SCREEN_WIDTH <= (oled->curr_x + jdx + 1)) {
                 break;
             }
             color = (rowpattern & 0x8000) ? 0xff : 0x0;
-            status = staDiplayDrawPixel(oled_dev.curr_x + jdx, oled_dev.curr_y + idx, color);
+            status = staDiplayDrawPixel(oled, oled->curr_x + jdx, oled->curr_y + idx, color);
             if (status < 0) {
                 goto done;
             }
             rowpattern <<= 1;
         } // end of for loop jdx
-        if (GMON_CFG_OLED_SSD1315_SCREEN_HEIGHT <= (oled_dev.curr_y + idx)) {
-            status = GMON_RESP_SKIP;
-            break;
-        }
     } // end of for loop idx
-    oled_dev.curr_x += jdx; // font->width
+    oled->curr_x += jdx; // advance width of the glyph
 done:
     return status;
 } // end of staDiplayDevPrintChar
 
-gMonStatus staDiplayDevPrintString(gmonPrintInfo_t *printinfo) {
-    if (printinfo == NULL || printinfo->str.data == NULL || printinfo->str.len <= 0) {
+// turn off pixels from current cursor to right edge of the screen, for the rows covered by given font,
+// this removes leftover of previous frame when the text line scrolls or becomes shorter.
+static void staDiplayDevEraseLineTail(oled_t *oled, gmonPrintFont_t *font) {
+    uint16_t idx = 0, jdx = 0;
+    for (idx = 0; idx < font->height; idx++) {
+        if (GMON_CFG_OLED_SSD1315_SCREEN_HEIGHT <= (oled->curr_y + idx))
+            break;
+        for (jdx = oled->curr_x; jdx < GMON_CFG_OLED_SSD1315_SCREEN_WIDTH; jdx++)
+            staDiplayDrawPixel(oled, jdx, oled->curr_y + idx, 0x0);
+    }
+}
+
+gMonStatus staDiplayDevPrintString(void *dev, gmonPrintInfo_t *printinfo) {
+    oled_t *oled = (oled_t *)dev;
+    if (oled == NULL || printinfo == NULL || printinfo->str.data == NULL || printinfo->str.len <= 0 ||
+        printinfo->font == NULL) {
         return GMON_RESP_ERRARGS;
     }
-    uint16_t   font_width = 0;
+    uint16_t   glyph_width = 0;
     uint16_t   num_chr_skip = 0;
     short      curr_posx = 0;
     uint16_t   idx = 0;
     gMonStatus status = GMON_RESP_OK;
 
     curr_posx = printinfo->posx;
-    font_width = printinfo->font->width;
     // if position x is negative integer, skip number of characters from the beginning of the given text
     if (curr_posx < 0) {
         curr_posx = curr_posx * -1;
-        num_chr_skip = curr_posx / font_width;  // #chars to skip at the beginning.
-        curr_posx -= num_chr_skip * font_width; // 0 < curr_posx < font_width
-        // the first character may be partially printed
-        XASSERT((0 <= curr_posx) && (curr_posx < font_width));
-        staOLEDsetCursor(0, printinfo->posy);
+        for (num_chr_skip = 0; num_chr_skip < printinfo->str.len; num_chr_skip++) {
+            glyph_width = staDisplayGlyphAdvance(printinfo->font, printinfo->str.data[num_chr_skip]);
+            if (glyph_width == 0 || curr_posx < glyph_width)
+                break;
+            curr_posx -= glyph_width; // #chars to skip at the beginning.
+        }
+        // the first character may be partially printed, 0 <= curr_posx < glyph_width
+        staOLEDsetCursor(oled, 0, printinfo->posy);
     } else {
-        staOLEDsetCursor(curr_posx, printinfo->posy);
+        staOLEDsetCursor(oled, curr_posx, printinfo->posy);
         curr_posx = 0;
     }
     for (idx = num_chr_skip; idx < printinfo->str.len; idx++) {
-        status = staDiplayDevPrintChar(printinfo->str.data[idx], curr_posx, 0, printinfo->font);
+        status = staDiplayDevPrintChar(oled, printinfo->str.data[idx], curr_posx, 0, printinfo->font);
         if (status != GMON_RESP_OK) {
             break;
         }
@@ -320,5 +360,6 @@ gMonStatus staDiplayDevPrintString(gmonPrintInfo_t *printinfo) {
             curr_posx = 0;
         }
     } // end of for loop
+    staDiplayDevEraseLineTail(oled, printinfo->font);
     return status;
 } // end of staDiplayDevPrintString
@@ -192,3 +192,122 @@ const unsigned short gmon_txt_font_bitmap_11x18[] = {
     0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3880, 0x7F80,
     0x4700, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, // ~
 }; // end of gmon_txt_font_bitmap_11x18
+
+// advance width (in pixels) of each glyph above, so text can be printed in proportional width
+const unsigned char gmon_txt_font_advance_11x18[] = {
+    6, 7, 9, 11, 10, 11, 11, 7, 10, 8, 9, 11, 7, 8, 7, 9,
+    10, 8, 10, 10, 10, 10, 10, 10, 10, 10, 7, 7, 10, 10, 10, 11,
+    10, 11, 10, 10, 10, 10, 10, 10, 10, 9, 10, 11, 10, 11, 10, 10,
+    10, 11, 11, 10, 11, 10, 11, 11, 11, 11, 10, 9, 9, 8, 10, 11,
+    7, 11, 10, 10, 10, 10, 11, 10, 10, 8, 8, 11, 8, 11, 10, 10,
+    10, 10, 10, 10, 10, 10, 11, 10, 10, 10, 11, 10, 8, 9, 10,
+}; // end of gmon_txt_font_advance_11x18
+
+// compact font for status lines which don't fit the screen in 11x18 font, each glyph is left-aligned
+// in a 6x8 cell, its advance width is recorded in gmon_txt_font_advance_6x8
+const unsigned short gmon_txt_font_bitmap_6x8[] = {
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, // sp
+    0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x0000, 0x8000, 0x0000, // !
+    0xA000, 0xA000, 0xA000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, // "
+    0x5000, 0x5000, 0xF800, 0x5000, 0xF800, 0x5000, 0x5000, 0x0000, // #
+    0x2000, 0x7800, 0xA000, 0x7000, 0x2800, 0xF000, 0x2000, 0x0000, // $
+    0xC000, 0xC800, 0x1000, 0x2000, 0x4000, 0x9800, 0x1800, 0x0000, // %
+    0x6000, 0x9000, 0xA000, 0x4000, 0xA800, 0x9000, 0x6800, 0x0000, // &
+    0xC000, 0x4000, 0x8000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, // '
+    0x2000, 0x4000, 0x8000, 0x8000, 0x8000, 0x4000, 0x2000, 0x0000, // (
+    0x8000, 0x4000, 0x2000, 0x2000, 0x2000, 0x4000, 0x8000, 0x0000, // )
+    0x0000, 0x5000, 0x2000, 0xF800, 0x2000, 0x5000, 0x0000, 0x0000, // *
+    0x0000, 0x2000, 0x2000, 0xF800, 0x2000, 0x2000, 0x0000, 0x0000, // +
+    0x0000, 0x0000, 0x0000, 0x0000, 0xC000, 0x4000, 0x8000, 0x0000, // ,
+    0x0000, 0x0000, 0x0000, 0xF800, 0x0000, 0x0000, 0x0000, 0x0000, // -
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xC000, 0xC000, 0x0000, // .
+    0x0000, 0x0800, 0x1000, 0x2000, 0x4000, 0x8000, 0x0000, 0x0000, // /
+    0x7000, 0x8800, 0x9800, 0xA800, 0xC800, 0x8800, 0x7000, 0x0000, // 0
+    0x4000, 0xC000, 0x4000, 0x4000, 0x4000, 0x4000, 0xE000, 0x0000, // 1
+    0x7000, 0x8800, 0x0800, 0x1000, 0x2000, 0x4000, 0xF800, 0x0000, // 2
+    0xF800, 0x1000, 0x2000, 0x1000, 0x0800, 0x8800, 0x7000, 0x0000, // 3
+    0x1000, 0x3000, 0x5000, 0x9000, 0xF800, 0x1000, 0x1000, 0x0000, // 4
+    0xF800, 0x8000, 0xF000, 0x0800, 0x0800, 0x8800, 0x7000, 0x0000, // 5
+    0x3000, 0x4000, 0x8000, 0xF000, 0x8800, 0x8800, 0x7000, 0x0000, // 6
+    0xF800, 0x0800, 0x1000, 0x2000, 0x4000, 0x4000, 0x4000, 0x0000, // 7
+    0x7000, 0x8800, 0x8800, 0x7000, 0x8800, 0x8800, 0x7000, 0x0000, // 8
+    0x7000, 0x8800, 0x8800, 0x7800, 0x0800, 0x1000, 0x6000, 0x0000, // 9
+    0x0000, 0xC000, 0xC000, 0x0000, 0xC000, 0xC000, 0x0000, 0x0000, // :
+    0x0000, 0xC000, 0xC000, 0x0000, 0xC000, 0x4000, 0x8000, 0x0000, // ;
+    0x1000, 0x2000, 0x4000, 0x8000, 0x4000, 0x2000, 0x1000, 0x0000, // <
+    0x0000, 0x0000, 0xF800, 0x0000, 0xF800, 0x0000, 0x0000, 0x0000, // =
+    0x8000, 0x4000, 0x2000, 0x1000, 0x2000, 0x4000, 0x8000, 0x0000, // >
+    0x7000, 0x8800, 0x0800, 0x1000, 0x2000, 0x0000, 0x2000, 0x0000, // ?
+    0x7000, 0x8800, 0x0800, 0x6800, 0xA800, 0xA800, 0x7000, 0x0000, // @
+    0x7000, 0x8800, 0x8800, 0x8800, 0xF800, 0x8800, 0x8800, 0x0000, // A
+    0xF000, 0x8800, 0x8800, 0xF000, 0x8800, 0x8800, 0xF000, 0x0000, // B
+    0x7000, 0x8800, 0x8000, 0x8000, 0x8000, 0x8800, 0x7000, 0x0000, // C
+    0xE000, 0x9000, 0x8800, 0x8800, 0x8800, 0x9000, 0xE000, 0x0000, // D
+    0xF800, 0x8000, 0x8000, 0xF000, 0x8000, 0x8000, 0xF800, 0x0000, // E
+    0xF800, 0x8000, 0x8000, 0xE000, 0x8000, 0x8000, 0x8000, 0x0000, // F
+    0x7000, 0x8800, 0x8000, 0x8000, 0x9800, 0x8800, 0x7000, 0x0000, // G
+    0x8800, 0x8800, 0x8800, 0xF800, 0x8800, 0x8800, 0x8800, 0x0000, // H
+    0xE000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0xE000, 0x0000, // I
+    0x3800, 0x1000, 0x1000, 0x1000, 0x1000, 0x9000, 0x6000, 0x0000, // J
+    0x8800, 0x9000, 0xA000, 0xC000, 0xA000, 0x9000, 0x8800, 0x0000, // K
+    0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0xF800, 0x0000, // L
+    0x8800, 0xD800, 0xA800, 0x8800, 0x8800, 0x8800, 0x8800, 0x0000, // M
+    0x8800, 0x8800, 0xC800, 0xA800, 0x9800, 0x8800, 0x8800, 0x0000, // N
+    0x7000, 0x8800, 0x8800, 0x8800, 0x8800, 0x8800, 0x7000, 0x0000, // O
+    0xF000, 0x8800, 0x8800, 0xF000, 0x8000, 0x8000, 0x8000, 0x0000, // P
+    0x7000, 0x8800, 0x8800, 0x8800, 0xA800, 0x9000, 0x6800, 0x0000, // Q
+    0xF000, 0x8800, 0x8800, 0xF000, 0xA000, 0x9000, 0x8800, 0x0000, // R
+    0x7800, 0x8000, 0x8000, 0x7000, 0x0800, 0x0800, 0xF000, 0x0000, // S
+    0xF800, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x0000, // T
+    0x8800, 0x8800, 0x8800, 0x8800, 0x8800, 0x8800, 0x7000, 0x0000, // U
+    0x8800, 0x8800, 0x8800, 0x8800, 0x8800, 0x5000, 0x2000, 0x0000, // V
+    0x8800, 0x8800, 0x8800, 0xA800, 0xA800, 0xD800, 0x8800, 0x0000, // W
+    0x8800, 0x8800, 0x5000, 0x2000, 0x5000, 0x8800, 0x8800, 0x0000, // X
+    0x8800, 0x8800, 0x5000, 0x2000, 0x2000, 0x2000, 0x2000, 0x0000, // Y
+    0xF800, 0x0800, 0x1000, 0x2000, 0x4000, 0x8000, 0xF800, 0x0000, // Z
+    0xE000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0xE000, 0x0000, // [
+    0x0000, 0x8000, 0x4000, 0x2000, 0x1000, 0x0800, 0x0000, 0x0000, /* \ */
+    0xE000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0xE000, 0x0000, // ]
+    0x2000, 0x5000, 0x8800, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, // ^
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xF800, 0x0000, // _
+    0x8000, 0x4000, 0x2000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, // `
+    0x0000, 0x0000, 0x7000, 0x0800, 0x7800, 0x8800, 0x7800, 0x0000, // a
+    0x8000, 0x8000, 0xB000, 0xC800, 0x8800, 0x8800, 0xF000, 0x0000, // b
+    0x0000, 0x0000, 0x7000, 0x8000, 0x8000, 0x8800, 0x7000, 0x0000, // c
+    0x0800, 0x0800, 0x6800, 0x9800, 0x8800, 0x8800, 0x7800, 0x0000, // d
+    0x0000, 0x0000, 0x7000, 0x8800, 0xF800, 0x8000, 0x7000, 0x0000, // e
+    0x3000, 0x4800, 0x4000, 0xE000, 0x4000, 0x4000, 0x4000, 0x0000, // f
+    0x0000, 0x0000, 0x7800, 0x8800, 0x7800, 0x0800, 0x3000, 0x0000, // g
+    0x8000, 0x8000, 0xB000, 0xC800, 0x8800, 0x8800, 0x8800, 0x0000, // h
+    0x4000, 0x0000, 0xC000, 0x4000, 0x4000, 0x4000, 0xE000, 0x0000, // i
+    0x1000, 0x0000, 0x3000, 0x1000, 0x1000, 0x9000, 0x6000, 0x0000, // j
+    0x8000, 0x8000, 0x9000, 0xA000, 0xC000, 0xA000, 0x9000, 0x0000, // k
+    0xC000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0xE000, 0x0000, // l
+    0x0000, 0x0000, 0xD000, 0xA800, 0xA800, 0x8800, 0x8800, 0x0000, // m
+    0x0000, 0x0000, 0xB000, 0xC800, 0x8800, 0x8800, 0x8800, 0x0000, // n
+    0x0000, 0x0000, 0x7000, 0x8800, 0x8800, 0x8800, 0x7000, 0x0000, // o
+    0x0000, 0x0000, 0xF000, 0x8800, 0xF000, 0x8000, 0x8000, 0x0000, // p
+    0x0000, 0x0000, 0x6800, 0x9800, 0x7800, 0x0800, 0x0800, 0x0000, // q
+    0x0000, 0x0000, 0xB000, 0xC800, 0x8000, 0x8000, 0x8000, 0x0000, // r
+    0x0000, 0x0000, 0x7000, 0x8000, 0x7000, 0x0800, 0xF000, 0x0000, // s
+    0x4000, 0x4000, 0xE000, 0x4000, 0x4000, 0x4800, 0x3000, 0x0000, // t
+    0x0000, 0x0000, 0x8800, 0x8800, 0x8800, 0x9800, 0x6800, 0x0000, // u
+    0x0000, 0x0000, 0x8800, 0x8800, 0x8800, 0x5000, 0x2000, 0x0000, // v
+    0x0000, 0x0000, 0x8800, 0x8800, 0xA800, 0xA800, 0x5000, 0x0000, // w
+    0x0000, 0x0000, 0x8800, 0x5000, 0x2000, 0x5000, 0x8800, 0x0000, // x
+    0x0000, 0x0000, 0x8800, 0x8800, 0x7800, 0x0800, 0x7000, 0x0000, // y
+    0x0000, 0x0000, 0xF800, 0x1000, 0x2000, 0x4000, 0xF800, 0x0000, // z
+    0x2000, 0x4000, 0x4000, 0x8000, 0x4000, 0x4000, 0x2000, 0x0000, // {
+    0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x0000, // |
+    0x8000, 0x4000, 0x4000, 0x2000, 0x4000, 0x4000, 0x8000, 0x0000, // }
+    0x4000, 0xA800, 0x1000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, // ~
+}; // end of gmon_txt_font_bitmap_6x8
+
+const unsigned char gmon_txt_font_advance_6x8[] = {
+    3, 2, 4, 6, 6, 6, 6, 3, 4, 4, 6, 6, 3, 6, 3, 6,
+    6, 4, 6, 6, 6, 6, 6, 6, 6, 6, 3, 3, 5, 6, 5, 6,
+    6, 6, 6, 6, 6, 6, 6, 6, 6, 4, 6, 6, 6, 6, 6, 6,
+    6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 4, 6, 4, 6, 6,
+    4, 6, 6, 6, 6, 6, 6, 6, 6, 4, 5, 5, 4, 6, 6, 6,
+    6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 4, 2, 4, 6,
+}; // end of gmon_txt_font_advance_6x8
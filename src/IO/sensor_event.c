@@ -23,6 +23,8 @@ gmonEvent_t *staAllocSensorEvent(gMonEvtPool_t *epool, gmonEventType_t etyp, uns
             out = &epool->pool[idx];
             XMEMSET(out, 0x00, sizeof(gmonEvent_t));
             out->flgs.alloc = 1;
+            if (epool->peak < ++epool->num_used)
+                epool->peak = epool->num_used;
             break;
         }
     }
@@ -53,8 +55,11 @@ gMonStatus staFreeSensorEvent(gMonEvtPool_t *epool, gmonEvent_t *record) {
             status = GMON_RESP_ERRMEM; // memory not aligned
             break;
         } else if (record == addr_start) {
-            if (record->flgs.alloc != 0)
+            if (record->flgs.alloc != 0) {
                 record->flgs.alloc = 0;
+                if (epool->num_used > 0)
+                    epool->num_used--;
+            }
             break;
         }
     }
@@ -95,13 +100,17 @@ gMonStatus staCpySensorEvent(gmonEvent_t *dst, gmonEvent_t *src) {
 }
 
 static gMonStatus staAddEventToMsgPipe(
-    gardenMonitor_t *gmon, stationSysMsgbox_t msgbuf, gmonEvent_t *msg, uint32_t block_time
+    gardenMonitor_t *gmon, stationSysMsgbox_t msgbuf, gmonEvent_t *msg, uint32_t block_time,
+    unsigned int *num_dropped
 ) {
     gMonStatus status = staSysMsgBoxPut(msgbuf, (void *)msg, block_time);
     if (status != GMON_RESP_OK) {
         // if message box is full, abandon the oldest item of the message box, ensure all
         // available items in the message box are up-to-date.
         gmonEvent_t *oldest_record = NULL;
+        stationSysEnterCritical();
+        (*num_dropped)++;
+        stationSysExitCritical();
         // Use 0 for block_time to immediately get
         status = staSysMsgBoxGet(msgbuf, (void **)&oldest_record, 0);
         XASSERT((status == GMON_RESP_OK) && (oldest_record != NULL));
@@ -120,8 +129,13 @@ gMonStatus staNotifyOthersWithEvent(gardenMonitor_t *gmon, gmonEvent_t *evt, uin
     XASSERT(status == GMON_RESP_OK);
     XASSERT(evt->data != NULL);
     XASSERT(evt_copy->data != NULL);
-    staAddEventToMsgPipe(gmon, gmon->msgpipe.sensor2display, evt, block_time);
-    staAddEventToMsgPipe(gmon, gmon->msgpipe.sensor2net, evt_copy, block_time);
+    GMON_TRACE(SENSOR, SENSOR_NOTIFY, evt->event_type);
+    staAddEventToMsgPipe(
+        gmon, gmon->msgpipe.sensor2display, evt, block_time, &gmon->msgpipe.num_dropped.sensor2display
+    );
+    staAddEventToMsgPipe(
+        gmon, gmon->msgpipe.sensor2net, evt_copy, block_time, &gmon->msgpipe.num_dropped.sensor2net
+    );
     return status;
 }
 
@@ -132,13 +146,14 @@ gMonStatus stationIOinit(gardenMonitor_t *gmon) {
         goto done;
     }
     // Initialize default sensor reading intervals
-    gmon->sensors.event.pool = (gmonEvent_t *)XMALLOC(sizeof(gmonEvent_t) * GMON_NUM_SENSOR_EVENTS);
+    gmon->sensors.event.pool = staArenaCalloc(&gmon->arena, GMON_NUM_SENSOR_EVENTS, sizeof(gmonEvent_t));
     if (gmon->sensors.event.pool == NULL) {
         status = GMON_RESP_ERRMEM;
         goto done;
     }
     gmon->sensors.event.len = GMON_NUM_SENSOR_EVENTS;
-    XMEMSET(gmon->sensors.event.pool, 0x00, sizeof(gmonEvent_t) * GMON_NUM_SENSOR_EVENTS);
+    gmon->sensors.event.num_used = 0;
+    gmon->sensors.event.peak = 0;
 
     status = GMON_SENSOR_INIT_FN_SOIL_MOIST(&gmon->sensors.soil_moist);
     if (status < 0)
@@ -166,7 +181,7 @@ gMonStatus stationIOinit(gardenMonitor_t *gmon) {
 #undef NUM_EVTS_PIPE
 done:
     if (status != GMON_RESP_OK && gmon != NULL && gmon->sensors.event.pool != NULL) {
-        XMEMFREE(gmon->sensors.event.pool);
+        staArenaFree(&gmon->arena, gmon->sensors.event.pool);
         gmon->sensors.event.pool = NULL;
         gmon->sensors.event.len = 0;
     }
@@ -211,7 +226,7 @@ gMonStatus stationIOdeinit(gardenMonitor_t *gmon) {
     status = GMON_SENSOR_DEINIT_FN_AIR_TEMP(&gmon->sensors.air_temp);
 done:
     if (gmon != NULL && gmon->sensors.event.pool != NULL) {
-        XMEMFREE(gmon->sensors.event.pool);
+        staArenaFree(&gmon->arena, gmon->sensors.event.pool);
         gmon->sensors.event.pool = NULL;
         gmon->sensors.event.len = 0;
     }
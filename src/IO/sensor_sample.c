@@ -1,7 +1,10 @@
 #include "station_include.h"
 
-gmonSensorSamples_t
-staAllocSensorSampleBuffer(gmonSensorSamples_t old, gMonSensorMeta_t *sensor, gmonSensorDataType_t dtype) {
+// `data_element_size` is size of a single data element (e.g., unsigned int, gmonAirCond_t)
+static inline gmonSensorSamples_t staAllocSensorSampleBufferTyped(
+    gmonSensorSamples_t old, gMonSensorMeta_t *sensor, gmonSensorDataType_t dtype,
+    unsigned short data_element_size
+) {
     gmonSensorSamples_t out = {0};
     void               *original_old_entries = old.entries;
     if (sensor == NULL || sensor->num_items == 0 || sensor->num_resamples == 0)
@@ -9,25 +12,11 @@ staAllocSensorSampleBuffer(gmonSensorSamples_t old, gMonSensorMeta_t *sensor, gm
 
     unsigned char num_items = sensor->num_items;
     unsigned char num_resamples = sensor->num_resamples;
-    // Size of a single data element (e.g., unsigned int, gmonAirCond_t)
-    unsigned short data_element_size = 0;
     // Check for potential overflow before multiplication, if num_items, num_resamples
     // or data_element_size are very large, they might exceed unsigned short or unsigned int.
     // However, the current sizes are small enough for typical embedded contexts.
     // This comment is for self-reflection and not part of the requested change.
 
-    switch (dtype) {
-    case GMON_SENSOR_DATA_TYPE_U32:
-        data_element_size = sizeof(unsigned int);
-        break;
-    case GMON_SENSOR_DATA_TYPE_AIRCOND:
-        data_element_size = sizeof(gmonAirCond_t);
-        break;
-    case GMON_SENSOR_DATA_TYPE_UNKNOWN:
-    default:
-        goto err_return; // Invalid or unsupported data type
-    }
-
     unsigned short outlier_flgs_per_sample_bytes = 0;
     // Calculate bytes for num_resamples bits
     if (num_resamples > 0)
@@ -84,7 +73,7 @@ err_return:
     if (original_old_entries != NULL)
         XMEMFREE(original_old_entries);
     return (gmonSensorSamples_t){0};
-} // end of staAllocSensorSampleBuffer
+} // end of staAllocSensorSampleBufferTyped
 
 static void staSensorU32DetectNoise(
     gMonSensorMeta_t *s_meta, const gmonSensorSample_t *s_samples, unsigned short tot_len
@@ -199,61 +188,38 @@ staAggregateAirCondSamples(gmonEvent_t *evt, gmonSensorSample_t *ssample, unsign
     return outlier_count;
 }
 
-gMonStatus staSensorDetectNoise(gMonSensorMeta_t *s_meta, gmonSensorSample_t *s_samples) {
+static gMonStatus
+staSensorNoiseCheckArgs(gMonSensorMeta_t *s_meta, gmonSensorSample_t *s_samples, unsigned short *tot_len) {
     if (s_samples == NULL || s_meta == NULL || s_meta->mad_threshold < 0.01f ||
         s_meta->outlier_threshold < 0.01f || s_meta->num_items == 0)
         return GMON_RESP_ERRARGS;
-    gMonStatus     status = GMON_RESP_OK;
-    unsigned short tot_len = 0, idx = 0;
-    for (idx = 0; idx < s_meta->num_items; idx++) {
+    *tot_len = 0;
+    for (unsigned short idx = 0; idx < s_meta->num_items; idx++) {
         if (s_samples[idx].data == NULL || s_samples[idx].outlier == NULL)
             return GMON_RESP_ERRMEM;
-        tot_len += s_samples[idx].len;
+        *tot_len += s_samples[idx].len;
     }
-    switch (s_samples[0].dtype) {
-    case GMON_SENSOR_DATA_TYPE_U32:
-        staSensorU32DetectNoise(s_meta, s_samples, tot_len);
-        break;
-    case GMON_SENSOR_DATA_TYPE_AIRCOND:
-        staSensorAirCondDetectNoise(s_meta, s_samples, tot_len);
-        break;
-    default:
-        status = GMON_RESP_MALFORMED_DATA;
-        break;
-    }
-    return status;
+    return GMON_RESP_OK;
 }
 
-gMonStatus staSensorSampleToEvent(gmonEvent_t *evt, gmonSensorSample_t *samples) {
-    if (evt == NULL || samples == NULL || evt->num_active_sensors == 0)
-        return GMON_RESP_ERRARGS;
-
-    gmonSensorDataType_t dtype0 = samples[0].dtype;
+// aggregate function is NULL for unsupported data type, all samples are regarded as outliers
+static inline gMonStatus staSensorSampleToEventTyped(
+    gmonEvent_t *evt, gmonSensorSample_t *samples, gmonSensorDataType_t dtype0,
+    unsigned short (*aggregate)(gmonEvent_t *, gmonSensorSample_t *, unsigned char)
+) {
     evt->flgs.corruption = 0;
 
     for (unsigned char i = 0; i < evt->num_active_sensors; ++i) {
-        gmonSensorSample_t  *current_sample = &samples[i];
-        gmonSensorDataType_t dtype = current_sample->dtype;
-        unsigned short       outlier_count = 0;
+        gmonSensorSample_t *current_sample = &samples[i];
+        unsigned short      outlier_count = 0;
 
-        if (dtype0 != dtype || current_sample->len == 0 || current_sample->data == NULL ||
+        if (dtype0 != current_sample->dtype || current_sample->len == 0 || current_sample->data == NULL ||
             current_sample->outlier == NULL) {
             // If data types mismatch, no samples, no data, or no outlier info, consider this sensor corrupted
             staSetBitFlag(&evt->flgs.corruption, current_sample->id - 1, 1);
             continue; // Skip to processing the next sensor
         }
-        switch (dtype) {
-        case GMON_SENSOR_DATA_TYPE_U32:
-            outlier_count = staAggregateU32Samples(evt, current_sample, i);
-            break;
-        case GMON_SENSOR_DATA_TYPE_AIRCOND:
-            outlier_count = staAggregateAirCondSamples(evt, current_sample, i);
-            break;
-        default:
-            // Unsupported data type for aggregation, mark sensor as corrupted
-            outlier_count = current_sample->len;
-            break;
-        }
+        outlier_count = (aggregate == NULL) ? current_sample->len : aggregate(evt, current_sample, i);
         // If more than half of samples were outliers, set corruption flag for the sensor
         if (outlier_count >= ((current_sample->len + 1) >> 1)) {
             staSetBitFlag(&evt->flgs.corruption, current_sample->id - 1, 1);
@@ -261,3 +227,71 @@ gMonStatus staSensorSampleToEvent(gmonEvent_t *evt, gmonSensorSample_t *samples)
     }
     return GMON_RESP_OK;
 }
+
+// functions specialised for each data type, sensor pipelines call them directly without
+// dispatching on data type of the samples at runtime
+#define GMON_SENSOR_DTYPE_FN_DEFINE(sfx, type_id, elm_t) \
+    gmonSensorSamples_t staAllocSensorSampleBuffer##sfx(gmonSensorSamples_t old, gMonSensorMeta_t *sensor) { \
+        return staAllocSensorSampleBufferTyped(old, sensor, type_id, sizeof(elm_t)); \
+    } \
+    gMonStatus staSensorDetectNoise##sfx(gMonSensorMeta_t *s_meta, gmonSensorSample_t *s_samples) { \
+        GMON_PROF_SCOPE(); \
+        unsigned short tot_len = 0; \
+        gMonStatus     status = staSensorNoiseCheckArgs(s_meta, s_samples, &tot_len); \
+        if (status != GMON_RESP_OK) \
+            return status; \
+        if (s_samples[0].dtype != type_id) \
+            return GMON_RESP_MALFORMED_DATA; \
+        staSensor##sfx##DetectNoise(s_meta, s_samples, tot_len); \
+        return GMON_RESP_OK; \
+    } \
+    gMonStatus staSensorSampleToEvent##sfx(gmonEvent_t *evt, gmonSensorSample_t *samples) { \
+        GMON_PROF_SCOPE(); \
+        if (evt == NULL || samples == NULL || evt->num_active_sensors == 0) \
+            return GMON_RESP_ERRARGS; \
+        return staSensorSampleToEventTyped(evt, samples, type_id, staAggregate##sfx##Samples); \
+    }
+GMON_SENSOR_DATA_TYPES(GMON_SENSOR_DTYPE_FN_DEFINE)
+#undef GMON_SENSOR_DTYPE_FN_DEFINE
+
+// generic versions below pick the specialised function by data type of the first sample
+#define GMON_SENSOR_DTYPE_CASE_ALLOC(sfx, type_id, elm_t) \
+    case type_id: \
+        return staAllocSensorSampleBuffer##sfx(old, sensor);
+#define GMON_SENSOR_DTYPE_CASE_DETECT_NOISE(sfx, type_id, elm_t) \
+    case type_id: \
+        return staSensorDetectNoise##sfx(s_meta, s_samples);
+#define GMON_SENSOR_DTYPE_CASE_TO_EVENT(sfx, type_id, elm_t) \
+    case type_id: \
+        return staSensorSampleToEvent##sfx(evt, samples);
+
+gmonSensorSamples_t
+staAllocSensorSampleBuffer(gmonSensorSamples_t old, gMonSensorMeta_t *sensor, gmonSensorDataType_t dtype) {
+    switch (dtype) {
+        GMON_SENSOR_DATA_TYPES(GMON_SENSOR_DTYPE_CASE_ALLOC)
+    default: // Invalid or unsupported data type
+        return staAllocSensorSampleBufferTyped(old, NULL, dtype, 0);
+    }
+}
+
+gMonStatus staSensorDetectNoise(gMonSensorMeta_t *s_meta, gmonSensorSample_t *s_samples) {
+    unsigned short tot_len = 0;
+    gMonStatus     status = staSensorNoiseCheckArgs(s_meta, s_samples, &tot_len);
+    if (status != GMON_RESP_OK)
+        return status;
+    switch (s_samples[0].dtype) {
+        GMON_SENSOR_DATA_TYPES(GMON_SENSOR_DTYPE_CASE_DETECT_NOISE)
+    default:
+        return GMON_RESP_MALFORMED_DATA;
+    }
+}
+
+gMonStatus staSensorSampleToEvent(gmonEvent_t *evt, gmonSensorSample_t *samples) {
+    if (evt == NULL || samples == NULL || evt->num_active_sensors == 0)
+        return GMON_RESP_ERRARGS;
+    switch (samples[0].dtype) {
+        GMON_SENSOR_DATA_TYPES(GMON_SENSOR_DTYPE_CASE_TO_EVENT)
+    default: // Unsupported data type for aggregation, mark sensors as corrupted
+        return staSensorSampleToEventTyped(evt, samples, samples[0].dtype, NULL);
+    }
+}
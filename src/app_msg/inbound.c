@@ -444,6 +444,7 @@ static gMonStatus staDecodeAppMsgInflightCore(
 // the function below checks each node of the JSON message, update everything specified by remote user after
 // successful decoding process.
 gMonStatus staDecodeAppMsgInflight(gardenMonitor_t *gmon) {
+    GMON_PROF_SCOPE();
     gMonStatus   status = GMON_RESP_OK;
     jsmn_parser *decoder_ptr = (jsmn_parser *)gmon->rawmsg.jsn_decoder;
     jsmntok_t   *tokens_ptr = (jsmntok_t *)gmon->rawmsg.jsn_decoded_token;
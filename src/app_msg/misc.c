@@ -2,51 +2,64 @@
 #define JSMN_HEADER
 #include "jsmn.h"
 
-#define FREE_IF_EXIST(v) \
+#define FREE_IF_EXIST(arena, v) \
     if (v) { \
-        XMEMFREE(v); \
+        staArenaFree((arena), (v)); \
         v = NULL; \
     }
 
+static gMonStatus staAppMsgRecordsInit(gMonArena_t *arena, gMonSensorRecords_t *logs) {
+    gmonSensorRecord_t *record = &logs->soilmoist;
+    record->events = staArenaCalloc(arena, GMON_CFG_NUM_SOIL_SENSOR_RECORDS_KEEP, sizeof(gmonEvent_t *));
+    record->num_refs = GMON_CFG_NUM_SOIL_SENSOR_RECORDS_KEEP;
+    record = &logs->aircond;
+    record->events = staArenaCalloc(arena, GMON_CFG_NUM_AIR_SENSOR_RECORDS_KEEP, sizeof(gmonEvent_t *));
+    record->num_refs = GMON_CFG_NUM_AIR_SENSOR_RECORDS_KEEP;
+    record = &logs->light;
+    record->events = staArenaCalloc(arena, GMON_CFG_NUM_LIGHT_SENSOR_RECORDS_KEEP, sizeof(gmonEvent_t *));
+    record->num_refs = GMON_CFG_NUM_LIGHT_SENSOR_RECORDS_KEEP;
+    uint8_t any_failed = (logs->soilmoist.events == NULL) || (logs->aircond.events == NULL) ||
+                         (logs->light.events == NULL);
+    return any_failed ? GMON_RESP_ERRMEM : GMON_RESP_OK;
+}
+
+static void staAppMsgRecordsDeinit(gMonArena_t *arena, gMonSensorRecords_t *logs) {
+    FREE_IF_EXIST(arena, logs->aircond.events);
+    FREE_IF_EXIST(arena, logs->soilmoist.events);
+    FREE_IF_EXIST(arena, logs->light.events);
+}
+
 gMonStatus staAppMsgInit(gardenMonitor_t *gmon) {
     gMonRawMsg_t *rmsg = &gmon->rawmsg;
     rmsg->outflight.data = NULL;
     rmsg->inflight.data = NULL;
     // Calculate required buffer sizes for outflight and inflight messages
     rmsg->inflight.len = staAppMsgInflightCalcRequiredBufSz();
-    rmsg->jsn_decoder = XCALLOC(1, sizeof(jsmn_parser));
-    rmsg->jsn_decoded_token = XCALLOC(GMON_NUM_JSON_TOKEN_DECODE, sizeof(jsmntok_t));
-
-    // Initialize record fields for latest_logs
-    gmonSensorRecord_t *record = &gmon->latest_logs.soilmoist;
-    record->events = XCALLOC(GMON_CFG_NUM_SOIL_SENSOR_RECORDS_KEEP, sizeof(gmonEvent_t *));
-    record->num_refs = GMON_CFG_NUM_SOIL_SENSOR_RECORDS_KEEP;
-    record = &gmon->latest_logs.aircond;
-    record->events = XCALLOC(GMON_CFG_NUM_AIR_SENSOR_RECORDS_KEEP, sizeof(gmonEvent_t *));
-    record->num_refs = GMON_CFG_NUM_AIR_SENSOR_RECORDS_KEEP;
-    record = &gmon->latest_logs.light;
-    record->events = XCALLOC(GMON_CFG_NUM_LIGHT_SENSOR_RECORDS_KEEP, sizeof(gmonEvent_t *));
-    record->num_refs = GMON_CFG_NUM_LIGHT_SENSOR_RECORDS_KEEP;
+    rmsg->jsn_decoder = staArenaCalloc(&gmon->arena, 1, sizeof(jsmn_parser));
+    rmsg->jsn_decoded_token = staArenaCalloc(&gmon->arena, GMON_NUM_JSON_TOKEN_DECODE, sizeof(jsmntok_t));
 
+    // Initialize record fields for latest_logs, and the ones detached from them for serialization
     uint8_t any_failed = (rmsg->jsn_decoder == NULL) || (rmsg->jsn_decoded_token == NULL) ||
-                         (gmon->latest_logs.soilmoist.events == NULL) ||
-                         (gmon->latest_logs.aircond.events == NULL) ||
-                         (gmon->latest_logs.light.events == NULL);
+                         (staAppMsgRecordsInit(&gmon->arena, &gmon->latest_logs) != GMON_RESP_OK) ||
+                         (staAppMsgRecordsInit(&gmon->arena, &rmsg->detached.logs) != GMON_RESP_OK);
     if (any_failed) // call de-init function below if init failed
         return GMON_RESP_ERRMEM;
+    // nothing has been received by the remote user, first log message includes all items
+    XMEMSET(&rmsg->deadband, 0x00, sizeof(gMonAppMsgDeadband_t));
     // init internal write pointers of sensor records
     staAppMsgOutResetAllRecords(gmon);
+    staAppMsgOutResetDetachedRecords(gmon);
     return GMON_RESP_OK;
 } // end of staAppMsgInit
 
 gMonStatus staAppMsgDeinit(gardenMonitor_t *gmon) {
-    FREE_IF_EXIST(gmon->rawmsg.outflight.data);
+    // outflight buffer is resized at runtime, it returns to heap
+    FREE_IF_EXIST(&gmon->arena, gmon->rawmsg.outflight.data);
     gmon->rawmsg.inflight.data = NULL;
-    FREE_IF_EXIST(gmon->rawmsg.jsn_decoder);
-    FREE_IF_EXIST(gmon->rawmsg.jsn_decoded_token);
-    FREE_IF_EXIST(gmon->latest_logs.aircond.events);
-    FREE_IF_EXIST(gmon->latest_logs.soilmoist.events);
-    FREE_IF_EXIST(gmon->latest_logs.light.events);
+    FREE_IF_EXIST(&gmon->arena, gmon->rawmsg.jsn_decoder);
+    FREE_IF_EXIST(&gmon->arena, gmon->rawmsg.jsn_decoded_token);
+    staAppMsgRecordsDeinit(&gmon->arena, &gmon->latest_logs);
+    staAppMsgRecordsDeinit(&gmon->arena, &gmon->rawmsg.detached.logs);
     return GMON_RESP_OK;
 }
 
@@ -87,6 +100,9 @@ void stationSensorDataLogTaskFn(void *params) {
             continue;
         configASSERT(status == GMON_RESP_OK);
         configASSERT(new_evt->data != NULL);
+        GMON_TRACE(DATALOG, DATALOG_BEGIN, new_evt->event_type);
+        // the event is visible to network handler task once it is logged
+        GMON_EVT_LATENCY_STAMP(new_evt, GMON_EVT_STAGE_LOGGED);
         switch (new_evt->event_type) {
         case GMON_EVENT_SOIL_MOISTURE_UPDATED:
             discarded_evt = staUpdateLastRecord(&gmon->latest_logs.soilmoist, new_evt);
@@ -102,5 +118,6 @@ void stationSensorDataLogTaskFn(void *params) {
         }
         if (discarded_evt)
             staFreeSensorEvent(&gmon->sensors.event, discarded_evt);
+        GMON_TRACE(DATALOG, DATALOG_END, discarded_evt != NULL);
     }
 }
@@ -25,6 +25,40 @@
 //     }
 // }
 //
+// if `GMON_CFG_APPMSG_REPORT_BY_EXCEPTION` is enabled, sensor types and actuators which moved less than
+// the deadband since the last acknowledged message are left out, the message might be as short as `{}`
+//
+// if `GMON_CFG_APPMSG_SYS_HEALTH` is enabled, runtime health of the station is appended to every full
+// message (all sensor types and actuators included) :
+//
+//     "sys": {
+//         "stack": [88, 120, 240, 64], "heap": 10240, "heapmin": 8192, "arena": 3624,
+//         "evtpeak": 9, "mboxdrop": [0, 3], "netms": 120, "netmaxms": 450
+//     }
+//
+// * `stack` : minimum free stack in words of the tasks, in order of sensor scheduler, data logger,
+//   network handler and display handler
+// * `heap`, `heapmin` : free heap in bytes, current and minimum ever since boot
+// * `arena` : bytes taken from the static region by objects created at initialization
+// * `evtpeak` : maximum number of events allocated from the event pool at the same time
+// * `mboxdrop` : number of events abandoned because message box to display / network task was full
+// * `netms`, `netmaxms` : duration of the last network cycle which published log message, and the longest
+// zero is reported for any item the platform cannot measure
+//
+// if `GMON_CFG_ENABLE_EVENT_LATENCY` is enabled, summary of latency histograms collected since previous
+// summary is appended to every `GMON_CFG_EVENT_LATENCY_REPORT_EVERY` full messages :
+//
+//     "latency": {
+//         "soilmoist": {"n": 30, "p50": [1, 2, 2, 4, 65536, 131072], "max": [3, 3, 4, 9, 119003, 240110]},
+//         "airtemp": {...}, "light": {...}
+//     }
+//
+// * `n` : number of events serialized
+// * `p50`, `max` : median (upper bound of log2 bucket) and maximum latency in milliseconds from acquisition
+//   of samples to each stage, in order of noise detection, aggregation to event, actuator trigger, logged
+//   by data logger task, serialized to log message, and acknowledged (the oldest event of each sensor type
+//   in the acknowledged messages)
+//
 // clang-format on
 
 #define GMON_APPMSG_DATA_NAME_TICKS      "ticks"
@@ -40,6 +74,8 @@
 #define GMON_APPMSG_DATA_NAME_BULB       "bulb"
 #define GMON_APPMSG_DATA_NAME_WORKTIME   "worktime"
 #define GMON_APPMSG_DATA_NAME_STATE      "state"
+#define GMON_APPMSG_DATA_NAME_SYS        "sys"
+#define GMON_APPMSG_DATA_NAME_LATENCY    "latency"
 
 #define GMON_APPMSG_MAX_NBYTES_SERIAL_NUMBER 12
 
@@ -52,6 +88,11 @@
 #define GMON_APPMSG_MAX_DIGITS_AIR_TEMP_HUMID 6  // for float (e.g., -99.99, 101.70)
 #define GMON_APPMSG_MAX_DIGITS_WORKTIME       10 // Max for 32-bit unsigned int
 #define GMON_APPMSG_MAX_DIGITS_STATE          1  // Max for gMonActuatorStatus (0-3)
+#define GMON_APPMSG_MAX_DIGITS_SYS            10 // Max for 32-bit unsigned int
+#define GMON_APPMSG_MAX_DIGITS_LATENCY        10 // Max for 32-bit unsigned int
+
+#define GMON_APPMSG_SYS_NUM_TASKS  4
+#define GMON_APPMSG_SYS_NUM_MBOXES 2
 
 // Helper to calculate size for a JSON key-value pair, excluding trailing comma
 // name_len: length of the key string
@@ -149,7 +190,35 @@ static unsigned short staAppMsgOutflightRequiredBufSz(
     total_len += KEY_VAL_LEN(sizeof(GMON_APPMSG_DATA_NAME_STATE) - 1, GMON_APPMSG_MAX_DIGITS_STATE);
     // No comma after bulb's state, as it's the last item in the actuators object.
     // Also no comma after the entire actuators object, as it's the last top-level object.
-
+#ifdef GMON_CFG_APPMSG_SYS_HEALTH
+    // ,"sys":{"stack":[..],"heap":X,"heapmin":X,"arena":X,"evtpeak":X,"mboxdrop":[..],"netms":X,
+    //  "netmaxms":X}
+    total_len += 1 + KEY_VAL_LEN(sizeof(GMON_APPMSG_DATA_NAME_SYS) - 1, 2);
+    total_len += KEY_VAL_LEN(
+        sizeof("stack") - 1, PRIMITIVE_ARRAY_LEN(GMON_APPMSG_MAX_DIGITS_SYS, GMON_APPMSG_SYS_NUM_TASKS)
+    );
+    total_len += 1 + KEY_VAL_LEN(sizeof("heap") - 1, GMON_APPMSG_MAX_DIGITS_SYS);
+    total_len += 1 + KEY_VAL_LEN(sizeof("heapmin") - 1, GMON_APPMSG_MAX_DIGITS_SYS);
+    total_len += 1 + KEY_VAL_LEN(sizeof("arena") - 1, GMON_APPMSG_MAX_DIGITS_SYS);
+    total_len += 1 + KEY_VAL_LEN(sizeof("evtpeak") - 1, GMON_APPMSG_MAX_DIGITS_SYS);
+    total_len += 1 + KEY_VAL_LEN(
+                         sizeof("mboxdrop") - 1,
+                         PRIMITIVE_ARRAY_LEN(GMON_APPMSG_MAX_DIGITS_SYS, GMON_APPMSG_SYS_NUM_MBOXES)
+                     );
+    total_len += 1 + KEY_VAL_LEN(sizeof("netms") - 1, GMON_APPMSG_MAX_DIGITS_SYS);
+    total_len += 1 + KEY_VAL_LEN(sizeof("netmaxms") - 1, GMON_APPMSG_MAX_DIGITS_SYS);
+#endif
+#ifdef GMON_CFG_ENABLE_EVENT_LATENCY
+    // ,"latency":{"soilmoist":{"n":X,"p50":[..],"max":[..]},"airtemp":{..},"light":{..}}
+    total_len += 1 + KEY_VAL_LEN(sizeof(GMON_APPMSG_DATA_NAME_LATENCY) - 1, 2) + 2 /* commas */;
+    total_len += KEY_VAL_LEN(sizeof(GMON_APPMSG_DATA_NAME_SOILMOIST) - 1, 0);
+    total_len += KEY_VAL_LEN(sizeof(GMON_APPMSG_DATA_NAME_AIRTEMP) - 1, 0);
+    total_len += KEY_VAL_LEN(sizeof(GMON_APPMSG_DATA_NAME_LIGHT) - 1, 0);
+    // each sensor type object : {"n":X,"p50":[..],"max":[..]}
+    total_len += GMON_APPMSG_ITEM_PUMP * (2 + KEY_VAL_LEN(sizeof("n") - 1, GMON_APPMSG_MAX_DIGITS_LATENCY));
+    unsigned short stage_arr_len = PRIMITIVE_ARRAY_LEN(GMON_APPMSG_MAX_DIGITS_LATENCY, GMON_EVT_NUM_STAGES);
+    total_len += GMON_APPMSG_ITEM_PUMP * 2 * (1 + KEY_VAL_LEN(sizeof("p50") - 1, stage_arr_len));
+#endif
     return total_len;
 }
 
@@ -165,12 +234,47 @@ static void appMsgRecordReset(gMonEvtPool_t *epool, gmonSensorRecord_t *sr) {
     sr->inner_wr_ptr = 0;
 }
 
+static void appMsgRecordsReset(gMonEvtPool_t *epool, gMonSensorRecords_t *logs) {
+    appMsgRecordReset(epool, &logs->soilmoist);
+    appMsgRecordReset(epool, &logs->aircond);
+    appMsgRecordReset(epool, &logs->light);
+}
+
 gMonStatus staAppMsgOutResetAllRecords(gardenMonitor_t *gmon) {
     if (gmon == NULL)
         return GMON_RESP_ERRARGS;
-    appMsgRecordReset(&gmon->sensors.event, &gmon->latest_logs.soilmoist);
-    appMsgRecordReset(&gmon->sensors.event, &gmon->latest_logs.aircond);
-    appMsgRecordReset(&gmon->sensors.event, &gmon->latest_logs.light);
+    appMsgRecordsReset(&gmon->sensors.event, &gmon->latest_logs);
+    return GMON_RESP_OK;
+}
+
+// return the events detached from `latest_logs` to the pool after they are serialized, so the records
+// are empty for next detachment
+gMonStatus staAppMsgOutResetDetachedRecords(gardenMonitor_t *gmon) {
+    if (gmon == NULL)
+        return GMON_RESP_ERRARGS;
+    appMsgRecordsReset(&gmon->sensors.event, &gmon->rawmsg.detached.logs);
+    return GMON_RESP_OK;
+}
+
+static void appMsgRecordSwap(gmonSensorRecord_t *live, gmonSensorRecord_t *detached) {
+    gmonSensorRecord_t tmp = *detached;
+    *detached = *live;
+    *live = tmp;
+}
+
+// swap the event references logged so far with the empty records, and copy state of the actuators at the
+// same moment. This is expected to run in critical section, it takes constant time regardless of number
+// of logged events, the detached records are serialized later without blocking the sensor tasks.
+gMonStatus staAppMsgOutDetachRecords(gardenMonitor_t *gmon) {
+    if (gmon == NULL)
+        return GMON_RESP_ERRARGS;
+    gMonAppMsgDetached_t *detached = &gmon->rawmsg.detached;
+    appMsgRecordSwap(&gmon->latest_logs.soilmoist, &detached->logs.soilmoist);
+    appMsgRecordSwap(&gmon->latest_logs.aircond, &detached->logs.aircond);
+    appMsgRecordSwap(&gmon->latest_logs.light, &detached->logs.light);
+    detached->actuators[0] = gmon->actuator.pump;
+    detached->actuators[1] = gmon->actuator.fan;
+    detached->actuators[2] = gmon->actuator.bulb;
     return GMON_RESP_OK;
 }
 
@@ -428,13 +532,22 @@ static gMonStatus serialize_aircond_values(
     return GMON_RESP_OK;
 }
 
+// working time shown in log message depends on current state of the actuator
+static unsigned int appMsgActuatorWorktime(gMonActuator_t *actuator) {
+    if (actuator->status == GMON_OUT_DEV_STATUS_ON)
+        return actuator->curr_worktime;
+    else if (actuator->status == GMON_OUT_DEV_STATUS_PAUSE)
+        return actuator->curr_resttime;
+    return 0;
+}
+
 // New static helper function to serialize a single actuator object
 static gMonStatus serialize_single_actuator_object(
     unsigned char **buf_ptr, unsigned short *remaining_len, const char *actuator_name,
     gMonActuator_t *actuator, unsigned char is_last_actuator
 ) {
     gMonStatus   status;
-    unsigned int worktime_val = 0;
+    unsigned int worktime_val = appMsgActuatorWorktime(actuator);
 
     status = staAppMsgSerializeAppendStr(buf_ptr, remaining_len, "\"");
     if (status != GMON_RESP_OK)
@@ -450,13 +563,6 @@ static gMonStatus serialize_single_actuator_object(
     status = staAppMsgSerializeAppendStr(buf_ptr, remaining_len, "\"worktime\":");
     if (status != GMON_RESP_OK)
         return status;
-    if (actuator->status == GMON_OUT_DEV_STATUS_ON) {
-        worktime_val = actuator->curr_worktime;
-    } else if (actuator->status == GMON_OUT_DEV_STATUS_PAUSE) {
-        worktime_val = actuator->curr_resttime;
-    } else {
-        worktime_val = 0;
-    }
     status = staAppMsgSerializeUInt(buf_ptr, remaining_len, worktime_val, GMON_APPMSG_MAX_DIGITS_WORKTIME);
     if (status != GMON_RESP_OK)
         return status;
@@ -484,36 +590,37 @@ static gMonStatus serialize_single_actuator_object(
     return status;
 }
 
+// whether none of the items serialized after the given one is selected, no trailing comma is needed
+#define APPMSG_IS_LAST_ITEM(items, item) (((items) >> ((item) + 1)) == 0)
+
+// source of outflight message, either the live records or the ones detached from them
+typedef struct {
+    gMonSensorRecords_t *logs;
+    gMonActuator_t      *actuators[GMON_APPMSG_NUM_ACTUATORS]; // pump, fan, bulb
+} appMsgOutSrc_t;
+
 // New static helper function to serialize the overall actuators object
 static gMonStatus serialize_actuators_object(
-    unsigned char **buf_ptr, unsigned short *remaining_len, gardenMonitor_t *gmon,
+    unsigned char **buf_ptr, unsigned short *remaining_len, appMsgOutSrc_t *src, unsigned char items,
     unsigned char is_last_top_level
 ) {
+    static const char *const names[GMON_APPMSG_NUM_ACTUATORS] = {
+        GMON_APPMSG_DATA_NAME_PUMP, GMON_APPMSG_DATA_NAME_FAN, GMON_APPMSG_DATA_NAME_BULB
+    };
     gMonStatus status;
     status = staAppMsgSerializeAppendStr(buf_ptr, remaining_len, "\"" GMON_APPMSG_DATA_NAME_ACTUATORS "\":{");
     if (status != GMON_RESP_OK)
         return status;
-
-    // Pump , Not the last field of actuator
-    status = serialize_single_actuator_object(
-        buf_ptr, remaining_len, GMON_APPMSG_DATA_NAME_PUMP, &gmon->actuator.pump, 0
-    );
-    if (status != GMON_RESP_OK)
-        return status;
-
-    // Fan
-    status = serialize_single_actuator_object(
-        buf_ptr, remaining_len, GMON_APPMSG_DATA_NAME_FAN, &gmon->actuator.fan, 0
-    );
-    if (status != GMON_RESP_OK)
-        return status;
-
-    // Bulb (last actuator)
-    status = serialize_single_actuator_object(
-        buf_ptr, remaining_len, GMON_APPMSG_DATA_NAME_BULB, &gmon->actuator.bulb, 1 // Last actuator
-    );
-    if (status != GMON_RESP_OK)
-        return status;
+    for (unsigned char idx = GMON_APPMSG_ITEM_PUMP; idx < GMON_APPMSG_NUM_ITEMS; idx++) {
+        if (!staGetBitFlag(&items, idx))
+            continue;
+        status = serialize_single_actuator_object(
+            buf_ptr, remaining_len, names[idx - GMON_APPMSG_ITEM_PUMP],
+            src->actuators[idx - GMON_APPMSG_ITEM_PUMP], APPMSG_IS_LAST_ITEM(items, idx)
+        );
+        if (status != GMON_RESP_OK)
+            return status;
+    }
 
     status = staAppMsgSerializeAppendStr(buf_ptr, remaining_len, "}"); // Close actuators object
     if (status != GMON_RESP_OK)
@@ -615,42 +722,392 @@ static gMonStatus serialize_sensor_type_object(
     return status;
 }
 
-gmonAppMsgOutflightResult_t staGetAppMsgOutflight(gardenMonitor_t *gmon) {
+#define GMON_APPMSG_ALL_ITEMS ((1 << GMON_APPMSG_NUM_ITEMS) - 1)
+
+#ifdef GMON_CFG_APPMSG_REPORT_BY_EXCEPTION
+    #define APPMSG_ABS_DIFF(a, b) (((a) > (b)) ? ((a) - (b)) : ((b) - (a)))
+
+// whether any value logged in the record moved beyond the deadband, compared with the reference values
+static unsigned char appMsgU32RecordChanged(
+    gmonSensorRecord_t *rec, const unsigned int *ref, unsigned char max_num_ref, unsigned int deadband
+) {
+    for (unsigned char i = 0; i < rec->num_refs; i++) {
+        gmonEvent_t *evt = rec->events[i];
+        if (evt == NULL)
+            continue;
+        if (evt->data == NULL || evt->flgs.corruption != 0 || evt->num_active_sensors > max_num_ref)
+            return 1;
+        unsigned int *data = (unsigned int *)evt->data;
+        for (unsigned char j = 0; j < evt->num_active_sensors; j++) {
+            if (APPMSG_ABS_DIFF(data[j], ref[j]) > deadband)
+                return 1;
+        }
+    }
+    return 0;
+}
+
+static unsigned char appMsgAirCondRecordChanged(gmonSensorRecord_t *rec, const gmonAirCond_t *ref) {
+    for (unsigned char i = 0; i < rec->num_refs; i++) {
+        gmonEvent_t *evt = rec->events[i];
+        if (evt == NULL)
+            continue;
+        if (evt->data == NULL || evt->flgs.corruption != 0 ||
+            evt->num_active_sensors > GMON_MAXNUM_AIR_SENSORS)
+            return 1;
+        gmonAirCond_t *data = (gmonAirCond_t *)evt->data;
+        for (unsigned char j = 0; j < evt->num_active_sensors; j++) {
+            if (APPMSG_ABS_DIFF(data[j].temporature, ref[j].temporature) > GMON_CFG_APPMSG_DEADBAND_AIRTEMP)
+                return 1;
+            if (APPMSG_ABS_DIFF(data[j].humidity, ref[j].humidity) > GMON_CFG_APPMSG_DEADBAND_AIRHUMID)
+                return 1;
+        }
+    }
+    return 0;
+}
+
+// select the items which moved beyond the deadband since the values the remote user received, all of
+// them are selected periodically so the remote user can recover from any message lost
+static unsigned char appMsgSelectItems(gardenMonitor_t *gmon, appMsgOutSrc_t *src) {
+    gMonAppMsgDeadband_t *db = &gmon->rawmsg.deadband;
+    gMonAppMsgSnapshot_t *ref = &db->acked;
+    gMonActuator_t       *actuator = NULL;
+    unsigned char         items = 0, changed = 0, act_idx = 0;
+    if ((db->num_since_full + 1) >= GMON_CFG_APPMSG_FULL_REPORT_EVERY)
+        return GMON_APPMSG_ALL_ITEMS;
+    for (unsigned char idx = 0; idx < GMON_APPMSG_NUM_ITEMS; idx++) {
+        changed = !staGetBitFlag(&ref->valid, idx);
+        if (changed) {
+            staSetBitFlag(&items, idx, changed);
+            continue;
+        }
+        switch (idx) {
+        case GMON_APPMSG_ITEM_SOILMOIST:
+            changed = (ref->qty[idx] != gmon->sensors.soil_moist.super.num_items) ||
+                      appMsgU32RecordChanged(
+                          &src->logs->soilmoist, ref->soilmoist, GMON_MAXNUM_SOIL_SENSORS,
+                          GMON_CFG_APPMSG_DEADBAND_SOILMOIST
+                      );
+            break;
+        case GMON_APPMSG_ITEM_AIRTEMP:
+            changed = (ref->qty[idx] != gmon->sensors.air_temp.num_items) ||
+                      appMsgAirCondRecordChanged(&src->logs->aircond, ref->aircond);
+            break;
+        case GMON_APPMSG_ITEM_LIGHT:
+            changed = (ref->qty[idx] != gmon->sensors.light.num_items) ||
+                      appMsgU32RecordChanged(
+                          &src->logs->light, ref->light, GMON_MAXNUM_LIGHT_SENSORS,
+                          GMON_CFG_APPMSG_DEADBAND_LIGHT
+                      );
+            break;
+        default:
+            act_idx = idx - GMON_APPMSG_ITEM_PUMP;
+            actuator = src->actuators[act_idx];
+            changed = (actuator->status != ref->actuator[act_idx].status) ||
+                      (APPMSG_ABS_DIFF(appMsgActuatorWorktime(actuator), ref->actuator[act_idx].worktime) >
+                       GMON_CFG_APPMSG_DEADBAND_WORKTIME_MS);
+            break;
+        }
+        staSetBitFlag(&items, idx, changed);
+    }
+    return items;
+}
+
+// copy values of the latest event in the record, the values of sensors not active are left unchanged
+static void
+appMsgSnapshotRecord(gmonSensorRecord_t *rec, void *dst, unsigned char max_num_ref, size_t item_sz) {
+    gmonEvent_t  *evt = get_latest_event_from_record(rec);
+    unsigned char num = 0;
+    if (evt == NULL || evt->data == NULL)
+        return;
+    num = (evt->num_active_sensors < max_num_ref) ? evt->num_active_sensors : max_num_ref;
+    XMEMCPY(dst, evt->data, num * item_sz);
+}
+
+// values of the serialized items are what the remote user will have once the message is delivered
+static void appMsgTakeSnapshot(gardenMonitor_t *gmon, appMsgOutSrc_t *src, unsigned char items) {
+    gMonAppMsgDeadband_t *db = &gmon->rawmsg.deadband;
+    gMonAppMsgSnapshot_t *snap = &db->pending;
+    gMonActuator_t       *actuator = NULL;
+    unsigned char         act_idx = 0;
+    for (unsigned char idx = 0; idx < GMON_APPMSG_NUM_ITEMS; idx++) {
+        if (!staGetBitFlag(&items, idx)) {
+            db->stats.num_omitted++;
+            continue;
+        }
+        switch (idx) {
+        case GMON_APPMSG_ITEM_SOILMOIST:
+            snap->qty[idx] = gmon->sensors.soil_moist.super.num_items;
+            appMsgSnapshotRecord(
+                &src->logs->soilmoist, snap->soilmoist, GMON_MAXNUM_SOIL_SENSORS, sizeof(unsigned int)
+            );
+            break;
+        case GMON_APPMSG_ITEM_AIRTEMP:
+            snap->qty[idx] = gmon->sensors.air_temp.num_items;
+            appMsgSnapshotRecord(
+                &src->logs->aircond, snap->aircond, GMON_MAXNUM_AIR_SENSORS, sizeof(gmonAirCond_t)
+            );
+            break;
+        case GMON_APPMSG_ITEM_LIGHT:
+            snap->qty[idx] = gmon->sensors.light.num_items;
+            appMsgSnapshotRecord(
+                &src->logs->light, snap->light, GMON_MAXNUM_LIGHT_SENSORS, sizeof(unsigned int)
+            );
+            break;
+        default:
+            act_idx = idx - GMON_APPMSG_ITEM_PUMP;
+            actuator = src->actuators[act_idx];
+            snap->actuator[act_idx].status = actuator->status;
+            snap->actuator[act_idx].worktime = appMsgActuatorWorktime(actuator);
+            break;
+        }
+        staSetBitFlag(&snap->valid, idx, 1);
+    }
+    if (items == GMON_APPMSG_ALL_ITEMS) {
+        db->num_since_full = 0;
+        db->stats.num_full++;
+    } else {
+        db->num_since_full++;
+    }
+}
+#endif // end of GMON_CFG_APPMSG_REPORT_BY_EXCEPTION
+
+// all log messages serialized so far have been received by the remote user, their values become
+// reference of the deadband for the following messages
+void staAppMsgOutAcked(gardenMonitor_t *gmon) {
+    if (gmon == NULL)
+        return;
+#ifdef GMON_CFG_APPMSG_REPORT_BY_EXCEPTION
+    gMonAppMsgDeadband_t *db = &gmon->rawmsg.deadband;
+    XMEMCPY(&db->acked, &db->pending, sizeof(gMonAppMsgSnapshot_t));
+#endif
+#ifdef GMON_CFG_ENABLE_EVENT_LATENCY
+    staEvtLatencyOnAcked(&gmon->rawmsg.latency, GMON_EVT_LATENCY_NOW_MS());
+#endif
+}
+
+#if defined(GMON_CFG_APPMSG_SYS_HEALTH) || defined(GMON_CFG_ENABLE_EVENT_LATENCY)
+// serialize `"key":value`, or `"key":[values]` if `num_vals` is not zero
+static gMonStatus serialize_uint_item(
+    unsigned char **buf_ptr, unsigned short *remaining_len, const char *key, const unsigned int *vals,
+    unsigned char num_vals
+) {
+    gMonStatus status = staAppMsgSerializeAppendStr(buf_ptr, remaining_len, "\"");
+    if (status == GMON_RESP_OK)
+        status = staAppMsgSerializeAppendStr(buf_ptr, remaining_len, key);
+    if (status == GMON_RESP_OK)
+        status = staAppMsgSerializeAppendStr(buf_ptr, remaining_len, (num_vals > 0) ? "\":[" : "\":");
+    for (unsigned char idx = 0; status == GMON_RESP_OK && idx < ((num_vals > 0) ? num_vals : 1); idx++) {
+        if (idx > 0)
+            status = staAppMsgSerializeAppendStr(buf_ptr, remaining_len, ",");
+        if (status == GMON_RESP_OK)
+            status = staAppMsgSerializeUInt(buf_ptr, remaining_len, vals[idx], GMON_APPMSG_MAX_DIGITS_SYS);
+    }
+    if (status == GMON_RESP_OK && num_vals > 0)
+        status = staAppMsgSerializeAppendStr(buf_ptr, remaining_len, "]");
+    return status;
+}
+#endif
+
+#ifdef GMON_CFG_APPMSG_SYS_HEALTH
+// runtime health of the station, appended to the last top-level object
+static gMonStatus
+serialize_sys_object(unsigned char **buf_ptr, unsigned short *remaining_len, gardenMonitor_t *gmon) {
+    unsigned int stack[GMON_APPMSG_SYS_NUM_TASKS] = {
+        stationSysGetTaskStackFree((stationSysTask_t)gmon->tasks.sensor_sched),
+        stationSysGetTaskStackFree((stationSysTask_t)gmon->tasks.sensor_data_aggregator_net),
+        stationSysGetTaskStackFree((stationSysTask_t)gmon->tasks.netconn_handler),
+        stationSysGetTaskStackFree((stationSysTask_t)gmon->tasks.display_handler),
+    };
+    unsigned int heap = stationSysGetHeapFree(), heapmin = stationSysGetHeapMinFree();
+    unsigned int arena = gmon->arena.used;
+    unsigned int evtpeak = 0, mboxdrop[GMON_APPMSG_SYS_NUM_MBOXES] = {0};
+    unsigned int netms = gmon->netconn.cycle.last_ms, netmaxms = gmon->netconn.cycle.max_ms;
+    const struct {
+        const char         *key;
+        const unsigned int *vals;
+        unsigned char       num_vals;
+    } items[] = {
+        {"stack", stack, GMON_APPMSG_SYS_NUM_TASKS},
+        {"heap", &heap, 0},
+        {"heapmin", &heapmin, 0},
+        {"arena", &arena, 0},
+        {"evtpeak", &evtpeak, 0},
+        {"mboxdrop", mboxdrop, GMON_APPMSG_SYS_NUM_MBOXES},
+        {"netms", &netms, 0},
+        {"netmaxms", &netmaxms, 0},
+    };
+    gMonStatus status = GMON_RESP_OK;
+    // counters updated by other tasks
+    stationSysEnterCritical();
+    evtpeak = gmon->sensors.event.peak;
+    mboxdrop[0] = gmon->msgpipe.num_dropped.sensor2display;
+    mboxdrop[1] = gmon->msgpipe.num_dropped.sensor2net;
+    stationSysExitCritical();
+    status = staAppMsgSerializeAppendStr(buf_ptr, remaining_len, ",\"" GMON_APPMSG_DATA_NAME_SYS "\":{");
+    for (unsigned char idx = 0; status == GMON_RESP_OK && idx < sizeof(items) / sizeof(items[0]); idx++) {
+        if (idx > 0)
+            status = staAppMsgSerializeAppendStr(buf_ptr, remaining_len, ",");
+        if (status == GMON_RESP_OK)
+            status = serialize_uint_item(
+                buf_ptr, remaining_len, items[idx].key, items[idx].vals, items[idx].num_vals
+            );
+    }
+    if (status == GMON_RESP_OK)
+        status = staAppMsgSerializeAppendStr(buf_ptr, remaining_len, "}");
+    return status;
+}
+#endif // end of GMON_CFG_APPMSG_SYS_HEALTH
+
+#ifdef GMON_CFG_ENABLE_EVENT_LATENCY
+// summary of latency histograms of all sensor types, appended to the last top-level object
+static gMonStatus
+serialize_latency_object(unsigned char **buf_ptr, unsigned short *remaining_len, gMonEvtLatency_t *lat) {
+    const char *names[GMON_APPMSG_ITEM_PUMP] = {
+        GMON_APPMSG_DATA_NAME_SOILMOIST, GMON_APPMSG_DATA_NAME_AIRTEMP, GMON_APPMSG_DATA_NAME_LIGHT
+    };
+    gMonEvtLatencyStat_t stat = {0};
+    gMonStatus           status =
+        staAppMsgSerializeAppendStr(buf_ptr, remaining_len, ",\"" GMON_APPMSG_DATA_NAME_LATENCY "\":{");
+    for (unsigned char idx = 0; status == GMON_RESP_OK && idx < GMON_APPMSG_ITEM_PUMP; idx++) {
+        staEvtLatencySummary(&lat->hist[idx], &stat);
+        status = staAppMsgSerializeAppendStr(buf_ptr, remaining_len, (idx > 0) ? ",\"" : "\"");
+        if (status == GMON_RESP_OK)
+            status = staAppMsgSerializeAppendStr(buf_ptr, remaining_len, names[idx]);
+        if (status == GMON_RESP_OK)
+            status = staAppMsgSerializeAppendStr(buf_ptr, remaining_len, "\":{");
+        if (status == GMON_RESP_OK)
+            status = serialize_uint_item(buf_ptr, remaining_len, "n", &stat.num_events, 0);
+        if (status == GMON_RESP_OK)
+            status = staAppMsgSerializeAppendStr(buf_ptr, remaining_len, ",");
+        if (status == GMON_RESP_OK)
+            status = serialize_uint_item(buf_ptr, remaining_len, "p50", stat.p50_ms, GMON_EVT_NUM_STAGES);
+        if (status == GMON_RESP_OK)
+            status = staAppMsgSerializeAppendStr(buf_ptr, remaining_len, ",");
+        if (status == GMON_RESP_OK)
+            status = serialize_uint_item(buf_ptr, remaining_len, "max", stat.max_ms, GMON_EVT_NUM_STAGES);
+        if (status == GMON_RESP_OK)
+            status = staAppMsgSerializeAppendStr(buf_ptr, remaining_len, "}");
+    }
+    if (status == GMON_RESP_OK)
+        status = staAppMsgSerializeAppendStr(buf_ptr, remaining_len, "}");
+    return status;
+}
+
+// latency of the events in the sensor types being serialized, the message closing the window of the
+// histograms also reports their summary
+static gMonStatus appMsgLatencyOnSerialized(
+    unsigned char **buf_ptr, unsigned short *remaining_len, gardenMonitor_t *gmon, appMsgOutSrc_t *src,
+    unsigned char items
+) {
+    gMonEvtLatency_t   *lat = &gmon->rawmsg.latency;
+    gmonSensorRecord_t *recs[GMON_APPMSG_ITEM_PUMP] = {
+        &src->logs->soilmoist, &src->logs->aircond, &src->logs->light
+    };
+    unsigned int now_ms = GMON_EVT_LATENCY_NOW_MS();
+    gMonStatus   status = GMON_RESP_OK;
+    for (unsigned char idx = 0; idx < GMON_APPMSG_ITEM_PUMP; idx++) {
+        if (staGetBitFlag(&items, idx))
+            staEvtLatencyOnSerialized(lat, idx, recs[idx], now_ms);
+    }
+    if (items != GMON_APPMSG_ALL_ITEMS)
+        return status;
+    if (++lat->num_full_since_report < GMON_CFG_EVENT_LATENCY_REPORT_EVERY)
+        return status;
+    status = serialize_latency_object(buf_ptr, remaining_len, lat);
+    if (status == GMON_RESP_OK)
+        staEvtLatencyReset(lat);
+    return status;
+}
+#endif // end of GMON_CFG_ENABLE_EVENT_LATENCY
+
+static gmonAppMsgOutflightResult_t appMsgOutflight(gardenMonitor_t *gmon, appMsgOutSrc_t *src) {
     gmonStr_t     *outflight_msg = &gmon->rawmsg.outflight;
     unsigned char *buf_ptr = outflight_msg->data;
     unsigned short remaining_len = outflight_msg->len;
+#ifdef GMON_CFG_APPMSG_REPORT_BY_EXCEPTION
+    unsigned char items = appMsgSelectItems(gmon, src);
+#else
+    unsigned char items = GMON_APPMSG_ALL_ITEMS;
+#endif
     // XMEMSET(buf_ptr, 0x0, sizeof(unsigned char) * remaining_len);
     // Start of the overall JSON object
     gMonStatus status = staAppMsgSerializeAppendStr(&buf_ptr, &remaining_len, "{");
     if (status != GMON_RESP_OK)
         goto done;
-    status = serialize_sensor_type_object(
-        &buf_ptr, &remaining_len, GMON_APPMSG_DATA_NAME_SOILMOIST, &gmon->sensors.soil_moist.super,
-        &gmon->latest_logs.soilmoist, GMON_SENSOR_DATA_TYPE_U32, 0 // Not last sensor type
-    );
-    if (status != GMON_RESP_OK)
-        goto done;
-    status = serialize_sensor_type_object(
-        &buf_ptr, &remaining_len, GMON_APPMSG_DATA_NAME_AIRTEMP, &gmon->sensors.air_temp,
-        &gmon->latest_logs.aircond, GMON_SENSOR_DATA_TYPE_AIRCOND, 0 // Not last sensor type
-    );
-    if (status != GMON_RESP_OK)
-        goto done;
-    status = serialize_sensor_type_object(
-        &buf_ptr, &remaining_len, GMON_APPMSG_DATA_NAME_LIGHT, &gmon->sensors.light, &gmon->latest_logs.light,
-        GMON_SENSOR_DATA_TYPE_U32,
-        0 // NOW NOT THE LAST SENSOR TYPE, actuators follow
-    );
-    if (status != GMON_RESP_OK)
-        goto done;
-
+    if (staGetBitFlag(&items, GMON_APPMSG_ITEM_SOILMOIST)) {
+        status = serialize_sensor_type_object(
+            &buf_ptr, &remaining_len, GMON_APPMSG_DATA_NAME_SOILMOIST, &gmon->sensors.soil_moist.super,
+            &src->logs->soilmoist, GMON_SENSOR_DATA_TYPE_U32,
+            APPMSG_IS_LAST_ITEM(items, GMON_APPMSG_ITEM_SOILMOIST)
+        );
+        if (status != GMON_RESP_OK)
+            goto done;
+    }
+    if (staGetBitFlag(&items, GMON_APPMSG_ITEM_AIRTEMP)) {
+        status = serialize_sensor_type_object(
+            &buf_ptr, &remaining_len, GMON_APPMSG_DATA_NAME_AIRTEMP, &gmon->sensors.air_temp,
+            &src->logs->aircond, GMON_SENSOR_DATA_TYPE_AIRCOND,
+            APPMSG_IS_LAST_ITEM(items, GMON_APPMSG_ITEM_AIRTEMP)
+        );
+        if (status != GMON_RESP_OK)
+            goto done;
+    }
+    if (staGetBitFlag(&items, GMON_APPMSG_ITEM_LIGHT)) {
+        status = serialize_sensor_type_object(
+            &buf_ptr, &remaining_len, GMON_APPMSG_DATA_NAME_LIGHT, &gmon->sensors.light,
+            &src->logs->light, GMON_SENSOR_DATA_TYPE_U32,
+            APPMSG_IS_LAST_ITEM(items, GMON_APPMSG_ITEM_LIGHT) // actuators might follow
+        );
+        if (status != GMON_RESP_OK)
+            goto done;
+    }
     // Serialize actuators object , the last top-level object
-    status = serialize_actuators_object(&buf_ptr, &remaining_len, gmon, 1);
+    if (!APPMSG_IS_LAST_ITEM(items, GMON_APPMSG_ITEM_LIGHT)) {
+        status = serialize_actuators_object(&buf_ptr, &remaining_len, src, items, 1);
+        if (status != GMON_RESP_OK)
+            goto done;
+    }
+#ifdef GMON_CFG_APPMSG_SYS_HEALTH
+    // only in full message, so report by exception still shrinks the messages in between
+    if (items == GMON_APPMSG_ALL_ITEMS) {
+        status = serialize_sys_object(&buf_ptr, &remaining_len, gmon);
+        if (status != GMON_RESP_OK)
+            goto done;
+    }
+#endif
+#ifdef GMON_CFG_ENABLE_EVENT_LATENCY
+    status = appMsgLatencyOnSerialized(&buf_ptr, &remaining_len, gmon, src, items);
     if (status != GMON_RESP_OK)
         goto done;
-
+#endif
     status = staAppMsgSerializeAppendStr(&buf_ptr, &remaining_len, "}\x00");
 done:
     outflight_msg->nbytes_written = outflight_msg->len - remaining_len;
+#ifdef GMON_CFG_APPMSG_REPORT_BY_EXCEPTION
+    if (status == GMON_RESP_OK)
+        appMsgTakeSnapshot(gmon, src, items);
+#endif
     return (gmonAppMsgOutflightResult_t){.msg = outflight_msg, .status = status};
 }
+
+// serialize the events being logged to the records, the caller should prevent the sensor tasks from
+// updating the records at the same time
+gmonAppMsgOutflightResult_t staGetAppMsgOutflight(gardenMonitor_t *gmon) {
+    GMON_PROF_SCOPE();
+    appMsgOutSrc_t src = {
+        .logs = &gmon->latest_logs,
+        .actuators = {&gmon->actuator.pump, &gmon->actuator.fan, &gmon->actuator.bulb},
+    };
+    return appMsgOutflight(gmon, &src);
+}
+
+// serialize the records detached by `staAppMsgOutDetachRecords()`, without blocking the sensor tasks
+gmonAppMsgOutflightResult_t staGetAppMsgOutflightDetached(gardenMonitor_t *gmon) {
+    GMON_PROF_SCOPE();
+    gMonAppMsgDetached_t *detached = &gmon->rawmsg.detached;
+    appMsgOutSrc_t        src = {
+        .logs = &detached->logs,
+        .actuators = {&detached->actuators[0], &detached->actuators[1], &detached->actuators[2]},
+    };
+    return appMsgOutflight(gmon, &src);
+}
@@ -0,0 +1,83 @@
+#include "station_include.h"
+
+static unsigned char staEvtLatencyBucket(unsigned int latency_ms) {
+    unsigned char idx = 0;
+    while (idx < (GMON_EVT_LATENCY_NUM_BUCKETS - 1) && (latency_ms >> idx) > 0)
+        idx++;
+    return idx;
+}
+
+void staEvtLatencyAdd(gMonEvtLatencyHist_t *hist, gmonEventStage_t stage, unsigned int latency_ms) {
+    unsigned short *count = &hist->counts[stage][staEvtLatencyBucket(latency_ms)];
+    if (*count < 0xffff)
+        (*count)++;
+    if (hist->max_ms[stage] < latency_ms)
+        hist->max_ms[stage] = latency_ms;
+}
+
+void staEvtLatencySummary(const gMonEvtLatencyHist_t *hist, gMonEvtLatencyStat_t *out) {
+    unsigned int total = 0, accu = 0, idx = 0;
+    XMEMSET(out, 0x00, sizeof(gMonEvtLatencyStat_t));
+    for (unsigned char stage = 0; stage < GMON_EVT_NUM_STAGES; stage++) {
+        for (idx = 0, total = 0; idx < GMON_EVT_LATENCY_NUM_BUCKETS; idx++)
+            total += hist->counts[stage][idx];
+        if (stage == GMON_EVT_STAGE_SERIALIZED)
+            out->num_events = total;
+        if (total == 0)
+            continue;
+        for (idx = 0, accu = 0; (accu << 1) < total; idx++)
+            accu += hist->counts[stage][idx];
+        // upper bound of the bucket does not exceed the maximum latency
+        out->p50_ms[stage] = 1U << (idx - 1);
+        out->max_ms[stage] = hist->max_ms[stage];
+        if (out->p50_ms[stage] > out->max_ms[stage])
+            out->p50_ms[stage] = out->max_ms[stage];
+    }
+}
+
+#ifdef GMON_CFG_ENABLE_EVENT_LATENCY
+static unsigned short staEvtLatencyStageMs(unsigned int elapsed_ms) {
+    return (elapsed_ms < 0xffff) ? elapsed_ms : 0xffff;
+}
+
+void staEvtLatencyBegin(gmonEvent_t *evt, unsigned int acquired_ms, unsigned int detected_ms) {
+    evt->acquired_ms = acquired_ms;
+    // noise detection completed before the event was allocated
+    evt->stage_ms[GMON_EVT_STAGE_DETECT] = staEvtLatencyStageMs(detected_ms - acquired_ms);
+}
+
+void staEvtLatencyStamp(gmonEvent_t *evt, gmonEventStage_t stage) {
+    evt->stage_ms[stage] = staEvtLatencyStageMs(GMON_EVT_LATENCY_NOW_MS() - evt->acquired_ms);
+}
+
+void staEvtLatencyOnSerialized(
+    gMonEvtLatency_t *lat, gMonAppMsgItem_t item, const gmonSensorRecord_t *rec, unsigned int now_ms
+) {
+    gMonEvtLatencyHist_t *hist = &lat->hist[item];
+    for (unsigned char idx = 0; idx < rec->num_refs; idx++) {
+        const gmonEvent_t *evt = rec->events[idx];
+        if (evt == NULL)
+            continue;
+        for (unsigned char stage = 0; stage < GMON_EVT_NUM_STAMPED_STAGES; stage++)
+            staEvtLatencyAdd(hist, stage, evt->stage_ms[stage]);
+        staEvtLatencyAdd(hist, GMON_EVT_STAGE_SERIALIZED, now_ms - evt->acquired_ms);
+        if (!staGetBitFlag(&lat->unacked, item) || (int)(evt->acquired_ms - lat->oldest_unacked_ms[item]) < 0)
+            lat->oldest_unacked_ms[item] = evt->acquired_ms;
+        staSetBitFlag(&lat->unacked, item, 1);
+    }
+}
+
+void staEvtLatencyOnAcked(gMonEvtLatency_t *lat, unsigned int now_ms) {
+    for (unsigned char item = 0; item < GMON_APPMSG_ITEM_PUMP; item++) {
+        if (!staGetBitFlag(&lat->unacked, item))
+            continue;
+        staEvtLatencyAdd(&lat->hist[item], GMON_EVT_STAGE_ACKED, now_ms - lat->oldest_unacked_ms[item]);
+        staSetBitFlag(&lat->unacked, item, 0);
+    }
+}
+
+void staEvtLatencyReset(gMonEvtLatency_t *lat) {
+    XMEMSET(lat->hist, 0x00, sizeof(lat->hist));
+    lat->num_full_since_report = 0;
+}
+#endif // end of GMON_CFG_ENABLE_EVENT_LATENCY
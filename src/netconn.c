@@ -64,17 +64,94 @@ static void serialize_err_outmsg(gmonAppMsgOutflightResult_t *res, gmonTick_t *t
     outflight_msg->nbytes_written = outflight_msg->len - remaining_len;
 }
 
+// decode received JSON data (as user update)
+static void staNetConnApplyInflight(gardenMonitor_t *gmon) {
+    gMonDisplayBlock_t *dblk = NULL;
+    gMonStatus          decode_status = staDecodeAppMsgInflight(gmon);
+    if (decode_status == GMON_RESP_OK) {
+        // update threshold to display device
+        dblk = &gmon->display.blocks[GMON_BLOCK_ACTUATOR_THRESHOLD];
+        dblk->render(&dblk->content, gmon);
+    }
+}
+
+// send out messages kept in backlog (oldest first), at most `GMON_CFG_NETCONN_BACKLOG_DRAIN_BATCH`
+// messages taken from backlog in one network cycle, so the backlog does not hold up the network task
+// for too long. Several messages are published before waiting for PUBACK of the oldest one, draining
+// the backlog is bounded by bandwidth of the link instead of round trip time. This returns after all
+// the messages in the window are acknowledged, or the connection is broken. User control message which
+// arrives while waiting for PUBACK is applied at once.
+static gMonStatus staNetConnDrainBacklog(gardenMonitor_t *gmon) {
+    gMonNet_t            *net_handle = &gmon->netconn;
+    gMonNetPubWindow_t   *pw = &net_handle->pub_win;
+    gMonNetPubWinEntry_t *entry = NULL;
+    gmonStr_t            *msg = NULL;
+    gMonStatus            status = GMON_RESP_OK;
+    unsigned short        num_taken = 0;
+    while (status == GMON_RESP_OK) {
+        // messages left unacknowledged in previous connection go first
+        entry = staNetConnPubWinNextUnsent(pw);
+        if (entry == NULL && num_taken < GMON_CFG_NETCONN_BACKLOG_DRAIN_BATCH) {
+            msg = staNetConnBacklogPeek(&net_handle->backlog);
+            if (msg != NULL)
+                entry = staNetConnPubWinAdd(pw, msg, stationNetConnReservePktId(net_handle));
+            if (entry != NULL) {
+                staNetConnBacklogPop(&net_handle->backlog);
+                num_taken++;
+            }
+        }
+        if (entry != NULL) {
+            status = stationNetConnPublish(net_handle, &entry->msg, entry->pkt_id, entry->dup);
+            if (status == GMON_RESP_OK)
+                staNetConnPubWinMarkSent(pw);
+            continue;
+        }
+        // window is full or nothing else to send
+        entry = staNetConnPubWinOldest(pw);
+        if (entry == NULL)
+            break;
+        // outflight message was sent before draining, its buffer can be cleared for inflight message
+        status = stationNetConnWaitPubAck(net_handle, entry->pkt_id, staGetAppMsgInflight(gmon));
+        if (status == GMON_RESP_SKIP) { // the PUBACK is still expected
+            staNetConnApplyInflight(gmon);
+            status = GMON_RESP_OK;
+        } else if (status == GMON_RESP_OK) {
+            status = staNetConnPubWinAck(pw, entry->pkt_id);
+        }
+    }
+    if (status != GMON_RESP_OK)
+        staNetConnPubWinRewind(pw);
+    return status;
+}
+
+static unsigned short staNetConnNumPending(gMonNet_t *net_handle) {
+    return staNetConnBacklogCount(&net_handle->backlog) + staNetConnPubWinCount(&net_handle->pub_win);
+}
+
+static void staNetConnCycleDone(gMonNet_t *net_handle, unsigned int start_ms) {
+    unsigned int duration_ms = stationSysGetTickCount() * GMON_NUM_MILLISECONDS_PER_TICK - start_ms;
+    net_handle->cycle.last_ms = duration_ms;
+    if (net_handle->cycle.max_ms < duration_ms)
+        net_handle->cycle.max_ms = duration_ms;
+}
+
+#ifndef GMON_CFG_NETCONN_PERSISTENT
 static struct gMonNetStatus staNetConnIteration(
-    gMonNet_t *net_handle, gmonStr_t *app_msg_recv, gmonStr_t *app_msg_send, uint8_t num_reconn
+    gardenMonitor_t *gmon, gmonStr_t *app_msg_recv, gmonStr_t *app_msg_send, uint8_t num_reconn
 ) {
+    gMonNet_t *net_handle = &gmon->netconn;
     // this station might not always receive update from remote user
-    gMonStatus send_status = GMON_RESP_OK, recv_status = GMON_RESP_SKIP;
+    gMonStatus   send_status = GMON_RESP_OK, recv_status = GMON_RESP_SKIP;
+    unsigned int start_ms = stationSysGetTickCount() * GMON_NUM_MILLISECONDS_PER_TICK;
+    GMON_TRACE(NETCONN, NETCONN_BEGIN, app_msg_send != NULL);
     // start network connection to MQTT broker
     while (num_reconn > 0) {
         send_status = stationNetConnEstablish(net_handle);
         if (send_status == GMON_RESP_OK) {
-            // publish encoded JSON data
+            // publish encoded JSON data, then the messages left unsent in previous cycles
             send_status = stationNetConnSend(net_handle, app_msg_send);
+            if (send_status == GMON_RESP_OK && staNetConnNumPending(net_handle) > 0)
+                staNetConnDrainBacklog(gmon);
         }
         if (send_status == GMON_RESP_OK) {
             // check any update from user including : threshold of each output device trigger,
@@ -84,44 +161,222 @@ static struct gMonNetStatus staNetConnIteration(
         stationNetConnClose(net_handle);
         num_reconn = (send_status == GMON_RESP_OK) ? 0 : (num_reconn - 1);
     }
+    // whole cycle in which the radio is on, including reconnections
+    staNetConnCycleDone(net_handle, start_ms);
+    GMON_TRACE(NETCONN, NETCONN_END, send_status);
     struct gMonNetStatus out = {.send = send_status, .recv = recv_status};
     return out;
 }
+#endif // end of GMON_CFG_NETCONN_PERSISTENT
 
-void stationNetConnHandlerTaskFn(void *params) {
+// serialize logged events to network payload. The records are swapped with empty ones in short critical
+// section, then the detached records are serialized while the sensor tasks keep logging new events.
+static gmonStr_t *staNetConnPrepareOutflight(gardenMonitor_t *gmon) {
+    stationSysEnterCritical();
+    staAppMsgOutDetachRecords(gmon);
+    staNetConnAdaptiveOnReport(gmon);
+    stationSysExitCritical();
+    // `app_send_result.status` is for debugging purpose
+    gmonAppMsgOutflightResult_t app_send_result = staGetAppMsgOutflightDetached(gmon);
+    if (app_send_result.status != GMON_RESP_OK)
+        serialize_err_outmsg(&app_send_result, &gmon->tick);
+    // return the serialized events to the pool for the next cycle
+    staAppMsgOutResetDetachedRecords(gmon);
+    return app_send_result.msg;
+}
+
+static void staNetConnRenderStatus(gardenMonitor_t *gmon) {
     gMonDisplayBlock_t *dblk = NULL;
-    gardenMonitor_t    *gmon = (gardenMonitor_t *)params;
-    while (1) {
-        stationSysDelayMs(gmon->netconn.interval_ms);
-        XASSERT(staAppMsgReallocBuffer(gmon) == GMON_RESP_OK);
-        stationSysEnterCritical();
+    gmon->user_ctrl.last_update.ticks = stationGetTicksPerDay(&gmon->tick);
+    gmon->user_ctrl.last_update.days = stationGetDays(&gmon->tick);
+    // update network connection status to display device
+    dblk = &gmon->display.blocks[GMON_BLOCK_NETCONN_STATUS];
+    dblk->render(&dblk->content, gmon);
+}
+
+// double the delay between reconnections, within configured range
+unsigned int staNetConnNextBackoff(unsigned int curr_backoff_ms) {
+#ifdef GMON_CFG_NETCONN_PERSISTENT
+    const unsigned int min_ms = GMON_CFG_NETCONN_RECONN_MIN_BACKOFF_MS;
+    const unsigned int max_ms = GMON_CFG_NETCONN_RECONN_MAX_BACKOFF_MS;
+#else
+    const unsigned int min_ms = GMON_MIN_NETCONN_START_INTERVAL_MS;
+    const unsigned int max_ms = GMON_MAX_NETCONN_START_INTERVAL_MS;
+#endif
+    if (curr_backoff_ms < min_ms)
+        return min_ms;
+    return (curr_backoff_ms > (max_ms >> 1)) ? max_ms : (curr_backoff_ms << 1);
+}
+
+#ifdef GMON_CFG_NETCONN_PERSISTENT
+static void staNetConnSessionDrop(gMonNet_t *net_handle, unsigned int now_ms) {
+    stationNetConnClose(net_handle);
+    net_handle->session.connected = 0;
+    net_handle->session.backoff_ms = staNetConnNextBackoff(net_handle->session.backoff_ms);
+    net_handle->session.reconn_at_ms = now_ms + net_handle->session.backoff_ms;
+}
+
+// connect to MQTT broker and subscribe the topic of user control, give up until next reconnection time
+// if anything failed, the delay between reconnections grows exponentially.
+static gMonStatus staNetConnSessionOpen(gMonNet_t *net_handle, unsigned int now_ms) {
+    gMonStatus status = GMON_RESP_OK;
+    if ((int)(now_ms - net_handle->session.reconn_at_ms) < 0)
+        return GMON_RESP_SKIP;
+    status = stationNetConnEstablish(net_handle);
+    if (status == GMON_RESP_OK)
+        status = stationNetConnSubscribe(net_handle);
+    if (status == GMON_RESP_OK) {
+        net_handle->session.connected = 1;
+        net_handle->session.backoff_ms = 0;
+        net_handle->session.last_sent_ms = now_ms;
+        net_handle->session.num_reconn++;
+    } else {
+        staNetConnSessionDrop(net_handle, now_ms);
+    }
+    return status;
+}
+
+static struct gMonNetStatus
+staNetConnSessionIteration(gardenMonitor_t *gmon, gmonStr_t *app_msg_send, unsigned int now_ms) {
+    gMonNet_t   *net_handle = &gmon->netconn;
+    gMonStatus   send_status = GMON_RESP_SKIP, recv_status = GMON_RESP_SKIP;
+    unsigned int idle_ms = 0;
+    GMON_TRACE(NETCONN, NETCONN_BEGIN, app_msg_send != NULL);
+    if (app_msg_send != NULL) {
+        send_status = stationNetConnSend(net_handle, app_msg_send);
+        if (send_status == GMON_RESP_OK) {
+            net_handle->session.last_sent_ms = now_ms;
+        } else { // keep the message before the shared buffer is overwritten by inflight message
+            staNetConnBacklogPush(&net_handle->backlog, app_msg_send);
+        }
+    }
+    if (send_status >= 0 && staNetConnNumPending(net_handle) > 0) {
+        send_status = staNetConnDrainBacklog(gmon);
+        if (send_status == GMON_RESP_OK)
+            net_handle->session.last_sent_ms = now_ms;
+    }
+    // waiting for user control message below is not counted
+    if (app_msg_send != NULL)
+        staNetConnCycleDone(net_handle, now_ms);
+    if (send_status >= 0) {
+        // shared buffer of outflight message can be cleared only after it was sent
         gmonStr_t *app_msg_recv = staGetAppMsgInflight(gmon);
-        // serialize logged events to network payload,
-        // `app_send_result.status` is for debugging purpose
-        gmonAppMsgOutflightResult_t app_send_result = staGetAppMsgOutflight(gmon);
-        if (app_send_result.status != GMON_RESP_OK)
-            serialize_err_outmsg(&app_send_result, &gmon->tick);
-        // Reset records AFTER serialization for the next cycle
-        staAppMsgOutResetAllRecords(gmon);
-        stationSysExitCritical();
-        // pause the working output device(s) that requires to rapidly frequently refresh
-        // sensor data due to the network latency.
-        staPauseWorkingActuators(gmon);
-        struct gMonNetStatus status =
-            staNetConnIteration(&gmon->netconn, app_msg_recv, app_send_result.msg, 3);
-        // decode received JSON data (as user update)
-        if (status.recv == GMON_RESP_OK) {
-            gMonStatus decode_status = staDecodeAppMsgInflight(gmon);
-            if (decode_status == GMON_RESP_OK) {
-                // update threshold to display device
-                dblk = &gmon->display.blocks[GMON_BLOCK_ACTUATOR_THRESHOLD];
-                dblk->render(&dblk->content, gmon);
-            }
+        recv_status = stationNetConnPoll(net_handle, app_msg_recv, GMON_CFG_NETCONN_POLL_INTERVAL_MS);
+    }
+    idle_ms = now_ms - net_handle->session.last_sent_ms;
+    if (send_status >= 0 && recv_status >= 0 && (idle_ms << 1) >= GMON_CFG_NETCONN_KEEPALIVE_SEC * 1000) {
+        send_status = stationNetConnPing(net_handle);
+        if (send_status == GMON_RESP_OK)
+            net_handle->session.last_sent_ms = now_ms;
+    }
+    if (send_status < 0 || recv_status < 0)
+        staNetConnSessionDrop(net_handle, now_ms);
+    GMON_TRACE(NETCONN, NETCONN_END, send_status);
+    struct gMonNetStatus out = {.send = send_status, .recv = recv_status};
+    return out;
+}
+
+gMonStatus stationNetConnHandlerStart(gMonNet_t *net_handle) {
+    if (net_handle == NULL)
+        return GMON_RESP_ERRARGS;
+    net_handle->session.connected = 0;
+    net_handle->session.backoff_ms = 0;
+    net_handle->session.num_reconn = 0;
+    net_handle->session.reconn_at_ms = stationSysGetTickCount() * GMON_NUM_MILLISECONDS_PER_TICK;
+    net_handle->session.last_publish_ms = net_handle->session.reconn_at_ms;
+    staNetConnAdaptiveReset(net_handle);
+    return GMON_RESP_OK;
+}
+
+// the session is kept open, logs are published every `interval_ms`, user control message is received
+// as soon as it arrives, and the broker is pinged if nothing sent for half of keep-alive interval.
+gMonStatus stationNetConnHandlerIteration(gardenMonitor_t *gmon) {
+    gMonNet_t           *net_handle = &gmon->netconn;
+    gmonStr_t           *app_msg_send = NULL;
+    struct gMonNetStatus status = {0};
+    unsigned int         now_ms = stationSysGetTickCount() * GMON_NUM_MILLISECONDS_PER_TICK;
+    XASSERT(staAppMsgReallocBuffer(gmon) == GMON_RESP_OK);
+    // logs are serialized on schedule even if the session is lost, then kept in backlog
+    if (staNetConnReportDue(gmon, now_ms)) {
+        staNetConnReportStamp(net_handle, now_ms);
+        app_msg_send = staNetConnPrepareOutflight(gmon);
+    }
+    if (!net_handle->session.connected) {
+        status.send = GMON_RESP_SKIP;
+        if ((int)(now_ms - net_handle->session.reconn_at_ms) >= 0) {
+            // pause the working output device(s) that requires to rapidly frequently refresh
+            // sensor data, reconnection may take a while.
+            staPauseWorkingActuators(gmon);
+            status.send = staNetConnSessionOpen(net_handle, now_ms);
+            if (status.send != GMON_RESP_OK)
+                net_handle->status.sent = status.send;
         }
-        gmon->user_ctrl.last_update.ticks = stationGetTicksPerDay(&gmon->tick);
-        gmon->user_ctrl.last_update.days = stationGetDays(&gmon->tick);
-        // update network connection status to display device
-        dblk = &gmon->display.blocks[GMON_BLOCK_NETCONN_STATUS];
-        dblk->render(&dblk->content, gmon);
+        if (status.send != GMON_RESP_OK) {
+            if (app_msg_send != NULL)
+                staNetConnBacklogPush(&net_handle->backlog, app_msg_send);
+            if (app_msg_send != NULL || status.send != GMON_RESP_SKIP)
+                staNetConnRenderStatus(gmon);
+            return status.send;
+        }
+    }
+    status = staNetConnSessionIteration(gmon, app_msg_send, now_ms);
+    if (status.send >= 0 && staNetConnNumPending(net_handle) == 0)
+        staAppMsgOutAcked(gmon);
+    if (status.recv == GMON_RESP_OK)
+        staNetConnApplyInflight(gmon);
+    if (app_msg_send != NULL || status.recv == GMON_RESP_OK || !net_handle->session.connected)
+        staNetConnRenderStatus(gmon);
+    return status.send;
+}
+
+void stationNetConnHandlerTaskFn(void *params) {
+    gardenMonitor_t *gmon = (gardenMonitor_t *)params;
+    stationNetConnHandlerStart(&gmon->netconn);
+    while (1) {
+        // waiting for user control message paces this task while the session is alive
+        if (!gmon->netconn.session.connected)
+            stationSysDelayMs(GMON_CFG_NETCONN_POLL_INTERVAL_MS);
+        stationNetConnHandlerIteration(gmon);
+    }
+}
+#else
+gMonStatus stationNetConnHandlerStart(gMonNet_t *net_handle) {
+    if (net_handle == NULL)
+        return GMON_RESP_ERRARGS;
+    net_handle->session.last_publish_ms = stationSysGetTickCount() * GMON_NUM_MILLISECONDS_PER_TICK;
+    staNetConnAdaptiveReset(net_handle);
+    return GMON_RESP_OK;
+}
+
+gMonStatus stationNetConnHandlerIteration(gardenMonitor_t *gmon) {
+    XASSERT(staAppMsgReallocBuffer(gmon) == GMON_RESP_OK);
+    staNetConnReportStamp(&gmon->netconn, stationSysGetTickCount() * GMON_NUM_MILLISECONDS_PER_TICK);
+    gmonStr_t *app_msg_recv = staGetAppMsgInflight(gmon);
+    gmonStr_t *app_msg_send = staNetConnPrepareOutflight(gmon);
+    // pause the working output device(s) that requires to rapidly frequently refresh
+    // sensor data due to the network latency.
+    staPauseWorkingActuators(gmon);
+    struct gMonNetStatus status = staNetConnIteration(gmon, app_msg_recv, app_msg_send, 3);
+    if (status.send != GMON_RESP_OK) // inflight message is never received in this case
+        staNetConnBacklogPush(&gmon->netconn.backlog, app_msg_send);
+    else if (staNetConnNumPending(&gmon->netconn) == 0)
+        staAppMsgOutAcked(gmon);
+    if (status.recv == GMON_RESP_OK)
+        staNetConnApplyInflight(gmon);
+    staNetConnRenderStatus(gmon);
+    return status.send;
+}
+
+void stationNetConnHandlerTaskFn(void *params) {
+    gardenMonitor_t *gmon = (gardenMonitor_t *)params;
+    unsigned int     wake_ms = stationSysGetTickCount() * GMON_NUM_MILLISECONDS_PER_TICK;
+    stationNetConnHandlerStart(&gmon->netconn);
+    while (1) {
+        // the radio is turned on only when the report is due, the check period does not include
+        // time spent on previous report
+        stationSysDelayUntilMs(&wake_ms, staNetConnCheckIntervalMs(&gmon->netconn));
+        if (staNetConnReportDue(gmon, stationSysGetTickCount() * GMON_NUM_MILLISECONDS_PER_TICK))
+            stationNetConnHandlerIteration(gmon);
     }
 }
+#endif // end of GMON_CFG_NETCONN_PERSISTENT
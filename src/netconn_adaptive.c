@@ -0,0 +1,134 @@
+#include "station_include.h"
+
+// Adaptive reporting interval. Log messages are published as soon as an actuator changes state or its
+// aggregated sensor data crosses the threshold (but not more often than the minimum gap), the interval
+// is doubled toward the configured maximum each time the readings stay stable between two reports, and
+// it falls back to the interval set by remote user once anything changes.
+
+void staNetConnAdaptiveReset(gMonNet_t *net_handle) {
+    if (net_handle == NULL)
+        return;
+    XMEMSET(&net_handle->adaptive, 0x00, sizeof(gMonNetAdaptive_t));
+    net_handle->adaptive.interval_ms = net_handle->interval_ms;
+}
+
+#ifdef GMON_CFG_NETCONN_ADAPTIVE_INTERVAL
+// working actuators are paused by network handler task itself, that is not regarded as state change
+static unsigned char staNetConnAdaptiveDevState(gMonActuator_t *dev) {
+    return (dev->status == GMON_OUT_DEV_STATUS_PAUSE) ? GMON_OUT_DEV_STATUS_ON : dev->status;
+}
+
+static void staNetConnAdaptiveActuators(gardenMonitor_t *gmon, gMonActuator_t **devs) {
+    devs[0] = &gmon->actuator.bulb;
+    devs[1] = &gmon->actuator.pump;
+    devs[2] = &gmon->actuator.fan;
+}
+
+// whether any actuator changed state, or its aggregated data crossed the threshold since last report
+static unsigned char staNetConnAdaptiveUrgent(gardenMonitor_t *gmon) {
+    gMonNetAdaptive_t *ada = &gmon->netconn.adaptive;
+    gMonActuator_t    *devs[GMON_NETCONN_ADAPTIVE_NUM_ACTUATORS] = {0};
+    unsigned char      idx = 0, above = 0;
+    if (!ada->snapshot_valid)
+        return 0;
+    staNetConnAdaptiveActuators(gmon, devs);
+    for (idx = 0; idx < GMON_NETCONN_ADAPTIVE_NUM_ACTUATORS; idx++) {
+        if (staNetConnAdaptiveDevState(devs[idx]) != ada->status[idx])
+            return 1;
+        above = devs[idx]->ema.last_aggregated > devs[idx]->threshold;
+        if (above != staGetBitFlag(&ada->above_threshold, idx))
+            return 1;
+    }
+    return 0;
+}
+#endif // end of GMON_CFG_NETCONN_ADAPTIVE_INTERVAL
+
+// called by network handler task to check whether logs should be serialized and published
+unsigned char staNetConnReportDue(gardenMonitor_t *gmon, unsigned int now_ms) {
+    gMonNet_t   *net_handle = &gmon->netconn;
+    unsigned int elapsed_ms = now_ms - net_handle->session.last_publish_ms;
+#ifdef GMON_CFG_NETCONN_ADAPTIVE_INTERVAL
+    gMonNetAdaptive_t *ada = &net_handle->adaptive;
+    // remote user might change the interval after last report
+    if (ada->interval_ms < net_handle->interval_ms)
+        ada->interval_ms = net_handle->interval_ms;
+    if (elapsed_ms >= ada->interval_ms)
+        return 1;
+    if (elapsed_ms >= GMON_CFG_NETCONN_ADAPTIVE_MIN_GAP_MS && staNetConnAdaptiveUrgent(gmon)) {
+        ada->num_early++;
+        return 1;
+    }
+    return 0;
+#else
+    return elapsed_ms >= net_handle->interval_ms;
+#endif
+}
+
+// called when report is due, before the logs are serialized. Next report is counted from the time this
+// report was due instead of `now_ms`, so late wakeup of network handler task does not push the next
+// report a whole period further. The time is taken from `now_ms` if the report is early, or was
+// missed for an entire interval (e.g. the task was blocked by reconnection for long time).
+void staNetConnReportStamp(gMonNet_t *net_handle, unsigned int now_ms) {
+    unsigned int interval_ms = staNetConnReportIntervalMs(net_handle);
+    unsigned int elapsed_ms = now_ms - net_handle->session.last_publish_ms;
+    if (elapsed_ms >= interval_ms && elapsed_ms < (interval_ms << 1))
+        net_handle->session.last_publish_ms += interval_ms;
+    else
+        net_handle->session.last_publish_ms = now_ms;
+}
+
+// take snapshot of the actuators when logs are serialized, then decide interval to next report
+void staNetConnAdaptiveOnReport(gardenMonitor_t *gmon) {
+#ifdef GMON_CFG_NETCONN_ADAPTIVE_INTERVAL
+    gMonNetAdaptive_t *ada = &gmon->netconn.adaptive;
+    gMonActuator_t    *devs[GMON_NETCONN_ADAPTIVE_NUM_ACTUATORS] = {0};
+    unsigned char      idx = 0, stable = ada->snapshot_valid, above = 0, state = 0;
+    unsigned int       delta = 0, max_delta = 0;
+    const unsigned int max_ms = GMON_CFG_NETCONN_ADAPTIVE_MAX_INTERVAL_MS;
+    staNetConnAdaptiveActuators(gmon, devs);
+    for (idx = 0; idx < GMON_NETCONN_ADAPTIVE_NUM_ACTUATORS; idx++) {
+        above = devs[idx]->ema.last_aggregated > devs[idx]->threshold;
+        delta = (devs[idx]->ema.last_aggregated > ada->aggregated[idx])
+                    ? (devs[idx]->ema.last_aggregated - ada->aggregated[idx])
+                    : (ada->aggregated[idx] - devs[idx]->ema.last_aggregated);
+        max_delta = (devs[idx]->threshold < 0) ? -devs[idx]->threshold : devs[idx]->threshold;
+        state = staNetConnAdaptiveDevState(devs[idx]);
+        if (state != ada->status[idx] || above != staGetBitFlag(&ada->above_threshold, idx) ||
+            (delta * 100) > (max_delta * GMON_CFG_NETCONN_ADAPTIVE_STABLE_PERCENT))
+            stable = 0;
+        ada->aggregated[idx] = devs[idx]->ema.last_aggregated;
+        ada->status[idx] = state;
+        staSetBitFlag(&ada->above_threshold, idx, above);
+    }
+    ada->snapshot_valid = 1;
+    if (!stable || ada->interval_ms < gmon->netconn.interval_ms) {
+        ada->interval_ms = gmon->netconn.interval_ms;
+    } else {
+        ada->interval_ms = (ada->interval_ms > (max_ms >> 1)) ? max_ms : (ada->interval_ms << 1);
+        if (ada->interval_ms < gmon->netconn.interval_ms)
+            ada->interval_ms = gmon->netconn.interval_ms;
+    }
+#else
+    (void)gmon;
+#endif
+}
+
+// current interval between two reports, published log message is superseded by the next one after that
+unsigned int staNetConnReportIntervalMs(gMonNet_t *net_handle) {
+#ifdef GMON_CFG_NETCONN_ADAPTIVE_INTERVAL
+    if (net_handle->adaptive.interval_ms > net_handle->interval_ms)
+        return net_handle->adaptive.interval_ms;
+#endif
+    return net_handle->interval_ms;
+}
+
+// how often the task in non-persistent mode wakes up to check whether report is due, the radio is
+// turned on only when the report is due.
+unsigned int staNetConnCheckIntervalMs(gMonNet_t *net_handle) {
+#ifdef GMON_CFG_NETCONN_ADAPTIVE_INTERVAL
+    (void)net_handle;
+    return GMON_CFG_NETCONN_ADAPTIVE_MIN_GAP_MS;
+#else
+    return net_handle->interval_ms;
+#endif
+}
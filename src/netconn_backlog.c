@@ -0,0 +1,142 @@
+#include "station_include.h"
+
+// Log messages which failed to be published are kept here until the connection recovers. The newest
+// messages are kept in RAM slots, and the oldest ones are moved to spill storage (if provided) when
+// the RAM slots are full, so messages in the spill storage are always older than those in RAM.
+
+gMonStatus staNetConnBacklogInit(gMonNetBacklog_t *bl, const gMonNetBacklogStorage_t *storage, void *ctx) {
+    if (bl == NULL)
+        return GMON_RESP_ERRARGS;
+    if (storage != NULL) {
+        if (storage->push == NULL || storage->peek == NULL || storage->pop == NULL || storage->count == NULL)
+            return GMON_RESP_ERRARGS;
+    }
+    XMEMSET(bl, 0x00, sizeof(gMonNetBacklog_t));
+    bl->storage = storage;
+    bl->storage_ctx = ctx;
+    bl->drop_policy = GMON_CFG_NETCONN_BACKLOG_DROP_POLICY;
+    return GMON_RESP_OK;
+}
+
+gMonStatus staNetConnBacklogDeinit(gMonNetBacklog_t *bl) {
+    if (bl == NULL)
+        return GMON_RESP_ERRARGS;
+    for (unsigned char idx = 0; idx < GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS; idx++) {
+        if (bl->slots[idx].data != NULL)
+            XMEMFREE(bl->slots[idx].data);
+    }
+    if (bl->xfer.data != NULL)
+        XMEMFREE(bl->xfer.data);
+    XMEMSET(bl, 0x00, sizeof(gMonNetBacklog_t));
+    return GMON_RESP_OK;
+}
+
+static unsigned short staNetConnBacklogNumStored(gMonNetBacklog_t *bl) {
+    return (bl->storage != NULL) ? bl->storage->count(bl->storage_ctx) : 0;
+}
+
+static void staNetConnBacklogDiscardOldestSlot(gMonNetBacklog_t *bl) {
+    bl->slots[bl->rd_ptr].nbytes_written = 0;
+    bl->rd_ptr = (bl->rd_ptr + 1) % GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS;
+    bl->num_used--;
+}
+
+// free one RAM slot by moving the oldest message to spill storage, or drop a message according to
+// the policy, GMON_RESP_SKIP means the new message should be dropped
+static gMonStatus staNetConnBacklogMakeRoom(gMonNetBacklog_t *bl) {
+    gMonStatus status = GMON_RESP_ERR;
+    if (bl->storage != NULL) {
+        status = bl->storage->push(bl->storage_ctx, &bl->slots[bl->rd_ptr]);
+        if (status == GMON_RESP_ERRMEM && bl->drop_policy == GMON_NETCONN_BACKLOG_DROP_OLDEST) {
+            if (bl->storage->pop(bl->storage_ctx) == GMON_RESP_OK) {
+                bl->xfer_loaded = 0;
+                bl->stats.num_dropped++;
+                status = bl->storage->push(bl->storage_ctx, &bl->slots[bl->rd_ptr]);
+            }
+        }
+        if (status == GMON_RESP_OK) {
+            bl->stats.num_spilled++;
+            staNetConnBacklogDiscardOldestSlot(bl);
+            return GMON_RESP_OK;
+        }
+    }
+    if (bl->drop_policy == GMON_NETCONN_BACKLOG_DROP_NEWEST)
+        return GMON_RESP_SKIP;
+    staNetConnBacklogDiscardOldestSlot(bl);
+    bl->stats.num_dropped++;
+    return GMON_RESP_OK;
+}
+
+// copy the message to backlog, return GMON_RESP_SKIP if it is dropped due to the policy
+gMonStatus staNetConnBacklogPush(gMonNetBacklog_t *bl, const gmonStr_t *msg) {
+    gmonStr_t     *slot = NULL;
+    gMonStatus     status = GMON_RESP_OK;
+    unsigned short num_total = 0;
+    if (bl == NULL || msg == NULL || msg->data == NULL || msg->nbytes_written == 0)
+        return GMON_RESP_ERRARGS;
+    if (bl->num_used >= GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS) {
+        status = staNetConnBacklogMakeRoom(bl);
+        if (status == GMON_RESP_SKIP) {
+            bl->stats.num_dropped++;
+            return status;
+        }
+    }
+    slot = &bl->slots[(bl->rd_ptr + bl->num_used) % GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS];
+    // buffer of each slot is reused as long as size of outflight message buffer stays the same
+    status = staEnsureStrBufferSize(slot, (msg->len > msg->nbytes_written) ? msg->len : msg->nbytes_written);
+    if (status != GMON_RESP_OK)
+        return status;
+    XMEMCPY(slot->data, msg->data, msg->nbytes_written);
+    slot->nbytes_written = msg->nbytes_written;
+    bl->num_used++;
+    bl->stats.num_queued++;
+    num_total = bl->num_used + staNetConnBacklogNumStored(bl);
+    if (bl->stats.peak < num_total)
+        bl->stats.peak = num_total;
+    return GMON_RESP_OK;
+}
+
+// oldest message in the backlog, NULL if nothing left, it stays in the backlog until popped
+gmonStr_t *staNetConnBacklogPeek(gMonNetBacklog_t *bl) {
+    gMonStatus status = GMON_RESP_OK;
+    if (bl == NULL)
+        return NULL;
+    if (bl->xfer_loaded)
+        return &bl->xfer;
+    if (staNetConnBacklogNumStored(bl) > 0) {
+        bl->xfer.nbytes_written = 0;
+        status = bl->storage->peek(bl->storage_ctx, &bl->xfer);
+        if (status == GMON_RESP_ERRMEM && bl->xfer.nbytes_written > bl->xfer.len) {
+            status = staEnsureStrBufferSize(&bl->xfer, bl->xfer.nbytes_written);
+            if (status == GMON_RESP_OK)
+                status = bl->storage->peek(bl->storage_ctx, &bl->xfer);
+        }
+        if (status == GMON_RESP_OK) {
+            bl->xfer_loaded = 1;
+            return &bl->xfer;
+        } // otherwise skip the storage, send messages in RAM slots anyway
+    }
+    return (bl->num_used > 0) ? &bl->slots[bl->rd_ptr] : NULL;
+}
+
+// remove the message returned by previous staNetConnBacklogPeek(), after it is sent successfully
+gMonStatus staNetConnBacklogPop(gMonNetBacklog_t *bl) {
+    gMonStatus status = GMON_RESP_OK;
+    if (bl == NULL)
+        return GMON_RESP_ERRARGS;
+    if (bl->xfer_loaded) {
+        status = bl->storage->pop(bl->storage_ctx);
+        bl->xfer_loaded = 0;
+    } else if (bl->num_used > 0) {
+        staNetConnBacklogDiscardOldestSlot(bl);
+    } else {
+        status = GMON_RESP_SKIP;
+    }
+    if (status == GMON_RESP_OK)
+        bl->stats.num_drained++;
+    return status;
+}
+
+unsigned short staNetConnBacklogCount(gMonNetBacklog_t *bl) {
+    return (bl == NULL) ? 0 : (bl->num_used + staNetConnBacklogNumStored(bl));
+}
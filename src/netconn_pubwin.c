@@ -0,0 +1,108 @@
+#include "station_include.h"
+
+// Log messages taken out of the backlog are published as QoS 1 without waiting for PUBACK one by one,
+// a copy of each message is kept here until its PUBACK arrives. If the connection is lost, the messages
+// still in the window are published again (with DUP flag) with the same packet IDs on the next
+// connection, the broker keeps the session (clean start is not set) so it can discard the duplicates.
+
+gMonStatus staNetConnPubWinInit(gMonNetPubWindow_t *pw) {
+    if (pw == NULL)
+        return GMON_RESP_ERRARGS;
+    XMEMSET(pw, 0x00, sizeof(gMonNetPubWindow_t));
+    pw->window = GMON_CFG_NETCONN_PUB_WINDOW_SZ;
+    return GMON_RESP_OK;
+}
+
+gMonStatus staNetConnPubWinDeinit(gMonNetPubWindow_t *pw) {
+    if (pw == NULL)
+        return GMON_RESP_ERRARGS;
+    for (unsigned char idx = 0; idx < GMON_CFG_NETCONN_PUB_WINDOW_SZ; idx++) {
+        if (pw->entries[idx].msg.data != NULL)
+            XMEMFREE(pw->entries[idx].msg.data);
+    }
+    XMEMSET(pw, 0x00, sizeof(gMonNetPubWindow_t));
+    return GMON_RESP_OK;
+}
+
+void staNetConnPubWinSetWindow(gMonNetPubWindow_t *pw, unsigned short peer_recv_max) {
+    if (pw == NULL)
+        return;
+    pw->window = GMON_CFG_NETCONN_PUB_WINDOW_SZ;
+    if (peer_recv_max > 0 && peer_recv_max < pw->window)
+        pw->window = peer_recv_max;
+}
+
+static gMonNetPubWinEntry_t *staNetConnPubWinAt(gMonNetPubWindow_t *pw, unsigned char offset) {
+    return &pw->entries[(pw->rd_ptr + offset) % GMON_CFG_NETCONN_PUB_WINDOW_SZ];
+}
+
+// copy the message to the window with packet ID reserved from network stack, NULL if the window is full
+gMonNetPubWinEntry_t *
+staNetConnPubWinAdd(gMonNetPubWindow_t *pw, const gmonStr_t *msg, unsigned short pkt_id) {
+    gmonStr_t            *buf = NULL;
+    gMonNetPubWinEntry_t *entry = NULL;
+    unsigned short        buf_sz = 0;
+    // packet ID 0 is not allowed in MQTT
+    if (pw == NULL || msg == NULL || msg->data == NULL || msg->nbytes_written == 0 || pkt_id == 0)
+        return NULL;
+    if (pw->num_used >= pw->window)
+        return NULL;
+    entry = staNetConnPubWinAt(pw, pw->num_used);
+    buf = &entry->msg;
+    buf_sz = (msg->len > msg->nbytes_written) ? msg->len : msg->nbytes_written;
+    if (staEnsureStrBufferSize(buf, buf_sz) != GMON_RESP_OK)
+        return NULL;
+    XMEMCPY(buf->data, msg->data, msg->nbytes_written);
+    buf->nbytes_written = msg->nbytes_written;
+    entry->pkt_id = pkt_id;
+    entry->dup = 0;
+    pw->num_used++;
+    if (pw->stats.peak < pw->num_used)
+        pw->stats.peak = pw->num_used;
+    return entry;
+}
+
+// next message to publish in current connection, NULL if all of them have been published
+gMonNetPubWinEntry_t *staNetConnPubWinNextUnsent(gMonNetPubWindow_t *pw) {
+    if (pw == NULL || pw->num_sent >= pw->num_used)
+        return NULL;
+    return staNetConnPubWinAt(pw, pw->num_sent);
+}
+
+void staNetConnPubWinMarkSent(gMonNetPubWindow_t *pw) {
+    if (pw != NULL && pw->num_sent < pw->num_used)
+        pw->num_sent++;
+}
+
+// oldest message published and waiting for PUBACK
+gMonNetPubWinEntry_t *staNetConnPubWinOldest(gMonNetPubWindow_t *pw) {
+    if (pw == NULL || pw->num_sent == 0)
+        return NULL;
+    return staNetConnPubWinAt(pw, 0);
+}
+
+// the broker sends PUBACKs in the order the messages were published, only the oldest one can be released
+gMonStatus staNetConnPubWinAck(gMonNetPubWindow_t *pw, unsigned short pkt_id) {
+    gMonNetPubWinEntry_t *entry = staNetConnPubWinOldest(pw);
+    if (entry == NULL)
+        return GMON_RESP_SKIP;
+    if (entry->pkt_id != pkt_id)
+        return GMON_RESP_INVALID_REQ;
+    entry->msg.nbytes_written = 0;
+    pw->rd_ptr = (pw->rd_ptr + 1) % GMON_CFG_NETCONN_PUB_WINDOW_SZ;
+    pw->num_used--;
+    pw->num_sent--;
+    return GMON_RESP_OK;
+}
+
+// connection lost, messages published without PUBACK will be sent again in next connection
+void staNetConnPubWinRewind(gMonNetPubWindow_t *pw) {
+    if (pw == NULL)
+        return;
+    for (unsigned char idx = 0; idx < pw->num_sent; idx++)
+        staNetConnPubWinAt(pw, idx)->dup = 1;
+    pw->stats.num_retransmit += pw->num_sent;
+    pw->num_sent = 0;
+}
+
+unsigned char staNetConnPubWinCount(gMonNetPubWindow_t *pw) { return (pw == NULL) ? 0 : pw->num_used; }
@@ -9,6 +9,15 @@
 #define GMON_MQTT_TOPIC_LOG               GMON_CFG_MQTT_TOPIC_LOG
 #define GMON_MQTT_TOPIC_USR_CTRL          GMON_CFG_MQTT_TOPIC_USR_CTRL
 
+#ifdef GMON_CFG_NETCONN_PERSISTENT
+    #define GMON_MQTT_KEEPALIVE_SEC GMON_CFG_NETCONN_KEEPALIVE_SEC
+#else
+    #define GMON_MQTT_KEEPALIVE_SEC MQTT_DEFAULT_KEEPALIVE_SEC
+#endif
+
+#define GMON_MQTT_NUM_CONN_PROPS 3
+#define GMON_MQTT_NUM_PUB_PROPS  2
+
 #define mqttSetupCmdUnsubscribe(unsubs, ext_ctx) mqttSetupCmdSubscribe((unsubs), (ext_ctx))
 #define mqttCleanCmdUnsubscribe(unsubs)          mqttCleanCmdSubscribe((unsubs))
 
@@ -18,6 +27,13 @@ typedef struct {
     mqttStr_t   client_id;
     mqttStr_t  *broker_username;
     mqttStr_t  *broker_password;
+    // property lists are built once at initialization, then linked to the command packets on each
+    // use, without allocating / deallocating them in every network cycle
+    mqttProp_t conn_props[GMON_MQTT_NUM_CONN_PROPS];
+    mqttProp_t pub_props[GMON_MQTT_NUM_PUB_PROPS];
+#ifndef GMON_CFG_MQTT_PIPELINED_PUBLISH
+    word16 next_pub_label; // labels messages in publish window
+#endif
 } mqttExtendCtx_t;
 
 static gMonStatus mqttRespToGMonResp(mqttRespStatus status_in) {
@@ -60,20 +76,38 @@ static gMonStatus mqttRespToGMonResp(mqttRespStatus status_in) {
     return status_out;
 } // end of mqttRespToGMonResp
 
+static void mqttPropListInit(mqttProp_t *list, const mqttPropertyType *types, unsigned char num_props) {
+    XMEMSET(list, 0x00, sizeof(mqttProp_t) * num_props);
+    for (unsigned char idx = 0; idx < num_props; idx++) {
+        list[idx].type = types[idx];
+        list[idx].next = ((idx + 1) < num_props) ? &list[idx + 1] : NULL;
+    }
+}
+
+static void mqttSetupPropLists(mqttExtendCtx_t *ext_ctx) {
+    const mqttPropertyType conn_types[GMON_MQTT_NUM_CONN_PROPS] = {
+        MQTT_PROP_RECV_MAX, MQTT_PROP_MAX_PKT_SIZE, MQTT_PROP_TOPIC_ALIAS_MAX
+    };
+    const mqttPropertyType pub_types[GMON_MQTT_NUM_PUB_PROPS] = {
+        MQTT_PROP_MSG_EXPIRY_INTVL, MQTT_PROP_TOPIC_ALIAS
+    };
+    mqttPropListInit(ext_ctx->conn_props, conn_types, GMON_MQTT_NUM_CONN_PROPS);
+    // only allow to handle subscribed inflight message one after another, not concurrently.
+    // This does not limit log messages published by this station, which is up to the broker.
+    ext_ctx->conn_props[0].body.u16 = 1;
+    ext_ctx->conn_props[1].body.u32 = MQTT_RECV_PKT_MAXBYTES - (MQTT_RECV_PKT_MAXBYTES >> 2);
+    ext_ctx->conn_props[2].body.u16 = GMON_MQTT_TOPIC_ALIAS_MAX;
+    mqttPropListInit(ext_ctx->pub_props, pub_types, GMON_MQTT_NUM_PUB_PROPS);
+    ext_ctx->pub_props[1].body.u16 = GMON_MQTT_TOPIC_ALIAS_GARDEN_LOG;
+}
+
 static void mqttSetupCmdConnect(mqttConn_t *mconn, mqttExtendCtx_t *ext_ctx) {
-    mqttProp_t *curr_prop = NULL;
     // if CLEAR flag is set, and if this client have session that is previously created on
     // the MQTT server before, then the server will clean up the previous session.
     mconn->protocol_lvl = MQTT_CONN_PROTOCOL_LEVEL;
     mconn->flgs.clean_session = 0;
-    mconn->keep_alive_sec = MQTT_DEFAULT_KEEPALIVE_SEC;
-    // only allow to handle subscribed inflight message one after another, not concurrently.
-    curr_prop = mqttPropertyCreate(&mconn->props, MQTT_PROP_RECV_MAX);
-    curr_prop->body.u16 = 1;
-    curr_prop = mqttPropertyCreate(&mconn->props, MQTT_PROP_MAX_PKT_SIZE);
-    curr_prop->body.u32 = MQTT_RECV_PKT_MAXBYTES - (MQTT_RECV_PKT_MAXBYTES >> 2);
-    curr_prop = mqttPropertyCreate(&mconn->props, MQTT_PROP_TOPIC_ALIAS_MAX);
-    curr_prop->body.u16 = GMON_MQTT_TOPIC_ALIAS_MAX;
+    mconn->keep_alive_sec = GMON_MQTT_KEEPALIVE_SEC;
+    mconn->props = &ext_ctx->conn_props[0];
     // no will message to send, TODO: support will message in case that a station crashed ?
     mconn->flgs.will_enable = 0;
     mconn->lwt_msg.retain = 0;
@@ -87,29 +121,39 @@ static void mqttSetupCmdDisconnect(mqttPktDisconn_t *disconn) {
     disconn->reason_code = MQTT_REASON_NORMAL_DISCONNECTION;
 }
 
-static void mqttSetupCmdPublish(mqttMsg_t *pubmsg, gmonStr_t *payld, unsigned int exp_interval_ms) {
-    mqttProp_t *curr_prop = NULL;
+static void mqttSetupCmdPublish(
+    mqttMsg_t *pubmsg, mqttExtendCtx_t *ext_ctx, gmonStr_t *payld, unsigned int exp_interval_ms
+) {
     pubmsg->retain = 1;
     pubmsg->duplicate = 0;
     pubmsg->qos = MQTT_QOS_1;
-    curr_prop = mqttPropertyCreate(&pubmsg->props, MQTT_PROP_MSG_EXPIRY_INTVL);
-    curr_prop->body.u32 = (exp_interval_ms << 1) / 1000; // message expiry time in seconds
-    curr_prop = mqttPropertyCreate(&pubmsg->props, MQTT_PROP_TOPIC_ALIAS);
-    curr_prop->body.u16 = GMON_MQTT_TOPIC_ALIAS_GARDEN_LOG;
+    // only message expiry time (in seconds) varies with current reporting interval, which might be
+    // stretched by adaptive reporting
+    ext_ctx->pub_props[0].body.u32 = (exp_interval_ms << 1) / 1000;
+    pubmsg->props = &ext_ctx->pub_props[0];
     pubmsg->topic.len = sizeof(GMON_MQTT_TOPIC_LOG) - 1;
     pubmsg->topic.data = (byte *)GMON_MQTT_TOPIC_LOG;
     pubmsg->app_data_len = payld->nbytes_written;
     pubmsg->buff = payld->data;
 }
 
+// receive maximum in CONNACK properties, 0 if the broker does not announce it
+static word16 mqttGetPeerRecvMax(mqttProp_t *props) {
+    for (mqttProp_t *curr = props; curr != NULL; curr = curr->next) {
+        if (curr->type == MQTT_PROP_RECV_MAX)
+            return curr->body.u16;
+    }
+    return 0;
+}
+
 static void mqttSetupCmdSubscribe(mqttPktSubs_t *subs, mqttExtendCtx_t *ext_ctx) {
     subs->topic_cnt = 1;
     subs->topics = &ext_ctx->subscribe_topic;
     ext_ctx->subscribe_topic.reason_code = MQTT_REASON_SUCCESS;
 }
 
+// properties of CONNECT and PUBLISH command belong to `mqttExtendCtx_t`, detach them without deallocation
 static void mqttCleanCmdConnect(mqttConn_t *mconn) {
-    mqttPropertyDel(mconn->props);
     XMEMSET(mconn, 0x00, sizeof(mqttConn_t));
 }
 
@@ -119,7 +163,6 @@ static void mqttCleanCmdDisconnect(mqttPktDisconn_t *disconn) {
 }
 
 static void mqttCleanCmdPublish(mqttMsg_t *pubmsg) {
-    mqttPropertyDel(pubmsg->props);
     XMEMSET(pubmsg, 0x00, sizeof(mqttMsg_t));
 }
 
@@ -128,7 +171,7 @@ static void mqttCleanCmdSubscribe(mqttPktSubs_t *subs) {
     XMEMSET(subs, 0x00, sizeof(mqttPktSubs_t));
 }
 
-gMonStatus stationNetConnInit(gMonNet_t *net_handle) {
+gMonStatus stationNetConnInit(gMonNet_t *net_handle, gMonArena_t *arena) {
     mqttExtendCtx_t *ext_ctx = NULL;
     if (net_handle == NULL)
         return GMON_RESP_ERRARGS;
@@ -137,10 +180,9 @@ gMonStatus stationNetConnInit(gMonNet_t *net_handle) {
     if (status < 0)
         return status;
 
-    ext_ctx = (mqttExtendCtx_t *)XMALLOC(sizeof(mqttExtendCtx_t));
+    ext_ctx = (mqttExtendCtx_t *)staArenaCalloc(arena, 1, sizeof(mqttExtendCtx_t));
     if (ext_ctx == NULL)
         return GMON_RESP_ERRMEM;
-    XMEMSET(ext_ctx, 0x00, sizeof(mqttExtendCtx_t));
 
     mqttRespStatus mqtt_status = mqttClientInit(&ext_ctx->mctx, GMON_MQTT_CMD_TIMEOUT_MS);
     status = mqttRespToGMonResp(mqtt_status);
@@ -157,11 +199,12 @@ gMonStatus stationNetConnInit(gMonNet_t *net_handle) {
         ext_ctx->subscribe_topic.alias = GMON_MQTT_TOPIC_ALIAS_GARDEN_CTRL;
         ext_ctx->subscribe_topic.filter.data = (byte *)GMON_MQTT_TOPIC_USR_CTRL;
         ext_ctx->subscribe_topic.filter.len = sizeof(GMON_MQTT_TOPIC_USR_CTRL) - 1;
+        mqttSetupPropLists(ext_ctx);
     }
     return status;
 } // end of stationNetConnInit
 
-gMonStatus stationNetConnDeinit(gMonNet_t *net_handle) {
+gMonStatus stationNetConnDeinit(gMonNet_t *net_handle, gMonArena_t *arena) {
     gMonStatus status = GMON_RESP_OK;
     if (net_handle == NULL) {
         status = GMON_RESP_ERRARGS;
@@ -174,7 +217,7 @@ gMonStatus stationNetConnDeinit(gMonNet_t *net_handle) {
                 mctx->drbg = NULL;
             }
             status = mqttRespToGMonResp(mqttClientDeinit(mctx));
-            XFREE(ext_ctx); // Free the allocated mqttExtendCtx_t
+            staArenaFree(arena, ext_ctx);
         }
         net_handle->lowlvl = NULL;
     }
@@ -206,6 +249,8 @@ gMonStatus stationNetConnEstablish(gMonNet_t *net_handle) {
         status = mqttChkReasonCode(connack->reason_code);
         if (status != MQTT_RESP_OK) {
             mctx->err_info.reason_code = connack->reason_code;
+        } else { // the broker limits number of QoS 1 messages in flight
+            staNetConnPubWinSetWindow(&net_handle->pub_win, mqttGetPeerRecvMax(connack->props));
         }
     } else {
         status = MQTT_RESP_ERR_CONN;
@@ -227,14 +272,20 @@ gMonStatus stationNetConnClose(gMonNet_t *net_handle) {
     return mqttRespToGMonResp(status);
 }
 
-gMonStatus stationNetConnSend(gMonNet_t *net_handle, gmonStr_t *app_msg) {
-    if (net_handle == NULL || app_msg == NULL || app_msg->data == NULL || app_msg->len == 0) {
-        return GMON_RESP_ERRARGS;
-    }
+static void mqttCopyCtrlMsg(mqttMsg_t *pubmsg_recv, gmonStr_t *app_msg) {
+    word32 cpy_sz = XMIN(pubmsg_recv->app_data_len, app_msg->len);
+    XMEMCPY(app_msg->data, pubmsg_recv->buff, cpy_sz); // copy payload
+    app_msg->nbytes_written = cpy_sz;
+}
+
+// PUBLISH is sent, then its PUBACK is waited for by the library, packet ID is assigned by the library
+static gMonStatus mqttSendPublishWaitAck(gMonNet_t *net_handle, gmonStr_t *app_msg, unsigned char dup) {
     mqttPktPubResp_t *pubresp = NULL;
     mqttExtendCtx_t  *ext_ctx = (mqttExtendCtx_t *)net_handle->lowlvl;
     mqttCtx_t        *mctx = ext_ctx->mctx;
-    mqttSetupCmdPublish(&mctx->send_pkt.pub_msg, app_msg, net_handle->interval_ms);
+    unsigned int      exp_interval_ms = staNetConnReportIntervalMs(net_handle);
+    mqttSetupCmdPublish(&mctx->send_pkt.pub_msg, ext_ctx, app_msg, exp_interval_ms);
+    mctx->send_pkt.pub_msg.duplicate = dup;
     mqttRespStatus status = mqttSendPublish(mctx, &pubresp);
     if (mctx->send_pkt.pub_msg.qos > MQTT_QOS_0) {
         if (pubresp != NULL) { // check what's in publish response structure
@@ -251,42 +302,127 @@ gMonStatus stationNetConnSend(gMonNet_t *net_handle, gmonStr_t *app_msg) {
     return net_handle->status.sent;
 }
 
-gMonStatus stationNetConnRecv(gMonNet_t *net_handle, gmonStr_t *app_msg) {
+gMonStatus stationNetConnSend(gMonNet_t *net_handle, gmonStr_t *app_msg) {
     if (net_handle == NULL || app_msg == NULL || app_msg->data == NULL || app_msg->len == 0) {
         return GMON_RESP_ERRARGS;
     }
-    mqttPktSuback_t *suback = NULL, *unsuback = NULL;
-    mqttMsg_t       *pubmsg_recv = NULL;
+    return mqttSendPublishWaitAck(net_handle, app_msg, 0);
+}
+
+#ifdef GMON_CFG_MQTT_PIPELINED_PUBLISH
+// packet ID is taken from the MQTT library, it never collides with the commands sent by the library
+unsigned short stationNetConnReservePktId(gMonNet_t *net_handle) {
+    if (net_handle == NULL || net_handle->lowlvl == NULL)
+        return 0;
+    return (unsigned short)mqttGetPktID();
+}
+
+// encode the PUBLISH packet and write it to the connection, PUBACK is collected later by
+// stationNetConnWaitPubAck() so several messages can be in flight at the same time. `pkt_id` has to be
+// reserved by stationNetConnReservePktId()
+gMonStatus stationNetConnPublish(
+    gMonNet_t *net_handle, gmonStr_t *app_msg, unsigned short pkt_id, unsigned char dup
+) {
+    if (net_handle == NULL || app_msg == NULL || app_msg->data == NULL || app_msg->len == 0 || pkt_id == 0) {
+        return GMON_RESP_ERRARGS;
+    }
     mqttExtendCtx_t *ext_ctx = (mqttExtendCtx_t *)net_handle->lowlvl;
     mqttCtx_t       *mctx = ext_ctx->mctx;
-    word32           cpy_sz = 0;
+    mqttMsg_t       *pubmsg = &mctx->send_pkt.pub_msg;
+    mqttRespStatus   status = MQTT_RESP_OK;
+    mqttSetupCmdPublish(pubmsg, ext_ctx, app_msg, staNetConnReportIntervalMs(net_handle));
+    pubmsg->packet_id = pkt_id;
+    pubmsg->duplicate = dup;
+    int pkt_len = mqttEncodePktPublish(mctx->tx_buf, mctx->tx_buf_len, pubmsg);
+    if (pkt_len > 0) {
+        pkt_len = mqttPktWrite(mctx, mctx->tx_buf, pkt_len);
+        if (pkt_len < 0)
+            status = (mqttRespStatus)pkt_len;
+    } else {
+        status = MQTT_RESP_ERR_EXCEED_PKT_SZ;
+    }
+    mqttCleanCmdPublish(pubmsg);
+    net_handle->status.sent = mqttRespToGMonResp(status);
+    return net_handle->status.sent;
+}
+
+// user control message may arrive before the PUBACK, in such case the message is copied to `ctrl_msg`
+// and GMON_RESP_SKIP is returned, the caller applies the message then waits for the same PUBACK again
+gMonStatus stationNetConnWaitPubAck(gMonNet_t *net_handle, unsigned short pkt_id, gmonStr_t *ctrl_msg) {
+    if (net_handle == NULL || net_handle->lowlvl == NULL || pkt_id == 0 || ctrl_msg == NULL ||
+        ctrl_msg->data == NULL || ctrl_msg->len == 0)
+        return GMON_RESP_ERRARGS;
+    void            *pkt_recv = NULL;
+    mqttExtendCtx_t *ext_ctx = (mqttExtendCtx_t *)net_handle->lowlvl;
+    mqttCtx_t       *mctx = ext_ctx->mctx;
+    mqttRespStatus   status = mqttClientWaitPkt(mctx, MQTT_PACKET_TYPE_PUBACK, pkt_id, &pkt_recv);
+    if (status == MQTT_RESP_ERR_CTRL_PKT_TYPE && pkt_recv != NULL) {
+        mqttCopyCtrlMsg((mqttMsg_t *)pkt_recv, ctrl_msg);
+        net_handle->status.recv = GMON_RESP_OK;
+        return GMON_RESP_SKIP;
+    } else if (status == MQTT_RESP_OK) {
+        if (pkt_recv != NULL) {
+            mqttPktPubResp_t *pubresp = (mqttPktPubResp_t *)pkt_recv;
+            status = mqttChkReasonCode(pubresp->reason_code);
+            if (status != MQTT_RESP_OK)
+                mctx->err_info.reason_code = pubresp->reason_code;
+        } else {
+            status = MQTT_RESP_ERR_CONN;
+        }
+    }
+    net_handle->status.sent = mqttRespToGMonResp(status);
+    return net_handle->status.sent;
+}
+#else
+// The library sends PUBLISH and waits for its PUBACK in one call (`mqttSendPublish()`), so each message
+// is acknowledged before stationNetConnPublish() returns, whatever the size of publish window is. Packet
+// ID on the wire is assigned by the library, the ID reserved here only labels the message in the window.
+unsigned short stationNetConnReservePktId(gMonNet_t *net_handle) {
+    if (net_handle == NULL || net_handle->lowlvl == NULL)
+        return 0;
+    mqttExtendCtx_t *ext_ctx = (mqttExtendCtx_t *)net_handle->lowlvl;
+    if (++ext_ctx->next_pub_label == 0)
+        ext_ctx->next_pub_label = 1;
+    return ext_ctx->next_pub_label;
+}
+
+gMonStatus stationNetConnPublish(
+    gMonNet_t *net_handle, gmonStr_t *app_msg, unsigned short pkt_id, unsigned char dup
+) {
+    if (net_handle == NULL || app_msg == NULL || app_msg->data == NULL || app_msg->len == 0 || pkt_id == 0) {
+        return GMON_RESP_ERRARGS;
+    }
+    return mqttSendPublishWaitAck(net_handle, app_msg, dup);
+}
+
+// only messages published successfully are waited for, they were acknowledged already. Control message
+// arriving before the PUBACK is handled by the library.
+gMonStatus stationNetConnWaitPubAck(gMonNet_t *net_handle, unsigned short pkt_id, gmonStr_t *ctrl_msg) {
+    if (net_handle == NULL || net_handle->lowlvl == NULL || pkt_id == 0 || ctrl_msg == NULL ||
+        ctrl_msg->data == NULL || ctrl_msg->len == 0)
+        return GMON_RESP_ERRARGS;
+    return GMON_RESP_OK;
+}
+#endif // end of GMON_CFG_MQTT_PIPELINED_PUBLISH
+
+static mqttRespStatus mqttSubscribeCtrlTopic(mqttCtx_t *mctx, mqttExtendCtx_t *ext_ctx) {
+    mqttPktSuback_t *suback = NULL;
     mqttRespStatus   status = MQTT_RESP_OK;
     mqttSetupCmdSubscribe(&mctx->send_pkt.subs, ext_ctx);
     status = mqttSendSubscribe(mctx, &suback);
     mqttCleanCmdSubscribe(&mctx->send_pkt.subs);
     if (status < 0)
-        goto done;
-    if (suback == NULL) {
-        status = MQTT_RESP_ERR_CONN;
-        goto done;
-    }
+        return status;
+    if (suback == NULL)
+        return MQTT_RESP_ERR_CONN;
     status = mqttChkReasonCode(suback->return_codes[0]); // only subscribe one topic
-    if (status != MQTT_RESP_OK) {
+    if (status != MQTT_RESP_OK)
         mctx->err_info.reason_code = suback->return_codes[0];
-        goto done;
-    }
-    // wait for inflight PUBLISH message
-    mqttModifyReadMsgTimeout(mctx, net_handle->read_timeout_ms);
-    status = mqttClientWaitPkt(mctx, MQTT_PACKET_TYPE_PUBLISH, 0, (void **)&pubmsg_recv);
-    if (status == MQTT_RESP_OK && pubmsg_recv != NULL) {
-        cpy_sz = XMIN(pubmsg_recv->app_data_len, app_msg->len);
-        XMEMCPY(app_msg->data, pubmsg_recv->buff, cpy_sz); // copy payload
-        app_msg->nbytes_written = cpy_sz;
-    } else {
-        mctx->err_info.reason_code = MQTT_REASON_UNSPECIFIED_ERR;
-    }
-    mqttModifyReadMsgTimeout(mctx, GMON_MQTT_CMD_TIMEOUT_MS);
-done: // unsubscribe topic
+    return status;
+}
+
+static void mqttUnsubscribeCtrlTopic(mqttCtx_t *mctx, mqttExtendCtx_t *ext_ctx) {
+    mqttPktSuback_t *unsuback = NULL;
     mqttSetupCmdUnsubscribe(&mctx->send_pkt.unsubs, ext_ctx);
     mqttSendUnsubscribe(mctx, &unsuback);
     mqttCleanCmdUnsubscribe(&mctx->send_pkt.unsubs);
@@ -295,6 +431,64 @@ done: // unsubscribe topic
             mctx->err_info.reason_code = unsuback->return_codes[0];
         }
     }
+}
+
+// wait for inflight PUBLISH message of the subscribed topic
+static mqttRespStatus mqttWaitCtrlMsg(mqttCtx_t *mctx, gmonStr_t *app_msg, unsigned int timeout_ms) {
+    mqttMsg_t     *pubmsg_recv = NULL;
+    mqttRespStatus status = MQTT_RESP_OK;
+    mqttModifyReadMsgTimeout(mctx, timeout_ms);
+    status = mqttClientWaitPkt(mctx, MQTT_PACKET_TYPE_PUBLISH, 0, (void **)&pubmsg_recv);
+    if (status == MQTT_RESP_OK && pubmsg_recv != NULL) {
+        mqttCopyCtrlMsg(pubmsg_recv, app_msg);
+    } else {
+        mctx->err_info.reason_code = MQTT_REASON_UNSPECIFIED_ERR;
+        if (status == MQTT_RESP_OK)
+            status = MQTT_RESP_ERR_CONN;
+    }
+    mqttModifyReadMsgTimeout(mctx, GMON_MQTT_CMD_TIMEOUT_MS);
+    return status;
+}
+
+gMonStatus stationNetConnRecv(gMonNet_t *net_handle, gmonStr_t *app_msg) {
+    if (net_handle == NULL || app_msg == NULL || app_msg->data == NULL || app_msg->len == 0) {
+        return GMON_RESP_ERRARGS;
+    }
+    mqttExtendCtx_t *ext_ctx = (mqttExtendCtx_t *)net_handle->lowlvl;
+    mqttCtx_t       *mctx = ext_ctx->mctx;
+    mqttRespStatus   status = mqttSubscribeCtrlTopic(mctx, ext_ctx);
+    if (status == MQTT_RESP_OK)
+        status = mqttWaitCtrlMsg(mctx, app_msg, net_handle->read_timeout_ms);
+    mqttUnsubscribeCtrlTopic(mctx, ext_ctx);
     net_handle->status.recv = mqttRespToGMonResp(status);
     return net_handle->status.recv;
 } // end of stationNetConnRecv
+
+// subscribe the topic of user control once, for the persistent session
+gMonStatus stationNetConnSubscribe(gMonNet_t *net_handle) {
+    if (net_handle == NULL || net_handle->lowlvl == NULL)
+        return GMON_RESP_ERRARGS;
+    mqttExtendCtx_t *ext_ctx = (mqttExtendCtx_t *)net_handle->lowlvl;
+    return mqttRespToGMonResp(mqttSubscribeCtrlTopic(ext_ctx->mctx, ext_ctx));
+}
+
+// check whether any user control message arrived within `timeout_ms`, GMON_RESP_SKIP means nothing
+// received, network status is updated only when a message arrived or the connection is broken.
+gMonStatus stationNetConnPoll(gMonNet_t *net_handle, gmonStr_t *app_msg, unsigned int timeout_ms) {
+    if (net_handle == NULL || app_msg == NULL || app_msg->data == NULL || app_msg->len == 0) {
+        return GMON_RESP_ERRARGS;
+    }
+    mqttExtendCtx_t *ext_ctx = (mqttExtendCtx_t *)net_handle->lowlvl;
+    mqttRespStatus   status = mqttWaitCtrlMsg(ext_ctx->mctx, app_msg, timeout_ms);
+    if (status == MQTT_RESP_TIMEOUT)
+        return GMON_RESP_SKIP;
+    net_handle->status.recv = mqttRespToGMonResp(status);
+    return net_handle->status.recv;
+}
+
+gMonStatus stationNetConnPing(gMonNet_t *net_handle) {
+    if (net_handle == NULL || net_handle->lowlvl == NULL)
+        return GMON_RESP_ERRARGS;
+    mqttExtendCtx_t *ext_ctx = (mqttExtendCtx_t *)net_handle->lowlvl;
+    return mqttRespToGMonResp(mqttSendPingReq(ext_ctx->mctx));
+}
@@ -0,0 +1,148 @@
+#define GMON_CRITSECT_PROF_INTERNAL
+#include "station_include.h"
+
+typedef struct {
+    gMonProfSite_t *site;
+    uint32_t            start;
+} gmonCritSectFrame_t;
+
+gMonProfSite_t *gmon_critsect_sites = NULL;
+
+static gmonCritSectFrame_t gmon_critsect_frames[GMON_CRITSECT_PROF_MAX_NESTING];
+static unsigned int        gmon_critsect_depth = 0;
+
+static void staProfSiteAdd(gMonProfSite_t *site, uint32_t duration) {
+    unsigned int max_cycles = atomic_load_explicit(&site->max_cycles, memory_order_relaxed), prev_lo = 0;
+    atomic_fetch_add_explicit(&site->count, 1, memory_order_relaxed);
+    prev_lo = atomic_fetch_add_explicit(&site->total_cycles_lo, duration, memory_order_relaxed);
+    if (prev_lo + duration < prev_lo) // carry of lower half goes to upper half
+        atomic_fetch_add_explicit(&site->total_cycles_hi, 1, memory_order_relaxed);
+    while (max_cycles < duration) {
+        if (atomic_compare_exchange_weak_explicit(
+                &site->max_cycles, &max_cycles, duration, memory_order_relaxed, memory_order_relaxed
+            ))
+            break;
+    }
+}
+
+static uint64_t staProfSiteTotalCycles(gMonProfSite_t *site) {
+    unsigned int hi = 0, lo = 0;
+    do {
+        hi = atomic_load_explicit(&site->total_cycles_hi, memory_order_relaxed);
+        lo = atomic_load_explicit(&site->total_cycles_lo, memory_order_relaxed);
+    } while (hi != atomic_load_explicit(&site->total_cycles_hi, memory_order_relaxed));
+    return ((uint64_t)hi << 32) | lo;
+}
+
+void staCritSectProfEnter(gMonProfSite_t *site) {
+    stationSysEnterCritical();
+    if (gmon_critsect_depth < GMON_CRITSECT_PROF_MAX_NESTING) {
+        if (!site->registered) {
+            site->registered = 1;
+            site->next = gmon_critsect_sites;
+            gmon_critsect_sites = site;
+        }
+        gmon_critsect_frames[gmon_critsect_depth].site = site;
+        // read the counter last, so time spent on bookkeeping is left out
+        gmon_critsect_frames[gmon_critsect_depth].start = stationSysGetCycleCount();
+    }
+    gmon_critsect_depth++;
+}
+
+void staCritSectProfExit(void) {
+    uint32_t now = stationSysGetCycleCount(), duration = 0;
+    if (gmon_critsect_depth > 0) {
+        gmon_critsect_depth--;
+        if (gmon_critsect_depth < GMON_CRITSECT_PROF_MAX_NESTING) {
+            gmonCritSectFrame_t *frame = &gmon_critsect_frames[gmon_critsect_depth];
+            duration = now - frame->start; // correct across wrap-around of the counter
+            staProfSiteAdd(frame->site, duration);
+        }
+    }
+    stationSysExitCritical();
+}
+
+static unsigned int staProfReport(gMonProfSite_t *sites, gMonProfStat_t *out, unsigned int max_sites) {
+    gMonProfSite_t *site = NULL;
+    gMonProfStat_t  stat = {0};
+    unsigned int    num_copied = 0, idx = 0, cycles_per_us = stationSysCyclesPerUs();
+    if (out == NULL || max_sites == 0)
+        return 0;
+    if (cycles_per_us == 0)
+        cycles_per_us = 1;
+    for (site = sites; site != NULL; site = site->next) {
+        stat.count = atomic_load_explicit(&site->count, memory_order_relaxed);
+        if (stat.count == 0)
+            continue;
+        stat.func = site->func;
+        stat.line = site->line;
+        stat.max_ns = (unsigned int)((uint64_t)atomic_load_explicit(&site->max_cycles, memory_order_relaxed) *
+                                     1000 / cycles_per_us);
+        stat.avg_ns = (unsigned int)(staProfSiteTotalCycles(site) * 1000 / stat.count / cycles_per_us);
+        // insertion sort, only the longest `max_sites` sites are kept
+        for (idx = num_copied; idx > 0 && out[idx - 1].max_ns < stat.max_ns; idx--) {
+            if (idx < max_sites)
+                out[idx] = out[idx - 1];
+        }
+        if (idx < max_sites) {
+            out[idx] = stat;
+            if (num_copied < max_sites)
+                num_copied++;
+        }
+    }
+    return num_copied;
+}
+
+static void staProfReset(gMonProfSite_t *sites) {
+    for (gMonProfSite_t *site = sites; site != NULL; site = site->next) {
+        atomic_store_explicit(&site->count, 0, memory_order_relaxed);
+        atomic_store_explicit(&site->max_cycles, 0, memory_order_relaxed);
+        atomic_store_explicit(&site->total_cycles_lo, 0, memory_order_relaxed);
+        atomic_store_explicit(&site->total_cycles_hi, 0, memory_order_relaxed);
+    }
+}
+
+unsigned int staCritSectProfReport(gMonProfStat_t *out, unsigned int max_sites) {
+    unsigned int num_copied = 0;
+    stationSysEnterCritical();
+    num_copied = staProfReport(gmon_critsect_sites, out, max_sites);
+    stationSysExitCritical();
+    return num_copied;
+}
+
+void staCritSectProfReset(void) {
+    stationSysEnterCritical();
+    staProfReset(gmon_critsect_sites);
+    stationSysExitCritical();
+}
+
+gMonProfSite_t *_Atomic gmon_prof_scope_sites = NULL;
+
+gMonProfScope_t staProfScopeBegin(gMonProfSite_t *site) {
+    // registration is deferred to the end of the scope, to keep it out of the measurement
+    return (gMonProfScope_t){.site = site, .start = stationSysGetCycleCount()};
+}
+
+// the same function may run in several tasks concurrently, statistics and list of the scopes are
+// updated by atomic operations, without critical section
+void staProfScopeEnd(gMonProfScope_t *scope) {
+    uint32_t        duration = stationSysGetCycleCount() - scope->start;
+    gMonProfSite_t *site = scope->site, *head = NULL;
+    if (!atomic_exchange_explicit(&site->registered, 1, memory_order_relaxed)) {
+        head = atomic_load_explicit(&gmon_prof_scope_sites, memory_order_relaxed);
+        do {
+            site->next = head;
+        } while (!atomic_compare_exchange_weak_explicit(
+            &gmon_prof_scope_sites, &head, site, memory_order_release, memory_order_relaxed
+        ));
+    }
+    staProfSiteAdd(site, duration);
+}
+
+unsigned int staProfScopeReport(gMonProfStat_t *out, unsigned int max_sites) {
+    return staProfReport(atomic_load_explicit(&gmon_prof_scope_sites, memory_order_acquire), out, max_sites);
+}
+
+void staProfScopeReset(void) {
+    staProfReset(atomic_load_explicit(&gmon_prof_scope_sites, memory_order_acquire));
+}
@@ -0,0 +1,52 @@
+#include "station_include.h"
+
+// read buffer is reallocated only when number of sensors or resamples is changed by remote user
+#define GMON_SENSOR_PIPELINE_DEFINE( \
+    name, meta_t, field, base_field, sfx, evt_type, detect_noise, read_fn, dev_field, trig_fn, interval_fn, \
+    hook_fn \
+) \
+    gMonStatus staSensorPipeline##name(gardenMonitor_t *gmon, gmonSensorSamples_t *read_vals) { \
+        meta_t           *sensor = &gmon->sensors.field; \
+        gMonSensorMeta_t *base = &gmon->sensors.base_field; \
+        gmonEvent_t      *event = NULL; \
+        gMonStatus        status = GMON_RESP_OK; \
+        unsigned int      acquired_ms = 0, detected_ms = 0; \
+        hook_fn(gmon, sensor); \
+        *read_vals = staAllocSensorSampleBuffer##sfx(*read_vals, base); \
+        if (read_vals->entries == NULL) \
+            return GMON_RESP_ERRMEM; \
+        status = read_fn(sensor, read_vals->entries); \
+        if (status != GMON_RESP_OK) \
+            return status; \
+        acquired_ms = GMON_EVT_LATENCY_NOW_MS(); \
+        if (detect_noise) { \
+            status = staSensorDetectNoise##sfx(base, read_vals->entries); \
+            if (status != GMON_RESP_OK) \
+                return status; \
+        } \
+        detected_ms = GMON_EVT_LATENCY_NOW_MS(); \
+        event = staAllocSensorEvent(&gmon->sensors.event, evt_type, base->num_items); \
+        if (event == NULL) \
+            return GMON_RESP_ERRMEM; \
+        GMON_EVT_LATENCY_BEGIN(event, acquired_ms, detected_ms); \
+        status = staSensorSampleToEvent##sfx(event, read_vals->entries); \
+        XASSERT(status == GMON_RESP_OK); \
+        GMON_EVT_LATENCY_STAMP(event, GMON_EVT_STAGE_AGGREGATE); \
+        status = trig_fn(&gmon->actuator.dev_field, event, sensor); \
+        (void)status; \
+        GMON_EVT_LATENCY_STAMP(event, GMON_EVT_STAGE_TRIGGER); \
+        /* always pass event to message pipe regardless of actuator's return value */ \
+        event->curr_ticks = stationGetTicksPerDay(&gmon->tick); \
+        event->curr_days = stationGetDays(&gmon->tick); \
+        return staNotifyOthersWithEvent(gmon, event, 0); \
+    } \
+    unsigned int staSensorPipeInterval##name(gardenMonitor_t *gmon) { \
+        return interval_fn(gmon, &gmon->sensors.field); \
+    }
+GMON_SENSOR_PIPELINES(GMON_SENSOR_PIPELINE_DEFINE)
+
+#define GMON_SENSOR_PIPELINE_ENTRY(name, ...) \
+    {.run = staSensorPipeline##name, .interval_ms = staSensorPipeInterval##name},
+const gMonSensorPipeline_t gmon_sensor_pipelines[GMON_NUM_SENSOR_PIPELINES] = {
+    GMON_SENSOR_PIPELINES(GMON_SENSOR_PIPELINE_ENTRY)
+};
@@ -0,0 +1,194 @@
+#include "station_include.h"
+
+// Single task runs all sensor pipelines in order of their deadlines. Next read time of a pipeline is
+// advanced from its previous deadline (not from the time the pipeline finished), so the reads do not
+// drift with execution time of the pipelines. Read interval is evaluated each time after the pipeline
+// ran, fast-poll divisor of soil sensors is honored in the next read once the pump is switched on.
+// Interval changed by remote user is checked on every wakeup, the deadline of the pipeline is moved
+// to its last read time plus the new interval at once.
+//
+// Pipelines are not preempted by each other. When several of them are due, the one listed earlier in
+// GMON_SENSOR_PIPELINES() runs first, so start of soil moisture pipeline (which drives the pump) is
+// delayed by at most one run of another pipeline, see `stats.max_lag_ms`. None of the pipelines waits
+// for sensor warm-up, the longest run is reading air sensors, about 18 ms start signal plus 5 ms frame
+// for each resample round (and for each sensor unless GMON_CFG_AIR_SENSOR_CONCURRENT_READ is enabled).
+
+// time comparison still works after the tick counter wraps around
+static unsigned char staSensorSchedBefore(gMonSensorSchedEntry_t *a, gMonSensorSchedEntry_t *b) {
+    return (int)(a->due_ms - b->due_ms) < 0;
+}
+
+static void staSensorSchedSwap(gMonSensorSchedEntry_t *a, gMonSensorSchedEntry_t *b) {
+    gMonSensorSchedEntry_t tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+static void staSensorSchedSiftUp(gMonSensorSched_t *sched, unsigned char idx) {
+    while (idx > 0) {
+        unsigned char parent = (idx - 1) >> 1;
+        if (!staSensorSchedBefore(&sched->heap[idx], &sched->heap[parent]))
+            break;
+        staSensorSchedSwap(&sched->heap[idx], &sched->heap[parent]);
+        idx = parent;
+    }
+}
+
+static unsigned char staSensorSchedSiftDown(gMonSensorSched_t *sched, unsigned char idx) {
+    unsigned char moved = 0;
+    while (1) {
+        unsigned char left = (idx << 1) + 1, right = left + 1, earliest = idx;
+        if (left < sched->len && staSensorSchedBefore(&sched->heap[left], &sched->heap[earliest]))
+            earliest = left;
+        if (right < sched->len && staSensorSchedBefore(&sched->heap[right], &sched->heap[earliest]))
+            earliest = right;
+        if (earliest == idx)
+            break;
+        staSensorSchedSwap(&sched->heap[idx], &sched->heap[earliest]);
+        idx = earliest;
+        moved = 1;
+    }
+    return moved;
+}
+
+// restore heap order after deadline of the entry at `idx` changed
+static void staSensorSchedRekey(gMonSensorSched_t *sched, unsigned char idx) {
+    if (!staSensorSchedSiftDown(sched, idx))
+        staSensorSchedSiftUp(sched, idx);
+}
+
+// interval of disabled sensor might be zero, limit it to valid range of read interval
+static unsigned int
+staSensorSchedInterval(gMonSensorSched_t *sched, gardenMonitor_t *gmon, unsigned char idx) {
+    unsigned int interval_ms = sched->pipelines[idx].interval_ms(gmon);
+    if (interval_ms == 0)
+        interval_ms = GMON_MIN_SENSOR_READ_INTERVAL_MS;
+    else if (interval_ms > GMON_MAX_SENSOR_READ_INTERVAL_MS)
+        interval_ms = GMON_MAX_SENSOR_READ_INTERVAL_MS;
+    return interval_ms;
+}
+
+gMonStatus staSensorSchedInit(
+    gMonSensorSched_t *sched, gardenMonitor_t *gmon, const gMonSensorPipeline_t *pipelines,
+    unsigned char num_pipelines, unsigned int now_ms
+) {
+    if (sched == NULL || gmon == NULL || pipelines == NULL || num_pipelines == 0 ||
+        num_pipelines > GMON_NUM_SENSOR_PIPELINES)
+        return GMON_RESP_ERRARGS;
+    XMEMSET(sched, 0x00, sizeof(gMonSensorSched_t));
+    sched->pipelines = pipelines;
+    // same as previous tasks for each sensor, first read starts after one interval
+    for (unsigned char idx = 0; idx < num_pipelines; idx++) {
+        sched->heap[idx].idx = idx;
+        sched->heap[idx].interval_ms = staSensorSchedInterval(sched, gmon, idx);
+        sched->heap[idx].due_ms = now_ms + sched->heap[idx].interval_ms;
+        sched->len++;
+        staSensorSchedSiftUp(sched, idx);
+    }
+    return GMON_RESP_OK;
+}
+
+void staSensorSchedDeinit(gMonSensorSched_t *sched) {
+    if (sched == NULL)
+        return;
+    for (unsigned char idx = 0; idx < GMON_NUM_SENSOR_PIPELINES; idx++) {
+        if (sched->read_vals[idx].entries != NULL)
+            XMEMFREE(sched->read_vals[idx].entries);
+    }
+    XMEMSET(sched, 0x00, sizeof(gMonSensorSched_t));
+}
+
+// time to wait until the earliest deadline, zero if any pipeline is due
+unsigned int staSensorSchedWaitMs(gMonSensorSched_t *sched, unsigned int now_ms) {
+    if (sched == NULL || sched->len == 0)
+        return GMON_MAX_SENSOR_READ_INTERVAL_MS;
+    int remain = (int)(sched->heap[0].due_ms - now_ms);
+    return (remain > 0) ? (unsigned int)remain : 0;
+}
+
+static unsigned int staSensorSchedNowMs(void) {
+    return stationSysGetTickCount() * GMON_NUM_MILLISECONDS_PER_TICK;
+}
+
+// move deadline of the pipelines whose interval was changed since they were scheduled
+static void staSensorSchedRefresh(gMonSensorSched_t *sched, gardenMonitor_t *gmon, unsigned int now_ms) {
+    unsigned char pos = 0, changed = 0;
+    for (pos = 0; pos < sched->len; pos++) {
+        gMonSensorSchedEntry_t *entry = &sched->heap[pos];
+        unsigned int            interval_ms = staSensorSchedInterval(sched, gmon, entry->idx);
+        if (interval_ms == entry->interval_ms)
+            continue;
+        // from the last read time
+        entry->due_ms += interval_ms - entry->interval_ms;
+        entry->interval_ms = interval_ms;
+        if ((int)(entry->due_ms - now_ms) < 0)
+            entry->due_ms = now_ms;
+        changed = 1;
+    }
+    if (changed) {
+        for (pos = sched->len >> 1; pos > 0; pos--)
+            staSensorSchedSiftDown(sched, pos - 1);
+    }
+}
+
+// highest-priority pipeline among those due, the heap root is always due if any of them is
+static unsigned char staSensorSchedPickDue(gMonSensorSched_t *sched, unsigned int now_ms) {
+    unsigned char picked = 0;
+    for (unsigned char pos = 1; pos < sched->len; pos++) {
+        if ((int)(sched->heap[pos].due_ms - now_ms) <= 0 && sched->heap[pos].idx < sched->heap[picked].idx)
+            picked = pos;
+    }
+    return picked;
+}
+
+// run all the pipelines due at given time, return number of pipelines which have been run
+unsigned int staSensorSchedRunDue(gMonSensorSched_t *sched, gardenMonitor_t *gmon, unsigned int now_ms) {
+    unsigned int num_run = 0;
+    if (sched == NULL || gmon == NULL)
+        return 0;
+    staSensorSchedRefresh(sched, gmon, now_ms);
+    while (sched->len > 0 && staSensorSchedWaitMs(sched, now_ms) == 0) {
+        unsigned char           pos = staSensorSchedPickDue(sched, now_ms);
+        gMonSensorSchedEntry_t *entry = &sched->heap[pos];
+        gMonStatus              status = GMON_RESP_OK;
+        unsigned int            lag_ms = staSensorSchedNowMs() - entry->due_ms;
+        lag_ms = ((int)lag_ms > 0) ? lag_ms : 0;
+        if (sched->stats.max_lag_ms[entry->idx] < lag_ms)
+            sched->stats.max_lag_ms[entry->idx] = lag_ms;
+        // errors are handled in the pipeline, the sensors are read again in next interval
+        GMON_TRACE(SENSOR, SENSOR_PIPELINE_BEGIN, entry->idx);
+        status = sched->pipelines[entry->idx].run(gmon, &sched->read_vals[entry->idx]);
+        GMON_TRACE(SENSOR, SENSOR_PIPELINE_END, status);
+        entry->interval_ms = staSensorSchedInterval(sched, gmon, entry->idx);
+        entry->due_ms += entry->interval_ms;
+        if ((int)(entry->due_ms - now_ms) <= 0) {
+            entry->due_ms = now_ms + entry->interval_ms;
+            sched->stats.num_late++;
+        }
+        staSensorSchedRekey(sched, pos);
+        num_run++;
+    }
+    sched->stats.num_runs += num_run;
+    return num_run;
+}
+
+void stationSensorSchedTaskFn(void *params) {
+    gardenMonitor_t  *gmon = (gardenMonitor_t *)params;
+    gMonSensorSched_t sched = {0};
+    unsigned int      wake_ms = staSensorSchedNowMs();
+    gMonStatus        status =
+        staSensorSchedInit(&sched, gmon, gmon_sensor_pipelines, GMON_NUM_SENSOR_PIPELINES, wake_ms);
+    XASSERT(status == GMON_RESP_OK);
+    while (1) {
+        // wake up exactly at the earliest deadline, regardless of time spent in the pipelines. The
+        // interval will be updated by network handling task during runtime, the sleep is limited so the
+        // new interval takes effect without waiting for the deadline scheduled with the old one.
+        unsigned int wait_ms = staSensorSchedWaitMs(&sched, wake_ms);
+        if (wait_ms > GMON_SENSOR_SCHED_MAX_SLEEP_MS)
+            wait_ms = GMON_SENSOR_SCHED_MAX_SLEEP_MS;
+        stationSysDelayUntilMs(&wake_ms, wait_ms);
+        // the task never sleeps for long, wraps of the cycle counter for trace timestamps are counted here
+        GMON_TRACE_CLOCK_UPDATE();
+        staSensorSchedRunDue(&sched, gmon, staSensorSchedNowMs());
+    }
+}
@@ -1,26 +1,62 @@
 #include "station_include.h"
 
-static gardenMonitor_t *garden_monitor;
+// Station context and all long-lived objects created at initialization are allocated from static arena,
+// so total RAM taken by the station is known at link time, and boot never fails due to heap fragmentation.
+// The context is not on stack of `main()`, which is reused by interrupt handlers once the RTOS scheduler
+// starts on Cortex-M.
+static uint64_t station_arena_mem[(GMON_CFG_INIT_ARENA_NBYTES + sizeof(gardenMonitor_t) + 7) >> 3];
+
+// the only reference of station context outside the tasks, assertion failure in RTOS kernel (see
+// `configASSERT()`) does not come with any context, the station handles it after initialization completed.
+static gardenMonitor_t *station_on_failure;
 
 void stationFailureHandler(unsigned int *func_pc) {
+    gardenMonitor_t *gmon = station_on_failure;
+    if (gmon == NULL)
+        return;
     gMonDisplayFailure_t c = {
-        .curr_ticks = stationGetTicksPerDay(&garden_monitor->tick),
-        .curr_days = stationGetDays(&garden_monitor->tick),
+        .curr_ticks = stationGetTicksPerDay(&gmon->tick),
+        .curr_days = stationGetDays(&gmon->tick),
         .func_pc = func_pc,
-        .status = staEmergencyShutdownAllActuators(garden_monitor),
+        .status = staEmergencyShutdownAllActuators(gmon),
     };
-    staDisplayFailure(&garden_monitor->display, c);
+    staDisplayFailure(&gmon->display, c);
 }
 
 static gMonStatus stationInit(gardenMonitor_t **gmon) {
     if (gmon == NULL)
         return GMON_RESP_ERRARGS;
-    gMonStatus status = GMON_RESP_OK;
-    *gmon = XCALLOC(sizeof(gardenMonitor_t), 0x1);
-    status = stationNetConnInit(&(*gmon)->netconn);
+    gMonStatus  status = GMON_RESP_OK;
+    gMonArena_t arena = {0};
+    status = staArenaInit(&arena, station_arena_mem, sizeof(station_arena_mem));
+    if (status < 0)
+        goto done;
+    *gmon = staArenaCalloc(&arena, 1, sizeof(gardenMonitor_t));
+    if (*gmon == NULL) {
+        status = GMON_RESP_ERRMEM;
+        goto done;
+    }
+    // the context keeps the arena from now on, including space taken by itself
+    (*gmon)->arena = arena;
+    status = stationNetConnInit(&(*gmon)->netconn, &(*gmon)->arena);
+    if (status < 0)
+        goto done;
+#ifdef GMON_CFG_NETCONN_BACKLOG_SPILL
+    void                          *spill_ctx = NULL;
+    const gMonNetBacklogStorage_t *spill = staPlatformGetNetBacklogStorage(&spill_ctx);
+    status = staNetConnBacklogInit(&(*gmon)->netconn.backlog, spill, spill_ctx);
+#else
+    status = staNetConnBacklogInit(&(*gmon)->netconn.backlog, NULL, NULL);
+#endif
+    if (status < 0)
+        goto done;
+    status = staNetConnPubWinInit(&(*gmon)->netconn.pub_win);
     if (status < 0)
         goto done;
     status = stationSysInit();
+    if (status < 0)
+        goto done;
+    status = GMON_TRACE_INIT();
     if (status < 0)
         goto done;
     status = staAppMsgInit(*gmon);
@@ -43,10 +79,12 @@ static gMonStatus stationDeinit(gardenMonitor_t *gmon) {
     gMonStatus status = GMON_RESP_OK;
     status = staDisplayDeInit(gmon);
     status = stationIOdeinit(gmon);
-    status = stationNetConnDeinit(&gmon->netconn);
+    status = staNetConnPubWinDeinit(&gmon->netconn.pub_win);
+    status = staNetConnBacklogDeinit(&gmon->netconn.backlog);
+    status = stationNetConnDeinit(&gmon->netconn, &gmon->arena);
     status = stationPlatformDeinit();
     status = staAppMsgDeinit(gmon);
-    XMEMFREE(gmon);
+    staArenaReset(&gmon->arena);
     return status;
 }
 
@@ -62,28 +100,13 @@ static void stationInitTaskFn(void *param) {
     const unsigned char isPrivileged = 0x1;
 
     task_ptr = NULL;
-    task_stack_size = 0x80; // Use same stack size as sensorReader for consistency
+    // single task reads from all types of sensors, with a bit more stack for the scheduler
+    task_stack_size = 0xa0;
     stationSysCreateTask(
-        "pumpCtrler", (stationSysTaskFn_t)pumpControllerTaskFn, (void *)gmon, task_stack_size,
+        "sensorSched", (stationSysTaskFn_t)stationSensorSchedTaskFn, (void *)gmon, task_stack_size,
         GMON_TASKS_PRIO_MIN, isPrivileged, &task_ptr
     );
-    gmon->tasks.pump_controller = (void *)task_ptr;
-
-    task_ptr = NULL;
-    task_stack_size = 0x80;
-    stationSysCreateTask(
-        "airMonitor", (stationSysTaskFn_t)airQualityMonitorTaskFn, (void *)gmon, task_stack_size,
-        GMON_TASKS_PRIO_MIN, isPrivileged, &task_ptr
-    );
-    gmon->tasks.air_quality_monitor = (void *)task_ptr;
-
-    task_ptr = NULL;
-    task_stack_size = 0x80;
-    stationSysCreateTask(
-        "lightCtrler", (stationSysTaskFn_t)lightControllerTaskFn, (void *)gmon, task_stack_size,
-        GMON_TASKS_PRIO_MIN, isPrivileged, &task_ptr
-    );
-    gmon->tasks.light_controller = (void *)task_ptr;
+    gmon->tasks.sensor_sched = (void *)task_ptr;
 
     task_ptr = NULL;
     task_stack_size = 0x38;
@@ -125,14 +148,16 @@ static void stationCreateWorkingTasks(gardenMonitor_t *gmon) {
 }
 
 int main(int argc, char **argv) {
-    gMonStatus status = GMON_RESP_OK;
-    garden_monitor = NULL;
-    status = stationInit(&garden_monitor);
+    (void)argc;
+    (void)argv;
+    gardenMonitor_t *gmon = NULL;
+    gMonStatus       status = stationInit(&gmon);
     if (status == GMON_RESP_OK) {
-        XASSERT(garden_monitor != NULL);
-        stationCreateWorkingTasks(garden_monitor);
+        XASSERT(gmon != NULL);
+        station_on_failure = gmon;
+        stationCreateWorkingTasks(gmon);
     } else { // terminate immediately on initialization failure
-        stationDeinit(garden_monitor);
+        stationDeinit(gmon);
     }
     XASSERT(0);
     return 0;
@@ -1,4 +1,6 @@
 #include "station_include.h"
+#include "FreeRTOS.h"
+#include "task.h"
 
 gMonStatus staSysCvtResp(int resp_in) {
     gMonStatus resp_out = GMON_RESP_OK;
@@ -46,8 +48,34 @@ gMonStatus stationSysTaskDelete(stationSysTask_t *task_ptr) {
     return (response == espOK ? GMON_RESP_OK : GMON_RESP_ERR);
 } // end of stationSysTaskDelete
 
+unsigned int stationSysGetTaskStackFree(stationSysTask_t task) {
+    if (task == NULL)
+        return 0;
+    return (unsigned int)uxTaskGetStackHighWaterMark((TaskHandle_t)task);
+}
+
+unsigned int stationSysGetHeapFree(void) { return (unsigned int)xPortGetFreeHeapSize(); }
+
+unsigned int stationSysGetHeapMinFree(void) { return (unsigned int)xPortGetMinimumEverFreeHeapSize(); }
+
 gMonStatus stationSysInit(void) { return stationPlatformInit(); }
 
 gMonStatus stationSysDelayUs(unsigned short time_us) {
     return staPlatformDelayUs(time_us);
 } // end of stationSysDelayUs
+
+// `prev_wake_ms` is advanced by the period on return, so the period does not include the time spent by
+// the caller between two delays. The task sleeps in vTaskDelayUntil() from the previous wakeup tick, a
+// relative delay computed from the tick read here would be stretched if the task is preempted before
+// it goes to sleep.
+gMonStatus stationSysDelayUntilMs(unsigned int *prev_wake_ms, unsigned int period_ms) {
+    if (prev_wake_ms == NULL)
+        return GMON_RESP_ERRARGS;
+    unsigned int now_ms = uiESPsysGetTickCount() * GMON_NUM_MILLISECONDS_PER_TICK;
+    unsigned int remain_ms = staNextWakeupMs(prev_wake_ms, period_ms, now_ms);
+    if (remain_ms == 0) // wakeup time has passed
+        return GMON_RESP_SKIP;
+    TickType_t prev_wake_tick = (TickType_t)((*prev_wake_ms - period_ms) / GMON_NUM_MILLISECONDS_PER_TICK);
+    vTaskDelayUntil(&prev_wake_tick, (TickType_t)(period_ms / GMON_NUM_MILLISECONDS_PER_TICK));
+    return GMON_RESP_OK;
+} // end of stationSysDelayUntilMs
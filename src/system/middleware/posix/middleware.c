@@ -0,0 +1,472 @@
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <limits.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include "station_include.h"
+
+// Each task runs in its own POSIX thread, scheduling is left to the host kernel. Critical sections of
+// RTOS port disable interrupts of the whole CPU, here they are mapped to one process-wide recursive
+// mutex so nested critical sections in the application still work.
+//
+// Tasks are driven by wall-clock time by default. If environment variable `GMON_SIM_TIME_WARP` is set,
+// they are driven by a discrete-event virtual clock instead : computation takes no time, and once all
+// the tasks are blocked (in delay functions or message boxes), the clock jumps to the earliest deadline
+// among them, so a day of station operation is simulated in seconds.
+
+#define SYS_NUM_BYTES_PER_STACK_WORD 4
+#define SYS_TASK_NAME_MAXLEN         16 // including NULL terminator, limit of Linux thread names
+
+struct staSysTask_s {
+    pthread_t          thread;
+    stationSysTaskFn_t fn;
+    void              *args;
+    char               name[SYS_TASK_NAME_MAXLEN];
+};
+
+struct staSysMsgbox_s {
+    pthread_mutex_t *lock; // lock of virtual clock is shared by all message boxes in time-warp mode
+    pthread_mutex_t  own_lock;
+    pthread_cond_t   not_empty;
+    pthread_cond_t   not_full;
+    void           **items;
+    size_t           capacity;
+    size_t           head; // index of the oldest item
+    size_t           count;
+};
+
+// thread blocked on virtual clock
+typedef struct sys_vwaiter_s {
+    pthread_cond_t       *cond;
+    uint64_t              deadline_ms; // UINT64_MAX waits forever
+    unsigned char         woken;
+    struct sys_vwaiter_s *next;
+} sys_vwaiter_t;
+
+typedef struct {
+    pthread_mutex_t lock;
+    uint64_t        now_ms;
+    unsigned int    num_threads; // number of threads driven by the clock, including the main thread
+    unsigned int    num_blocked;
+    unsigned int    num_advances;
+    sys_vwaiter_t  *waiters;
+    unsigned char   enabled;
+} sys_vclock_t;
+
+static pthread_mutex_t sys_critical_lock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+static pthread_once_t  sys_clock_once = PTHREAD_ONCE_INIT;
+static struct timespec sys_clock_start;
+static sys_vclock_t    sys_vclock = {.lock = PTHREAD_MUTEX_INITIALIZER};
+// handle of the task running in current thread, for deleting the task by itself
+static __thread stationSysTask_t sys_curr_task;
+
+static void staSysClockInit(void) {
+    const char *warp_env = getenv("GMON_SIM_TIME_WARP");
+    clock_gettime(CLOCK_MONOTONIC, &sys_clock_start);
+    sys_vclock.enabled = (warp_env != NULL && warp_env[0] != 0x0 && warp_env[0] != '0');
+    sys_vclock.num_threads = 1; // the main thread
+}
+
+static unsigned char staSysVClockEnabled(void) {
+    pthread_once(&sys_clock_once, staSysClockInit);
+    return sys_vclock.enabled;
+}
+
+static uint64_t staSysWallClockMs(void) {
+    struct timespec now = {0};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)(now.tv_sec - sys_clock_start.tv_sec) * 1000 +
+           (now.tv_nsec - sys_clock_start.tv_nsec) / 1000000;
+}
+
+static uint64_t staSysVClockNowMs(void) {
+    pthread_mutex_lock(&sys_vclock.lock);
+    uint64_t now_ms = sys_vclock.now_ms;
+    pthread_mutex_unlock(&sys_vclock.lock);
+    return now_ms;
+}
+
+static void staSysVClockWakeOne(sys_vwaiter_t *waiter) {
+    waiter->woken = 1;
+    sys_vclock.num_blocked--;
+    pthread_cond_broadcast(waiter->cond);
+}
+
+// caller has to hold lock of the clock, time advances only if no thread can make progress
+static void staSysVClockAdvance(void) {
+    sys_vwaiter_t *waiter = NULL;
+    while (sys_vclock.num_threads > 0 && sys_vclock.num_blocked == sys_vclock.num_threads) {
+        uint64_t next_ms = UINT64_MAX;
+        for (waiter = sys_vclock.waiters; waiter != NULL; waiter = waiter->next) {
+            if (!waiter->woken && waiter->deadline_ms < next_ms)
+                next_ms = waiter->deadline_ms;
+        }
+        if (next_ms == UINT64_MAX) // all threads wait for each other, nothing will happen
+            return;
+        if (sys_vclock.now_ms < next_ms) {
+            sys_vclock.now_ms = next_ms;
+            sys_vclock.num_advances++;
+        }
+        for (waiter = sys_vclock.waiters; waiter != NULL; waiter = waiter->next) {
+            if (!waiter->woken && waiter->deadline_ms <= sys_vclock.now_ms)
+                staSysVClockWakeOne(waiter);
+        }
+    }
+} // end of staSysVClockAdvance
+
+// wake all threads blocked on `cond` without waiting for deadline, caller has to hold lock of the clock
+static void staSysVClockSignal(pthread_cond_t *cond) {
+    for (sys_vwaiter_t *waiter = sys_vclock.waiters; waiter != NULL; waiter = waiter->next) {
+        if (!waiter->woken && waiter->cond == cond)
+            staSysVClockWakeOne(waiter);
+    }
+}
+
+static void staSysVClockUnlinkWaiter(void *arg) {
+    sys_vwaiter_t  *waiter = arg;
+    sys_vwaiter_t **curr = &sys_vclock.waiters;
+    while (*curr != NULL && *curr != waiter)
+        curr = &(*curr)->next;
+    if (*curr != NULL)
+        *curr = waiter->next;
+    if (!waiter->woken) // the thread is cancelled while blocked
+        sys_vclock.num_blocked--;
+}
+
+static void staSysVClockCancelWait(void *arg) {
+    staSysVClockUnlinkWaiter(arg);
+    pthread_mutex_unlock(&sys_vclock.lock);
+}
+
+// block the calling thread until `cond` is signaled or the deadline passed, return non-zero on timeout.
+// caller has to hold lock of the clock
+static int staSysVClockWait(pthread_cond_t *cond, uint64_t deadline_ms) {
+    sys_vwaiter_t waiter = {.cond = cond, .deadline_ms = deadline_ms, .next = sys_vclock.waiters};
+    sys_vclock.waiters = &waiter;
+    sys_vclock.num_blocked++;
+    staSysVClockAdvance();
+    pthread_cleanup_push(staSysVClockCancelWait, &waiter);
+    while (!waiter.woken)
+        pthread_cond_wait(cond, &sys_vclock.lock);
+    pthread_cleanup_pop(0);
+    staSysVClockUnlinkWaiter(&waiter);
+    return sys_vclock.now_ms >= deadline_ms;
+}
+
+static void staSysVClockSleep(uint64_t time_ms) {
+    pthread_cond_t cond;
+    pthread_cond_init(&cond, NULL);
+    pthread_mutex_lock(&sys_vclock.lock);
+    staSysVClockWait(&cond, sys_vclock.now_ms + time_ms);
+    pthread_mutex_unlock(&sys_vclock.lock);
+    pthread_cond_destroy(&cond);
+}
+
+// threads join or leave the clock, time is not advanced while any of them is running
+static void staSysVClockJoin(void) {
+    if (!staSysVClockEnabled())
+        return;
+    pthread_mutex_lock(&sys_vclock.lock);
+    sys_vclock.num_threads++;
+    pthread_mutex_unlock(&sys_vclock.lock);
+}
+
+static void staSysVClockLeave(void) {
+    if (!staSysVClockEnabled())
+        return;
+    pthread_mutex_lock(&sys_vclock.lock);
+    sys_vclock.num_threads--;
+    staSysVClockAdvance();
+    pthread_mutex_unlock(&sys_vclock.lock);
+}
+
+uint32_t staSysGetTickCount(void) {
+    uint64_t elapsed_ms = staSysVClockEnabled() ? staSysVClockNowMs() : staSysWallClockMs();
+    // wraps around in the same way as tick counter of RTOS port
+    return (uint32_t)elapsed_ms;
+}
+
+uint32_t staSysGetTimestampUs(void) {
+    struct timespec now = {0};
+    if (staSysVClockEnabled()) // nothing happens between advances of virtual clock
+        return (uint32_t)(staSysVClockNowMs() * 1000);
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((uint64_t)(now.tv_sec - sys_clock_start.tv_sec) * 1000000 +
+                      (now.tv_nsec - sys_clock_start.tv_nsec) / 1000);
+}
+
+uint32_t staSysGetCycleCount(void) {
+    struct timespec now = {0};
+    clock_gettime(CLOCK_MONOTONIC_RAW, &now);
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000000 + now.tv_nsec);
+}
+
+void staSysEnterCritical(void) { pthread_mutex_lock(&sys_critical_lock); }
+
+void staSysExitCritical(void) { pthread_mutex_unlock(&sys_critical_lock); }
+
+static void staSysSleepNs(int64_t time_ns) {
+    struct timespec req = {.tv_sec = time_ns / 1000000000, .tv_nsec = time_ns % 1000000000}, rem = {0};
+    while (nanosleep(&req, &rem) != 0 && errno == EINTR)
+        req = rem;
+}
+
+void staSysDelayMs(unsigned int time_ms) {
+    if (!staSysVClockEnabled())
+        staSysSleepNs((int64_t)time_ms * 1000000);
+    else if (time_ms > 0)
+        staSysVClockSleep(time_ms);
+}
+
+// below resolution of virtual clock, it does not take any time in time-warp mode
+gMonStatus stationSysDelayUs(unsigned short time_us) {
+    return staSysVClockEnabled() ? GMON_RESP_OK : staPlatformDelayUs(time_us);
+}
+
+// similar to vTaskDelayUntil() in FreeRTOS, `prev_wake_ms` is advanced by the period on return, so the
+// period does not include the time spent by the caller between two delays.
+gMonStatus stationSysDelayUntilMs(unsigned int *prev_wake_ms, unsigned int period_ms) {
+    if (prev_wake_ms == NULL)
+        return GMON_RESP_ERRARGS;
+    unsigned int now_ms = staSysGetTickCount() * GMON_NUM_MILLISECONDS_PER_TICK;
+    unsigned int remain_ms = staNextWakeupMs(prev_wake_ms, period_ms, now_ms);
+    if (remain_ms == 0) // wakeup time has passed
+        return GMON_RESP_SKIP;
+    staSysDelayMs(remain_ms);
+    return GMON_RESP_OK;
+} // end of stationSysDelayUntilMs
+
+static void *staSysTaskEntry(void *arg) {
+    sys_curr_task = (stationSysTask_t)arg;
+    sys_curr_task->fn(sys_curr_task->args);
+    staSysVClockLeave();
+    return NULL;
+}
+
+gMonStatus stationSysCreateTask(
+    const char *task_name, stationSysTaskFn_t task_fp, void *const args, size_t stack_sz, uint32_t prio,
+    uint8_t isPrivileged, stationSysTask_t *task_ptr
+) {
+    (void)prio;
+    (void)isPrivileged;
+    if (task_fp == NULL || task_ptr == NULL)
+        return GMON_RESP_ERRARGS;
+    gMonStatus       status = GMON_RESP_OK;
+    pthread_attr_t   attr;
+    stationSysTask_t task = XCALLOC(sizeof(struct staSysTask_s), 0x1);
+    if (task == NULL)
+        return GMON_RESP_ERRMEM;
+    task->fn = task_fp;
+    task->args = args;
+    if (task_name != NULL)
+        strncpy(task->name, task_name, SYS_TASK_NAME_MAXLEN - 1);
+    // stack size of the RTOS tasks is too small for C library functions on the host, e.g. printf()
+    stack_sz = stack_sz * SYS_NUM_BYTES_PER_STACK_WORD + PTHREAD_STACK_MIN;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, stack_sz);
+    staSysVClockJoin();
+    if (pthread_create(&task->thread, &attr, staSysTaskEntry, (void *)task) != 0) {
+        staSysVClockLeave();
+        XMEMFREE(task);
+        task = NULL;
+        status = GMON_RESP_ERR;
+    } else if (task->name[0] != 0x0) {
+        // shown in perf, gdb and sanitizer reports
+        pthread_setname_np(task->thread, task->name);
+    }
+    pthread_attr_destroy(&attr);
+    *task_ptr = task;
+    return status;
+} // end of stationSysCreateTask
+
+gMonStatus stationSysTaskDelete(stationSysTask_t *task_ptr) {
+    if (task_ptr != NULL && *task_ptr == NULL)
+        return GMON_RESP_ERRARGS;
+    if (task_ptr == NULL || *task_ptr == sys_curr_task) {
+        // resources of the task are released by the thread which joins it
+        staSysVClockLeave();
+        pthread_exit(NULL);
+    }
+    pthread_cancel((*task_ptr)->thread);
+    pthread_join((*task_ptr)->thread, NULL);
+    staSysVClockLeave();
+    XMEMFREE(*task_ptr);
+    *task_ptr = NULL;
+    return GMON_RESP_OK;
+} // end of stationSysTaskDelete
+
+unsigned int stationSysGetTaskStackFree(stationSysTask_t task) {
+    (void)task;
+    return 0;
+}
+
+unsigned int stationSysGetHeapFree(void) { return 0; }
+
+unsigned int stationSysGetHeapMinFree(void) { return 0; }
+
+void staSysTaskWaitUntilExit(stationSysTask_t *task_ptr, void **return_p) {
+    if (task_ptr != NULL && *task_ptr != NULL) {
+        pthread_join((*task_ptr)->thread, return_p);
+        XMEMFREE(*task_ptr);
+        *task_ptr = NULL;
+    }
+    const char  *run_sec_env = getenv("GMON_SIM_RUN_SEC");
+    unsigned int run_sec = (run_sec_env != NULL) ? (unsigned int)strtoul(run_sec_env, NULL, 10) : 0;
+    if (run_sec == 0) {
+        staSysVClockLeave(); // virtual time is driven by the other tasks
+        while (1)
+            pause();
+    }
+    staSysDelayMs(run_sec * 1000);
+    // other tasks are not allowed to enter critical sections while the platform reports and shuts down
+    staSysEnterCritical();
+    stationPlatformDeinit();
+    if (staSysVClockEnabled()) {
+        fprintf(
+            stdout, "[sim] virtual clock: %u ms simulated in %u ms wall-clock time, advanced %u times\n",
+            staSysGetTickCount(), (unsigned int)staSysWallClockMs(), sys_vclock.num_advances
+        );
+    }
+    exit(EXIT_SUCCESS);
+} // end of staSysTaskWaitUntilExit
+
+gMonStatus stationSysInit(void) {
+    pthread_once(&sys_clock_once, staSysClockInit);
+    return stationPlatformInit();
+}
+
+// deadline is on the clock which drives the tasks
+static void staSysMboxDeadline(struct timespec *deadline, uint32_t block_time) {
+    if (staSysVClockEnabled()) {
+        uint64_t now_ms = staSysVClockNowMs();
+        deadline->tv_sec = (time_t)(now_ms / 1000);
+        deadline->tv_nsec = (long)(now_ms % 1000) * 1000000;
+    } else {
+        clock_gettime(CLOCK_MONOTONIC, deadline);
+    }
+    deadline->tv_sec += block_time / 1000;
+    deadline->tv_nsec += (long)(block_time % 1000) * 1000000;
+    if (deadline->tv_nsec >= 1000000000) {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000;
+    }
+}
+
+// wait until `cond` is signaled or the deadline passed, return non-zero on timeout
+static int staSysMboxWait(
+    stationSysMsgbox_t mbox, pthread_cond_t *cond, uint32_t block_time, const struct timespec *deadline
+) {
+    if (block_time == 0)
+        return 1;
+    if (sys_vclock.enabled) {
+        uint64_t deadline_ms = (block_time == GMON_MAX_BLOCKTIME_SYS_MSGBOX)
+                                   ? UINT64_MAX
+                                   : (uint64_t)deadline->tv_sec * 1000 + deadline->tv_nsec / 1000000;
+        return staSysVClockWait(cond, deadline_ms);
+    }
+    if (block_time == GMON_MAX_BLOCKTIME_SYS_MSGBOX)
+        return pthread_cond_wait(cond, mbox->lock);
+    return pthread_cond_timedwait(cond, mbox->lock, deadline) == ETIMEDOUT;
+}
+
+static void staSysMboxSignal(pthread_cond_t *cond) {
+    if (sys_vclock.enabled)
+        staSysVClockSignal(cond);
+    else
+        pthread_cond_signal(cond);
+}
+
+stationSysMsgbox_t staSysMboxCreate(size_t length) {
+    pthread_condattr_t cond_attr;
+    stationSysMsgbox_t mbox = NULL;
+    if (length == 0)
+        return NULL;
+    mbox = XCALLOC(sizeof(struct staSysMsgbox_s), 0x1);
+    if (mbox == NULL)
+        return NULL;
+    mbox->items = XCALLOC(sizeof(void *), length);
+    if (mbox->items == NULL) {
+        XMEMFREE(mbox);
+        return NULL;
+    }
+    mbox->capacity = length;
+    pthread_mutex_init(&mbox->own_lock, NULL);
+    mbox->lock = staSysVClockEnabled() ? &sys_vclock.lock : &mbox->own_lock;
+    // timeout of blocking operations should not be affected by changes of wall-clock time
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&mbox->not_empty, &cond_attr);
+    pthread_cond_init(&mbox->not_full, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
+    return mbox;
+} // end of staSysMboxCreate
+
+void staSysMboxDelete(stationSysMsgbox_t *msgbuf_ptr) {
+    if (msgbuf_ptr == NULL || *msgbuf_ptr == NULL)
+        return;
+    stationSysMsgbox_t mbox = *msgbuf_ptr;
+    pthread_cond_destroy(&mbox->not_full);
+    pthread_cond_destroy(&mbox->not_empty);
+    pthread_mutex_destroy(&mbox->own_lock);
+    XMEMFREE(mbox->items);
+    XMEMFREE(mbox);
+    *msgbuf_ptr = NULL;
+}
+
+gMonStatus staSysMboxGet(stationSysMsgbox_t msgbuf, void **msg, uint32_t block_time) {
+    struct timespec deadline = {0};
+    gMonStatus      status = GMON_RESP_OK;
+    if (msgbuf == NULL || msg == NULL)
+        return GMON_RESP_ERRARGS;
+    staSysMboxDeadline(&deadline, block_time);
+    pthread_mutex_lock(msgbuf->lock);
+    while (msgbuf->count == 0) {
+        if (staSysMboxWait(msgbuf, &msgbuf->not_empty, block_time, &deadline) && msgbuf->count == 0) {
+            status = GMON_RESP_TIMEOUT;
+            goto done;
+        }
+    }
+    *msg = msgbuf->items[msgbuf->head];
+    msgbuf->head = (msgbuf->head + 1) % msgbuf->capacity;
+    msgbuf->count--;
+    staSysMboxSignal(&msgbuf->not_full);
+done:
+    pthread_mutex_unlock(msgbuf->lock);
+    return status;
+} // end of staSysMboxGet
+
+gMonStatus staSysMboxPut(stationSysMsgbox_t msgbuf, void *msg, uint32_t block_time) {
+    struct timespec deadline = {0};
+    gMonStatus      status = GMON_RESP_OK;
+    if (msgbuf == NULL)
+        return GMON_RESP_ERRARGS;
+    staSysMboxDeadline(&deadline, block_time);
+    pthread_mutex_lock(msgbuf->lock);
+    while (msgbuf->count == msgbuf->capacity) {
+        if (staSysMboxWait(msgbuf, &msgbuf->not_full, block_time, &deadline) &&
+            msgbuf->count == msgbuf->capacity) {
+            status = GMON_RESP_TIMEOUT;
+            goto done;
+        }
+    }
+    msgbuf->items[(msgbuf->head + msgbuf->count) % msgbuf->capacity] = msg;
+    msgbuf->count++;
+    staSysMboxSignal(&msgbuf->not_empty);
+done:
+    pthread_mutex_unlock(msgbuf->lock);
+    return status;
+} // end of staSysMboxPut
+
+unsigned int staSysCvtUNumToStr(unsigned char *outstr, unsigned int num, unsigned char base) {
+    const char   digits[] = "0123456789abcdef";
+    unsigned int num_chr = 0;
+    if (outstr == NULL || base < 2 || base > 16)
+        return 0;
+    do {
+        outstr[num_chr++] = digits[num % base];
+        num /= base;
+    } while (num > 0);
+    staReverseString(outstr, num_chr);
+    return num_chr;
+}
@@ -0,0 +1,670 @@
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+#include "station_include.h"
+
+// The garden is modeled with a few first-order rules, readings follow state of the actuators :
+// * soil moisture sensor reports raw ADC value, it goes up as the soil dries, and drops while the pump
+//   is working
+// * light sensors follow compressed day / night cycle, plus light from the bulb when it is on
+// * air temperature rises slowly, and the fan cools it down
+// small noise is added to all readings, the sequence is reproducible in each run.
+//
+// Weather (length of a day, drying rate of soil, ambient temperature, sunlight) can be changed over time
+// by script file given in environment variable `GMON_SIM_SCRIPT`, each line is a step in the format
+// `<time in seconds> <parameter> <value>`, in ascending order of time, e.g. `43200 soil 500` for rain
+// at noon. Parameters are listed in `sim_script_params`.
+//
+// For evaluation of control loops, the model records how long a reading stays above trigger threshold
+// of its actuator (default configuration), and latency from the reading crossing the threshold to the
+// actuator switched on.
+//
+// If trace is enabled (see station_trace.h), the trace ring is written at exit to the file given in
+// environment variable `GMON_SIM_TRACE_FILE`. If critical-section profiler is enabled (see
+// station_profile.h), the longest critical sections are reported at exit.
+
+#define SIM_NUM_ADC_DEVICES     (sizeof(sim_adc_devices) / sizeof(sim_adc_dev_t))
+#define SIM_NUM_AIR_SENSOR_PINS (sizeof(sim_air_temp_read_pin) / sizeof(sim_pinout_t))
+#define SIM_NUM_ACTUATORS       (sizeof(sim_actuator_pins) / sizeof(sim_pinout_t *))
+
+#define SIM_NUM_CRITSECT_REPORTED  10
+#define SIM_NUM_PROF_SCOPE_REPORTED 10
+
+#define SIM_DAY_PERIOD_MS      600000 // one day / night cycle in 10 minutes
+#define SIM_SOIL_DRY_ADC       1000.f
+#define SIM_SOIL_WET_ADC       350.f
+#define SIM_SOIL_DRY_PER_SEC   1.5f
+#define SIM_SOIL_WET_PER_SEC   25.f
+#define SIM_LIGHT_NIGHT_ADC    80.f
+#define SIM_LIGHT_DAY_ADC      700.f
+#define SIM_LIGHT_BULB_ADC     250.f
+#define SIM_AIR_HOT_CELSIUS    33.f
+#define SIM_AIR_COOL_CELSIUS   22.f
+#define SIM_AIR_HEAT_PER_SEC   0.05f
+#define SIM_AIR_COOL_PER_SEC   0.4f
+#define SIM_ADC_NOISE_MAX      3
+#define SIM_SCRIPT_MAX_STEPS   128
+#define SIM_DHT11_RESPONSE_US  30
+#define SIM_DHT11_START_ACK_US 80
+#define SIM_DHT11_BIT_LOW_US   50
+#define SIM_DHT11_BIT0_HIGH_US 26
+#define SIM_DHT11_BIT1_HIGH_US 70
+
+// response of an actuator to the reading it is triggered by
+typedef struct {
+    float         threshold;
+    unsigned int  crossed_at_ms;
+    unsigned int  above_ms; // total time the reading stays above threshold
+    unsigned int  num_responses;
+    unsigned int  sum_latency_ms;
+    unsigned int  max_latency_ms;
+    unsigned char pending : 1; // the reading crossed threshold, the actuator is not switched on yet
+} sim_ctrl_loop_t;
+
+typedef struct {
+    const char      *label;
+    uint8_t          direction;
+    uint8_t          state;
+    unsigned int     num_switched_on;
+    unsigned int     on_since_ms;
+    unsigned int     total_on_ms;
+    sim_ctrl_loop_t *loop;
+} sim_pinout_t;
+
+typedef struct {
+    uint8_t app_sensor_id; // identity in upper application layer
+    // difference to reading of the model, so identical sensors do not report exactly the same value
+    short offset;
+} sim_adc_dev_t;
+
+// conditions out of control of the station
+typedef struct {
+    unsigned int day_period_ms;
+    float        soil_dry_per_sec;
+    float        air_hot_celsius; // temperature the air approaches without the fan
+    float        light_day_adc;   // peak sunlight at noon
+} sim_weather_t;
+
+typedef enum {
+    SIM_SCRIPT_DAY_SEC = 0,
+    SIM_SCRIPT_SOIL_DRY_RATE,
+    SIM_SCRIPT_AIR_HOT,
+    SIM_SCRIPT_LIGHT_DAY,
+    SIM_SCRIPT_SOIL, // set soil moisture reading at once, e.g. rain
+} sim_script_param_t;
+
+typedef struct {
+    unsigned int       at_ms;
+    sim_script_param_t param;
+    float              value;
+} sim_script_step_t;
+
+typedef struct {
+    float         soil_adc;
+    float         temperature; // in Celsius
+    float         humidity;    // in percent
+    unsigned int  last_update_ms;
+    uint32_t      noise_state;
+    sim_weather_t weather;
+    struct {
+        sim_script_step_t steps[SIM_SCRIPT_MAX_STEPS];
+        unsigned short    num_steps;
+        unsigned short    next;
+    } script;
+    struct {
+        unsigned int num_adc_scans;
+        unsigned int num_air_frames;
+        unsigned int num_spi_bytes;
+    } stats;
+} sim_garden_t;
+
+static const char *const sim_script_params[] = {"day_sec", "soil_dry_rate", "air_hot", "light_day", "soil"};
+
+static sim_ctrl_loop_t sim_pump_loop = {.threshold = GMON_CFG_ACTUATOR_TRIG_THRESHOLD_PUMP};
+static sim_ctrl_loop_t sim_fan_loop = {.threshold = GMON_CFG_ACTUATOR_TRIG_THRESHOLD_FAN};
+
+static sim_pinout_t  sim_pump_write_pin = {.label = "pump", .loop = &sim_pump_loop};
+static sim_pinout_t  sim_fan_write_pin = {.label = "fan", .loop = &sim_fan_loop};
+static sim_pinout_t  sim_bulb_write_pin = {.label = "bulb"};
+static sim_pinout_t *sim_actuator_pins[3] = {&sim_pump_write_pin, &sim_fan_write_pin, &sim_bulb_write_pin};
+static sim_pinout_t  sim_display_rst_pin = {.label = "display-rst"};
+static sim_pinout_t  sim_display_dc_pin = {.label = "display-dc"};
+static sim_pinout_t  sim_display_spi_pins = {.label = "display-spi"};
+static sim_pinout_t  sim_air_temp_read_pin[GMON_PLATFORM_NUM_AIR_SENSOR_PINS] = {
+    {.label = "air1"}, {.label = "air2"}, {.label = "air3"}
+};
+// low-level handle of air sensors in application layer, one signal pin for each sensor
+static void *sim_air_temp_pins[GMON_PLATFORM_NUM_AIR_SENSOR_PINS] = {
+    &sim_air_temp_read_pin[0], &sim_air_temp_read_pin[1], &sim_air_temp_read_pin[2]
+};
+
+static const sim_adc_dev_t sim_adc_devices[3] = {
+    {.app_sensor_id = 1, .offset = 0},  // soil moisture
+    {.app_sensor_id = 1, .offset = 0},  // light sensor 1
+    {.app_sensor_id = 2, .offset = 15}, // light sensor 2
+};
+
+static sim_garden_t sim_garden;
+
+static unsigned int simNowMs(void) { return stationSysGetTickCount() * GMON_NUM_MILLISECONDS_PER_TICK; }
+
+// xorshift32, range of the output is [-max, max]
+static int simNoise(int max) {
+    uint32_t x = sim_garden.noise_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    sim_garden.noise_state = x;
+    return (int)(x % (uint32_t)(2 * max + 1)) - max;
+}
+
+static float simApproach(float curr, float target, float rate) {
+    if (curr < target)
+        return (curr + rate > target) ? target : (curr + rate);
+    return (curr - rate < target) ? target : (curr - rate);
+}
+
+// reading changes linearly from `before` to `after` in the time span
+static void simCtrlLoopObserve(
+    sim_ctrl_loop_t *loop, float before, float after, unsigned int from_ms, unsigned int to_ms,
+    uint8_t pin_state
+) {
+    float        thr = loop->threshold;
+    unsigned int cross_ms = from_ms;
+    if (before > thr && after > thr) {
+        loop->above_ms += to_ms - from_ms;
+    } else if (before > thr || after > thr) {
+        // time at which the reading crosses threshold
+        cross_ms += (unsigned int)((float)(to_ms - from_ms) * (thr - before) / (after - before));
+        loop->above_ms += (after > thr) ? (to_ms - cross_ms) : (cross_ms - from_ms);
+    }
+    if (pin_state == GMON_PLATFORM_PIN_SET) {
+        loop->pending = 0;
+        return;
+    }
+    // the actuator may also be switched off before the reading drops below threshold
+    if (after > thr && !loop->pending)
+        loop->crossed_at_ms = cross_ms;
+    loop->pending = (after > thr);
+} // end of simCtrlLoopObserve
+
+static void simCtrlLoopRespond(sim_ctrl_loop_t *loop, unsigned int now_ms) {
+    if (loop == NULL || !loop->pending)
+        return;
+    unsigned int latency_ms = now_ms - loop->crossed_at_ms;
+    loop->num_responses++;
+    loop->sum_latency_ms += latency_ms;
+    if (loop->max_latency_ms < latency_ms)
+        loop->max_latency_ms = latency_ms;
+    loop->pending = 0;
+}
+
+static void simGardenAdvance(unsigned int to_ms) {
+    unsigned int from_ms = sim_garden.last_update_ms;
+    float        elapsed_sec = (float)(to_ms - from_ms) / 1000.f, before = 0.f;
+    sim_garden.last_update_ms = to_ms;
+    before = sim_garden.soil_adc;
+    if (sim_pump_write_pin.state == GMON_PLATFORM_PIN_SET)
+        sim_garden.soil_adc =
+            simApproach(sim_garden.soil_adc, SIM_SOIL_WET_ADC, SIM_SOIL_WET_PER_SEC * elapsed_sec);
+    else
+        sim_garden.soil_adc = simApproach(
+            sim_garden.soil_adc, SIM_SOIL_DRY_ADC, sim_garden.weather.soil_dry_per_sec * elapsed_sec
+        );
+    simCtrlLoopObserve(&sim_pump_loop, before, sim_garden.soil_adc, from_ms, to_ms, sim_pump_write_pin.state);
+    before = sim_garden.temperature;
+    if (sim_fan_write_pin.state == GMON_PLATFORM_PIN_SET)
+        sim_garden.temperature =
+            simApproach(sim_garden.temperature, SIM_AIR_COOL_CELSIUS, SIM_AIR_COOL_PER_SEC * elapsed_sec);
+    else
+        sim_garden.temperature = simApproach(
+            sim_garden.temperature, sim_garden.weather.air_hot_celsius, SIM_AIR_HEAT_PER_SEC * elapsed_sec
+        );
+    simCtrlLoopObserve(
+        &sim_fan_loop, before, sim_garden.temperature, from_ms, to_ms, sim_fan_write_pin.state
+    );
+    // wet soil keeps the air humid
+    sim_garden.humidity = 40.f + 40.f * (SIM_SOIL_DRY_ADC - sim_garden.soil_adc) / SIM_SOIL_DRY_ADC;
+} // end of simGardenAdvance
+
+static void simScriptApply(const sim_script_step_t *step) {
+    switch (step->param) {
+    case SIM_SCRIPT_DAY_SEC:
+        sim_garden.weather.day_period_ms = (unsigned int)(step->value * 1000.f);
+        break;
+    case SIM_SCRIPT_SOIL_DRY_RATE:
+        sim_garden.weather.soil_dry_per_sec = step->value;
+        break;
+    case SIM_SCRIPT_AIR_HOT:
+        sim_garden.weather.air_hot_celsius = step->value;
+        break;
+    case SIM_SCRIPT_LIGHT_DAY:
+        sim_garden.weather.light_day_adc = step->value;
+        break;
+    case SIM_SCRIPT_SOIL:
+        // sudden change, as if the reading moved there in no time
+        simCtrlLoopObserve(
+            &sim_pump_loop, sim_garden.soil_adc, step->value, step->at_ms, step->at_ms,
+            sim_pump_write_pin.state
+        );
+        sim_garden.soil_adc = step->value;
+        break;
+    default:
+        break;
+    }
+}
+
+// advance the model to current time, weather changes on the way if scripted, caller has to enter
+// critical section
+static void simGardenUpdate(void) {
+    unsigned int now_ms = simNowMs();
+    while (sim_garden.script.next < sim_garden.script.num_steps) {
+        const sim_script_step_t *step = &sim_garden.script.steps[sim_garden.script.next];
+        if ((int)(now_ms - step->at_ms) < 0)
+            break;
+        simGardenAdvance(step->at_ms);
+        simScriptApply(step);
+        sim_garden.script.next++;
+    }
+    simGardenAdvance(now_ms);
+}
+
+static gMonStatus simScriptLoad(const char *path) {
+    char               line[128] = {0}, param[32] = {0};
+    float              at_sec = 0.f, value = 0.f;
+    unsigned int       lineno = 0, idx = 0;
+    gMonStatus         status = GMON_RESP_OK;
+    sim_script_step_t *step = NULL;
+    FILE              *fp = fopen(path, "r");
+    if (fp == NULL) {
+        fprintf(stderr, "[sim] failed to open script %s\n", path);
+        return GMON_RESP_ERRARGS;
+    }
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        lineno++;
+        if (line[0] == '#' || sscanf(line, "%f %31s %f", &at_sec, param, &value) != 3)
+            continue;
+        for (idx = 0; idx < sizeof(sim_script_params) / sizeof(char *); idx++) {
+            if (strcmp(param, sim_script_params[idx]) == 0)
+                break;
+        }
+        step = &sim_garden.script.steps[sim_garden.script.num_steps];
+        if (idx == sizeof(sim_script_params) / sizeof(char *) || at_sec < 0.f ||
+            sim_garden.script.num_steps == SIM_SCRIPT_MAX_STEPS ||
+            (sim_garden.script.num_steps > 0 && (unsigned int)(at_sec * 1000.f) < step[-1].at_ms)) {
+            fprintf(stderr, "[sim] invalid step at line %u of script %s\n", lineno, path);
+            status = GMON_RESP_ERRARGS;
+            break;
+        }
+        *step = (sim_script_step_t){
+            .at_ms = (unsigned int)(at_sec * 1000.f), .param = (sim_script_param_t)idx, .value = value
+        };
+        sim_garden.script.num_steps++;
+    }
+    fclose(fp);
+    return status;
+} // end of simScriptLoad
+
+static float simLightLevel(void) {
+    unsigned int period_ms = sim_garden.weather.day_period_ms;
+    unsigned int phase_ms = simNowMs() % period_ms;
+    // triangle wave, darkest at the beginning of each cycle
+    float day_ratio = (float)phase_ms / (period_ms >> 1);
+    if (day_ratio > 1.f)
+        day_ratio = 2.f - day_ratio;
+    float level = SIM_LIGHT_NIGHT_ADC + (sim_garden.weather.light_day_adc - SIM_LIGHT_NIGHT_ADC) * day_ratio;
+    if (sim_bulb_write_pin.state == GMON_PLATFORM_PIN_SET)
+        level += SIM_LIGHT_BULB_ADC;
+    return level;
+}
+
+static unsigned int simAdcValue(float level, short offset) {
+    int value = (int)level + offset + simNoise(SIM_ADC_NOISE_MAX);
+    return (value < 1) ? 1 : (unsigned int)value;
+}
+
+gMonStatus stationPlatformInit(void) {
+    const char *script_path = getenv("GMON_SIM_SCRIPT");
+    gMonStatus  status = GMON_RESP_OK;
+    XMEMSET(&sim_garden, 0x00, sizeof(sim_garden_t));
+    // soil is a bit wetter than pump threshold in default configuration, air is comfortable
+    sim_garden.soil_adc = 860.f;
+    sim_garden.temperature = 25.f;
+    sim_garden.noise_state = 0x2545f491;
+    sim_garden.weather = (sim_weather_t){
+        .day_period_ms = SIM_DAY_PERIOD_MS,
+        .soil_dry_per_sec = SIM_SOIL_DRY_PER_SEC,
+        .air_hot_celsius = SIM_AIR_HOT_CELSIUS,
+        .light_day_adc = SIM_LIGHT_DAY_ADC,
+    };
+    if (script_path != NULL)
+        status = simScriptLoad(script_path);
+    sim_garden.last_update_ms = simNowMs();
+    simGardenUpdate();
+    return status;
+}
+
+static void simCtrlLoopReport(sim_pinout_t *pin) {
+    sim_ctrl_loop_t *loop = pin->loop;
+    fprintf(
+        stdout,
+        "[sim] %s control loop: reading above threshold %.0f for %u ms, %u responses, latency avg %u ms, "
+        "max %u ms%s\n",
+        pin->label, loop->threshold, loop->above_ms, loop->num_responses,
+        (loop->num_responses > 0) ? (loop->sum_latency_ms / loop->num_responses) : 0, loop->max_latency_ms,
+        loop->pending ? ", 1 pending" : ""
+    );
+}
+
+static void simTraceDump(const char *path) {
+    gMonTraceRing_t *ring = GMON_TRACE_RING();
+    unsigned int     nbytes = staTraceRingDumpSize(ring);
+    FILE            *fp = NULL;
+    if (path == NULL)
+        return;
+    if (ring == NULL || nbytes == 0) {
+        fprintf(stderr, "[sim] trace is not enabled, see GMON_CFG_ENABLE_TRACE\n");
+        return;
+    }
+    fp = fopen(path, "wb");
+    if (fp == NULL || fwrite(ring, nbytes, 1, fp) != 1)
+        fprintf(stderr, "[sim] failed to write trace to %s\n", path);
+    else
+        fprintf(stdout, "[sim] trace ring written to %s, %u bytes\n", path, nbytes);
+    if (fp != NULL)
+        fclose(fp);
+}
+
+static void simCritSectReport(void) {
+    gMonProfStat_t stats[SIM_NUM_CRITSECT_REPORTED];
+    unsigned int   num_sites = staCritSectProfReport(stats, SIM_NUM_CRITSECT_REPORTED);
+    for (unsigned int idx = 0; idx < num_sites; idx++) {
+        fprintf(
+            stdout, "[sim] critical section %s:%u : entered %u times, max %u ns, avg %u ns\n",
+            stats[idx].func, stats[idx].line, stats[idx].count, stats[idx].max_ns, stats[idx].avg_ns
+        );
+    }
+}
+
+static void simProfScopeReport(void) {
+    gMonProfStat_t stats[SIM_NUM_PROF_SCOPE_REPORTED];
+    unsigned int   num_sites = staProfScopeReport(stats, SIM_NUM_PROF_SCOPE_REPORTED);
+    for (unsigned int idx = 0; idx < num_sites; idx++) {
+        fprintf(
+            stdout, "[sim] function %s:%u : called %u times, max %u ns, avg %u ns\n", stats[idx].func,
+            stats[idx].line, stats[idx].count, stats[idx].max_ns, stats[idx].avg_ns
+        );
+    }
+}
+
+gMonStatus stationPlatformDeinit(void) {
+    unsigned int now_ms = simNowMs(), on_ms = 0, num_published = 0, nbytes_published = 0;
+    float        num_days = (float)now_ms / GMON_NUM_MILLISECONDS_PER_DAY;
+    simGardenUpdate();
+    staPlatformSimNetStats(&num_published, &nbytes_published);
+    fprintf(stdout, "[sim] run time: %u ms (%.2f days)\n", now_ms, num_days);
+    fprintf(
+        stdout, "[sim] ADC scans: %u, air sensor frames: %u, display SPI bytes: %u\n",
+        sim_garden.stats.num_adc_scans, sim_garden.stats.num_air_frames, sim_garden.stats.num_spi_bytes
+    );
+    for (unsigned char idx = 0; idx < SIM_NUM_ACTUATORS; idx++) {
+        sim_pinout_t *pin = sim_actuator_pins[idx];
+        on_ms = pin->total_on_ms;
+        if (pin->state == GMON_PLATFORM_PIN_SET)
+            on_ms += now_ms - pin->on_since_ms;
+        fprintf(
+            stdout, "[sim] %s: switched on %u times, %u ms in total, %.0f ms per day\n", pin->label,
+            pin->num_switched_on, on_ms, (num_days > 0.f) ? (on_ms / num_days) : 0.f
+        );
+        if (pin->loop != NULL)
+            simCtrlLoopReport(pin);
+    }
+    fprintf(
+        stdout, "[sim] log messages published: %u, %u bytes, %.0f bytes per day\n", num_published,
+        nbytes_published, (num_days > 0.f) ? (nbytes_published / num_days) : 0.f
+    );
+    simTraceDump(getenv("GMON_SIM_TRACE_FILE"));
+    simCritSectReport();
+    simProfScopeReport();
+    fflush(stdout);
+    return GMON_RESP_OK;
+}
+
+gMonStatus staSensorPlatformInitSoilMoist(gMonSensorMeta_t *s) {
+    if (s->num_items != 1)
+        return GMON_RESP_ERRARGS;
+    s->lowlvl = (void *)&sim_adc_devices[0];
+    return GMON_RESP_OK;
+}
+
+gMonStatus staSensorPlatformDeInitSoilMoist(gMonSensorMeta_t *s) {
+    s->lowlvl = NULL;
+    return GMON_RESP_OK;
+}
+
+gMonStatus staSensorPlatformInitLight(gMonSensorMeta_t *s) {
+    if (s->num_items != 2)
+        return GMON_RESP_ERRARGS;
+    s->lowlvl = (void *)&sim_adc_devices[1];
+    return GMON_RESP_OK;
+}
+
+gMonStatus staSensorPlatformDeInitLight(gMonSensorMeta_t *s) {
+    s->lowlvl = NULL;
+    return GMON_RESP_OK;
+}
+
+// same constraints as ADC scan of STM32 port, all oversample rounds of enabled channels at once
+static gMonStatus simAdcScan(gMonSensorMeta_t *sensor, gmonSensorSample_t *out, unsigned char is_soil) {
+    if (sensor == NULL || out == NULL || sensor->num_items == 0)
+        return GMON_RESP_ERRARGS;
+    if (out->dtype != GMON_SENSOR_DATA_TYPE_U32)
+        return GMON_RESP_ERRARGS;
+    const sim_adc_dev_t *adc_devs = (const sim_adc_dev_t *)sensor->lowlvl;
+    unsigned short       k = 0, m_round = 0;
+    float                level = 0.f;
+    if (adc_devs == NULL || sensor->num_items > SIM_NUM_ADC_DEVICES)
+        return GMON_RESP_ERRARGS;
+    stationSysEnterCritical();
+    simGardenUpdate();
+    level = is_soil ? sim_garden.soil_adc : simLightLevel();
+    for (k = 0; k < sensor->num_items; k++) {
+        if (out[k].data == NULL || out[k].len == 0 || out[k].id != adc_devs[k].app_sensor_id)
+            break;
+        if (is_soil && !staSensorPollEnabled((gMonSoilSensorMeta_t *)sensor, k))
+            continue;
+        for (m_round = 0; m_round < out[k].len; m_round++)
+            ((unsigned int *)out[k].data)[m_round] = simAdcValue(level, adc_devs[k].offset);
+    }
+    sim_garden.stats.num_adc_scans++;
+    stationSysExitCritical();
+    return (k == sensor->num_items) ? GMON_RESP_OK : GMON_RESP_ERRMEM;
+} // end of simAdcScan
+
+gMonStatus staPlatformReadSoilMoistSensor(gMonSensorMeta_t *sensor, gmonSensorSample_t *out) {
+    return simAdcScan(sensor, out, 1);
+}
+
+gMonStatus staPlatformReadLightSensor(gMonSensorMeta_t *sensor, gmonSensorSample_t *out) {
+    return simAdcScan(sensor, out, 0);
+}
+
+gMonStatus staSensorPlatformInitAirTemp(gMonSensorMeta_t *s) {
+    if (s == NULL || s->num_items == 0 || s->num_items > SIM_NUM_AIR_SENSOR_PINS)
+        return GMON_RESP_ERRARGS;
+    s->lowlvl = (void *)sim_air_temp_pins;
+    return GMON_RESP_OK;
+}
+
+gMonStatus staSensorPlatformDeInitAirTemp(gMonSensorMeta_t *s) {
+    s->lowlvl = NULL;
+    return GMON_RESP_OK;
+}
+
+gMonStatus staActuatorPlatformInitPump(void **pinstruct) {
+    if (pinstruct == NULL)
+        return GMON_RESP_ERRARGS;
+    *(sim_pinout_t **)pinstruct = &sim_pump_write_pin;
+    return GMON_RESP_OK;
+}
+
+gMonStatus staActuatorPlatformInitFan(void **pinstruct) {
+    if (pinstruct == NULL)
+        return GMON_RESP_ERRARGS;
+    *(sim_pinout_t **)pinstruct = &sim_fan_write_pin;
+    return GMON_RESP_OK;
+}
+
+gMonStatus staActuatorPlatformInitBulb(void **pinstruct) {
+    if (pinstruct == NULL)
+        return GMON_RESP_ERRARGS;
+    *(sim_pinout_t **)pinstruct = &sim_bulb_write_pin;
+    return GMON_RESP_OK;
+}
+
+gMonStatus staDisplayPlatformInit(uint8_t comm_protocal_id, void **pinstruct) {
+    if (pinstruct == NULL)
+        return GMON_RESP_ERRARGS;
+    if (comm_protocal_id != GMON_PLATFORM_DISPLAY_SPI)
+        return GMON_RESP_ERR_NOT_SUPPORT;
+    *(sim_pinout_t **)pinstruct = &sim_display_spi_pins;
+    return GMON_RESP_OK;
+}
+
+void *staPlatformiGetDisplayRstPin(void) { return (void *)&sim_display_rst_pin; }
+
+void *staPlatformiGetDisplayDataCmdPin(void) { return (void *)&sim_display_dc_pin; }
+
+gMonStatus staDisplayPlatformDeinit(void *pinstruct) {
+    return (pinstruct == &sim_display_spi_pins) ? GMON_RESP_OK : GMON_RESP_ERRARGS;
+}
+
+// there is no panel, only amount of data sent to the display is recorded
+gMonStatus staPlatformSPItransmit(void *pinstruct, unsigned char *pData, unsigned short sz) {
+    if (pinstruct == NULL || pData == NULL || sz == 0)
+        return GMON_RESP_ERRARGS;
+    sim_garden.stats.num_spi_bytes += sz;
+    return GMON_RESP_OK;
+}
+
+// busy waiting as the timer of STM32 port, sleeping in the host OS takes much longer than a few microseconds
+gMonStatus staPlatformDelayUs(uint16_t us) {
+    struct timespec start = {0}, now = {0};
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+    } while ((now.tv_sec - start.tv_sec) * 1000000 + (now.tv_nsec - start.tv_nsec) / 1000 < us);
+    return GMON_RESP_OK;
+}
+
+static sim_pinout_t *simCapturePin(void *pinstruct) {
+    for (uint8_t idx = 0; idx < SIM_NUM_AIR_SENSOR_PINS; idx++) {
+        if (pinstruct == &sim_air_temp_read_pin[idx])
+            return &sim_air_temp_read_pin[idx];
+    }
+    return NULL;
+}
+
+// record a DHT11 frame with current air condition, as captured by a free-running 16-bit timer, the
+// rising edge of bus released by MCU comes first as on real hardware. Return time length of the frame
+// in microseconds
+static unsigned int simDHT11Frame(uint16_t *edges_us, uint16_t num_edges, float temp_offset) {
+    uint8_t  data[5] = {0}, bit = 0;
+    uint16_t now_us = (uint16_t)simNoise(0x7fff), num = 0, idx = 0, start_us = now_us;
+    float    temperature = sim_garden.temperature + temp_offset;
+    data[0] = (uint8_t)sim_garden.humidity;
+    data[2] = (uint8_t)temperature;
+    data[3] = (uint8_t)((temperature - data[2]) * 10.f);
+    data[4] = (uint8_t)(data[0] + data[1] + data[2] + data[3]);
+    edges_us[num++] = now_us;
+    if (num < num_edges)
+        edges_us[num++] = (now_us += SIM_DHT11_RESPONSE_US);
+    if (num < num_edges)
+        edges_us[num++] = (now_us += SIM_DHT11_START_ACK_US);
+    if (num < num_edges)
+        edges_us[num++] = (now_us += SIM_DHT11_START_ACK_US);
+    for (idx = 0; idx < 40 && num < num_edges; idx++) {
+        edges_us[num++] = (now_us += SIM_DHT11_BIT_LOW_US);
+        bit = (data[idx >> 3] >> (7 - (idx & 0x7))) & 0x1;
+        if (num < num_edges)
+            edges_us[num++] = (now_us += bit ? SIM_DHT11_BIT1_HIGH_US : SIM_DHT11_BIT0_HIGH_US);
+    }
+    if (num < num_edges) // the sensor releases the bus after the last bit
+        edges_us[num++] = (now_us += SIM_DHT11_BIT_LOW_US);
+    return (uint16_t)(now_us - start_us);
+} // end of simDHT11Frame
+
+gMonStatus staPlatformCaptureEdgesMulti(
+    void **pinstructs, uint8_t num_pins, uint16_t *edges_us, uint16_t num_edges, uint16_t timeout_ms,
+    gMonStatus *pin_status
+) {
+    if (pinstructs == NULL || num_pins == 0 || num_pins > SIM_NUM_AIR_SENSOR_PINS || edges_us == NULL ||
+        num_edges == 0 || pin_status == NULL)
+        return GMON_RESP_ERRARGS;
+    unsigned int frame_us = 0, max_frame_us = 0;
+    uint8_t      idx = 0;
+    for (idx = 0; idx < num_pins; idx++) {
+        if (simCapturePin(pinstructs[idx]) == NULL)
+            return GMON_RESP_ERR_NOT_SUPPORT;
+    }
+    stationSysEnterCritical();
+    simGardenUpdate();
+    for (idx = 0; idx < num_pins; idx++) {
+        frame_us = simDHT11Frame(&edges_us[idx * num_edges], num_edges, idx * 0.3f);
+        if (max_frame_us < frame_us)
+            max_frame_us = frame_us;
+        pin_status[idx] = GMON_RESP_OK;
+    }
+    sim_garden.stats.num_air_frames += num_pins;
+    stationSysExitCritical();
+    // frames are captured in parallel, the caller sleeps until the longest one ends
+    max_frame_us = (max_frame_us + 999) / 1000;
+    stationSysDelayMs((max_frame_us < timeout_ms) ? max_frame_us : timeout_ms);
+    return GMON_RESP_OK;
+} // end of staPlatformCaptureEdgesMulti
+
+gMonStatus
+staPlatformCaptureEdges(void *pinstruct, uint16_t *edges_us, uint16_t num_edges, uint16_t timeout_ms) {
+    gMonStatus pin_status = GMON_RESP_ERR;
+    gMonStatus status =
+        staPlatformCaptureEdgesMulti(&pinstruct, 1, edges_us, num_edges, timeout_ms, &pin_status);
+    return (status == GMON_RESP_OK) ? pin_status : status;
+}
+
+gMonStatus staPlatformPinSetDirection(void *pinstruct, uint8_t direction) {
+    if (pinstruct == NULL)
+        return GMON_RESP_ERRARGS;
+    if (direction != GMON_PLATFORM_PIN_DIRECTION_OUT && direction != GMON_PLATFORM_PIN_DIRECTION_IN)
+        return GMON_RESP_ERR;
+    sim_pinout_t *pin = (sim_pinout_t *)pinstruct;
+    pin->direction = direction;
+    if (direction == GMON_PLATFORM_PIN_DIRECTION_OUT)
+        staPlatformWritePin(pinstruct, GMON_PLATFORM_PIN_RESET);
+    return GMON_RESP_OK;
+}
+
+gMonStatus staPlatformWritePin(void *pinstruct, uint8_t new_state) {
+    if (pinstruct == NULL)
+        return GMON_RESP_ERRARGS;
+    sim_pinout_t *pin = (sim_pinout_t *)pinstruct;
+    unsigned int  now_ms = 0;
+    stationSysEnterCritical();
+    // the garden responds to previous state of the actuators until now
+    simGardenUpdate();
+    now_ms = sim_garden.last_update_ms;
+    if (pin->state != GMON_PLATFORM_PIN_SET && new_state == GMON_PLATFORM_PIN_SET) {
+        pin->num_switched_on++;
+        pin->on_since_ms = now_ms;
+        simCtrlLoopRespond(pin->loop, now_ms);
+    } else if (pin->state == GMON_PLATFORM_PIN_SET && new_state != GMON_PLATFORM_PIN_SET) {
+        pin->total_on_ms += now_ms - pin->on_since_ms;
+    }
+    pin->state = new_state;
+    stationSysExitCritical();
+    return GMON_RESP_OK;
+}
+
+uint8_t staPlatformReadPin(void *pinstruct) {
+    if (pinstruct == NULL)
+        return GMON_PLATFORM_PIN_RESET;
+    return ((sim_pinout_t *)pinstruct)->state;
+}
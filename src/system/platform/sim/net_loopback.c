@@ -0,0 +1,182 @@
+#include "station_include.h"
+
+// In-process stand-in of MQTT broker for host build, connection never fails and every log message is
+// acknowledged at once, the messages are printed to standard output. Control message from remote user
+// can be given in environment variable `GMON_SIM_CTRL_MSG`, it is delivered once in the first session.
+
+#define SIM_NET_MAX_INFLIGHT 16
+
+typedef struct {
+    const char    *ctrl_msg;
+    unsigned short pkt_ids[SIM_NET_MAX_INFLIGHT]; // PUBACKs on their way back to the station
+    unsigned short next_pkt_id;
+    unsigned char  num_pubacks;
+    unsigned char  connected         : 1;
+    unsigned char  ctrl_msg_consumed : 1;
+    unsigned int   num_published;
+    unsigned int   nbytes_published;
+} sim_net_broker_t;
+
+static sim_net_broker_t sim_net_broker;
+
+void staPlatformSimNetStats(unsigned int *num_published, unsigned int *nbytes_published) {
+    *num_published = sim_net_broker.num_published;
+    *nbytes_published = sim_net_broker.nbytes_published;
+}
+
+static void simNetLogPublish(gmonStr_t *app_msg) {
+    sim_net_broker.num_published++;
+    sim_net_broker.nbytes_published += app_msg->nbytes_written;
+    unsigned int now_ms = stationSysGetTickCount() * GMON_NUM_MILLISECONDS_PER_TICK;
+    fprintf(
+        stdout, "[sim] %u ms, publish %u bytes: %.*s\n", now_ms, app_msg->nbytes_written,
+        (int)app_msg->nbytes_written, (const char *)app_msg->data
+    );
+    fflush(stdout);
+}
+
+// deliver control message if there is one left, otherwise wait until timeout
+static gMonStatus simNetDeliverCtrlMsg(gmonStr_t *app_msg, unsigned int timeout_ms) {
+    unsigned int payload_len = 0;
+    if (sim_net_broker.ctrl_msg == NULL || sim_net_broker.ctrl_msg_consumed) {
+        stationSysDelayMs(timeout_ms);
+        return GMON_RESP_TIMEOUT;
+    }
+    payload_len = XSTRLEN(sim_net_broker.ctrl_msg);
+    if (payload_len > app_msg->len)
+        payload_len = app_msg->len;
+    XMEMCPY(app_msg->data, sim_net_broker.ctrl_msg, payload_len);
+    app_msg->nbytes_written = payload_len;
+    sim_net_broker.ctrl_msg_consumed = 1;
+    return GMON_RESP_OK;
+}
+
+gMonStatus stationNetConnInit(gMonNet_t *net_handle, gMonArena_t *arena) {
+    (void)arena;
+    if (net_handle == NULL)
+        return GMON_RESP_ERRARGS;
+    gMonStatus status =
+        staSetNetConnTaskInterval(net_handle, (unsigned int)GMON_CFG_NETCONN_START_INTERVAL_MS);
+    if (status < 0)
+        return status;
+    XMEMSET(&sim_net_broker, 0x00, sizeof(sim_net_broker_t));
+    sim_net_broker.ctrl_msg = getenv("GMON_SIM_CTRL_MSG");
+    net_handle->lowlvl = (void *)&sim_net_broker;
+    net_handle->read_timeout_ms = 6000;
+    return GMON_RESP_OK;
+}
+
+gMonStatus stationNetConnDeinit(gMonNet_t *net_handle, gMonArena_t *arena) {
+    (void)arena;
+    if (net_handle == NULL)
+        return GMON_RESP_ERRARGS;
+    net_handle->lowlvl = NULL;
+    return GMON_RESP_OK;
+}
+
+gMonStatus stationNetConnEstablish(gMonNet_t *net_handle) {
+    if (net_handle == NULL || net_handle->lowlvl == NULL)
+        return GMON_RESP_ERRARGS;
+    sim_net_broker.connected = 1;
+    sim_net_broker.num_pubacks = 0;
+    staNetConnPubWinSetWindow(&net_handle->pub_win, SIM_NET_MAX_INFLIGHT);
+    return GMON_RESP_OK;
+}
+
+gMonStatus stationNetConnClose(gMonNet_t *net_handle) {
+    if (net_handle == NULL || net_handle->lowlvl == NULL)
+        return GMON_RESP_ERRARGS;
+    sim_net_broker.connected = 0;
+    sim_net_broker.num_pubacks = 0;
+    return GMON_RESP_OK;
+}
+
+gMonStatus stationNetConnSend(gMonNet_t *net_handle, gmonStr_t *app_msg) {
+    if (net_handle == NULL || app_msg == NULL || app_msg->data == NULL || app_msg->len == 0)
+        return GMON_RESP_ERRARGS;
+    if (!sim_net_broker.connected) {
+        net_handle->status.sent = GMON_RESP_ERR_CONN;
+        return net_handle->status.sent;
+    }
+    simNetLogPublish(app_msg);
+    net_handle->status.sent = GMON_RESP_OK;
+    return GMON_RESP_OK;
+}
+
+unsigned short stationNetConnReservePktId(gMonNet_t *net_handle) {
+    if (net_handle == NULL || net_handle->lowlvl == NULL)
+        return 0;
+    if (++sim_net_broker.next_pkt_id == 0)
+        sim_net_broker.next_pkt_id = 1;
+    return sim_net_broker.next_pkt_id;
+}
+
+gMonStatus stationNetConnPublish(
+    gMonNet_t *net_handle, gmonStr_t *app_msg, unsigned short pkt_id, unsigned char dup
+) {
+    (void)dup;
+    if (net_handle == NULL || app_msg == NULL || app_msg->data == NULL || app_msg->len == 0 || pkt_id == 0)
+        return GMON_RESP_ERRARGS;
+    if (!sim_net_broker.connected || sim_net_broker.num_pubacks >= SIM_NET_MAX_INFLIGHT) {
+        net_handle->status.sent = GMON_RESP_ERR_CONN;
+        return net_handle->status.sent;
+    }
+    sim_net_broker.pkt_ids[sim_net_broker.num_pubacks++] = pkt_id;
+    simNetLogPublish(app_msg);
+    net_handle->status.sent = GMON_RESP_OK;
+    return GMON_RESP_OK;
+}
+
+// PUBACKs are sent back at once in the same order as the PUBLISH packets received, control message is
+// only delivered by stationNetConnPoll()
+gMonStatus stationNetConnWaitPubAck(gMonNet_t *net_handle, unsigned short pkt_id, gmonStr_t *ctrl_msg) {
+    if (net_handle == NULL || net_handle->lowlvl == NULL || pkt_id == 0 || ctrl_msg == NULL)
+        return GMON_RESP_ERRARGS;
+    if (!sim_net_broker.connected || sim_net_broker.num_pubacks == 0 || sim_net_broker.pkt_ids[0] != pkt_id) {
+        net_handle->status.sent = GMON_RESP_ERR_CONN;
+        return net_handle->status.sent;
+    }
+    sim_net_broker.num_pubacks--;
+    for (unsigned char idx = 0; idx < sim_net_broker.num_pubacks; idx++)
+        sim_net_broker.pkt_ids[idx] = sim_net_broker.pkt_ids[idx + 1];
+    net_handle->status.sent = GMON_RESP_OK;
+    return GMON_RESP_OK;
+}
+
+gMonStatus stationNetConnSubscribe(gMonNet_t *net_handle) {
+    if (net_handle == NULL || net_handle->lowlvl == NULL)
+        return GMON_RESP_ERRARGS;
+    return sim_net_broker.connected ? GMON_RESP_OK : GMON_RESP_ERR_CONN;
+}
+
+gMonStatus stationNetConnRecv(gMonNet_t *net_handle, gmonStr_t *app_msg) {
+    gMonStatus status = GMON_RESP_OK;
+    if (net_handle == NULL || app_msg == NULL || app_msg->data == NULL || app_msg->len == 0)
+        return GMON_RESP_ERRARGS;
+    status = stationNetConnSubscribe(net_handle);
+    if (status == GMON_RESP_OK)
+        status = simNetDeliverCtrlMsg(app_msg, net_handle->read_timeout_ms);
+    net_handle->status.recv = status;
+    return status;
+}
+
+gMonStatus stationNetConnPoll(gMonNet_t *net_handle, gmonStr_t *app_msg, unsigned int timeout_ms) {
+    gMonStatus status = GMON_RESP_OK;
+    if (net_handle == NULL || app_msg == NULL || app_msg->data == NULL || app_msg->len == 0)
+        return GMON_RESP_ERRARGS;
+    if (!sim_net_broker.connected) {
+        net_handle->status.recv = GMON_RESP_ERR_CONN;
+        return net_handle->status.recv;
+    }
+    status = simNetDeliverCtrlMsg(app_msg, timeout_ms);
+    if (status == GMON_RESP_TIMEOUT)
+        return GMON_RESP_SKIP;
+    net_handle->status.recv = status;
+    return status;
+}
+
+gMonStatus stationNetConnPing(gMonNet_t *net_handle) {
+    if (net_handle == NULL || net_handle->lowlvl == NULL)
+        return GMON_RESP_ERRARGS;
+    return sim_net_broker.connected ? GMON_RESP_OK : GMON_RESP_ERR_CONN;
+}
@@ -1,9 +1,21 @@
 #include "station_include.h"
 #include "pin_map.h"
+#include "FreeRTOS.h"
+#include "task.h"
 
 #define PLATFORM_ONE_MHZ    1000000
 #define APP_APB2CLK_DIVIDER RCC_HCLK_DIV1 // PCLK2 freq. == HCLK
 
+#define HAL_NUM_ADC_DEVICES (sizeof(hal_extended_adc_devices) / sizeof(hal_extend_adc_t))
+#define HAL_ADC_MAX_ROUNDS                                                                             \
+    ((GMON_MAX_OVERSAMPLES_SOIL_SENSORS > GMON_MAX_OVERSAMPLES_LIGHT_SENSORS)                          \
+         ? GMON_MAX_OVERSAMPLES_SOIL_SENSORS                                                           \
+         : GMON_MAX_OVERSAMPLES_LIGHT_SENSORS)
+// time limit of entire scan burst, all channels for all oversample rounds
+#define HAL_ADC_DMA_TIMEOUT_MS 100
+#define HAL_TIM4_CLK_DIVIDER   RCC_HCLK_DIV4 // same as APB1 prescaler in SystemClock_Config()
+#define HAL_NUM_AIR_SENSOR_PINS (sizeof(hal_air_temp_read_pin) / sizeof(hal_capture_pinout_t))
+
 typedef struct {
     GPIO_TypeDef *port;
     uint16_t      pin;
@@ -23,14 +35,69 @@ typedef struct {
     uint8_t            app_sensor_id; // identity in upper application layer
 } hal_extend_adc_t;
 
+// pin which can also be switched to input capture channel of a timer, `super` has to be the first
+// member so this structure can be accessed as `hal_pinout_t` by other GPIO functions
+typedef struct {
+    hal_pinout_t          super;
+    TIM_HandleTypeDef    *timer;
+    uint32_t              channel;
+    uint16_t              dma_id; // index to DMA handle of the timer channel
+    HAL_TIM_ActiveChannel active; // reported in timer callbacks, also used as bit flag of the channel
+    DMA_Stream_TypeDef   *dma_stream;
+    IRQn_Type             dma_irq;
+    DMA_HandleTypeDef     dma;
+} hal_capture_pinout_t;
+
+// task waiting for completion of DMA transfers, notified in ISR once all the transfers in `pending`
+// bit flags are done
+typedef struct {
+    TaskHandle_t     task;
+    volatile uint8_t pending;
+    volatile uint8_t error;
+} hal_dma_waiter_t;
+
 // timer that increments counter every 1 microsecond in non-blocking manner,
 // all functions in this module accessing this timer are NOT thread-safe, callers
 // must handle race condition by themselves.
 static TIM_HandleTypeDef hal_tim_us;
 static ADC_HandleTypeDef hadc1; // used as analog input of soil moisture sensor
+// DMA2 stream 0 moves converted values of ADC1 to memory in scan mode
+static DMA_HandleTypeDef hal_dma_adc1;
+// timer 4 timestamps edges on signal pins of air sensors
+static TIM_HandleTypeDef hal_tim_capture;
 static SPI_HandleTypeDef hspi2;
 // PC14, PC15 are reserved for RCC LSE clock
-static hal_pinout_t     hal_air_temp_read_pin[1] = {{HW_AIRTEMP_PORT, HW_AIRTEMP_PIN, 0}};
+// request of each timer channel is mapped to channel 2 of different DMA1 stream, TIM4_CH4 does not
+// have DMA request so at most 3 air sensors are supported
+static hal_capture_pinout_t hal_air_temp_read_pin[GMON_PLATFORM_NUM_AIR_SENSOR_PINS] = {
+    {.super = {HW_AIRTEMP_PORT, HW_AIRTEMP1_PIN, HW_AIRTEMP_AF},
+     .timer = &hal_tim_capture,
+     .channel = HW_AIRTEMP1_TIM_CH,
+     .dma_id = TIM_DMA_ID_CC3,
+     .active = HAL_TIM_ACTIVE_CHANNEL_3,
+     .dma_stream = DMA1_Stream7,
+     .dma_irq = DMA1_Stream7_IRQn},
+    {.super = {HW_AIRTEMP_PORT, HW_AIRTEMP2_PIN, HW_AIRTEMP_AF},
+     .timer = &hal_tim_capture,
+     .channel = HW_AIRTEMP2_TIM_CH,
+     .dma_id = TIM_DMA_ID_CC1,
+     .active = HAL_TIM_ACTIVE_CHANNEL_1,
+     .dma_stream = DMA1_Stream0,
+     .dma_irq = DMA1_Stream0_IRQn},
+    {.super = {HW_AIRTEMP_PORT, HW_AIRTEMP3_PIN, HW_AIRTEMP_AF},
+     .timer = &hal_tim_capture,
+     .channel = HW_AIRTEMP3_TIM_CH,
+     .dma_id = TIM_DMA_ID_CC2,
+     .active = HAL_TIM_ACTIVE_CHANNEL_2,
+     .dma_stream = DMA1_Stream3,
+     .dma_irq = DMA1_Stream3_IRQn},
+};
+// low-level handle of air sensors in application layer, one signal pin for each sensor
+static void *hal_air_temp_pins[GMON_PLATFORM_NUM_AIR_SENSOR_PINS] = {
+    &hal_air_temp_read_pin[0].super,
+    &hal_air_temp_read_pin[1].super,
+    &hal_air_temp_read_pin[2].super,
+};
 static hal_pinout_t     hal_pump_write_pin = {HW_PUMP_PORT, HW_PUMP_PIN, 0};
 static hal_pinout_t     hal_fan_write_pin = {HW_FAN_PORT, HW_FAN_PIN, 0};
 static hal_pinout_t     hal_bulb_write_pin = {HW_BULB_PORT, HW_BULB_PIN, 0};
@@ -44,6 +111,12 @@ static const hal_extend_adc_t hal_extended_adc_devices[3] = {
     {.reference = &hadc1, .channel = HW_LIGHT_SENSOR_ADC_CH2, .app_sensor_id = 2},
 };
 
+// conversion results of all ranks in a scan sequence are interleaved in this buffer, in order
+// to be accessed by DMA, the buffer is shared by all sensors attached to ADC1.
+static uint16_t         hal_adc_dma_buf[HAL_ADC_MAX_ROUNDS * HAL_NUM_ADC_DEVICES];
+static hal_dma_waiter_t hal_adc_dma_waiter;
+static hal_dma_waiter_t hal_capture_dma_waiter;
+
 HAL_StatusTypeDef SystemClock_Config(void) {
     HAL_StatusTypeDef        status = HAL_OK;
     RCC_OscInitTypeDef       RCC_OscInitStruct = {0};
@@ -122,6 +195,40 @@ done:
     return status;
 } // end of STM32_HAL_timer_us_Init
 
+// 1 MHz free-running timer, its input capture channels record the counter on both edges of the
+// signal pins of air sensors
+static HAL_StatusTypeDef STM32_HAL_timer_capture_Init(void) {
+    HAL_StatusTypeDef  status = HAL_OK;
+    TIM_IC_InitTypeDef sConfigIC = {0};
+    uint8_t            idx = 0;
+    // Note timer 4 is clocked by PCLK1, which is doubled when APB1 prescaler is not 1
+    uint32_t tim4_clk_hz = HAL_RCC_GetPCLK1Freq();
+    if (HAL_TIM4_CLK_DIVIDER != RCC_HCLK_DIV1) {
+        tim4_clk_hz = tim4_clk_hz << 1;
+    }
+    hal_tim_capture.Instance = HW_AIRTEMP_TIM;
+    hal_tim_capture.Init.Prescaler = (tim4_clk_hz / PLATFORM_ONE_MHZ) - 1;
+    hal_tim_capture.Init.CounterMode = TIM_COUNTERMODE_UP;
+    hal_tim_capture.Init.Period = 0xffff;
+    hal_tim_capture.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    status = HAL_TIM_IC_Init(&hal_tim_capture);
+    if (status != HAL_OK) {
+        goto done;
+    }
+    sConfigIC.ICPolarity = TIM_INPUTCHANNELPOLARITY_BOTHEDGE;
+    sConfigIC.ICSelection = TIM_ICSELECTION_DIRECTTI;
+    sConfigIC.ICPrescaler = TIM_ICPSC_DIV1;
+    sConfigIC.ICFilter = 0x3; // reject glitches shorter than 8 cycles of timer kernel clock
+    for (idx = 0; idx < HAL_NUM_AIR_SENSOR_PINS; idx++) {
+        status = HAL_TIM_IC_ConfigChannel(&hal_tim_capture, &sConfigIC, hal_air_temp_read_pin[idx].channel);
+        if (status != HAL_OK) {
+            goto done;
+        }
+    }
+done:
+    return status;
+} // end of STM32_HAL_timer_capture_Init
+
 void HAL_TIM_Base_MspInit(TIM_HandleTypeDef *htim_base) {
     if (htim_base->Instance == TIM1) {
         // Peripheral clock enable
@@ -146,6 +253,23 @@ void HAL_ADC_MspInit(ADC_HandleTypeDef *hadc) {
         GPIO_InitStruct.Mode = GPIO_MODE_ANALOG;
         GPIO_InitStruct.Pull = GPIO_NOPULL;
         HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
+        // ADC1 is mapped to channel 0 of DMA2 stream 0, one transfer for each scan burst
+        __HAL_RCC_DMA2_CLK_ENABLE();
+        hal_dma_adc1.Instance = DMA2_Stream0;
+        hal_dma_adc1.Init.Channel = DMA_CHANNEL_0;
+        hal_dma_adc1.Init.Direction = DMA_PERIPH_TO_MEMORY;
+        hal_dma_adc1.Init.PeriphInc = DMA_PINC_DISABLE;
+        hal_dma_adc1.Init.MemInc = DMA_MINC_ENABLE;
+        hal_dma_adc1.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+        hal_dma_adc1.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+        hal_dma_adc1.Init.Mode = DMA_NORMAL;
+        hal_dma_adc1.Init.Priority = DMA_PRIORITY_LOW;
+        hal_dma_adc1.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+        if (HAL_DMA_Init(&hal_dma_adc1) == HAL_OK) {
+            __HAL_LINKDMA(hadc, DMA_Handle, hal_dma_adc1);
+            HAL_NVIC_SetPriority(DMA2_Stream0_IRQn, (configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY + 1), 0);
+            HAL_NVIC_EnableIRQ(DMA2_Stream0_IRQn);
+        }
     }
 }
 
@@ -158,9 +282,119 @@ void HAL_ADC_MspDeInit(ADC_HandleTypeDef *hadc) {
         // PB1     ------> ADC1_IN9
         HAL_GPIO_DeInit(GPIOA, HW_SOIL_MOISTURE_PIN | HW_LIGHT_SENSOR_CH1_PIN);
         HAL_GPIO_DeInit(GPIOB, HW_LIGHT_SENSOR_CH2_PIN);
+        HAL_NVIC_DisableIRQ(DMA2_Stream0_IRQn);
+        HAL_DMA_DeInit(hadc->DMA_Handle);
+    }
+}
+
+void HAL_TIM_IC_MspInit(TIM_HandleTypeDef *htim) {
+    if (htim->Instance == HW_AIRTEMP_TIM) {
+        __HAL_RCC_TIM4_CLK_ENABLE();
+        __HAL_RCC_DMA1_CLK_ENABLE();
+        // one DMA transfer for each captured edge
+        for (uint8_t idx = 0; idx < HAL_NUM_AIR_SENSOR_PINS; idx++) {
+            hal_capture_pinout_t *cap = &hal_air_temp_read_pin[idx];
+            cap->dma.Instance = cap->dma_stream;
+            cap->dma.Init.Channel = DMA_CHANNEL_2;
+            cap->dma.Init.Direction = DMA_PERIPH_TO_MEMORY;
+            cap->dma.Init.PeriphInc = DMA_PINC_DISABLE;
+            cap->dma.Init.MemInc = DMA_MINC_ENABLE;
+            cap->dma.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+            cap->dma.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+            cap->dma.Init.Mode = DMA_NORMAL;
+            cap->dma.Init.Priority = DMA_PRIORITY_HIGH;
+            cap->dma.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+            if (HAL_DMA_Init(&cap->dma) == HAL_OK) {
+                __HAL_LINKDMA(htim, hdma[cap->dma_id], cap->dma);
+                HAL_NVIC_SetPriority(cap->dma_irq, (configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY + 1), 0);
+                HAL_NVIC_EnableIRQ(cap->dma_irq);
+            }
+        }
     }
 }
 
+void HAL_TIM_IC_MspDeInit(TIM_HandleTypeDef *htim) {
+    if (htim->Instance == HW_AIRTEMP_TIM) {
+        for (uint8_t idx = 0; idx < HAL_NUM_AIR_SENSOR_PINS; idx++) {
+            HAL_NVIC_DisableIRQ(hal_air_temp_read_pin[idx].dma_irq);
+            HAL_DMA_DeInit(&hal_air_temp_read_pin[idx].dma);
+        }
+        __HAL_RCC_TIM4_CLK_DISABLE();
+    }
+}
+
+void DMA2_Stream0_IRQHandler(void) { HAL_DMA_IRQHandler(&hal_dma_adc1); }
+
+void DMA1_Stream7_IRQHandler(void) { HAL_DMA_IRQHandler(&hal_air_temp_read_pin[0].dma); }
+
+void DMA1_Stream0_IRQHandler(void) { HAL_DMA_IRQHandler(&hal_air_temp_read_pin[1].dma); }
+
+void DMA1_Stream3_IRQHandler(void) { HAL_DMA_IRQHandler(&hal_air_temp_read_pin[2].dma); }
+
+// must be called by the task before starting DMA transfers, `pending` is bit flags of the transfers
+static void STM32_HAL_WaiterArm(hal_dma_waiter_t *waiter, uint8_t pending) {
+    waiter->task = xTaskGetCurrentTaskHandle();
+    waiter->pending = pending;
+    waiter->error = 0;
+    ulTaskNotifyTake(pdTRUE, 0); // discard stale notification from previous transfer
+}
+
+// called by the task when a transfer cannot be started, ISR might update the flags at the same time
+static void STM32_HAL_WaiterCancel(hal_dma_waiter_t *waiter, uint8_t flag) {
+    stationSysEnterCritical();
+    waiter->pending &= ~flag;
+    waiter->error |= flag;
+    stationSysExitCritical();
+}
+
+// block the task until ISR notifies completion of all the transfers
+static HAL_StatusTypeDef STM32_HAL_WaiterBlock(hal_dma_waiter_t *waiter, uint32_t timeout_ms) {
+    HAL_StatusTypeDef status = HAL_OK;
+    if (waiter->pending == 0)
+        status = HAL_OK;
+    else if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout_ms)) == 0)
+        status = HAL_TIMEOUT;
+    if (status == HAL_OK && waiter->error)
+        status = HAL_ERROR;
+    waiter->task = NULL;
+    return status;
+}
+
+static void STM32_HAL_WaiterNotifyFromISR(hal_dma_waiter_t *waiter, uint8_t flag, uint8_t error) {
+    BaseType_t woken = pdFALSE;
+    if (error)
+        waiter->error |= flag;
+    if ((waiter->pending & flag) == 0)
+        return;
+    waiter->pending &= ~flag;
+    if (waiter->pending == 0 && waiter->task != NULL)
+        vTaskNotifyGiveFromISR(waiter->task, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+// invoked in DMA interrupt once all the conversions of a scan burst are transferred
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc) {
+    if (hadc->Instance == ADC1)
+        STM32_HAL_WaiterNotifyFromISR(&hal_adc_dma_waiter, 0x1, 0);
+}
+
+// overrun or DMA transfer error
+void HAL_ADC_ErrorCallback(ADC_HandleTypeDef *hadc) {
+    if (hadc->Instance == ADC1)
+        STM32_HAL_WaiterNotifyFromISR(&hal_adc_dma_waiter, 0x1, 1);
+}
+
+// invoked in DMA interrupt once all the edges on a pin are captured
+void HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef *htim) {
+    if (htim->Instance == HW_AIRTEMP_TIM)
+        STM32_HAL_WaiterNotifyFromISR(&hal_capture_dma_waiter, (uint8_t)htim->Channel, 0);
+}
+
+void HAL_TIM_ErrorCallback(TIM_HandleTypeDef *htim) {
+    if (htim->Instance == HW_AIRTEMP_TIM)
+        STM32_HAL_WaiterNotifyFromISR(&hal_capture_dma_waiter, (uint8_t)htim->Channel, 1);
+}
+
 void HAL_SPI_MspInit(SPI_HandleTypeDef *hspi) {
     GPIO_InitTypeDef GPIO_InitStruct = {0};
     if (hspi->Instance == SPI2) {
@@ -209,8 +443,9 @@ static gMonStatus STM32_HAL_ADC1_Init(unsigned short num_devices) {
     hadc1.Init.ExternalTrigConv = ADC_SOFTWARE_START;
     hadc1.Init.DataAlign = ADC_DATAALIGN_RIGHT;
     hadc1.Init.NbrOfConversion = num_devices;
+    // DMA stops requesting after the last transfer, each scan burst is started by the sensor task
     hadc1.Init.DMAContinuousRequests = DISABLE;
-    hadc1.Init.EOCSelection = ADC_EOC_SINGLE_CONV;
+    hadc1.Init.EOCSelection = ADC_EOC_SEQ_CONV;
     HAL_StatusTypeDef status = HAL_ADC_Init(&hadc1);
     return (status == HAL_OK ? GMON_RESP_OK : GMON_RESP_ERR);
 }
@@ -238,7 +473,7 @@ gMonStatus stationPlatformInit(void) {
     __HAL_RCC_GPIOC_CLK_ENABLE();
     __HAL_RCC_GPIOB_CLK_ENABLE();
     __HAL_RCC_GPIOA_CLK_ENABLE();
-    unsigned short    num_analog_pins = sizeof(hal_extended_adc_devices);
+    unsigned short    num_analog_pins = HAL_NUM_ADC_DEVICES;
     HAL_StatusTypeDef status = STM32_HAL_ADC1_Init(num_analog_pins);
     if (status != HAL_OK) {
         goto done;
@@ -247,7 +482,15 @@ gMonStatus stationPlatformInit(void) {
     if (status != HAL_OK) {
         goto done;
     }
+    status = STM32_HAL_timer_capture_Init();
+    if (status != HAL_OK) {
+        goto done;
+    }
     status = HAL_TIM_Base_Start(&hal_tim_us);
+    // cycle counter for profilers, see `staPlatformGetCycleCount()`
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
 done:
     return (status == HAL_OK ? GMON_RESP_OK : GMON_RESP_ERR);
 }
@@ -257,6 +500,10 @@ gMonStatus stationPlatformDeinit(void) {
     if (status != HAL_OK) {
         goto done;
     }
+    status = HAL_TIM_IC_DeInit(&hal_tim_capture);
+    if (status != HAL_OK) {
+        goto done;
+    }
     status = HAL_ADC_DeInit(&hadc1);
 done:
     return (status == HAL_OK ? GMON_RESP_OK : GMON_RESP_ERR);
@@ -286,124 +533,85 @@ gMonStatus staSensorPlatformDeInitLight(gMonSensorMeta_t *s) {
     return GMON_RESP_OK;
 }
 
-gMonStatus staPlatformReadSoilMoistSensor(gMonSensorMeta_t *sensor, gmonSensorSample_t *out) {
+// Scan all enabled channels of the sensor for all oversample rounds in one burst. ADC1 runs in continuous
+// scan mode, DMA moves each conversion to the shared buffer without CPU, the caller is blocked until
+// DMA interrupt notifies completion of the transfer, then the results are distributed to sample buffers.
+static gMonStatus
+staPlatformADCscanDMA(gMonSensorMeta_t *sensor, gmonSensorSample_t *out, unsigned char chk_enabled) {
     if (sensor == NULL || out == NULL || sensor->num_items == 0)
         return GMON_RESP_ERRARGS;
     if (out->dtype != GMON_SENSOR_DATA_TYPE_U32)
         return GMON_RESP_ERRARGS;
-    HAL_StatusTypeDef hal_status = HAL_OK;
-    hal_extend_adc_t *adc_devs = (hal_extend_adc_t *)sensor->lowlvl;
-
-    unsigned short k = 0, max_oversample_len = 0;
-    if (adc_devs == NULL)
+    HAL_StatusTypeDef  hal_status = HAL_OK;
+    hal_extend_adc_t  *adc_devs = (hal_extend_adc_t *)sensor->lowlvl;
+    ADC_HandleTypeDef *hadc = NULL;
+    uint8_t            rank_to_item[HAL_NUM_ADC_DEVICES] = {0};
+    unsigned short     k = 0, num_ranks = 0, max_oversample_len = 0, m_round = 0;
+    if (adc_devs == NULL || sensor->num_items > HAL_NUM_ADC_DEVICES)
         return GMON_RESP_ERRARGS;
+    // note in current implementation, all channels comes from the same ADC1 components
+    hadc = adc_devs[0].reference;
 
     for (k = 0; k < sensor->num_items; k++) {
         ADC_ChannelConfTypeDef sConfig = {0};
         if (out[k].data == NULL || out[k].len == 0 || out[k].id != adc_devs[k].app_sensor_id)
             return GMON_RESP_ERRMEM;
-
-        char enabled = staSensorPollEnabled((gMonSoilSensorMeta_t *)sensor, k);
-        if (!enabled)
+        if (out[k].len > HAL_ADC_MAX_ROUNDS)
+            return GMON_RESP_ERRMEM;
+        if (chk_enabled && !staSensorPollEnabled((gMonSoilSensorMeta_t *)sensor, k))
             continue;
+        // disabled channels are left out of the scan sequence
         sConfig.Channel = adc_devs[k].channel;
-        sConfig.Rank = k + 1;
+        sConfig.Rank = num_ranks + 1;
         sConfig.SamplingTime = ADC_SAMPLETIME_15CYCLES;
-
-        hal_status = HAL_ADC_ConfigChannel(adc_devs[k].reference, &sConfig);
+        hal_status = HAL_ADC_ConfigChannel(hadc, &sConfig);
         if (hal_status != HAL_OK)
             goto done;
+        rank_to_item[num_ranks++] = k;
         if (out[k].len > max_oversample_len)
             max_oversample_len = out[k].len;
     }
-    // Perform resampling rounds with start/stop per round
-    for (unsigned short m_round = 0; m_round < max_oversample_len; m_round++) {
-        // Start ADC for this resampling round,
-        // note in current implementation, all channels comes from the same
-        // ADC1 components, simply start ADC1 at here.
-        hal_status = HAL_ADC_Start(adc_devs[0].reference);
-        if (hal_status != HAL_OK)
-            break;
+    if (num_ranks == 0)
+        goto done;
+    // length of regular sequence is only applied in HAL_ADC_Init(), update it for current sensor
+    hadc->Init.NbrOfConversion = num_ranks;
+    MODIFY_REG(hadc->Instance->SQR1, ADC_SQR1_L, ADC_SQR1(num_ranks));
 
-        for (k = 0; k < sensor->num_items; k++) {
-            char enabled = staSensorPollEnabled((gMonSoilSensorMeta_t *)sensor, k);
-            if (!enabled)
-                continue;
-            if (m_round >= out[k].len)
-                continue;
-            hal_status = HAL_ADC_PollForConversion(adc_devs[k].reference, 100);
-            if (hal_status != HAL_OK) {
-                HAL_ADC_Stop(adc_devs[0].reference); // Stop ADC on error before exiting
-                goto done;
-            }
-            uint32_t adc_value = HAL_ADC_GetValue(adc_devs[k].reference);
-            ((unsigned int *)out[k].data)[m_round] = adc_value;
+    STM32_HAL_WaiterArm(&hal_adc_dma_waiter, 0x1);
+    hal_status = HAL_ADC_Start_DMA(hadc, (uint32_t *)hal_adc_dma_buf, num_ranks * max_oversample_len);
+    if (hal_status != HAL_OK)
+        goto done;
+    hal_status = STM32_HAL_WaiterBlock(&hal_adc_dma_waiter, HAL_ADC_DMA_TIMEOUT_MS);
+    HAL_ADC_Stop_DMA(hadc);
+    if (hal_status != HAL_OK)
+        goto done;
+    // buffer layout : [round 0: rank 1, rank 2, ...], [round 1: rank 1, rank 2, ...], ...
+    for (m_round = 0; m_round < max_oversample_len; m_round++) {
+        for (k = 0; k < num_ranks; k++) {
+            gmonSensorSample_t *sample = &out[rank_to_item[k]];
+            if (m_round < sample->len)
+                ((unsigned int *)sample->data)[m_round] = hal_adc_dma_buf[m_round * num_ranks + k];
         }
-        // Stop ADC after all channels for this round are sampled
-        HAL_ADC_Stop(adc_devs[0].reference);
     }
 done:
+    hal_adc_dma_waiter.task = NULL;
+    if (hal_status == HAL_TIMEOUT)
+        return GMON_RESP_TIMEOUT;
     return (hal_status == HAL_OK ? GMON_RESP_OK : GMON_RESP_ERR);
-} // end of staPlatformReadSoilMoistSensor
+} // end of staPlatformADCscanDMA
 
-gMonStatus staPlatformReadLightSensor(gMonSensorMeta_t *sensor, gmonSensorSample_t *out) {
-    if (sensor == NULL || out == NULL || sensor->num_items == 0)
-        return GMON_RESP_ERRARGS;
-    if (out->dtype != GMON_SENSOR_DATA_TYPE_U32)
-        return GMON_RESP_ERRARGS;
-    HAL_StatusTypeDef hal_status = HAL_OK;
-    hal_extend_adc_t *adc_devs = (hal_extend_adc_t *)sensor->lowlvl;
-
-    unsigned short k = 0, max_oversample_len = 0;
-    if (adc_devs == NULL)
-        return GMON_RESP_ERRARGS;
-
-    for (k = 0; k < sensor->num_items; k++) {
-        ADC_ChannelConfTypeDef sConfig = {0};
-        if (out[k].data == NULL || out[k].len == 0 || out[k].id != adc_devs[k].app_sensor_id)
-            return GMON_RESP_ERRMEM;
-
-        sConfig.Channel = adc_devs[k].channel;
-        sConfig.Rank = k + 1;
-        sConfig.SamplingTime = ADC_SAMPLETIME_15CYCLES;
-        hal_status = HAL_ADC_ConfigChannel(adc_devs[k].reference, &sConfig);
-        if (hal_status != HAL_OK)
-            goto done;
-        if (out[k].len > max_oversample_len)
-            max_oversample_len = out[k].len;
-    }
-    // Perform resampling rounds with start/stop per round
-    for (unsigned short m_round = 0; m_round < max_oversample_len; m_round++) {
-        // Start ADC for this resampling round,
-        // note in current implementation, all channels comes from the same
-        // ADC1 components, simply start ADC1 at here.
-        hal_status = HAL_ADC_Start(adc_devs[0].reference);
-        if (hal_status != HAL_OK)
-            break;
+gMonStatus staPlatformReadSoilMoistSensor(gMonSensorMeta_t *sensor, gmonSensorSample_t *out) {
+    return staPlatformADCscanDMA(sensor, out, 1);
+}
 
-        for (k = 0; k < sensor->num_items; k++) {
-            if (m_round >= out[k].len)
-                continue;
-            hal_status = HAL_ADC_PollForConversion(adc_devs[k].reference, 80);
-            if (hal_status != HAL_OK) {
-                HAL_ADC_Stop(adc_devs[0].reference); // Stop ADC on error before exiting
-                goto done;
-            }
-            uint32_t adc_value = HAL_ADC_GetValue(adc_devs[k].reference);
-            ((unsigned int *)out[k].data)[m_round] = adc_value;
-        }
-        // Stop ADC after all channels for this round are sampled
-        HAL_ADC_Stop(adc_devs[0].reference);
-    }
-done:
-    return (hal_status == HAL_OK ? GMON_RESP_OK : GMON_RESP_ERR);
-} // end of staPlatformReadLightSensor
+gMonStatus staPlatformReadLightSensor(gMonSensorMeta_t *sensor, gmonSensorSample_t *out) {
+    return staPlatformADCscanDMA(sensor, out, 0);
+}
 
 gMonStatus staSensorPlatformInitAirTemp(gMonSensorMeta_t *s) {
-    if (s == NULL || s->num_items != 1)
+    if (s == NULL || s->num_items == 0 || s->num_items > HAL_NUM_AIR_SENSOR_PINS)
         return GMON_RESP_ERRARGS;
-    void **pinstruct = &s->lowlvl;
-    *(hal_pinout_t **)pinstruct = hal_air_temp_read_pin;
+    s->lowlvl = (void *)hal_air_temp_pins;
     return GMON_RESP_OK;
 }
 
@@ -498,28 +706,75 @@ gMonStatus staPlatformDelayUs(uint16_t us) {
     return GMON_RESP_OK;
 }
 
-gMonStatus staPlatformMeasurePulse(void *pinstruct, uint8_t *direction, uint16_t *us) {
-    if (pinstruct == NULL || direction == NULL || us == NULL) {
+static hal_capture_pinout_t *STM32_HAL_CapturePin(void *pinstruct) {
+    for (uint8_t idx = 0; idx < HAL_NUM_AIR_SENSOR_PINS; idx++) {
+        if (pinstruct == &hal_air_temp_read_pin[idx].super)
+            return &hal_air_temp_read_pin[idx];
+    }
+    return NULL;
+}
+
+gMonStatus staPlatformCaptureEdgesMulti(
+    void **pinstructs, uint8_t num_pins, uint16_t *edges_us, uint16_t num_edges, uint16_t timeout_ms,
+    gMonStatus *pin_status
+) {
+    if (pinstructs == NULL || num_pins == 0 || num_pins > HAL_NUM_AIR_SENSOR_PINS || edges_us == NULL ||
+        num_edges == 0 || pin_status == NULL) {
         return GMON_RESP_ERRARGS;
     }
-    hal_pinout_t *hal_pinstruct = (hal_pinout_t *)pinstruct;
-    uint32_t      current_counter;
-    // reset timer to zero
-    __HAL_TIM_SET_COUNTER(&hal_tim_us, 0);
-    // read initial state of the given GPIO pin pinstruct, record it to a local variable, say s0
-    GPIO_PinState s0 = HAL_GPIO_ReadPin(hal_pinstruct->port, hal_pinstruct->pin);
-    // read the same GPIO pin in a loop until the state is changed.
-    do {
-        current_counter = __HAL_TIM_GET_COUNTER(&hal_tim_us);
-        // if the timer value is about to exceed its max representable value, return appropriate error
-        if (current_counter >= 0xFF80) { // max limited period is 0xFF80. Check before it wraps.
-            return GMON_RESP_TIMEOUT;    // Represents a "read sensor timeout"
+    hal_capture_pinout_t *caps[HAL_NUM_AIR_SENSOR_PINS] = {0};
+    GPIO_InitTypeDef      GPIO_InitStruct = {0};
+    HAL_StatusTypeDef     status = HAL_OK;
+    uint8_t               idx = 0, flags = 0;
+    for (idx = 0; idx < num_pins; idx++) {
+        caps[idx] = STM32_HAL_CapturePin(pinstructs[idx]);
+        if (caps[idx] == NULL || (flags & caps[idx]->active)) {
+            return GMON_RESP_ERR_NOT_SUPPORT;
         }
-    } while (HAL_GPIO_ReadPin(hal_pinstruct->port, hal_pinstruct->pin) == s0);
-    // retrieve timer value , write it to given argument us
-    *us = (uint16_t)current_counter;
-    *direction = (s0 == GPIO_PIN_RESET) ? 1 : 0;
+        flags |= caps[idx]->active;
+    }
+    // each edge triggers one DMA request, CPU is not involved until all the frames are captured
+    STM32_HAL_WaiterArm(&hal_capture_dma_waiter, flags);
+    // the caller keeps the bus LOW, the sensor responds 20-40 us after it is released. Arming and
+    // releasing are not preempted, otherwise the acknowledgment might be missed.
+    stationSysEnterCritical();
+    for (idx = 0; idx < num_pins; idx++) {
+        status = HAL_TIM_IC_Start_DMA(
+            caps[idx]->timer, caps[idx]->channel, (uint32_t *)&edges_us[idx * num_edges], num_edges
+        );
+        if (status != HAL_OK) {
+            STM32_HAL_WaiterCancel(&hal_capture_dma_waiter, caps[idx]->active);
+            continue;
+        }
+        // switch the pin to the timer channel after capture started, this releases the bus which is
+        // pulled HIGH by resistor, the rising edge is captured first, then the edges from the sensor
+        GPIO_InitStruct.Pin = caps[idx]->super.pin;
+        GPIO_InitStruct.Mode = GPIO_MODE_AF_OD;
+        GPIO_InitStruct.Pull = GPIO_NOPULL;
+        GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+        GPIO_InitStruct.Alternate = caps[idx]->super.alternate;
+        HAL_GPIO_Init(caps[idx]->super.port, &GPIO_InitStruct);
+    }
+    stationSysExitCritical();
+    STM32_HAL_WaiterBlock(&hal_capture_dma_waiter, timeout_ms);
+    for (idx = 0; idx < num_pins; idx++) {
+        HAL_TIM_IC_Stop_DMA(caps[idx]->timer, caps[idx]->channel);
+        if (hal_capture_dma_waiter.error & caps[idx]->active)
+            pin_status[idx] = GMON_RESP_ERR;
+        else if (hal_capture_dma_waiter.pending & caps[idx]->active)
+            pin_status[idx] = GMON_RESP_TIMEOUT; // Represents a "read sensor timeout"
+        else
+            pin_status[idx] = GMON_RESP_OK;
+    }
     return GMON_RESP_OK;
+} // end of staPlatformCaptureEdgesMulti
+
+gMonStatus
+staPlatformCaptureEdges(void *pinstruct, uint16_t *edges_us, uint16_t num_edges, uint16_t timeout_ms) {
+    gMonStatus pin_status = GMON_RESP_ERR;
+    gMonStatus status =
+        staPlatformCaptureEdgesMulti(&pinstruct, 1, edges_us, num_edges, timeout_ms, &pin_status);
+    return (status == GMON_RESP_OK) ? pin_status : status;
 }
 
 gMonStatus staPlatformPinSetDirection(void *pinstruct, uint8_t direction) {
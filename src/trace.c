@@ -0,0 +1,139 @@
+#include "station_include.h"
+
+#ifdef GMON_CFG_ENABLE_TRACE
+uint32_t gmon_trace_mem[GMON_TRACE_RING_NWORDS(GMON_CFG_TRACE_NUM_ENTRIES)];
+#endif
+
+static const char *gmon_trace_task_names[GMON_TRACE_NUM_TASKS] = {
+    [GMON_TRACE_TASK_SENSOR] = "sensorSched",
+    [GMON_TRACE_TASK_DATALOG] = "DataLogger",
+    [GMON_TRACE_TASK_NETCONN] = "netConnHandler",
+    [GMON_TRACE_TASK_DISPLAY] = "DisplayHandler",
+};
+
+static const char *gmon_trace_event_names[GMON_TRACE_NUM_EVENTS] = {
+    [GMON_TRACE_EVT_SENSOR_PIPELINE_BEGIN] = "sensor pipeline",
+    [GMON_TRACE_EVT_SENSOR_PIPELINE_END] = "sensor pipeline",
+    [GMON_TRACE_EVT_SENSOR_NOTIFY] = "notify sensor event",
+    [GMON_TRACE_EVT_DATALOG_BEGIN] = "log sensor event",
+    [GMON_TRACE_EVT_DATALOG_END] = "log sensor event",
+    [GMON_TRACE_EVT_NETCONN_BEGIN] = "network cycle",
+    [GMON_TRACE_EVT_NETCONN_END] = "network cycle",
+    [GMON_TRACE_EVT_DISPLAY_REFRESH_BEGIN] = "display refresh",
+    [GMON_TRACE_EVT_DISPLAY_REFRESH_END] = "display refresh",
+};
+
+// number of half periods of the cycle counter passed, its lowest bit follows the top bit of the counter
+static atomic_uint gmon_trace_cycle_epoch;
+
+static unsigned int staTraceCyclesEpoch(uint32_t cycles) {
+    unsigned int epoch = atomic_load_explicit(&gmon_trace_cycle_epoch, memory_order_relaxed);
+    while ((epoch & 1U) != (cycles >> 31)) {
+        if ((cycles & 0x40000000U) && epoch > 0) {
+            // still in the last quarter of previous half, the caller was preempted after reading the
+            // counter and someone else has moved on to the next half
+            epoch--;
+            break;
+        }
+        // top bit flipped since the last timestamp, unless another writer just did the same
+        if (atomic_compare_exchange_weak_explicit(
+                &gmon_trace_cycle_epoch, &epoch, epoch + 1, memory_order_relaxed, memory_order_relaxed
+            )) {
+            epoch++;
+            break;
+        }
+    }
+    return epoch;
+}
+
+void staTraceCyclesTrack(uint32_t cycles) { (void)staTraceCyclesEpoch(cycles); }
+
+uint32_t staTraceCyclesToUs(uint32_t cycles, unsigned int cycles_per_us) {
+    uint64_t total = ((uint64_t)(staTraceCyclesEpoch(cycles) >> 1) << 32) | cycles;
+    return (uint32_t)(total / (cycles_per_us ? cycles_per_us : 1));
+}
+
+gMonStatus staTraceRingInit(gMonTraceRing_t *ring, unsigned int nbytes) {
+    unsigned int capacity = 0;
+    if (ring == NULL || nbytes <= sizeof(gMonTraceRing_t))
+        return GMON_RESP_ERRARGS;
+    capacity = (nbytes - sizeof(gMonTraceRing_t)) / sizeof(gmonTraceEntry_t);
+    // round down to power of 2, so the position in the ring is found by masking the sequence number
+    while (capacity & (capacity - 1))
+        capacity &= capacity - 1;
+    if (capacity == 0 || capacity > 0x8000)
+        return GMON_RESP_ERRARGS;
+    XMEMSET(ring, 0x00, sizeof(gMonTraceRing_t) + sizeof(gmonTraceEntry_t) * capacity);
+    ring->version = GMON_TRACE_RING_VERSION;
+    ring->capacity = (uint16_t)capacity;
+    atomic_store_explicit(&ring->head, 0, memory_order_relaxed);
+    // writers check the magic number, so they never touch the ring before it is ready
+    atomic_thread_fence(memory_order_release);
+    ring->magic = GMON_TRACE_RING_MAGIC;
+    return GMON_RESP_OK;
+}
+
+void staTraceRingRecord(gMonTraceRing_t *ring, uint8_t task_id, uint8_t event_id, int16_t arg) {
+    if (ring == NULL || ring->magic != GMON_TRACE_RING_MAGIC)
+        return;
+    uint32_t          ts_us = GMON_TRACE_TIMESTAMP_US();
+    unsigned int      seq = atomic_fetch_add_explicit(&ring->head, 1, memory_order_relaxed);
+    gmonTraceEntry_t *entry = &ring->entries[seq & (ring->capacity - 1)];
+    atomic_store_explicit((atomic_uint *)&entry->seq, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    entry->ts_us = ts_us;
+    entry->arg = arg;
+    entry->task_id = task_id;
+    entry->event_id = event_id;
+    atomic_store_explicit((atomic_uint *)&entry->seq, seq + 1, memory_order_release);
+}
+
+unsigned int staTraceRingSnapshot(gMonTraceRing_t *ring, gmonTraceEntry_t *out, unsigned int max_entries) {
+    unsigned int head = 0, seq = 0, num_copied = 0;
+    if (ring == NULL || out == NULL || ring->magic != GMON_TRACE_RING_MAGIC)
+        return 0;
+    head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    seq = (head > ring->capacity) ? (head - ring->capacity) : 0;
+    for (; seq < head && num_copied < max_entries; seq++) {
+        gmonTraceEntry_t *entry = &ring->entries[seq & (ring->capacity - 1)];
+        if (atomic_load_explicit((atomic_uint *)&entry->seq, memory_order_acquire) != seq + 1)
+            continue; // still being written, or overwritten by newer entry
+        out[num_copied] = *entry;
+        atomic_thread_fence(memory_order_acquire);
+        // skip the entry if a writer took over the slot while it was copied
+        if (atomic_load_explicit((atomic_uint *)&entry->seq, memory_order_relaxed) == seq + 1)
+            num_copied++;
+    }
+    return num_copied;
+}
+
+unsigned int staTraceRingDumpSize(const gMonTraceRing_t *ring) {
+    if (ring == NULL || ring->magic != GMON_TRACE_RING_MAGIC)
+        return 0;
+    return sizeof(gMonTraceRing_t) + sizeof(gmonTraceEntry_t) * ring->capacity;
+}
+
+const char *staTraceTaskName(uint8_t task_id) {
+    return (task_id < GMON_TRACE_NUM_TASKS) ? gmon_trace_task_names[task_id] : NULL;
+}
+
+const char *staTraceEventName(uint8_t event_id) {
+    return (event_id < GMON_TRACE_NUM_EVENTS) ? gmon_trace_event_names[event_id] : NULL;
+}
+
+char staTraceEventPhase(uint8_t event_id) {
+    switch (event_id) {
+    case GMON_TRACE_EVT_SENSOR_PIPELINE_BEGIN:
+    case GMON_TRACE_EVT_DATALOG_BEGIN:
+    case GMON_TRACE_EVT_NETCONN_BEGIN:
+    case GMON_TRACE_EVT_DISPLAY_REFRESH_BEGIN:
+        return 'B';
+    case GMON_TRACE_EVT_SENSOR_PIPELINE_END:
+    case GMON_TRACE_EVT_DATALOG_END:
+    case GMON_TRACE_EVT_NETCONN_END:
+    case GMON_TRACE_EVT_DISPLAY_REFRESH_END:
+        return 'E';
+    default:
+        return 'i';
+    }
+}
@@ -49,6 +49,20 @@ unsigned int stationGetDays(gmonTick_t *tick_info) {
     return tick_info->days;
 }
 
+// advance absolute wakeup time by one period, return time to sleep until the new wakeup time. If the
+// caller is already behind by whole period, the wakeup time is re-aligned to current time, the missed
+// periods are skipped instead of running back-to-back.
+unsigned int staNextWakeupMs(unsigned int *prev_wake_ms, unsigned int period_ms, unsigned int now_ms) {
+    unsigned int next_ms = *prev_wake_ms + period_ms;
+    int          remain = (int)(next_ms - now_ms);
+    if (remain <= -(int)period_ms) {
+        next_ms = now_ms;
+        remain = 0;
+    }
+    *prev_wake_ms = next_ms;
+    return (remain > 0) ? (unsigned int)remain : 0;
+}
+
 // Hoare Partition Scheme implementation,
 // partition given integer array with given pivot
 unsigned short staPartitionIntArray(unsigned int *list, unsigned short len) {
@@ -259,3 +273,40 @@ int staCvtIntFromStr(unsigned char *str, size_t sz) {
     }
     return out;
 }
+
+gMonStatus staArenaInit(gMonArena_t *arena, void *mem, unsigned int len) {
+    if (arena == NULL || (mem == NULL && len > 0) || ((uintptr_t)mem & (GMON_ARENA_ALIGN - 1)) != 0)
+        return GMON_RESP_ERRARGS;
+    arena->mem = (unsigned char *)mem;
+    arena->len = len;
+    arena->used = 0;
+    return GMON_RESP_OK;
+}
+
+void *staArenaCalloc(gMonArena_t *arena, unsigned int num, unsigned int size) {
+    unsigned int offset = 0, nbytes = num * size;
+    if (arena == NULL || num == 0 || size == 0 || (nbytes / size) != num)
+        return NULL;
+    if (arena->mem == NULL)
+        return XCALLOC(num, size);
+    offset = (arena->used + GMON_ARENA_ALIGN - 1) & ~(GMON_ARENA_ALIGN - 1);
+    if (offset > arena->len || nbytes > (arena->len - offset))
+        return NULL;
+    arena->used = offset + nbytes;
+    XMEMSET(&arena->mem[offset], 0x00, nbytes);
+    return &arena->mem[offset];
+}
+
+void staArenaFree(gMonArena_t *arena, void *ptr) {
+    unsigned char *p = (unsigned char *)ptr;
+    if (p == NULL)
+        return;
+    if (arena != NULL && arena->mem != NULL && p >= arena->mem && p < &arena->mem[arena->len])
+        return;
+    XMEMFREE(ptr);
+}
+
+void staArenaReset(gMonArena_t *arena) {
+    if (arena != NULL)
+        arena->used = 0;
+}
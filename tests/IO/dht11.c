@@ -0,0 +1,197 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "station_include.h"
+
+#define UTEST_DHT11_NUM_EDGES   (1 + 3 + (40 << 1) + 1)
+#define UTEST_DHT11_NUM_SENSORS 3
+
+static gMonSensorMeta_t   utest_air_meta;
+static gmonAirCond_t      utest_air_data[UTEST_DHT11_NUM_SENSORS][2];
+static gmonSensorSample_t utest_air_samples[UTEST_DHT11_NUM_SENSORS];
+static uint16_t           utest_waveform[UTEST_DHT11_NUM_SENSORS][UTEST_DHT11_NUM_EDGES];
+static unsigned char      utest_pin_dummy[UTEST_DHT11_NUM_SENSORS];
+static void              *utest_signal_pins[UTEST_DHT11_NUM_SENSORS];
+// tick count at the end of warm-up, the sensors are initialized at tick 0
+static const uint32_t utest_tick_ready = 1000 / GMON_NUM_MILLISECONDS_PER_TICK;
+
+// record edges of a frame on given sensor, as captured by timer which starts counting at `start_us`,
+// `high_us` is length of HIGH pulse of each data bit with value '1'. Same as the hardware, the first
+// edge is the bus released by MCU, the sensor responds 30 us later.
+static void
+utestDHT11Waveform(unsigned char sensor_idx, const uint8_t data[5], uint16_t start_us, uint16_t high_us) {
+    uint16_t *wave = utest_waveform[sensor_idx];
+    uint16_t  now_us = start_us, idx = 0, num = 0;
+    wave[num++] = now_us;
+    wave[num++] = (now_us += 30);
+    wave[num++] = (now_us += 82);
+    wave[num++] = (now_us += 79);
+    for (idx = 0; idx < 40; idx++) {
+        wave[num++] = (now_us += 51);
+        wave[num++] = (now_us += ((data[idx >> 3] >> (7 - (idx & 0x7))) & 0x1) ? high_us : 26);
+    }
+    wave[num++] = (now_us += 49);
+    TEST_ASSERT_EQUAL_UINT16(UTEST_DHT11_NUM_EDGES, num);
+    UTestPlatformSetCapturedEdges(utest_signal_pins[sensor_idx], wave, num);
+}
+
+TEST_GROUP(DHT11Capture);
+
+TEST_SETUP(DHT11Capture) {
+    XMEMSET(&utest_air_meta, 0x00, sizeof(gMonSensorMeta_t));
+    setMockTickCount(0);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staSensorInitAirTemp(&utest_air_meta));
+    XMEMSET(utest_air_data, 0x00, sizeof(utest_air_data));
+    for (unsigned char idx = 0; idx < UTEST_DHT11_NUM_SENSORS; idx++) {
+        utest_signal_pins[idx] = &utest_pin_dummy[idx];
+        utest_air_samples[idx] = (gmonSensorSample_t){
+            .id = idx + 1, .dtype = GMON_SENSOR_DATA_TYPE_AIRCOND, .len = 2, .data = utest_air_data[idx]
+        };
+    }
+    utest_air_meta.lowlvl = utest_signal_pins;
+    utest_air_meta.num_items = 1;
+    utest_air_meta.num_resamples = 1;
+    setMockTickCount(utest_tick_ready);
+}
+
+TEST_TEAR_DOWN(DHT11Capture) { UTestPlatformSetCapturedEdges(NULL, NULL, 0); }
+
+TEST(DHT11Capture, DecodeFrame) {
+    const uint8_t data[5] = {55, 0, 23, 4, (55 + 23 + 4) & 0xff};
+    utestDHT11Waveform(0, data, 0x100, 70);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staSensorReadAirTemp(&utest_air_meta, utest_air_samples));
+    TEST_ASSERT_EQUAL_FLOAT(55.f, utest_air_data[0][0].humidity);
+    TEST_ASSERT_EQUAL_FLOAT(23.4f, utest_air_data[0][0].temporature);
+}
+
+TEST(DHT11Capture, CounterWrapAround) {
+    const uint8_t data[5] = {0xff, 0x80, 0x01, 0x7f, (0xff + 0x80 + 0x01 + 0x7f) & 0xff};
+    // counter wraps around in the middle of the frame
+    utestDHT11Waveform(0, data, 0xfe00, 62);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staSensorReadAirTemp(&utest_air_meta, utest_air_samples));
+    TEST_ASSERT_EQUAL_FLOAT(0xff + 0x80 / 10.f, utest_air_data[0][0].humidity);
+    TEST_ASSERT_EQUAL_FLOAT(0x01 + 0x7f / 10.f, utest_air_data[0][0].temporature);
+}
+
+TEST(DHT11Capture, ChecksumMismatch) {
+    const uint8_t data[5] = {40, 0, 20, 0, 61};
+    utestDHT11Waveform(0, data, 0, 70);
+    TEST_ASSERT_EQUAL(GMON_RESP_SENSOR_FAIL, staSensorReadAirTemp(&utest_air_meta, utest_air_samples));
+}
+
+TEST(DHT11Capture, InvalidPulse) {
+    const uint8_t data[5] = {40, 0, 20, 0, 60};
+    // HIGH pulse within allowed range of the protocol, but neither '0' nor '1'
+    utestDHT11Waveform(0, data, 0, 45);
+    TEST_ASSERT_EQUAL(GMON_RESP_SENSOR_FAIL, staSensorReadAirTemp(&utest_air_meta, utest_air_samples));
+    // LOW pulse of a data bit is too long
+    utestDHT11Waveform(0, data, 0, 70);
+    for (uint16_t idx = 10; idx < UTEST_DHT11_NUM_EDGES; idx++)
+        utest_waveform[0][idx] += 20;
+    TEST_ASSERT_EQUAL(GMON_RESP_ERR_MSG_DECODE, staSensorReadAirTemp(&utest_air_meta, utest_air_samples));
+}
+
+TEST(DHT11Capture, IncompleteFrame) {
+    const uint8_t data[5] = {40, 0, 20, 0, 60};
+    utestDHT11Waveform(0, data, 0, 70);
+    UTestPlatformSetCapturedEdges(utest_signal_pins[0], utest_waveform[0], UTEST_DHT11_NUM_EDGES - 1);
+    TEST_ASSERT_EQUAL(GMON_RESP_TIMEOUT, staSensorReadAirTemp(&utest_air_meta, utest_air_samples));
+}
+
+TEST(DHT11Capture, MultiSensors) {
+    const uint8_t data[UTEST_DHT11_NUM_SENSORS][5] = {
+        {50, 0, 21, 0, 71},
+        {60, 0, 22, 5, 87},
+        {70, 0, 23, 9, 102},
+    };
+    unsigned char idx = 0, jdx = 0;
+    utest_air_meta.num_items = UTEST_DHT11_NUM_SENSORS;
+    utest_air_meta.num_resamples = 2;
+    for (idx = 0; idx < UTEST_DHT11_NUM_SENSORS; idx++)
+        utestDHT11Waveform(idx, data[idx], idx * 0x30, 70);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staSensorReadAirTemp(&utest_air_meta, utest_air_samples));
+    for (idx = 0; idx < UTEST_DHT11_NUM_SENSORS; idx++) {
+        for (jdx = 0; jdx < 2; jdx++) {
+            TEST_ASSERT_EQUAL_FLOAT(data[idx][0], utest_air_data[idx][jdx].humidity);
+            TEST_ASSERT_EQUAL_FLOAT(data[idx][2] + data[idx][3] / 10.f, utest_air_data[idx][jdx].temporature);
+        }
+    }
+    // the task sleeps until the longest frame is captured in each round
+    unsigned int frame_ms = 0, expect_ms = 0;
+    for (idx = 0; idx < UTEST_DHT11_NUM_SENSORS; idx++) {
+        frame_ms = (uint16_t)(utest_waveform[idx][UTEST_DHT11_NUM_EDGES - 1] - utest_waveform[idx][0]);
+        frame_ms = (frame_ms + 999) / 1000;
+#ifdef GMON_CFG_AIR_SENSOR_CONCURRENT_READ
+        expect_ms = (expect_ms < frame_ms) ? frame_ms : expect_ms;
+#else
+        expect_ms += frame_ms;
+#endif
+    }
+    TEST_ASSERT_EQUAL_UINT32(
+        expect_ms * 2, (g_mock_tick_count - utest_tick_ready) * GMON_NUM_MILLISECONDS_PER_TICK
+    );
+}
+
+TEST(DHT11Capture, MultiSensorsPartialFail) {
+    const uint8_t data[5] = {40, 0, 20, 0, 60};
+    utest_air_meta.num_items = UTEST_DHT11_NUM_SENSORS;
+    utestDHT11Waveform(0, data, 0, 70);
+    utestDHT11Waveform(2, data, 0, 70);
+    // sensor in the middle does not respond, the others are still decoded
+    TEST_ASSERT_EQUAL(GMON_RESP_TIMEOUT, staSensorReadAirTemp(&utest_air_meta, utest_air_samples));
+    TEST_ASSERT_EQUAL_FLOAT(40.f, utest_air_data[0][0].humidity);
+    TEST_ASSERT_EQUAL_FLOAT(0.f, utest_air_data[1][0].humidity);
+    TEST_ASSERT_EQUAL_FLOAT(40.f, utest_air_data[2][0].humidity);
+}
+
+TEST(DHT11Capture, MiddleRoundFail) {
+    const uint8_t data[5] = {40, 0, 20, 0, 60};
+    utest_air_meta.num_items = 2;
+    utest_air_meta.num_resamples = 3;
+    utest_air_samples[0].len = utest_air_samples[1].len = 3;
+    gmonAirCond_t air_data[2][3] = {0};
+    utest_air_samples[0].data = air_data[0];
+    utest_air_samples[1].data = air_data[1];
+    utestDHT11Waveform(0, data, 0, 70);
+    utestDHT11Waveform(1, data, 0, 70);
+    // second sensor does not respond in the second round only, the last round succeeds
+    UTestPlatformFailCapture(utest_signal_pins[1], 2);
+    TEST_ASSERT_EQUAL(GMON_RESP_TIMEOUT, staSensorReadAirTemp(&utest_air_meta, utest_air_samples));
+    for (unsigned char idx = 0; idx < 3; idx++)
+        TEST_ASSERT_EQUAL_FLOAT(40.f, air_data[0][idx].humidity);
+    TEST_ASSERT_EQUAL_FLOAT(40.f, air_data[1][0].humidity);
+    TEST_ASSERT_EQUAL_FLOAT(0.f, air_data[1][1].humidity);
+    TEST_ASSERT_EQUAL_FLOAT(40.f, air_data[1][2].humidity);
+}
+
+TEST(DHT11Capture, SkipUntilWarmUp) {
+    const uint8_t data[5] = {55, 0, 23, 4, (55 + 23 + 4) & 0xff};
+    unsigned char num_resamples = utest_air_meta.num_resamples;
+    setMockTickCount(0x20);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staSensorInitAirTemp(&utest_air_meta));
+    utest_air_meta.num_items = 1;
+    utest_air_meta.num_resamples = num_resamples;
+    utestDHT11Waveform(0, data, 0x100, 70);
+    // the read neither blocks nor sends start signal before the sensor warms up
+    setMockTickCount(0x20 + 999 / GMON_NUM_MILLISECONDS_PER_TICK);
+    TEST_ASSERT_EQUAL(GMON_RESP_SKIP, staSensorReadAirTemp(&utest_air_meta, utest_air_samples));
+    TEST_ASSERT_EQUAL_UINT32(0x20 + 999 / GMON_NUM_MILLISECONDS_PER_TICK, g_mock_tick_count);
+    TEST_ASSERT_EQUAL_FLOAT(0.f, utest_air_data[0][0].humidity);
+    setMockTickCount(0x20 + 1000 / GMON_NUM_MILLISECONDS_PER_TICK);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staSensorReadAirTemp(&utest_air_meta, utest_air_samples));
+    TEST_ASSERT_EQUAL_FLOAT(55.f, utest_air_data[0][0].humidity);
+    // warm-up happens only once, no matter how far the tick counter moves afterwards
+    setMockTickCount(0x10);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staSensorReadAirTemp(&utest_air_meta, utest_air_samples));
+}
+
+TEST_GROUP_RUNNER(gMonDHT11) {
+    RUN_TEST_CASE(DHT11Capture, DecodeFrame);
+    RUN_TEST_CASE(DHT11Capture, CounterWrapAround);
+    RUN_TEST_CASE(DHT11Capture, ChecksumMismatch);
+    RUN_TEST_CASE(DHT11Capture, InvalidPulse);
+    RUN_TEST_CASE(DHT11Capture, IncompleteFrame);
+    RUN_TEST_CASE(DHT11Capture, MultiSensors);
+    RUN_TEST_CASE(DHT11Capture, MultiSensorsPartialFail);
+    RUN_TEST_CASE(DHT11Capture, MiddleRoundFail);
+    RUN_TEST_CASE(DHT11Capture, SkipUntilWarmUp);
+}
@@ -33,6 +33,10 @@ TEST(RenderPrintText, InitOk) {
     TEST_ASSERT_EQUAL(11, test_gmon.display.fonts[0].width);
     TEST_ASSERT_EQUAL(18, test_gmon.display.fonts[0].height);
     TEST_ASSERT_NOT_EQUAL(NULL, test_gmon.display.fonts[0].bitmap);
+    TEST_ASSERT_EQUAL(6, test_gmon.display.fonts[1].width);
+    TEST_ASSERT_EQUAL(8, test_gmon.display.fonts[1].height);
+    TEST_ASSERT_NOT_EQUAL(NULL, test_gmon.display.fonts[1].bitmap);
+    TEST_ASSERT_NOT_EQUAL(NULL, test_gmon.display.fonts[1].advance);
     // Verify scroll speed configuration
     TEST_ASSERT_EQUAL(4, test_gmon.display.config.scroll_speed);
     TEST_ASSERT_EQUAL(GMON_DISPLAY_NUM_PRINT_STRINGS, test_gmon.display.num_blocks);
@@ -273,6 +277,61 @@ TEST(RenderPrintText, AppFailure) {
     TEST_ASSERT_EQUAL_STRING_LEN("Status:0", info3->str.data, info3->str.nbytes_written);
 }
 
+TEST(RenderPrintText, TextPixelWidth) {
+    gmonPrintFont_t  mono_font = {.width = 7, .height = 9, .bitmap = NULL, .advance = NULL};
+    gmonPrintFont_t *compact_font = &test_gmon.display.fonts[1];
+    unsigned char    rawtxt[] = "ab c\x00\x00\x00";
+    gmonStr_t        str = {.len = sizeof(rawtxt) - 1, .nbytes_written = 4, .data = rawtxt};
+    TEST_ASSERT_EQUAL(7, staDisplayGlyphAdvance(&mono_font, 'x'));
+    TEST_ASSERT_EQUAL(7, staDisplayGlyphAdvance(&mono_font, ' '));
+    TEST_ASSERT_EQUAL(0, staDisplayGlyphAdvance(&mono_font, '\n'));
+    TEST_ASSERT_EQUAL(0, staDisplayGlyphAdvance(&mono_font, 0x7F));
+    TEST_ASSERT_EQUAL(0, staDisplayGlyphAdvance(NULL, 'x'));
+    TEST_ASSERT_EQUAL(6, staDisplayGlyphAdvance(compact_font, 'x'));
+    TEST_ASSERT_EQUAL(3, staDisplayGlyphAdvance(compact_font, ' '));
+    // counting stops at NULL terminator
+    TEST_ASSERT_EQUAL(7 * 4, staDisplayStrPixelWidth(&mono_font, &str));
+    TEST_ASSERT_EQUAL(6 * 3 + 3, staDisplayStrPixelWidth(compact_font, &str));
+    str.data = NULL;
+    TEST_ASSERT_EQUAL(0, staDisplayStrPixelWidth(compact_font, &str));
+}
+
+TEST(RenderPrintText, LayoutSelectFont) {
+    gMonDisplayContext_t *ctx = &test_gmon.display;
+    gmonPrintInfo_t      *info = &ctx->blocks[GMON_BLOCK_ACTUATOR_THRESHOLD].content;
+    unsigned char         rawtxt[24] = {0};
+    gmonStr_t             origin_str = info->str;
+    const unsigned short  scr_width = 120;
+    info->str.data = rawtxt;
+    info->str.len = sizeof(rawtxt);
+    // short text fits the screen in the largest font
+    XMEMCPY(rawtxt, "PC:8001234", 10);
+    info->posx = -15;
+    gMonStatus status = staDisplayLayoutBlock(ctx, info, scr_width);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, status);
+    TEST_ASSERT_EQUAL_PTR(&ctx->fonts[0], info->font);
+    TEST_ASSERT_EQUAL(-15, info->posx); // font unchanged, keep scrolling position
+    // text only fits the screen in compact font, 125 pixels in 11x18 font, 73 pixels in 6x8 font
+    XMEMCPY(rawtxt, "PC:8001234567", 13);
+    status = staDisplayLayoutBlock(ctx, info, scr_width);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, status);
+    TEST_ASSERT_EQUAL_PTR(&ctx->fonts[1], info->font);
+    TEST_ASSERT_EQUAL(0, info->posx);
+    // none of the fonts fits, the smallest one is still selected
+    XMEMSET(rawtxt, 'x', sizeof(rawtxt));
+    status = staDisplayLayoutBlock(ctx, info, 60);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, status);
+    TEST_ASSERT_EQUAL_PTR(&ctx->fonts[1], info->font);
+    // switch back to large font once the text becomes short
+    XMEMSET(rawtxt, 0, sizeof(rawtxt));
+    XMEMCPY(rawtxt, "Status:-3", 9);
+    status = staDisplayLayoutBlock(ctx, info, scr_width);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, status);
+    TEST_ASSERT_EQUAL_PTR(&ctx->fonts[0], info->font);
+    TEST_ASSERT_EQUAL(GMON_RESP_ERRARGS, staDisplayLayoutBlock(NULL, info, scr_width));
+    info->str = origin_str;
+}
+
 TEST_GROUP_RUNNER(gMonDisplay) {
     RUN_TEST_CASE(RenderPrintText, InitOk);
     RUN_TEST_CASE(RenderPrintText, SoilSensorLogOk);
@@ -280,4 +339,6 @@ TEST_GROUP_RUNNER(gMonDisplay) {
     RUN_TEST_CASE(RenderPrintText, LightSensorLogOk);
     RUN_TEST_CASE(RenderPrintText, ActuatorStateOk);
     RUN_TEST_CASE(RenderPrintText, AppFailure);
+    RUN_TEST_CASE(RenderPrintText, TextPixelWidth);
+    RUN_TEST_CASE(RenderPrintText, LayoutSelectFont);
 }
@@ -0,0 +1,199 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <unistd.h>
+#include "unity.h"
+#include "unity_fixture.h"
+#include "station_include.h"
+#include "oled_emu.h"
+
+#define UTEST_OLED_BENCH_NUM_ROUNDS 200
+
+static gardenMonitor_t utest_oled_gmon = {0};
+
+// pixel expected on the panel after the driver prints `txt` with given font at (posx, posy)
+static uint8_t utestExpectedPixel(
+    const gmonPrintFont_t *font, const char *txt, short posx, short posy, uint16_t x, uint16_t y
+) {
+    int            vx = (int)x - posx, row = (int)y - posy, start = 0;
+    unsigned short adv = 0;
+    // the driver never draws on the last column of the screen
+    if (x >= (UTEST_OLED_EMU_WIDTH - 1) || row < 0 || row >= font->height || vx < 0)
+        return 0;
+    for (; *txt != 0x0; txt++, start += adv) {
+        adv = staDisplayGlyphAdvance(font, (unsigned char)*txt);
+        if (vx < (start + adv)) {
+            unsigned short rowpattern = font->bitmap[(*txt - GMON_DISPLAY_FONT_FIRST_CHR) * font->height + row];
+            return (rowpattern >> (15 - (vx - start))) & 0x1;
+        }
+    }
+    return 0;
+}
+
+static void utestAssertScreen(const gmonPrintFont_t *font, const char *txt, short posx, short posy) {
+    uint16_t x = 0, y = 0;
+    for (y = 0; y < UTEST_OLED_EMU_HEIGHT; y++) {
+        for (x = 0; x < UTEST_OLED_EMU_WIDTH; x++) {
+            uint8_t expect = utestExpectedPixel(font, txt, posx, posy, x, y);
+            if (expect != UTestOLEDemuGetPixel(x, y)) {
+                char msg[48];
+                snprintf(msg, sizeof(msg), "pixel mismatch at (%u, %u)", x, y);
+                TEST_FAIL_MESSAGE(msg);
+            }
+        }
+    }
+}
+
+static void utestOLEDprint(gmonPrintFont_t *font, const char *txt, short posx, short posy) {
+    gmonPrintInfo_t info = {
+        .str = {.data = (unsigned char *)txt, .len = XSTRLEN(txt), .nbytes_written = XSTRLEN(txt)},
+        .font = font,
+        .posx = posx,
+        .posy = posy,
+    };
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staDiplayDevPrintString(utest_oled_gmon.display.dev, &info));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staDisplayRefreshScreen(utest_oled_gmon.display.dev));
+}
+
+TEST_GROUP(OLEDemulator);
+
+TEST_SETUP(OLEDemulator) {
+    UTestOLEDemuReset();
+    gMonStatus status = staDisplayInit(&utest_oled_gmon);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, status);
+}
+
+TEST_TEAR_DOWN(OLEDemulator) {
+    gMonStatus status = staDisplayDeInit(&utest_oled_gmon);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, status);
+}
+
+TEST(OLEDemulator, InitSequence) {
+    const UTestOLEDemuStats_t *stats = UTestOLEDemuGetStats();
+    uint16_t                   x = 0, y = 0;
+    TEST_ASSERT_EQUAL(1, UTestOLEDemuDisplayOn());
+    TEST_ASSERT_EQUAL(UTEST_OLED_EMU_WIDTH, staDisplayDevGetScreenWidth(utest_oled_gmon.display.dev));
+    TEST_ASSERT_EQUAL(UTEST_OLED_EMU_HEIGHT, staDisplayDevGetScreenHeight(utest_oled_gmon.display.dev));
+    // the driver clears entire screen at the end of init sequence
+    TEST_ASSERT_EQUAL(1, stats->num_frames);
+    TEST_ASSERT_EQUAL(UTEST_OLED_EMU_WIDTH * UTEST_OLED_EMU_NUM_PAGES, stats->nbytes_data);
+    for (y = 0; y < UTEST_OLED_EMU_HEIGHT; y++) {
+        for (x = 0; x < UTEST_OLED_EMU_WIDTH; x++)
+            TEST_ASSERT_EQUAL(0, UTestOLEDemuGetPixel(x, y));
+    }
+}
+
+TEST(OLEDemulator, PrintGlyphs) {
+    gmonPrintFont_t *compact = &utest_oled_gmon.display.fonts[1];
+    gmonPrintFont_t *large = &utest_oled_gmon.display.fonts[0];
+    utestOLEDprint(compact, "Hi, 42.5'C", 2, 9);
+    utestAssertScreen(compact, "Hi, 42.5'C", 2, 9);
+    staDisplayDevClearScreen(utest_oled_gmon.display.dev);
+    utestOLEDprint(large, "Pump: ON", 0, 20);
+    utestAssertScreen(large, "Pump: ON", 0, 20);
+    // text exceeding right edge of the screen is clipped
+    staDisplayDevClearScreen(utest_oled_gmon.display.dev);
+    utestOLEDprint(compact, "[Sensor Log]: Soil moisture: 1024.", 0, 0);
+    utestAssertScreen(compact, "[Sensor Log]: Soil moisture: 1024.", 0, 0);
+    // text line partially visible at bottom edge of the screen
+    staDisplayDevClearScreen(utest_oled_gmon.display.dev);
+    utestOLEDprint(large, "Bulb: OFF", 0, 56);
+    utestAssertScreen(large, "Bulb: OFF", 0, 56);
+}
+
+TEST(OLEDemulator, ScrollPartialGlyph) {
+    gmonPrintFont_t *compact = &utest_oled_gmon.display.fonts[1];
+    gmonPrintFont_t *large = &utest_oled_gmon.display.fonts[0];
+    // first visible glyph is partially printed
+    utestOLEDprint(compact, "Lightness: 1001.", -9, 30);
+    utestAssertScreen(compact, "Lightness: 1001.", -9, 30);
+    staDisplayDevClearScreen(utest_oled_gmon.display.dev);
+    utestOLEDprint(large, "Fan: PAUSE", -13, 3);
+    utestAssertScreen(large, "Fan: PAUSE", -13, 3);
+    // shorter text erases leftover of previous frame in the same line
+    utestOLEDprint(large, "Fan: ON", 0, 3);
+    utestAssertScreen(large, "Fan: ON", 0, 3);
+    staDisplayDevClearScreen(utest_oled_gmon.display.dev);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staDisplayRefreshScreen(utest_oled_gmon.display.dev));
+    utestAssertScreen(large, "", 0, 0);
+}
+
+// measure number of bytes transmitted and frame rate of current render loop, set environment variable
+// UTEST_OLED_BENCH to print the report, and UTEST_OLED_SNAPSHOT to dump the last frame as PGM image.
+TEST(OLEDemulator, RenderLoopBench) {
+    const UTestOLEDemuStats_t *stats = UTestOLEDemuGetStats();
+    const char                *snapshot_path = getenv("UTEST_OLED_SNAPSHOT");
+    unsigned int               idx = 0, num_refreshed = 0;
+    gMonStatus                 status = staDisplayRefreshStart(&utest_oled_gmon.display);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, status);
+    TEST_ASSERT_EQUAL(UTEST_OLED_EMU_WIDTH, utest_oled_gmon.display.refresh.screen_width);
+    UTestOLEDemuBenchStart();
+    for (idx = 0; idx < UTEST_OLED_BENCH_NUM_ROUNDS; idx++) {
+        status = staDisplayRefreshIteration(&utest_oled_gmon);
+        if (status == GMON_RESP_OK)
+            num_refreshed++;
+        else
+            TEST_ASSERT_EQUAL(GMON_RESP_SKIP, status);
+    }
+    // long text lines keep scrolling, every round sends entire frame buffer
+    TEST_ASSERT_GREATER_THAN(0, utest_oled_gmon.display.refresh.num_scrolling);
+    TEST_ASSERT_EQUAL(UTEST_OLED_BENCH_NUM_ROUNDS, num_refreshed);
+    TEST_ASSERT_EQUAL(num_refreshed, stats->num_frames);
+    TEST_ASSERT_EQUAL(num_refreshed * UTEST_OLED_EMU_WIDTH * UTEST_OLED_EMU_NUM_PAGES, stats->nbytes_data);
+    TEST_ASSERT_EQUAL(num_refreshed * 3 * UTEST_OLED_EMU_NUM_PAGES, stats->nbytes_cmd);
+    if (getenv("UTEST_OLED_BENCH"))
+        UTestOLEDemuBenchReport(stdout, "render loop");
+    if (snapshot_path)
+        TEST_ASSERT_GREATER_THAN(0, UTestOLEDemuDumpPGM(snapshot_path));
+}
+
+// all text lines fit the screen, redraw only when any of them changed, including the lines rendered by
+// network handler task
+TEST(OLEDemulator, RedrawOnNetConnStatus) {
+    gMonDisplayBlock_t *dblk = NULL;
+    gMonStatus          status = staDisplayRefreshStart(&utest_oled_gmon.display);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, status);
+    // pretend the screen is wide enough to hold all text lines without scrolling
+    utest_oled_gmon.display.refresh.screen_width = 0xffff;
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staDisplayRefreshIteration(&utest_oled_gmon));
+    TEST_ASSERT_EQUAL(0, utest_oled_gmon.display.refresh.num_scrolling);
+    TEST_ASSERT_EQUAL(GMON_RESP_SKIP, staDisplayRefreshIteration(&utest_oled_gmon));
+    TEST_ASSERT_EQUAL(GMON_RESP_SKIP, staDisplayRefreshIteration(&utest_oled_gmon));
+    dblk = &utest_oled_gmon.display.blocks[GMON_BLOCK_NETCONN_STATUS];
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, dblk->render(&dblk->content, &utest_oled_gmon));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staDisplayRefreshIteration(&utest_oled_gmon));
+    TEST_ASSERT_EQUAL(GMON_RESP_SKIP, staDisplayRefreshIteration(&utest_oled_gmon));
+    dblk = &utest_oled_gmon.display.blocks[GMON_BLOCK_ACTUATOR_THRESHOLD];
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, dblk->render(&dblk->content, &utest_oled_gmon));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staDisplayRefreshIteration(&utest_oled_gmon));
+    TEST_ASSERT_EQUAL(GMON_RESP_SKIP, staDisplayRefreshIteration(&utest_oled_gmon));
+}
+
+TEST(OLEDemulator, DumpPGM) {
+    char  path[] = "/tmp/gmon_utest_oled_XXXXXX";
+    char  header[16] = {0};
+    FILE *fp = NULL;
+    int   fd = mkstemp(path), nread = 0;
+    TEST_ASSERT_GREATER_OR_EQUAL(0, fd);
+    close(fd);
+    utestOLEDprint(&utest_oled_gmon.display.fonts[1], "A", 0, 0);
+    TEST_ASSERT_EQUAL(
+        XSTRLEN("P5\n128 64\n255\n") + UTEST_OLED_EMU_WIDTH * UTEST_OLED_EMU_HEIGHT, UTestOLEDemuDumpPGM(path)
+    );
+    fp = fopen(path, "rb");
+    TEST_ASSERT_NOT_NULL(fp);
+    nread = fread(header, 1, XSTRLEN("P5\n128 64\n255\n"), fp);
+    fclose(fp);
+    remove(path);
+    TEST_ASSERT_EQUAL(XSTRLEN("P5\n128 64\n255\n"), nread);
+    TEST_ASSERT_EQUAL_STRING("P5\n128 64\n255\n", header);
+    TEST_ASSERT_EQUAL(-1, UTestOLEDemuDumpPGM("/nonexistent-dir/snapshot.pgm"));
+}
+
+TEST_GROUP_RUNNER(gMonOLEDemulator) {
+    RUN_TEST_CASE(OLEDemulator, InitSequence);
+    RUN_TEST_CASE(OLEDemulator, PrintGlyphs);
+    RUN_TEST_CASE(OLEDemulator, ScrollPartialGlyph);
+    RUN_TEST_CASE(OLEDemulator, RenderLoopBench);
+    RUN_TEST_CASE(OLEDemulator, RedrawOnNetConnStatus);
+    RUN_TEST_CASE(OLEDemulator, DumpPGM);
+}
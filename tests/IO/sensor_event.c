@@ -98,6 +98,27 @@ TEST(SensorEvtPool, PoolFullTriggersAssertion) {
     }
 }
 
+TEST(SensorEvtPool, TracksPeakUsage) {
+    gMonEvtPool_t *epool = &gmon.sensors.event;
+    gmonEvent_t   *events[3] = {0};
+    for (unsigned int i = 0; i < 3; i++)
+        events[i] = staAllocSensorEvent(epool, GMON_EVENT_SOIL_MOISTURE_UPDATED, 1);
+    TEST_ASSERT_EQUAL(3, epool->num_used);
+    TEST_ASSERT_EQUAL(3, epool->peak);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staFreeSensorEvent(epool, events[1]));
+    // freeing the same event twice does not count
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staFreeSensorEvent(epool, events[1]));
+    TEST_ASSERT_EQUAL(2, epool->num_used);
+    events[1] = staAllocSensorEvent(epool, GMON_EVENT_LIGHTNESS_UPDATED, 1);
+    TEST_ASSERT_EQUAL(3, epool->num_used);
+    TEST_ASSERT_EQUAL(3, epool->peak);
+    for (unsigned int i = 0; i < 3; i++)
+        TEST_ASSERT_EQUAL(GMON_RESP_OK, staFreeSensorEvent(epool, events[i]));
+    // peak is kept after all events are returned
+    TEST_ASSERT_EQUAL(0, epool->num_used);
+    TEST_ASSERT_EQUAL(3, epool->peak);
+}
+
 // Test cases for staFreeSensorEvent
 TEST(SensorEvtPool, FreesValidAllocatedEvent) {
     gMonEvtPool_t *epool = &gmon.sensors.event;
@@ -250,6 +271,7 @@ TEST_GROUP_RUNNER(gMonSensorEvt) {
     RUN_TEST_CASE(SensorEvtPool, AllocatesFromEmptyPool);
     RUN_TEST_CASE(SensorEvtPool, AllocatesFromPartiallyFilledPool);
     RUN_TEST_CASE(SensorEvtPool, PoolFullTriggersAssertion);
+    RUN_TEST_CASE(SensorEvtPool, TracksPeakUsage);
     RUN_TEST_CASE(SensorEvtPool, FreesValidAllocatedEvent);
     RUN_TEST_CASE(SensorEvtPool, FreesEventAlreadyFreedSafely);
     RUN_TEST_CASE(SensorEvtPool, ReturnsErrorForNullRecord);
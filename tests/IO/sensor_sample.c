@@ -468,6 +468,29 @@ TEST(SensorNoiseDetection, AirCondzeroMAD) {
     TEST_ASSERT_TRUE(staGetBitFlag(mock_samples[0].outlier, 5));  // {100.0f, 100.0f} (idx 4) is outlier
 }
 
+TEST(SensorNoiseDetection, TypedMismatch) {
+    gMonSensorMeta_t *s = &gmon.sensors.air_temp;
+    s->num_items = 1;
+    s->num_resamples = 3;
+    s->outlier_threshold = 2.2f;
+    s->mad_threshold = 0.5f;
+    gmonSensorSamples_t result = staAllocSensorSampleBufferAirCond((gmonSensorSamples_t){0}, s);
+    mock_samples = result.entries;
+    TEST_ASSERT_NOT_NULL(mock_samples);
+    TEST_ASSERT_EQUAL(GMON_SENSOR_DATA_TYPE_AIRCOND, mock_samples[0].dtype);
+    TEST_ASSERT_EQUAL(GMON_RESP_ERRARGS, staSensorDetectNoiseAirCond(s, NULL));
+    // specialised function only accepts samples of its own data type
+    TEST_ASSERT_EQUAL(GMON_RESP_MALFORMED_DATA, staSensorDetectNoiseU32(s, mock_samples));
+    gmonAirCond_t *d = (gmonAirCond_t *)mock_samples[0].data;
+    d[0] = (gmonAirCond_t){.temporature = 21.0f, .humidity = 50.0f};
+    d[1] = (gmonAirCond_t){.temporature = 21.0f, .humidity = 51.0f};
+    d[2] = (gmonAirCond_t){.temporature = 90.0f, .humidity = 50.0f};
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staSensorDetectNoiseAirCond(s, mock_samples));
+    TEST_ASSERT_FALSE(staGetBitFlag(mock_samples[0].outlier, 0));
+    TEST_ASSERT_FALSE(staGetBitFlag(mock_samples[0].outlier, 1));
+    TEST_ASSERT_TRUE(staGetBitFlag(mock_samples[0].outlier, 2));
+}
+
 TEST(SensorSampleToEvent, ErrArgsNullZero) {
     gMonSensorMeta_t    sensor_cfg = {.num_items = 1, .num_resamples = 3};
     gmonSensorSamples_t result =
@@ -761,6 +784,34 @@ TEST(SensorSampleToEvent, MixedCorruptionFlags) {
     TEST_ASSERT_TRUE(staGetBitFlag(&mock_event->flgs.corruption, 3));
 }
 
+TEST(SensorSampleToEvent, TypedSameAsGeneric) {
+    gMonSensorMeta_t    sensor_cfg = {.num_items = 2, .num_resamples = 2};
+    gmonSensorSamples_t result = staAllocSensorSampleBufferU32((gmonSensorSamples_t){0}, &sensor_cfg);
+    mock_samples = result.entries;
+    TEST_ASSERT_NOT_NULL(mock_samples);
+    mock_event =
+        createAndInitEvent(GMON_EVENT_LIGHTNESS_UPDATED, sensor_cfg.num_items, sizeof(unsigned int));
+    ((unsigned int *)mock_samples[0].data)[0] = 30;
+    ((unsigned int *)mock_samples[0].data)[1] = 34;
+    ((unsigned int *)mock_samples[1].data)[0] = 70;
+    ((unsigned int *)mock_samples[1].data)[1] = 90;
+    staSetBitFlag(mock_samples[1].outlier, 1, 1);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staSensorSampleToEventU32(mock_event, mock_samples));
+    TEST_ASSERT_EQUAL(32, ((unsigned int *)mock_event->data)[0]);
+    TEST_ASSERT_EQUAL(70, ((unsigned int *)mock_event->data)[1]);
+    // half of the samples are outliers in the second sensor
+    TEST_ASSERT_EQUAL(0x2, mock_event->flgs.corruption);
+    unsigned char corruption = mock_event->flgs.corruption;
+    XMEMSET(mock_event->data, 0x00, sizeof(unsigned int) * sensor_cfg.num_items);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staSensorSampleToEvent(mock_event, mock_samples));
+    TEST_ASSERT_EQUAL(32, ((unsigned int *)mock_event->data)[0]);
+    TEST_ASSERT_EQUAL(70, ((unsigned int *)mock_event->data)[1]);
+    TEST_ASSERT_EQUAL(corruption, mock_event->flgs.corruption);
+    // samples of other data type are corrupted
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staSensorSampleToEventAirCond(mock_event, mock_samples));
+    TEST_ASSERT_EQUAL(0x3, mock_event->flgs.corruption);
+}
+
 TEST_GROUP_RUNNER(gMonSensorSample) {
     RUN_TEST_CASE(SensorSampleAlloc, initOk);
     RUN_TEST_CASE(SensorSampleAlloc, reallocToDifferentSize);
@@ -772,6 +823,7 @@ TEST_GROUP_RUNNER(gMonSensorSample) {
     RUN_TEST_CASE(SensorNoiseDetection, U32HalfOutliers);
     RUN_TEST_CASE(SensorNoiseDetection, U32zeroMAD);
     RUN_TEST_CASE(SensorNoiseDetection, AirCondzeroMAD);
+    RUN_TEST_CASE(SensorNoiseDetection, TypedMismatch);
     RUN_TEST_CASE(SensorSampleToEvent, ErrArgsNullZero);
     RUN_TEST_CASE(SensorSampleToEvent, U32HappyPathNoOutliers);
     RUN_TEST_CASE(SensorSampleToEvent, AirCondHappyPathNoOutliers);
@@ -785,4 +837,5 @@ TEST_GROUP_RUNNER(gMonSensorSample) {
     RUN_TEST_CASE(SensorSampleToEvent, NullOutlierPointerSetsCorruption);
     RUN_TEST_CASE(SensorSampleToEvent, UnsupportedDataTypeSetsCorruption);
     RUN_TEST_CASE(SensorSampleToEvent, MixedCorruptionFlags);
+    RUN_TEST_CASE(SensorSampleToEvent, TypedSameAsGeneric);
 }
@@ -0,0 +1,192 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "station_include.h"
+
+#define UTEST_SCHED_NUM_PIPES 3
+#define UTEST_SCHED_LOG_SZ    16
+
+static gardenMonitor_t   utest_gmon;
+static gMonSensorSched_t utest_sched;
+static unsigned int      utest_intervals[UTEST_SCHED_NUM_PIPES];
+static unsigned int      utest_run_cost_ms[UTEST_SCHED_NUM_PIPES];
+static unsigned char     utest_run_log[UTEST_SCHED_LOG_SZ];
+static unsigned char     utest_num_logged;
+
+// time spent in the pipeline is simulated by advancing the tick
+static void utestPipeLog(unsigned char idx) {
+    if (utest_num_logged < UTEST_SCHED_LOG_SZ)
+        utest_run_log[utest_num_logged++] = idx;
+    setMockTickCount(stationSysGetTickCount() + utest_run_cost_ms[idx] / GMON_NUM_MILLISECONDS_PER_TICK);
+}
+
+#define UTEST_SCHED_MOCK_PIPE(idx) \
+    static gMonStatus utestPipeRun##idx(gardenMonitor_t *gmon, gmonSensorSamples_t *read_vals) { \
+        (void)gmon; \
+        (void)read_vals; \
+        utestPipeLog(idx); \
+        return GMON_RESP_OK; \
+    } \
+    static unsigned int utestPipeInterval##idx(gardenMonitor_t *gmon) { \
+        (void)gmon; \
+        return utest_intervals[idx]; \
+    }
+UTEST_SCHED_MOCK_PIPE(0)
+UTEST_SCHED_MOCK_PIPE(1)
+UTEST_SCHED_MOCK_PIPE(2)
+
+static const gMonSensorPipeline_t utest_pipelines[UTEST_SCHED_NUM_PIPES] = {
+    {.run = utestPipeRun0, .interval_ms = utestPipeInterval0},
+    {.run = utestPipeRun1, .interval_ms = utestPipeInterval1},
+    {.run = utestPipeRun2, .interval_ms = utestPipeInterval2},
+};
+
+static void utestSchedInit(unsigned int now_ms) {
+    gMonStatus status = staSensorSchedInit(&utest_sched, &utest_gmon, utest_pipelines, 3, now_ms);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, status);
+}
+
+TEST_GROUP(SensorSched);
+
+TEST_SETUP(SensorSched) {
+    XMEMSET(&utest_gmon, 0x00, sizeof(gardenMonitor_t));
+    XMEMSET(utest_run_log, 0x00, sizeof(utest_run_log));
+    XMEMSET(utest_run_cost_ms, 0x00, sizeof(utest_run_cost_ms));
+    utest_num_logged = 0;
+    setMockTickCount(0);
+    utest_intervals[0] = 300;
+    utest_intervals[1] = 500;
+    utest_intervals[2] = 700;
+}
+
+TEST_TEAR_DOWN(SensorSched) { staSensorSchedDeinit(&utest_sched); }
+
+TEST(SensorSched, InvalidArgs) {
+    TEST_ASSERT_EQUAL(GMON_RESP_ERRARGS, staSensorSchedInit(NULL, &utest_gmon, utest_pipelines, 3, 0));
+    TEST_ASSERT_EQUAL(GMON_RESP_ERRARGS, staSensorSchedInit(&utest_sched, &utest_gmon, NULL, 3, 0));
+    gMonStatus status = staSensorSchedInit(&utest_sched, &utest_gmon, utest_pipelines, 0, 0);
+    TEST_ASSERT_EQUAL(GMON_RESP_ERRARGS, status);
+    status = staSensorSchedInit(&utest_sched, &utest_gmon, utest_pipelines, GMON_NUM_SENSOR_PIPELINES + 1, 0);
+    TEST_ASSERT_EQUAL(GMON_RESP_ERRARGS, status);
+    TEST_ASSERT_EQUAL(0, staSensorSchedRunDue(NULL, &utest_gmon, 0));
+}
+
+TEST(SensorSched, DeadlineOrder) {
+    utestSchedInit(0);
+    TEST_ASSERT_EQUAL_UINT32(300, staSensorSchedWaitMs(&utest_sched, 0));
+    TEST_ASSERT_EQUAL_UINT32(0, staSensorSchedRunDue(&utest_sched, &utest_gmon, 299));
+    TEST_ASSERT_EQUAL_UINT32(1, staSensorSchedRunDue(&utest_sched, &utest_gmon, 300));
+    TEST_ASSERT_EQUAL_UINT32(200, staSensorSchedWaitMs(&utest_sched, 300));
+    // pipeline 1 (due at 500) runs before pipeline 0 (due at 600)
+    TEST_ASSERT_EQUAL_UINT32(1, staSensorSchedRunDue(&utest_sched, &utest_gmon, 500));
+    TEST_ASSERT_EQUAL_UINT32(1, staSensorSchedRunDue(&utest_sched, &utest_gmon, 650));
+    TEST_ASSERT_EQUAL_UINT32(50, staSensorSchedWaitMs(&utest_sched, 650));
+    TEST_ASSERT_EQUAL_UINT32(1, staSensorSchedRunDue(&utest_sched, &utest_gmon, 700));
+    const unsigned char expect[] = {0, 1, 0, 2};
+    TEST_ASSERT_EQUAL(sizeof(expect), utest_num_logged);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expect, utest_run_log, sizeof(expect));
+    TEST_ASSERT_EQUAL_UINT32(4, utest_sched.stats.num_runs);
+    TEST_ASSERT_EQUAL_UINT32(0, utest_sched.stats.num_late);
+}
+
+TEST(SensorSched, NoDrift) {
+    unsigned int idx = 0, now_ms = 0;
+    utest_intervals[1] = utest_intervals[2] = GMON_MAX_SENSOR_READ_INTERVAL_MS;
+    utestSchedInit(0);
+    // each run starts a bit late, next deadline is still based on previous one
+    for (idx = 1; idx <= 5; idx++) {
+        now_ms = idx * 300 + 40;
+        TEST_ASSERT_EQUAL_UINT32(1, staSensorSchedRunDue(&utest_sched, &utest_gmon, now_ms));
+        TEST_ASSERT_EQUAL_UINT32(260, staSensorSchedWaitMs(&utest_sched, now_ms));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, utest_sched.stats.num_late);
+}
+
+TEST(SensorSched, SkipMissedReads) {
+    utest_intervals[1] = utest_intervals[2] = GMON_MAX_SENSOR_READ_INTERVAL_MS;
+    utestSchedInit(0);
+    // blocked for several intervals, run once instead of catching up
+    TEST_ASSERT_EQUAL_UINT32(1, staSensorSchedRunDue(&utest_sched, &utest_gmon, 1250));
+    TEST_ASSERT_EQUAL_UINT32(1, utest_sched.stats.num_late);
+    TEST_ASSERT_EQUAL_UINT32(300, staSensorSchedWaitMs(&utest_sched, 1250));
+}
+
+TEST(SensorSched, IntervalChange) {
+    utestSchedInit(0);
+    // e.g. fast-poll enabled while the pipeline is running
+    utest_intervals[0] = 100;
+    TEST_ASSERT_EQUAL_UINT32(1, staSensorSchedRunDue(&utest_sched, &utest_gmon, 300));
+    TEST_ASSERT_EQUAL_UINT32(100, staSensorSchedWaitMs(&utest_sched, 300));
+    // disabled sensor or interval out of range, applied from the last read at 300
+    utest_intervals[0] = 0;
+    TEST_ASSERT_EQUAL_UINT32(0, staSensorSchedRunDue(&utest_sched, &utest_gmon, 400));
+    TEST_ASSERT_EQUAL_UINT32(GMON_MIN_SENSOR_READ_INTERVAL_MS - 100, staSensorSchedWaitMs(&utest_sched, 400));
+    TEST_ASSERT_EQUAL_UINT32(2, staSensorSchedRunDue(&utest_sched, &utest_gmon, 500));
+    TEST_ASSERT_EQUAL_UINT8(0, utest_sched.heap[0].idx);
+    TEST_ASSERT_EQUAL_UINT32(500 + GMON_MIN_SENSOR_READ_INTERVAL_MS, utest_sched.heap[0].due_ms);
+}
+
+// interval changed by remote user takes effect before the deadline scheduled with the old interval
+TEST(SensorSched, RekeyOnIntervalChange) {
+    utestSchedInit(0);
+    utest_intervals[2] = 200;
+    TEST_ASSERT_EQUAL_UINT32(0, staSensorSchedRunDue(&utest_sched, &utest_gmon, 100));
+    TEST_ASSERT_EQUAL_UINT32(100, staSensorSchedWaitMs(&utest_sched, 100));
+    TEST_ASSERT_EQUAL_UINT32(1, staSensorSchedRunDue(&utest_sched, &utest_gmon, 200));
+    // longer interval postpones the read
+    utest_intervals[1] = 1000;
+    TEST_ASSERT_EQUAL_UINT32(0, staSensorSchedRunDue(&utest_sched, &utest_gmon, 250));
+    TEST_ASSERT_EQUAL_UINT32(1, staSensorSchedRunDue(&utest_sched, &utest_gmon, 300));
+    TEST_ASSERT_EQUAL_UINT32(100, staSensorSchedWaitMs(&utest_sched, 300));
+    // deadline of shorter interval already passed, read at once
+    utest_intervals[1] = GMON_MIN_SENSOR_READ_INTERVAL_MS;
+    TEST_ASSERT_EQUAL_UINT32(1, staSensorSchedRunDue(&utest_sched, &utest_gmon, 350));
+    const unsigned char expect[] = {2, 0, 1};
+    TEST_ASSERT_EQUAL(sizeof(expect), utest_num_logged);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expect, utest_run_log, sizeof(expect));
+    TEST_ASSERT_EQUAL_UINT32(0, utest_sched.stats.num_late);
+}
+
+// pipeline listed first (soil moisture, which drives the pump) is not blocked by other due pipelines
+TEST(SensorSched, PriorityWhenDue) {
+    utest_intervals[0] = 500;
+    utest_intervals[1] = 450;
+    utest_intervals[2] = GMON_MAX_SENSOR_READ_INTERVAL_MS;
+    utest_run_cost_ms[0] = 30;
+    utest_run_cost_ms[1] = 120;
+    utestSchedInit(0);
+    setMockTickCount(500 / GMON_NUM_MILLISECONDS_PER_TICK);
+    TEST_ASSERT_EQUAL_UINT32(2, staSensorSchedRunDue(&utest_sched, &utest_gmon, 500));
+    TEST_ASSERT_EQUAL_UINT32(0, utest_sched.stats.max_lag_ms[0]);
+    TEST_ASSERT_EQUAL_UINT32(50 + 30, utest_sched.stats.max_lag_ms[1]);
+    // pipeline 0 becomes due while pipeline 1 is running, it waits for one run of pipeline 1 at most
+    setMockTickCount(950 / GMON_NUM_MILLISECONDS_PER_TICK);
+    TEST_ASSERT_EQUAL_UINT32(1, staSensorSchedRunDue(&utest_sched, &utest_gmon, 950));
+    TEST_ASSERT_EQUAL_UINT32(1, staSensorSchedRunDue(&utest_sched, &utest_gmon, 950 + 120));
+    TEST_ASSERT_EQUAL_UINT32(70, utest_sched.stats.max_lag_ms[0]);
+    const unsigned char expect[] = {0, 1, 1, 0};
+    TEST_ASSERT_EQUAL(sizeof(expect), utest_num_logged);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expect, utest_run_log, sizeof(expect));
+}
+
+TEST(SensorSched, TickWrapAround) {
+    const unsigned int start_ms = 0xffffff00;
+    utestSchedInit(start_ms);
+    TEST_ASSERT_EQUAL_UINT32(300, staSensorSchedWaitMs(&utest_sched, start_ms));
+    TEST_ASSERT_EQUAL_UINT32(0, staSensorSchedRunDue(&utest_sched, &utest_gmon, 0xffffffff));
+    TEST_ASSERT_EQUAL_UINT32(1, staSensorSchedRunDue(&utest_sched, &utest_gmon, start_ms + 300));
+    TEST_ASSERT_EQUAL_UINT32(2, staSensorSchedRunDue(&utest_sched, &utest_gmon, start_ms + 600));
+    // both are due, pipeline 0 has higher priority
+    const unsigned char expect[] = {0, 0, 1};
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expect, utest_run_log, sizeof(expect));
+}
+
+TEST_GROUP_RUNNER(gMonSensorSched) {
+    RUN_TEST_CASE(SensorSched, InvalidArgs);
+    RUN_TEST_CASE(SensorSched, DeadlineOrder);
+    RUN_TEST_CASE(SensorSched, NoDrift);
+    RUN_TEST_CASE(SensorSched, SkipMissedReads);
+    RUN_TEST_CASE(SensorSched, IntervalChange);
+    RUN_TEST_CASE(SensorSched, RekeyOnIntervalChange);
+    RUN_TEST_CASE(SensorSched, PriorityWhenDue);
+    RUN_TEST_CASE(SensorSched, TickWrapAround);
+}
@@ -89,6 +89,25 @@ TEST(DecodeMsgInflight, SensorQtyExceed) {
     TEST_ASSERT_EQUAL(0, test_gmon.sensors.light.num_items);
 }
 
+// application accepts up to GMON_MAXNUM_AIR_SENSORS, the platform wires fewer signal pins
+TEST(DecodeMsgInflight, AirSensorQtyExceedPlatformPins) {
+    const unsigned char *json_data = (const unsigned char *)"{\"sensor\":{\"airtemp\":{\"qty\":7}}}";
+    uint16_t             testdata_sz = strlen((const char *)json_data);
+    TEST_ASSERT_LESS_THAN(GMON_MAXNUM_AIR_SENSORS + 1, 7);
+    TEST_ASSERT_GREATER_THAN(GMON_PLATFORM_NUM_AIR_SENSOR_PINS, 7);
+    test_gmon.sensors.air_temp.num_items = 2;
+    XMEMCPY(test_gmon.rawmsg.inflight.data, json_data, testdata_sz);
+    test_gmon.rawmsg.inflight.nbytes_written = testdata_sz;
+    gMonStatus status = staDecodeAppMsgInflight(&test_gmon);
+    TEST_ASSERT_EQUAL(GMON_RESP_INVALID_REQ, status);
+    TEST_ASSERT_EQUAL(2, test_gmon.sensors.air_temp.num_items);
+    TEST_ASSERT_EQUAL(GMON_RESP_INVALID_REQ, staSetNumAirSensor(&test_gmon.sensors.air_temp, 7));
+    TEST_ASSERT_EQUAL(
+        GMON_RESP_OK, staSetNumAirSensor(&test_gmon.sensors.air_temp, GMON_PLATFORM_NUM_AIR_SENSOR_PINS)
+    );
+    TEST_ASSERT_EQUAL(GMON_PLATFORM_NUM_AIR_SENSOR_PINS, test_gmon.sensors.air_temp.num_items);
+}
+
 TEST(DecodeMsgInflight, SensorResampleExceed) {
     const unsigned char *json_data =
         (const unsigned char *)"{\"sensor\":{\"soilmoist\":{\"resample\":6},"
@@ -222,19 +241,19 @@ TEST(DecodeMsgInflight, MalformedThresholdObject) {
 
 TEST(DecodeMsgInflight, UnknownTopLevelKey) {
     const unsigned char *json_data =
-        (const unsigned char *)"{\"unknown_key\":\"some_value\", \"netconn\":{\"interval\":100}}";
+        (const unsigned char *)"{\"unknown_key\":\"some_value\", \"netconn\":{\"interval\":100000}}";
     uint16_t testdata_sz = strlen((const char *)json_data);
     TEST_ASSERT_LESS_THAN_UINT16(test_gmon.rawmsg.inflight.len, testdata_sz);
     XMEMCPY(test_gmon.rawmsg.inflight.data, json_data, testdata_sz);
     test_gmon.rawmsg.inflight.nbytes_written = testdata_sz;
     gMonStatus status = staDecodeAppMsgInflight(&test_gmon);
     TEST_ASSERT_EQUAL(GMON_RESP_OK, status); // Should skip unknown key and continue parsing
-    TEST_ASSERT_EQUAL(100, test_gmon.netconn.interval_ms);
+    TEST_ASSERT_EQUAL(100000, test_gmon.netconn.interval_ms);
 }
 
 TEST(DecodeMsgInflight, NestedUnknownKeys) {
     const unsigned char *json_data =
-        (const unsigned char *)"{\"netconn\":{\"interval\":146, \"junk\":{\"nested_junk\":1}}, \"sensor\":{"
+        (const unsigned char *)"{\"netconn\":{\"interval\":146000, \"junk\":{\"nested_junk\":1}}, \"sensor\":{"
                                "\"soilmoist\":{}}, \"actuators\":{\"pump\":{\"threshold\":291}}}";
     uint16_t testdata_sz = strlen((const char *)json_data);
     TEST_ASSERT_LESS_THAN_UINT16(test_gmon.rawmsg.inflight.len, testdata_sz);
@@ -242,7 +261,7 @@ TEST(DecodeMsgInflight, NestedUnknownKeys) {
     test_gmon.rawmsg.inflight.nbytes_written = testdata_sz;
     gMonStatus status = staDecodeAppMsgInflight(&test_gmon);
     TEST_ASSERT_EQUAL(GMON_RESP_OK, status);
-    TEST_ASSERT_EQUAL(146, test_gmon.netconn.interval_ms);
+    TEST_ASSERT_EQUAL(146000, test_gmon.netconn.interval_ms);
     TEST_ASSERT_EQUAL(291, test_gmon.actuator.pump.threshold);
 }
 
@@ -297,7 +316,7 @@ TEST(DecodeMsgInflight, ComprehensiveConfigWithActuators) {
     const char *json_data =
         "{\"sensor\":{"
         "\"soilmoist\":{\"interval\":2100,\"qty\":3,\"resample\":5,\"outlier\":[35,13],\"mad\":[40,17]},"
-        "\"airtemp\":{\"interval\":7100,\"qty\":4,\"resample\":2,\"outlier\":[35,14],\"mad\":[42,19]},"
+        "\"airtemp\":{\"interval\":7100,\"qty\":3,\"resample\":2,\"outlier\":[35,14],\"mad\":[42,19]},"
         "\"light\":{\"interval\":11000,\"qty\":6,\"resample\":3,\"outlier\":[36,13],\"mad\":[43,23]}},"
         "\"netconn\":{\"interval\":360095},\"daylength\":7200012,\"actuators\":{"
         "\"pump\":{\"max_worktime\":50000,\"min_resttime\":5000,\"threshold\":934},"
@@ -314,7 +333,7 @@ TEST(DecodeMsgInflight, ComprehensiveConfigWithActuators) {
     TEST_ASSERT_EQUAL(7100, test_gmon.sensors.air_temp.read_interval_ms);
     TEST_ASSERT_EQUAL(11000, test_gmon.sensors.light.read_interval_ms);
     TEST_ASSERT_EQUAL(3, test_gmon.sensors.soil_moist.super.num_items);
-    TEST_ASSERT_EQUAL(4, test_gmon.sensors.air_temp.num_items);
+    TEST_ASSERT_EQUAL(3, test_gmon.sensors.air_temp.num_items);
     TEST_ASSERT_EQUAL(6, test_gmon.sensors.light.num_items);
     TEST_ASSERT_EQUAL(5, test_gmon.sensors.soil_moist.super.num_resamples);
     TEST_ASSERT_EQUAL(2, test_gmon.sensors.air_temp.num_resamples);
@@ -385,6 +404,7 @@ TEST_GROUP_RUNNER(gMonAppMsgInbound) {
     RUN_TEST_CASE(DecodeMsgInflight, MixedValidReordered);
     RUN_TEST_CASE(DecodeMsgInflight, InvalidRootType);
     RUN_TEST_CASE(DecodeMsgInflight, SensorQtyExceed);
+    RUN_TEST_CASE(DecodeMsgInflight, AirSensorQtyExceedPlatformPins);
     RUN_TEST_CASE(DecodeMsgInflight, SensorResampleExceed);
     RUN_TEST_CASE(DecodeMsgInflight, NoTokens);
     RUN_TEST_CASE(DecodeMsgInflight, MalformedIntervalObject);
@@ -12,6 +12,16 @@ static int ut_mockidx_aircond;
 // Similar defines would be needed for AIR and LIGHT if not already in station_include.h
 static gardenMonitor_t test_gmon; // Global gardenMonitor_t for tests
 
+// runtime health appended to every full message, the test station has neither task nor allocation
+// except events taken from the pool
+#ifdef GMON_CFG_APPMSG_SYS_HEALTH
+    #define UT_EXPECTED_SYS_JSON(evtpeak) \
+        ",\"sys\":{\"stack\":[0,0,0,0],\"heap\":0,\"heapmin\":0,\"arena\":0,\"evtpeak\":" #evtpeak "," \
+        "\"mboxdrop\":[0,0],\"netms\":0,\"netmaxms\":0}"
+#else
+    #define UT_EXPECTED_SYS_JSON(evtpeak) ""
+#endif
+
 static gmonEvent_t create_test_event(
     gmonEventType_t type, unsigned int soil_moist, float air_temp, float air_humid, unsigned int lightness,
     unsigned int ticks, unsigned int days
@@ -64,7 +74,7 @@ TEST(GenerateMsgOutflight, EmptyLogEvt) {
     "\"light\":{\"ticks\":0,\"days\":0,\"qty\":0,\"corruption\":[],\"values\":[]}," \
     "\"actuators\":{\"pump\":{\"worktime\":0,\"state\":0}," \
     "\"fan\":{\"worktime\":0,\"state\":0},\"bulb\":{\"worktime\":0,\"state\":0}}" \
-    "}"
+    UT_EXPECTED_SYS_JSON(0) "}"
     unsigned short expected_json_sz = sizeof(EXPECTED_JSON) - 1;
     TEST_ASSERT_GREATER_OR_EQUAL(expected_json_sz, out_msg->len);
     TEST_ASSERT_EQUAL_UINT16(expected_json_sz, out_msg->nbytes_written);
@@ -108,7 +118,7 @@ TEST(GenerateMsgOutflight, SingleLogEvtPerSensor) {
     "\"light\":{\"ticks\":1234567,\"days\":10,\"qty\":1,\"corruption\":[0],\"values\":[[500]]}," \
     "\"actuators\":{\"pump\":{\"worktime\":0,\"state\":0}," \
     "\"fan\":{\"worktime\":0,\"state\":0},\"bulb\":{\"worktime\":0,\"state\":0}}" \
-    "}"
+    UT_EXPECTED_SYS_JSON(0) "}"
     unsigned short expected_json_sz = sizeof(EXPECTED_JSON) - 1;
     TEST_ASSERT_GREATER_OR_EQUAL(expected_json_sz, out_msg->len);
     TEST_ASSERT_EQUAL_UINT16(expected_json_sz, out_msg->nbytes_written);
@@ -190,7 +200,7 @@ TEST(GenerateMsgOutflight, MultiLogEvtPerSensor) {
     "\"light\":{\"ticks\":6000,\"days\":1,\"qty\":3,\"corruption\":[3,0],\"values\":" \
     "[[500,600,616],[510,610,637]]},\"actuators\":{\"pump\":{\"worktime\":7200,\"state\":1}," \
     "\"fan\":{\"worktime\":0,\"state\":0},\"bulb\":{\"worktime\":18000,\"state\":2}}" \
-    "}"
+    UT_EXPECTED_SYS_JSON(0) "}"
     unsigned short expected_json_sz = sizeof(EXPECTED_JSON) - 1;
     TEST_ASSERT_GREATER_OR_EQUAL(expected_json_sz, out_msg->len);
     TEST_ASSERT_EQUAL_UINT16(expected_json_sz, out_msg->nbytes_written);
@@ -279,7 +289,7 @@ TEST(GenerateMsgOutflight, FullLogEvt) {
     "\"values\":[[504,505],[506,507],[508,509],[510,511]]}," \
     "\"actuators\":{\"pump\":{\"worktime\":85100,\"state\":2}," \
     "\"fan\":{\"worktime\":91200,\"state\":1},\"bulb\":{\"worktime\":0,\"state\":0}}" \
-    "}"
+    UT_EXPECTED_SYS_JSON(0) "}"
 
     unsigned short expected_json_sz = sizeof(EXPECTED_JSON) - 1;
     TEST_ASSERT_GREATER_OR_EQUAL(expected_json_sz, out_msg->len);
@@ -391,7 +401,7 @@ TEST(GenerateMsgOutflight, LogEvtDataMissing) {
     "\"light\":{\"ticks\":6000,\"days\":1,\"qty\":1,\"corruption\":[0,1],\"values\":" \
     "[[500],null]},\"actuators\":{\"pump\":{\"worktime\":0,\"state\":0}," \
     "\"fan\":{\"worktime\":0,\"state\":0},\"bulb\":{\"worktime\":0,\"state\":0}}" \
-    "}"
+    UT_EXPECTED_SYS_JSON(0) "}"
     unsigned short expected_json_sz = sizeof(EXPECTED_JSON) - 1;
     TEST_ASSERT_GREATER_OR_EQUAL(expected_json_sz, out_msg->len);
     TEST_ASSERT_EQUAL_UINT16(expected_json_sz, out_msg->nbytes_written);
@@ -456,7 +466,7 @@ TEST(GenerateMsgOutflight, LogEvtInterleavedNullRef) {
     "\"light\":{\"ticks\":0,\"days\":0,\"qty\":0,\"corruption\":[],\"values\":[]}," \
     "\"actuators\":{\"pump\":{\"worktime\":0,\"state\":0}," \
     "\"fan\":{\"worktime\":0,\"state\":0},\"bulb\":{\"worktime\":0,\"state\":0}}" \
-    "}"
+    UT_EXPECTED_SYS_JSON(0) "}"
 
     unsigned short expected_json_sz = sizeof(EXPECTED_JSON) - 1;
     TEST_ASSERT_GREATER_OR_EQUAL(expected_json_sz, out_msg->len);
@@ -526,7 +536,7 @@ TEST(GenerateMsgOutflight, LogEvtExtremeValues) {
     "\"values\":[[9999,10],[0,9998]]}," \
     "\"actuators\":{\"pump\":{\"worktime\":2147483647,\"state\":1}," \
     "\"fan\":{\"worktime\":0,\"state\":0},\"bulb\":{\"worktime\":0,\"state\":0}}" \
-    "}"
+    UT_EXPECTED_SYS_JSON(0) "}"
 
     unsigned short expected_json_sz = sizeof(EXPECTED_JSON) - 1;
     TEST_ASSERT_GREATER_OR_EQUAL(expected_json_sz, out_msg->len);
@@ -571,7 +581,7 @@ TEST(GenerateMsgOutflight, InsufficientMemory) {
     "\"light\":{\"ticks\":0,\"days\":0,\"qty\":0,\"corruption\":[],\"values\":[]}," \
     "\"actuators\":{\"pump\":{\"worktime\":0,\"state\":0}," \
     "\"fan\":{\"worktime\":0,\"state\":0},\"bulb\":{\"worktime\":0,\"state\":0}}" \
-    "}"
+    UT_EXPECTED_SYS_JSON(0) "}"
     // ---------- subcase 1 ----------
     // Manually reduce the effective buffer size of outflight message to simulate
     // insufficient memory. This will cause serialization functions to return GMON_RESP_ERRMEM.
@@ -634,7 +644,7 @@ TEST(GenerateMsgOutflight, NumDigitExceedLimit) {
     "\"light\":{\"ticks\":0,\"days\":0,\"qty\":0,\"corruption\":[],\"values\":[]}," \
     "\"actuators\":{\"pump\":{\"worktime\":0,\"state\":0}," \
     "\"fan\":{\"worktime\":0,\"state\":0},\"bulb\":{\"worktime\":0,\"state\":0}}" \
-    "}"
+    UT_EXPECTED_SYS_JSON(0) "}"
     unsigned short              expect_data_sz = sizeof(UT_EXPECTED_JSON) - 1, actual_data_sz = 0;
     gmonAppMsgOutflightResult_t of_res = staGetAppMsgOutflight(&test_gmon);
     actual_data_sz = of_res.msg->nbytes_written;
@@ -865,6 +875,18 @@ TEST(ReallocBuffer, SameSize_ReuseBuffer) {
     TEST_ASSERT_EQUAL_PTR(first_alloc_ptr, second_alloc_ptr);
 }
 
+// allocator may or may not move the buffer, the entire length reported must be writable and shared
+// with in-flight message
+static void ut_realloc_assert_buffer_usable(unsigned char pattern) {
+    unsigned char *buf = test_gmon.rawmsg.outflight.data;
+    unsigned short idx = 0;
+    TEST_ASSERT_NOT_NULL(buf);
+    TEST_ASSERT_EQUAL_PTR(buf, test_gmon.rawmsg.inflight.data);
+    XMEMSET(buf, pattern, test_gmon.rawmsg.outflight.len);
+    for (idx = 0; idx < test_gmon.rawmsg.outflight.len; idx++)
+        TEST_ASSERT_EQUAL_HEX8(pattern, buf[idx]);
+}
+
 TEST(ReallocBuffer, GrowShrinkBuffer) {
     // 1. Initial allocation with a smaller configuration
     test_gmon.sensors.soil_moist.super.num_items = 1;
@@ -872,10 +894,9 @@ TEST(ReallocBuffer, GrowShrinkBuffer) {
     test_gmon.sensors.light.num_items = 1;
     gMonStatus status = staAppMsgReallocBuffer(&test_gmon);
     TEST_ASSERT_EQUAL(GMON_RESP_OK, status);
-    void          *first_alloc_ptr = test_gmon.rawmsg.outflight.data;
     unsigned short first_alloc_len = test_gmon.rawmsg.outflight.len;
-    TEST_ASSERT_NOT_NULL(first_alloc_ptr);
     TEST_ASSERT_GREATER_THAN(0, first_alloc_len);
+    ut_realloc_assert_buffer_usable(0x5a);
 
     // 2. Modify sensor counts to require a larger buffer
     test_gmon.sensors.soil_moist.super.num_items = 2;
@@ -883,12 +904,9 @@ TEST(ReallocBuffer, GrowShrinkBuffer) {
     test_gmon.sensors.light.num_items = 3;
     status = staAppMsgReallocBuffer(&test_gmon);
     TEST_ASSERT_EQUAL(GMON_RESP_OK, status);
-    void          *second_alloc_ptr = test_gmon.rawmsg.outflight.data;
     unsigned short second_alloc_len = test_gmon.rawmsg.outflight.len;
-    TEST_ASSERT_NOT_NULL(second_alloc_ptr);
-    TEST_ASSERT_EQUAL_PTR(second_alloc_ptr, test_gmon.rawmsg.inflight.data);
     TEST_ASSERT_GREATER_THAN(first_alloc_len, second_alloc_len);
-    TEST_ASSERT_NOT_EQUAL(first_alloc_ptr, second_alloc_ptr);
+    ut_realloc_assert_buffer_usable(0xa5);
 
     // 3. Modify sensor counts to require a smaller buffer
     test_gmon.sensors.soil_moist.super.num_items = 2;
@@ -896,16 +914,287 @@ TEST(ReallocBuffer, GrowShrinkBuffer) {
     test_gmon.sensors.light.num_items = 2;
     status = staAppMsgReallocBuffer(&test_gmon);
     TEST_ASSERT_EQUAL(GMON_RESP_OK, status);
-    void          *third_alloc_ptr = test_gmon.rawmsg.outflight.data;
     unsigned short third_alloc_len = test_gmon.rawmsg.outflight.len;
-    TEST_ASSERT_NOT_NULL(third_alloc_ptr);
-    TEST_ASSERT_EQUAL_PTR(third_alloc_ptr, test_gmon.rawmsg.inflight.data);
-    TEST_ASSERT_NOT_EQUAL(first_alloc_ptr, third_alloc_ptr);
-    TEST_ASSERT_NOT_EQUAL(second_alloc_ptr, third_alloc_ptr);
-    TEST_ASSERT_GREATER_THAN(first_alloc_len, second_alloc_len);
     TEST_ASSERT_GREATER_THAN(third_alloc_len, second_alloc_len);
     TEST_ASSERT_GREATER_THAN(first_alloc_len, third_alloc_len);
+    ut_realloc_assert_buffer_usable(0x3c);
+}
+
+TEST_GROUP(DetachRecords);
+
+static gmonEvent_t ut_detach_evt_pool[4];
+
+static gmonEvent_t *ut_detach_log_soil(unsigned int soil_moist, unsigned int ticks) {
+    gmonEvent_t *evt = staAllocSensorEvent(&test_gmon.sensors.event, GMON_EVENT_SOIL_MOISTURE_UPDATED, 1);
+    TEST_ASSERT_NOT_NULL(evt);
+    ((unsigned int *)evt->data)[0] = soil_moist;
+    evt->curr_ticks = ticks;
+    evt->curr_days = 1;
+    TEST_ASSERT_NULL(staUpdateLastRecord(&test_gmon.latest_logs.soilmoist, evt));
+    return evt;
+}
+
+TEST_SETUP(DetachRecords) {
+    XMEMSET(&test_gmon, 0, sizeof(gardenMonitor_t));
+    XMEMSET(ut_detach_evt_pool, 0, sizeof(ut_detach_evt_pool));
+    test_gmon.sensors.event.pool = ut_detach_evt_pool;
+    test_gmon.sensors.event.len = 4;
+    staAppMsgInit(&test_gmon);
+    test_gmon.sensors.soil_moist.super.num_items = 1;
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staAppMsgReallocBuffer(&test_gmon));
+}
+
+TEST_TEAR_DOWN(DetachRecords) {
+    staAppMsgOutResetAllRecords(&test_gmon);
+    staAppMsgOutResetDetachedRecords(&test_gmon);
+    staAppMsgDeinit(&test_gmon);
+}
+
+TEST(DetachRecords, SerializeWhileLogging) {
+    gmonEvent_t *evt1 = ut_detach_log_soil(811, 100);
+    test_gmon.actuator.pump.status = GMON_OUT_DEV_STATUS_ON;
+    test_gmon.actuator.pump.curr_worktime = 500;
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staAppMsgOutDetachRecords(&test_gmon));
+    for (int i = 0; i < test_gmon.latest_logs.soilmoist.num_refs; i++)
+        TEST_ASSERT_NULL(test_gmon.latest_logs.soilmoist.events[i]);
+    TEST_ASSERT_EQUAL(0, test_gmon.latest_logs.soilmoist.inner_wr_ptr);
+    // sensor task keeps logging, and the actuator changes state, before the serialization completes
+    gmonEvent_t *evt2 = ut_detach_log_soil(822, 200);
+    test_gmon.actuator.pump.status = GMON_OUT_DEV_STATUS_OFF;
+    gmonAppMsgOutflightResult_t of_res = staGetAppMsgOutflightDetached(&test_gmon);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, of_res.status);
+#define EXPECTED_JSON \
+    "{\"soilmoist\":{\"ticks\":100,\"days\":1,\"qty\":1,\"corruption\":[0],\"values\":[[811]]}," \
+    "\"airtemp\":{\"ticks\":0,\"days\":0,\"qty\":0,\"corruption\":[]," \
+    "\"values\":{\"temp\":[],\"humid\":[]}}," \
+    "\"light\":{\"ticks\":0,\"days\":0,\"qty\":0,\"corruption\":[],\"values\":[]}," \
+    "\"actuators\":{\"pump\":{\"worktime\":500,\"state\":1}," \
+    "\"fan\":{\"worktime\":0,\"state\":0},\"bulb\":{\"worktime\":0,\"state\":0}}" \
+    UT_EXPECTED_SYS_JSON(2) "}"
+    TEST_ASSERT_EQUAL_UINT16(sizeof(EXPECTED_JSON) - 1, of_res.msg->nbytes_written);
+    TEST_ASSERT_EQUAL_STRING_LEN(EXPECTED_JSON, (const char *)of_res.msg->data, sizeof(EXPECTED_JSON) - 1);
+#undef EXPECTED_JSON
+    // serialized events are returned to the pool, the one logged meanwhile is kept for next cycle
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staAppMsgOutResetDetachedRecords(&test_gmon));
+    TEST_ASSERT_EQUAL(0, evt1->flgs.alloc);
+    TEST_ASSERT_EQUAL(1, evt2->flgs.alloc);
+    for (int i = 0; i < test_gmon.rawmsg.detached.logs.soilmoist.num_refs; i++)
+        TEST_ASSERT_NULL(test_gmon.rawmsg.detached.logs.soilmoist.events[i]);
+    TEST_ASSERT_EQUAL_PTR(evt2, test_gmon.latest_logs.soilmoist.events[0]);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staAppMsgOutDetachRecords(&test_gmon));
+    TEST_ASSERT_EQUAL_PTR(evt2, test_gmon.rawmsg.detached.logs.soilmoist.events[0]);
+    TEST_ASSERT_EQUAL(1, test_gmon.rawmsg.detached.logs.soilmoist.inner_wr_ptr);
+    TEST_ASSERT_EQUAL(GMON_OUT_DEV_STATUS_OFF, test_gmon.rawmsg.detached.actuators[0].status);
+}
+
+#ifdef GMON_CFG_APPMSG_SYS_HEALTH
+TEST(GenerateMsgOutflight, SysHealth) {
+    // mock task handle points to its free stack
+    unsigned int stack_free[4] = {88, 120, 240, 64};
+    test_gmon.tasks.sensor_sched = &stack_free[0];
+    test_gmon.tasks.sensor_data_aggregator_net = &stack_free[1];
+    test_gmon.tasks.netconn_handler = &stack_free[2];
+    test_gmon.tasks.display_handler = &stack_free[3];
+    g_mock_heap_free = 10240;
+    g_mock_heap_min_free = 8192;
+    test_gmon.arena.used = 3624;
+    test_gmon.sensors.event.peak = 9;
+    test_gmon.msgpipe.num_dropped.sensor2display = 0;
+    test_gmon.msgpipe.num_dropped.sensor2net = 3;
+    test_gmon.netconn.cycle.last_ms = 120;
+    test_gmon.netconn.cycle.max_ms = 450;
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staAppMsgReallocBuffer(&test_gmon));
+    gmonAppMsgOutflightResult_t of_res = staGetAppMsgOutflight(&test_gmon);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, of_res.status);
+#define EXPECTED_SYS_JSON \
+    ",\"sys\":{\"stack\":[88,120,240,64],\"heap\":10240,\"heapmin\":8192,\"arena\":3624,\"evtpeak\":9," \
+    "\"mboxdrop\":[0,3],\"netms\":120,\"netmaxms\":450}}"
+    unsigned short expected_sz = sizeof(EXPECTED_SYS_JSON) - 1;
+    TEST_ASSERT_GREATER_THAN(expected_sz, of_res.msg->nbytes_written);
+    TEST_ASSERT_EQUAL_STRING_LEN(
+        EXPECTED_SYS_JSON, (const char *)&of_res.msg->data[of_res.msg->nbytes_written - expected_sz],
+        expected_sz
+    );
+#undef EXPECTED_SYS_JSON
+    g_mock_heap_free = 0;
+    g_mock_heap_min_free = 0;
+}
+#endif // end of GMON_CFG_APPMSG_SYS_HEALTH
+
+#ifdef GMON_CFG_ENABLE_EVENT_LATENCY
+TEST(GenerateMsgOutflight, EventLatency) {
+    gMonEvtLatency_t *lat = &test_gmon.rawmsg.latency;
+    gmonEvent_t       evts[3] = {0};
+    ut_mockidx_soilmoist = 0;
+    test_gmon.sensors.soil_moist.super.num_items = 1;
+    test_gmon.sensors.air_temp.num_items = 1;
+    test_gmon.sensors.light.num_items = 1;
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staAppMsgReallocBuffer(&test_gmon));
+    for (int i = 0; i < 3; i++) {
+        evts[i] = create_test_event(GMON_EVENT_SOIL_MOISTURE_UPDATED, 800 + i, 0, 0, 0, 1200, 3);
+        evts[i].num_active_sensors = 1;
+        evts[i].acquired_ms = 1000 + i * 100;
+        evts[i].stage_ms[GMON_EVT_STAGE_DETECT] = 1;
+        evts[i].stage_ms[GMON_EVT_STAGE_AGGREGATE] = 2;
+        evts[i].stage_ms[GMON_EVT_STAGE_TRIGGER] = 3;
+        evts[i].stage_ms[GMON_EVT_STAGE_LOGGED] = 9;
+        staUpdateLastRecord(&test_gmon.latest_logs.soilmoist, &evts[i]);
+    }
+    // this message closes the window
+    lat->num_full_since_report = GMON_CFG_EVENT_LATENCY_REPORT_EVERY - 1;
+    setMockTickCount(1300);
+    gmonAppMsgOutflightResult_t of_res = staGetAppMsgOutflight(&test_gmon);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, of_res.status);
+    // median of serialization latency (300, 200, 100 ms) falls in bucket [128, 256)
+#define EXPECTED_LATENCY_JSON \
+    ",\"latency\":{\"soilmoist\":{\"n\":3,\"p50\":[1,2,3,9,256,0],\"max\":[1,2,3,9,300,0]}," \
+    "\"airtemp\":{\"n\":0,\"p50\":[0,0,0,0,0,0],\"max\":[0,0,0,0,0,0]}," \
+    "\"light\":{\"n\":0,\"p50\":[0,0,0,0,0,0],\"max\":[0,0,0,0,0,0]}}}"
+    unsigned short expected_sz = sizeof(EXPECTED_LATENCY_JSON) - 1;
+    TEST_ASSERT_GREATER_THAN(expected_sz, of_res.msg->nbytes_written);
+    TEST_ASSERT_EQUAL_STRING_LEN(
+        EXPECTED_LATENCY_JSON, (const char *)&of_res.msg->data[of_res.msg->nbytes_written - expected_sz],
+        expected_sz
+    );
+#undef EXPECTED_LATENCY_JSON
+    // next window starts, the oldest event is still waiting for acknowledgement
+    TEST_ASSERT_EQUAL(0, lat->num_full_since_report);
+    TEST_ASSERT_EQUAL(0, lat->hist[GMON_APPMSG_ITEM_SOILMOIST].max_ms[GMON_EVT_STAGE_SERIALIZED]);
+    setMockTickCount(1500);
+    staAppMsgOutAcked(&test_gmon);
+    TEST_ASSERT_EQUAL(500, lat->hist[GMON_APPMSG_ITEM_SOILMOIST].max_ms[GMON_EVT_STAGE_ACKED]);
+    TEST_ASSERT_EQUAL(0, lat->hist[GMON_APPMSG_ITEM_AIRTEMP].max_ms[GMON_EVT_STAGE_ACKED]);
+    TEST_ASSERT_EQUAL(0, lat->unacked);
+    setMockTickCount(0);
+}
+#endif // end of GMON_CFG_ENABLE_EVENT_LATENCY
+
+#ifdef GMON_CFG_APPMSG_REPORT_BY_EXCEPTION
+TEST_GROUP(ReportByException);
+
+static gmonEvent_t ut_rbe_evts[3];
+
+// clear the records without freeing events to pool, then log one event for each sensor type
+static void
+ut_rbe_log_events(unsigned int soil_moist, float air_temp, float air_humid, unsigned int lightness) {
+    gmonSensorRecord_t *recs[3] = {
+        &test_gmon.latest_logs.soilmoist, &test_gmon.latest_logs.aircond, &test_gmon.latest_logs.light
+    };
+    for (int i = 0; i < 3; i++) {
+        XMEMSET(recs[i]->events, 0x00, recs[i]->num_refs * sizeof(gmonEvent_t *));
+        recs[i]->inner_wr_ptr = 0;
+    }
+    ut_mockidx_soilmoist = 0;
+    ut_mockidx_aircond = 0;
+    ut_mockidx_lightness = 0;
+    ut_rbe_evts[0] = create_test_event(GMON_EVENT_SOIL_MOISTURE_UPDATED, soil_moist, 0, 0, 0, 1200, 3);
+    ut_rbe_evts[1] = create_test_event(GMON_EVENT_AIR_TEMP_UPDATED, 0, air_temp, air_humid, 0, 1200, 3);
+    ut_rbe_evts[2] = create_test_event(GMON_EVENT_LIGHTNESS_UPDATED, 0, 0, 0, lightness, 1200, 3);
+    for (int i = 0; i < 3; i++) {
+        ut_rbe_evts[i].num_active_sensors = 1;
+        staUpdateLastRecord(recs[i], &ut_rbe_evts[i]);
+    }
+}
+
+static void ut_rbe_assert_outflight(const char *expect_json) {
+    gmonAppMsgOutflightResult_t of_res = staGetAppMsgOutflight(&test_gmon);
+    unsigned short              expect_sz = strlen(expect_json);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, of_res.status);
+    TEST_ASSERT_EQUAL_STRING_LEN(expect_json, (const char *)of_res.msg->data, of_res.msg->nbytes_written);
+    TEST_ASSERT_EQUAL_UINT16(expect_sz, of_res.msg->nbytes_written);
+    TEST_ASSERT_EQUAL_STRING_LEN(expect_json, (const char *)of_res.msg->data, expect_sz);
+}
+
+TEST_SETUP(ReportByException) {
+    XMEMSET(&test_gmon, 0, sizeof(gardenMonitor_t));
+    staAppMsgInit(&test_gmon);
+    test_gmon.sensors.soil_moist.super.num_items = 1;
+    test_gmon.sensors.air_temp.num_items = 1;
+    test_gmon.sensors.light.num_items = 1;
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staAppMsgReallocBuffer(&test_gmon));
+}
+
+TEST_TEAR_DOWN(ReportByException) { staAppMsgDeinit(&test_gmon); }
+
+TEST(ReportByException, OmitWithinDeadband) {
+    ut_rbe_log_events(800, 25.5f, 70.5f, 500);
+    ut_rbe_assert_outflight(
+        "{\"soilmoist\":{\"ticks\":1200,\"days\":3,\"qty\":1,\"corruption\":[0],\"values\":[[800]]},"
+        "\"airtemp\":{\"ticks\":1200,\"days\":3,\"qty\":1,\"corruption\":[0],"
+        "\"values\":{\"temp\":[[25.5]],\"humid\":[[70.5]]}},"
+        "\"light\":{\"ticks\":1200,\"days\":3,\"qty\":1,\"corruption\":[0],\"values\":[[500]]},"
+        "\"actuators\":{\"pump\":{\"worktime\":0,\"state\":0},"
+        "\"fan\":{\"worktime\":0,\"state\":0},\"bulb\":{\"worktime\":0,\"state\":0}}"
+        UT_EXPECTED_SYS_JSON(0) "}"
+    );
+    staAppMsgOutAcked(&test_gmon);
+    // only light sensor moved beyond the deadband, and pump changed state
+    ut_rbe_log_events(800 + GMON_CFG_APPMSG_DEADBAND_SOILMOIST, 25.7f, 71.0f, 517);
+    test_gmon.actuator.pump.status = GMON_OUT_DEV_STATUS_ON;
+    test_gmon.actuator.pump.curr_worktime = 1000;
+    ut_rbe_assert_outflight(
+        "{\"light\":{\"ticks\":1200,\"days\":3,\"qty\":1,\"corruption\":[0],\"values\":[[517]]},"
+        "\"actuators\":{\"pump\":{\"worktime\":1000,\"state\":1}}}"
+    );
+    TEST_ASSERT_EQUAL(4, test_gmon.rawmsg.deadband.stats.num_omitted);
+    staAppMsgOutAcked(&test_gmon);
+    // nothing changed
+    ut_rbe_log_events(801, 25.5f, 70.5f, 510);
+    test_gmon.actuator.pump.curr_worktime = 1000 + GMON_CFG_APPMSG_DEADBAND_WORKTIME_MS;
+    ut_rbe_assert_outflight("{}");
+    // the sensor type is serialized if any of its events is beyond the deadband
+    ut_rbe_log_events(801, 25.5f, 70.5f, 510);
+    ut_rbe_evts[1].flgs.corruption = 1;
+    ut_rbe_assert_outflight(
+        "{\"airtemp\":{\"ticks\":1200,\"days\":3,\"qty\":1,\"corruption\":[1],"
+        "\"values\":{\"temp\":[[25.5]],\"humid\":[[70.5]]}}}"
+    );
+}
+
+TEST(ReportByException, ReferenceUntilAcked) {
+    const char *expect_soil_json =
+        "{\"soilmoist\":{\"ticks\":1200,\"days\":3,\"qty\":1,\"corruption\":[0],\"values\":[[%u]]}}";
+    char expect_json[96] = {0};
+    ut_rbe_log_events(800, 25.5f, 70.5f, 500);
+    staGetAppMsgOutflight(&test_gmon);
+    staAppMsgOutAcked(&test_gmon);
+    ut_rbe_log_events(900, 25.5f, 70.5f, 500);
+    snprintf(expect_json, sizeof(expect_json), expect_soil_json, 900);
+    ut_rbe_assert_outflight(expect_json);
+    // previous message is not delivered yet, compare with the values the remote user received
+    ut_rbe_log_events(902, 25.5f, 70.5f, 500);
+    snprintf(expect_json, sizeof(expect_json), expect_soil_json, 902);
+    ut_rbe_assert_outflight(expect_json);
+    staAppMsgOutAcked(&test_gmon);
+    ut_rbe_log_events(905, 25.5f, 70.5f, 500);
+    ut_rbe_assert_outflight("{}");
+    // reported in the message which failed to serialize
+    ut_rbe_log_events(930, 25.5f, 70.5f, 500);
+    test_gmon.rawmsg.outflight.len = 8;
+    TEST_ASSERT_EQUAL(GMON_RESP_ERRMEM, staGetAppMsgOutflight(&test_gmon).status);
+    staAppMsgOutAcked(&test_gmon);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staAppMsgReallocBuffer(&test_gmon));
+    snprintf(expect_json, sizeof(expect_json), expect_soil_json, 930);
+    ut_rbe_assert_outflight(expect_json);
+}
+
+TEST(ReportByException, PeriodicFullReport) {
+    gmonAppMsgOutflightResult_t of_res = {0};
+    ut_rbe_log_events(800, 25.5f, 70.5f, 500);
+    staGetAppMsgOutflight(&test_gmon);
+    staAppMsgOutAcked(&test_gmon);
+    TEST_ASSERT_EQUAL(1, test_gmon.rawmsg.deadband.stats.num_full);
+    for (int i = 1; i < GMON_CFG_APPMSG_FULL_REPORT_EVERY; i++) {
+        ut_rbe_assert_outflight("{}");
+        staAppMsgOutAcked(&test_gmon);
+    }
+    of_res = staGetAppMsgOutflight(&test_gmon);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, of_res.status);
+    TEST_ASSERT_GREATER_THAN(sizeof("{}"), of_res.msg->nbytes_written);
+    TEST_ASSERT_EQUAL(2, test_gmon.rawmsg.deadband.stats.num_full);
+    TEST_ASSERT_EQUAL(0, test_gmon.rawmsg.deadband.num_since_full);
 }
+#endif // end of GMON_CFG_APPMSG_REPORT_BY_EXCEPTION
 
 TEST_GROUP_RUNNER(gMonAppMsgOutbound) {
     RUN_TEST_CASE(GenerateMsgOutflight, EmptyLogEvt);
@@ -925,4 +1214,16 @@ TEST_GROUP_RUNNER(gMonAppMsgOutbound) {
     RUN_TEST_CASE(UpdateLastRecord, AddNullEventToFullRecord);
     RUN_TEST_CASE(ReallocBuffer, SameSize_ReuseBuffer);
     RUN_TEST_CASE(ReallocBuffer, GrowShrinkBuffer);
+    RUN_TEST_CASE(DetachRecords, SerializeWhileLogging);
+#ifdef GMON_CFG_APPMSG_SYS_HEALTH
+    RUN_TEST_CASE(GenerateMsgOutflight, SysHealth);
+#endif
+#ifdef GMON_CFG_ENABLE_EVENT_LATENCY
+    RUN_TEST_CASE(GenerateMsgOutflight, EventLatency);
+#endif
+#ifdef GMON_CFG_APPMSG_REPORT_BY_EXCEPTION
+    RUN_TEST_CASE(ReportByException, OmitWithinDeadband);
+    RUN_TEST_CASE(ReportByException, ReferenceUntilAcked);
+    RUN_TEST_CASE(ReportByException, PeriodicFullReport);
+#endif
 }
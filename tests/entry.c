@@ -3,13 +3,26 @@
 static void RunAllTests(void) {
     RUN_TEST_GROUP(gMonUtilityStrProcess);
     RUN_TEST_GROUP(gMonUtilityStatistical);
+    RUN_TEST_GROUP(gMonInitArena);
+    RUN_TEST_GROUP(gMonTraceRing);
+    RUN_TEST_GROUP(gMonCritSectProf);
+    RUN_TEST_GROUP(gMonEvtLatency);
+    RUN_TEST_GROUP(gMonProfScope);
     RUN_TEST_GROUP(gMonAppMsgInbound);
     RUN_TEST_GROUP(gMonAppMsgOutbound);
     RUN_TEST_GROUP(gMonSensorEvt);
     RUN_TEST_GROUP(gMonSensorSample);
+    RUN_TEST_GROUP(gMonSensorSched);
     RUN_TEST_GROUP(gMonActuator);
     RUN_TEST_GROUP(gMonDisplay);
+    RUN_TEST_GROUP(gMonOLEDemulator);
     RUN_TEST_GROUP(gMonSoilSensor);
+    RUN_TEST_GROUP(gMonDHT11);
+    RUN_TEST_GROUP(gMonNetConnBacklog);
+    RUN_TEST_GROUP(gMonNetConnPubWindow);
+    RUN_TEST_GROUP(gMonNetConnAdaptive);
+    RUN_TEST_GROUP(gMonNetConnMqttClient);
+    RUN_TEST_GROUP(gMonNetConnHandler);
 }
 
 int main(int argc, const char *argv[]) { return UnityMain(argc, argv, RunAllTests); }
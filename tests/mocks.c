@@ -1,7 +1,6 @@
 #include "station_include.h"
 #include "mocks.h"
-
-const unsigned short gmon_txt_font_bitmap_11x18[] = {2, 3, 4, 5};
+#include "oled_emu.h"
 
 uint32_t UTestSysGetTickCount(void) { return g_mock_tick_count; }
 
@@ -10,6 +9,26 @@ uint32_t g_mock_tick_count = 0;
 
 void setMockTickCount(uint32_t count) { g_mock_tick_count = count; }
 
+unsigned int g_mock_heap_free = 0;
+unsigned int g_mock_heap_min_free = 0;
+
+// mock task handle points to the amount of stack left to the task
+unsigned int UTestSysGetTaskStackFree(stationSysTask_t task) {
+    return (task != NULL) ? *(unsigned int *)task : 0;
+}
+
+// sleeping task is simulated by advancing the mock tick count to the wakeup time
+gMonStatus UTestSysDelayUntilMs(unsigned int *prev_wake_ms, unsigned int period_ms) {
+    if (prev_wake_ms == NULL)
+        return GMON_RESP_ERRARGS;
+    unsigned int now_ms = g_mock_tick_count * GMON_NUM_MILLISECONDS_PER_TICK;
+    unsigned int remain_ms = staNextWakeupMs(prev_wake_ms, period_ms, now_ms);
+    if (remain_ms == 0)
+        return GMON_RESP_SKIP;
+    g_mock_tick_count += remain_ms / GMON_NUM_MILLISECONDS_PER_TICK;
+    return GMON_RESP_OK;
+}
+
 stationSysMsgbox_t UTestSysMsgBoxCreate(size_t length) {
     mock_msg_queue_t *queue = (mock_msg_queue_t *)XMALLOC(sizeof(mock_msg_queue_t));
     if (queue == NULL)
@@ -66,26 +85,45 @@ gMonStatus staActuatorInitPump(gMonActuator_t *dev) {
     return GMON_RESP_OK;
 }
 gMonStatus staActuatorDeinitPump(void) { return GMON_RESP_OK; }
+gMonStatus staActuatorTrigPump(gMonActuator_t *dev, gmonEvent_t *evt, gMonSoilSensorMeta_t *sensor) {
+    (void)dev;
+    (void)evt;
+    (void)sensor;
+    return GMON_RESP_OK;
+}
 
 gMonStatus staActuatorInitFan(gMonActuator_t *dev) {
     (void)dev;
     return GMON_RESP_OK;
 }
 gMonStatus staActuatorDeinitFan(void) { return GMON_RESP_OK; }
+gMonStatus staActuatorTrigFan(gMonActuator_t *dev, gmonEvent_t *evt, gMonSensorMeta_t *sensor) {
+    (void)dev;
+    (void)evt;
+    (void)sensor;
+    return GMON_RESP_OK;
+}
 
 gMonStatus staActuatorInitBulb(gMonActuator_t *dev) {
     (void)dev;
     return GMON_RESP_OK;
 }
 gMonStatus staActuatorDeinitBulb(void) { return GMON_RESP_OK; }
+gMonStatus staActuatorTrigBulb(gMonActuator_t *dev, gmonEvent_t *evt, gMonSensorMeta_t *sensor) {
+    (void)dev;
+    (void)evt;
+    (void)sensor;
+    return GMON_RESP_OK;
+}
 
 gMonStatus staTurnOffActuator(gMonActuator_t *ac) {
     ac->status = GMON_OUT_DEV_STATUS_OFF;
     return GMON_RESP_OK;
 }
 
-gMonStatus staSetNetConnTaskInterval(gMonNet_t *net, unsigned int interval_ms) {
-    net->interval_ms = interval_ms; // Update gmon for verification
+// weak symbol for fleet simulation, unit tests and the network benchmark link the real one in src/netconn.c
+__attribute__((weak)) gMonStatus staSetNetConnTaskInterval(gMonNet_t *net, unsigned int interval_ms) {
+    net->interval_ms = interval_ms;
     return GMON_RESP_OK;
 }
 
@@ -97,16 +135,6 @@ gMonStatus staSetRequiredDaylenTicks(gardenMonitor_t *gmon, unsigned int light_l
     return GMON_RESP_INVALID_REQ;
 }
 
-gMonStatus staDisplayDevInit(void) { return GMON_RESP_OK; }
-gMonStatus staDisplayDevDeInit(void) { return GMON_RESP_OK; }
-gMonStatus staDiplayDevPrintString(gmonPrintInfo_t *printinfo) {
-    (void)printinfo;
-    return GMON_RESP_OK;
-}
-unsigned short staDisplayDevGetScreenWidth(void) { return 120; }
-
-gMonStatus staDisplayRefreshScreen(void) { return GMON_RESP_OK; }
-
 gMonStatus staSensorPlatformInitSoilMoist(gMonSensorMeta_t *s) {
     (void)s;
     return GMON_RESP_OK;
@@ -141,21 +169,88 @@ gMonStatus staSensorPlatformDeInitAirTemp(gMonSensorMeta_t *s) {
     (void)s;
     return GMON_RESP_OK;
 }
-gMonStatus staPlatformMeasurePulse(void *pinstruct, uint8_t *direction, uint16_t *us) {
-    (void)pinstruct;
-    (void)direction;
-    (void)us;
+typedef struct {
+    void           *pinstruct;
+    const uint16_t *edges_us;
+    uint16_t        num_edges;
+    unsigned char   num_captures;
+    unsigned char   fail_at; // the capture which does not receive any edge, counted from 1
+} utestCapturedWave_t;
+
+static utestCapturedWave_t utest_captured_waves[GMON_MAXNUM_AIR_SENSORS];
+
+void UTestPlatformSetCapturedEdges(void *pinstruct, const uint16_t *edges_us, uint16_t num_edges) {
+    unsigned char idx = 0;
+    if (pinstruct == NULL) {
+        XMEMSET(utest_captured_waves, 0x00, sizeof(utest_captured_waves));
+        return;
+    }
+    for (idx = 0; idx < GMON_MAXNUM_AIR_SENSORS; idx++) {
+        if (utest_captured_waves[idx].pinstruct == pinstruct || utest_captured_waves[idx].pinstruct == NULL)
+            break;
+    }
+    if (idx < GMON_MAXNUM_AIR_SENSORS)
+        utest_captured_waves[idx] =
+            (utestCapturedWave_t){.pinstruct = pinstruct, .edges_us = edges_us, .num_edges = num_edges};
+}
+
+void UTestPlatformFailCapture(void *pinstruct, unsigned char nth) {
+    for (unsigned char idx = 0; idx < GMON_MAXNUM_AIR_SENSORS; idx++) {
+        if (utest_captured_waves[idx].pinstruct == pinstruct)
+            utest_captured_waves[idx].fail_at = nth;
+    }
+}
+
+// replay recorded waveform of each pin, timeout if it does not contain enough edges. The caller sleeps
+// until the longest frame is captured, the mock tick count advances by that time
+gMonStatus staPlatformCaptureEdgesMulti(
+    void **pinstructs, uint8_t num_pins, uint16_t *edges_us, uint16_t num_edges, uint16_t timeout_ms,
+    gMonStatus *pin_status
+) {
+    uint16_t      num_copy = 0, frame_us = 0, max_frame_us = 0;
+    unsigned char idx = 0, jdx = 0;
+    if (pinstructs == NULL || num_pins == 0 || edges_us == NULL || num_edges == 0 || pin_status == NULL)
+        return GMON_RESP_ERRARGS;
+    for (idx = 0; idx < num_pins; idx++) {
+        utestCapturedWave_t *wave = NULL;
+        for (jdx = 0; jdx < GMON_MAXNUM_AIR_SENSORS; jdx++) {
+            if (utest_captured_waves[jdx].pinstruct == pinstructs[idx])
+                wave = &utest_captured_waves[jdx];
+        }
+        num_copy = (wave == NULL) ? 0 : ((wave->num_edges < num_edges) ? wave->num_edges : num_edges);
+        if (wave != NULL && ++wave->num_captures == wave->fail_at)
+            num_copy = 0;
+        if (num_copy > 0) {
+            XMEMCPY(&edges_us[idx * num_edges], wave->edges_us, sizeof(uint16_t) * num_copy);
+            frame_us = wave->edges_us[num_copy - 1] - wave->edges_us[0];
+        }
+        if (num_copy < num_edges) {
+            pin_status[idx] = GMON_RESP_TIMEOUT;
+            frame_us = timeout_ms * 1000;
+        } else {
+            pin_status[idx] = GMON_RESP_OK;
+        }
+        if (max_frame_us < frame_us)
+            max_frame_us = frame_us;
+    }
+    setMockTickCount(g_mock_tick_count + (max_frame_us + 999) / 1000 / GMON_NUM_MILLISECONDS_PER_TICK);
     return GMON_RESP_OK;
 }
+
+gMonStatus
+staPlatformCaptureEdges(void *pinstruct, uint16_t *edges_us, uint16_t num_edges, uint16_t timeout_ms) {
+    gMonStatus pin_status = GMON_RESP_ERR;
+    gMonStatus status =
+        staPlatformCaptureEdgesMulti(&pinstruct, 1, edges_us, num_edges, timeout_ms, &pin_status);
+    return (status == GMON_RESP_OK) ? pin_status : status;
+}
 gMonStatus staPlatformPinSetDirection(void *pinstruct, uint8_t direction) {
     (void)pinstruct;
     (void)direction;
     return GMON_RESP_OK;
 }
 gMonStatus staPlatformWritePin(void *pinstruct, uint8_t new_state) {
-    (void)pinstruct;
-    (void)new_state;
-    return GMON_RESP_OK;
+    return UTestOLEDemuWritePin(pinstruct, new_state);
 }
 gMonStatus stationSysDelayUs(unsigned short time_us) {
     (void)time_us;
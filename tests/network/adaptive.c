@@ -0,0 +1,157 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "station_include.h"
+
+#define UTEST_BASE_INTERVAL_MS GMON_MIN_NETCONN_START_INTERVAL_MS
+
+static gardenMonitor_t utest_gmon;
+
+// serialize logs at given time, same as network handler task does
+static void utestAdaptiveReport(unsigned int now_ms) {
+    utest_gmon.netconn.session.last_publish_ms = now_ms;
+    staNetConnAdaptiveOnReport(&utest_gmon);
+}
+
+TEST_GROUP(NetConnAdaptive);
+
+TEST_SETUP(NetConnAdaptive) {
+    XMEMSET(&utest_gmon, 0x00, sizeof(gardenMonitor_t));
+    utest_gmon.netconn.interval_ms = UTEST_BASE_INTERVAL_MS;
+    utest_gmon.actuator.bulb.threshold = 100;
+    utest_gmon.actuator.pump.threshold = 800;
+    utest_gmon.actuator.fan.threshold = 50;
+    utest_gmon.actuator.bulb.ema.last_aggregated = 300;
+    utest_gmon.actuator.pump.ema.last_aggregated = 600;
+    utest_gmon.actuator.fan.ema.last_aggregated = 25;
+    staNetConnAdaptiveReset(&utest_gmon.netconn);
+}
+
+TEST_TEAR_DOWN(NetConnAdaptive) {}
+
+#ifdef GMON_CFG_NETCONN_ADAPTIVE_INTERVAL
+TEST(NetConnAdaptive, BackoffWhenStable) {
+    unsigned int now_ms = 0, expect_ms = UTEST_BASE_INTERVAL_MS;
+    TEST_ASSERT_FALSE(staNetConnReportDue(&utest_gmon, UTEST_BASE_INTERVAL_MS - 1));
+    TEST_ASSERT_TRUE(staNetConnReportDue(&utest_gmon, UTEST_BASE_INTERVAL_MS));
+    // first report only takes snapshot of the actuators
+    utestAdaptiveReport(now_ms);
+    TEST_ASSERT_EQUAL_UINT32(UTEST_BASE_INTERVAL_MS, utest_gmon.netconn.adaptive.interval_ms);
+    while (expect_ms < GMON_CFG_NETCONN_ADAPTIVE_MAX_INTERVAL_MS) {
+        now_ms += utest_gmon.netconn.adaptive.interval_ms;
+        // small drift within the deadband
+        utest_gmon.actuator.pump.ema.last_aggregated += 1;
+        utestAdaptiveReport(now_ms);
+        expect_ms <<= 1;
+        if (expect_ms > GMON_CFG_NETCONN_ADAPTIVE_MAX_INTERVAL_MS)
+            expect_ms = GMON_CFG_NETCONN_ADAPTIVE_MAX_INTERVAL_MS;
+        TEST_ASSERT_EQUAL_UINT32(expect_ms, utest_gmon.netconn.adaptive.interval_ms);
+    }
+    TEST_ASSERT_FALSE(staNetConnReportDue(&utest_gmon, now_ms + expect_ms - 1));
+    TEST_ASSERT_TRUE(staNetConnReportDue(&utest_gmon, now_ms + expect_ms));
+    // readings move beyond the deadband, fall back to base interval
+    utest_gmon.actuator.fan.ema.last_aggregated += 10;
+    utestAdaptiveReport(now_ms + expect_ms);
+    TEST_ASSERT_EQUAL_UINT32(UTEST_BASE_INTERVAL_MS, utest_gmon.netconn.adaptive.interval_ms);
+    TEST_ASSERT_EQUAL_UINT32(0, utest_gmon.netconn.adaptive.num_early);
+}
+
+TEST(NetConnAdaptive, EarlyReportOnStateChange) {
+    unsigned int now_ms = 0;
+    utestAdaptiveReport(now_ms);
+    utestAdaptiveReport(now_ms += UTEST_BASE_INTERVAL_MS);
+    TEST_ASSERT_EQUAL_UINT32(UTEST_BASE_INTERVAL_MS << 1, utest_gmon.netconn.adaptive.interval_ms);
+    utest_gmon.actuator.pump.status = GMON_OUT_DEV_STATUS_ON;
+    // not more often than the minimum gap
+    TEST_ASSERT_FALSE(staNetConnReportDue(&utest_gmon, now_ms + GMON_CFG_NETCONN_ADAPTIVE_MIN_GAP_MS - 1));
+    TEST_ASSERT_TRUE(staNetConnReportDue(&utest_gmon, now_ms + GMON_CFG_NETCONN_ADAPTIVE_MIN_GAP_MS));
+    TEST_ASSERT_EQUAL_UINT32(1, utest_gmon.netconn.adaptive.num_early);
+    utestAdaptiveReport(now_ms += GMON_CFG_NETCONN_ADAPTIVE_MIN_GAP_MS);
+    TEST_ASSERT_EQUAL_UINT32(UTEST_BASE_INTERVAL_MS, utest_gmon.netconn.adaptive.interval_ms);
+    TEST_ASSERT_FALSE(staNetConnReportDue(&utest_gmon, now_ms + GMON_CFG_NETCONN_ADAPTIVE_MIN_GAP_MS));
+    // paused by network handler task itself
+    staPauseWorkingActuators(&utest_gmon);
+    TEST_ASSERT_EQUAL(GMON_OUT_DEV_STATUS_PAUSE, utest_gmon.actuator.pump.status);
+    TEST_ASSERT_FALSE(staNetConnReportDue(&utest_gmon, now_ms + GMON_CFG_NETCONN_ADAPTIVE_MIN_GAP_MS));
+    utest_gmon.actuator.pump.status = GMON_OUT_DEV_STATUS_OFF;
+    TEST_ASSERT_TRUE(staNetConnReportDue(&utest_gmon, now_ms + GMON_CFG_NETCONN_ADAPTIVE_MIN_GAP_MS));
+}
+
+TEST(NetConnAdaptive, EarlyReportOnThresholdCross) {
+    unsigned int now_ms = 0;
+    utestAdaptiveReport(now_ms);
+    utest_gmon.actuator.fan.ema.last_aggregated = utest_gmon.actuator.fan.threshold + 1;
+    TEST_ASSERT_TRUE(staNetConnReportDue(&utest_gmon, now_ms + GMON_CFG_NETCONN_ADAPTIVE_MIN_GAP_MS));
+    utestAdaptiveReport(now_ms += GMON_CFG_NETCONN_ADAPTIVE_MIN_GAP_MS);
+    // stays above the threshold, nothing changed
+    TEST_ASSERT_FALSE(staNetConnReportDue(&utest_gmon, now_ms + GMON_CFG_NETCONN_ADAPTIVE_MIN_GAP_MS));
+    utest_gmon.actuator.fan.ema.last_aggregated = utest_gmon.actuator.fan.threshold;
+    TEST_ASSERT_TRUE(staNetConnReportDue(&utest_gmon, now_ms + GMON_CFG_NETCONN_ADAPTIVE_MIN_GAP_MS));
+}
+
+TEST(NetConnAdaptive, FollowUserInterval) {
+    unsigned int now_ms = 0;
+    utestAdaptiveReport(now_ms);
+    utestAdaptiveReport(now_ms += UTEST_BASE_INTERVAL_MS);
+    TEST_ASSERT_EQUAL_UINT32(UTEST_BASE_INTERVAL_MS << 1, utest_gmon.netconn.adaptive.interval_ms);
+    // remote user sets longer interval than current one
+    utest_gmon.netconn.interval_ms = UTEST_BASE_INTERVAL_MS << 2;
+    TEST_ASSERT_FALSE(staNetConnReportDue(&utest_gmon, now_ms + (UTEST_BASE_INTERVAL_MS << 1)));
+    TEST_ASSERT_EQUAL_UINT32(UTEST_BASE_INTERVAL_MS << 2, utest_gmon.netconn.adaptive.interval_ms);
+    TEST_ASSERT_TRUE(staNetConnReportDue(&utest_gmon, now_ms + (UTEST_BASE_INTERVAL_MS << 2)));
+}
+
+TEST(NetConnAdaptive, ReportInterval) {
+    unsigned int now_ms = 0;
+    utestAdaptiveReport(now_ms);
+    utestAdaptiveReport(now_ms += UTEST_BASE_INTERVAL_MS);
+    TEST_ASSERT_EQUAL_UINT32(UTEST_BASE_INTERVAL_MS << 1, staNetConnReportIntervalMs(&utest_gmon.netconn));
+    // remote user sets longer interval, before next report
+    utest_gmon.netconn.interval_ms = UTEST_BASE_INTERVAL_MS << 2;
+    TEST_ASSERT_EQUAL_UINT32(UTEST_BASE_INTERVAL_MS << 2, staNetConnReportIntervalMs(&utest_gmon.netconn));
+}
+#else
+TEST(NetConnAdaptive, FixedInterval) {
+    unsigned int now_ms = 0;
+    utestAdaptiveReport(now_ms);
+    utestAdaptiveReport(now_ms += UTEST_BASE_INTERVAL_MS);
+    TEST_ASSERT_EQUAL_UINT32(UTEST_BASE_INTERVAL_MS, staNetConnReportIntervalMs(&utest_gmon.netconn));
+    // actuator state change does not trigger early report
+    utest_gmon.actuator.pump.status = GMON_OUT_DEV_STATUS_ON;
+    TEST_ASSERT_FALSE(staNetConnReportDue(&utest_gmon, now_ms + UTEST_BASE_INTERVAL_MS - 1));
+    TEST_ASSERT_TRUE(staNetConnReportDue(&utest_gmon, now_ms + UTEST_BASE_INTERVAL_MS));
+    TEST_ASSERT_EQUAL_UINT32(UTEST_BASE_INTERVAL_MS, staNetConnCheckIntervalMs(&utest_gmon.netconn));
+}
+#endif // end of GMON_CFG_NETCONN_ADAPTIVE_INTERVAL
+
+// network handler task wakes up late, next report is still due one interval after the scheduled one
+TEST(NetConnAdaptive, LateWakeup) {
+    unsigned int interval_ms = staNetConnReportIntervalMs(&utest_gmon.netconn);
+    unsigned int late_ms = 3 * GMON_NUM_MILLISECONDS_PER_TICK, now_ms = interval_ms + late_ms;
+    TEST_ASSERT_TRUE(staNetConnReportDue(&utest_gmon, now_ms));
+    staNetConnReportStamp(&utest_gmon.netconn, now_ms);
+    TEST_ASSERT_EQUAL_UINT32(interval_ms, utest_gmon.netconn.session.last_publish_ms);
+    // the task is back on schedule
+    now_ms = interval_ms << 1;
+    TEST_ASSERT_TRUE(staNetConnReportDue(&utest_gmon, now_ms));
+    staNetConnReportStamp(&utest_gmon.netconn, now_ms);
+    TEST_ASSERT_EQUAL_UINT32(now_ms, utest_gmon.netconn.session.last_publish_ms);
+    // entire interval is missed, e.g. the task was blocked by reconnection, the time is not caught up
+    now_ms = (interval_ms << 2) + late_ms;
+    TEST_ASSERT_TRUE(staNetConnReportDue(&utest_gmon, now_ms));
+    staNetConnReportStamp(&utest_gmon.netconn, now_ms);
+    TEST_ASSERT_EQUAL_UINT32(now_ms, utest_gmon.netconn.session.last_publish_ms);
+    TEST_ASSERT_FALSE(staNetConnReportDue(&utest_gmon, now_ms + interval_ms - 1));
+}
+
+TEST_GROUP_RUNNER(gMonNetConnAdaptive) {
+#ifdef GMON_CFG_NETCONN_ADAPTIVE_INTERVAL
+    RUN_TEST_CASE(NetConnAdaptive, BackoffWhenStable);
+    RUN_TEST_CASE(NetConnAdaptive, EarlyReportOnStateChange);
+    RUN_TEST_CASE(NetConnAdaptive, EarlyReportOnThresholdCross);
+    RUN_TEST_CASE(NetConnAdaptive, FollowUserInterval);
+    RUN_TEST_CASE(NetConnAdaptive, ReportInterval);
+#else
+    RUN_TEST_CASE(NetConnAdaptive, FixedInterval);
+#endif
+    RUN_TEST_CASE(NetConnAdaptive, LateWakeup);
+}
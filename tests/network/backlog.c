@@ -0,0 +1,164 @@
+#define _POSIX_C_SOURCE 200809L
+#include <unistd.h>
+#include "unity.h"
+#include "unity_fixture.h"
+#include "station_include.h"
+#include "backlog_file.h"
+
+#define UTEST_BACKLOG_MSG_BUF_SZ 64
+
+static gMonNetBacklog_t   utest_backlog;
+static UTestBacklogFile_t utest_bfile;
+static char               utest_bfile_path[] = "/tmp/gmon_utest_backlog_XXXXXX";
+static unsigned char      utest_msg_buf[UTEST_BACKLOG_MSG_BUF_SZ];
+
+// outflight message, buffer capacity stays the same as in network handler task
+static gmonStr_t *utestBacklogMsg(unsigned int seq) {
+    static gmonStr_t msg = {.len = UTEST_BACKLOG_MSG_BUF_SZ, .data = utest_msg_buf};
+    msg.nbytes_written = snprintf((char *)utest_msg_buf, UTEST_BACKLOG_MSG_BUF_SZ, "{\"seq\":%u}", seq);
+    return &msg;
+}
+
+static void utestAssertPopSeq(unsigned int seq) {
+    char       expect[UTEST_BACKLOG_MSG_BUF_SZ] = {0};
+    gmonStr_t *msg = staNetConnBacklogPeek(&utest_backlog);
+    int        expect_sz = snprintf(expect, UTEST_BACKLOG_MSG_BUF_SZ, "{\"seq\":%u}", seq);
+    TEST_ASSERT_NOT_NULL(msg);
+    TEST_ASSERT_EQUAL_UINT16(expect_sz, msg->nbytes_written);
+    TEST_ASSERT_EQUAL_STRING_LEN(expect, (const char *)msg->data, expect_sz);
+    // peek again without pop returns the same message
+    TEST_ASSERT_EQUAL_PTR(msg, staNetConnBacklogPeek(&utest_backlog));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staNetConnBacklogPop(&utest_backlog));
+}
+
+TEST_GROUP(NetConnBacklog);
+TEST_GROUP(NetConnBacklogSpill);
+
+TEST_SETUP(NetConnBacklog) {
+    gMonStatus status = staNetConnBacklogInit(&utest_backlog, NULL, NULL);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, status);
+}
+
+TEST_TEAR_DOWN(NetConnBacklog) { staNetConnBacklogDeinit(&utest_backlog); }
+
+TEST_SETUP(NetConnBacklogSpill) {
+    int fd = mkstemp(utest_bfile_path);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, fd);
+    close(fd);
+    gMonStatus status = UTestBacklogFileOpen(&utest_bfile, utest_bfile_path, 3);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, status);
+    status = staNetConnBacklogInit(&utest_backlog, &utest_backlog_file_ops, &utest_bfile);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, status);
+}
+
+TEST_TEAR_DOWN(NetConnBacklogSpill) {
+    staNetConnBacklogDeinit(&utest_backlog);
+    UTestBacklogFileClose(&utest_bfile);
+    remove(utest_bfile_path);
+    XMEMCPY(utest_bfile_path + sizeof(utest_bfile_path) - 7, "XXXXXX", 6);
+}
+
+TEST(NetConnBacklog, InvalidArgs) {
+    gMonNetBacklogStorage_t incomplete = {.push = utest_backlog_file_ops.push};
+    gmonStr_t               empty = {.len = 8, .data = utest_msg_buf};
+    TEST_ASSERT_EQUAL(GMON_RESP_ERRARGS, staNetConnBacklogInit(NULL, NULL, NULL));
+    TEST_ASSERT_EQUAL(GMON_RESP_ERRARGS, staNetConnBacklogInit(&utest_backlog, &incomplete, NULL));
+    TEST_ASSERT_EQUAL(GMON_RESP_ERRARGS, staNetConnBacklogPush(&utest_backlog, NULL));
+    TEST_ASSERT_EQUAL(GMON_RESP_ERRARGS, staNetConnBacklogPush(&utest_backlog, &empty));
+    TEST_ASSERT_NULL(staNetConnBacklogPeek(&utest_backlog));
+    TEST_ASSERT_EQUAL(GMON_RESP_SKIP, staNetConnBacklogPop(&utest_backlog));
+    TEST_ASSERT_EQUAL(0, staNetConnBacklogCount(&utest_backlog));
+}
+
+TEST(NetConnBacklog, FifoOrder) {
+    unsigned int idx = 0;
+    for (idx = 0; idx < GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS; idx++)
+        TEST_ASSERT_EQUAL(GMON_RESP_OK, staNetConnBacklogPush(&utest_backlog, utestBacklogMsg(idx)));
+    TEST_ASSERT_EQUAL(GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS, staNetConnBacklogCount(&utest_backlog));
+    utestAssertPopSeq(0);
+    // wrap around
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staNetConnBacklogPush(&utest_backlog, utestBacklogMsg(idx)));
+    for (idx = 1; idx <= GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS; idx++)
+        utestAssertPopSeq(idx);
+    TEST_ASSERT_NULL(staNetConnBacklogPeek(&utest_backlog));
+    TEST_ASSERT_EQUAL(GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS + 1, utest_backlog.stats.num_queued);
+    TEST_ASSERT_EQUAL(GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS + 1, utest_backlog.stats.num_drained);
+    TEST_ASSERT_EQUAL(GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS, utest_backlog.stats.peak);
+    TEST_ASSERT_EQUAL(0, utest_backlog.stats.num_dropped);
+}
+
+TEST(NetConnBacklog, DropOldest) {
+    unsigned int idx = 0, num_pushed = GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS + 3;
+    utest_backlog.drop_policy = GMON_NETCONN_BACKLOG_DROP_OLDEST;
+    for (idx = 0; idx < num_pushed; idx++)
+        TEST_ASSERT_EQUAL(GMON_RESP_OK, staNetConnBacklogPush(&utest_backlog, utestBacklogMsg(idx)));
+    TEST_ASSERT_EQUAL(GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS, staNetConnBacklogCount(&utest_backlog));
+    TEST_ASSERT_EQUAL(3, utest_backlog.stats.num_dropped);
+    for (idx = 3; idx < num_pushed; idx++)
+        utestAssertPopSeq(idx);
+}
+
+TEST(NetConnBacklog, DropNewest) {
+    unsigned int idx = 0, num_pushed = GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS + 3;
+    utest_backlog.drop_policy = GMON_NETCONN_BACKLOG_DROP_NEWEST;
+    for (idx = 0; idx < num_pushed; idx++) {
+        gMonStatus expect = (idx < GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS) ? GMON_RESP_OK : GMON_RESP_SKIP;
+        TEST_ASSERT_EQUAL(expect, staNetConnBacklogPush(&utest_backlog, utestBacklogMsg(idx)));
+    }
+    TEST_ASSERT_EQUAL(3, utest_backlog.stats.num_dropped);
+    for (idx = 0; idx < GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS; idx++)
+        utestAssertPopSeq(idx);
+}
+
+TEST(NetConnBacklogSpill, SpillAndDrain) {
+    unsigned int idx = 0, num_pushed = GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS + 3;
+    for (idx = 0; idx < num_pushed; idx++)
+        TEST_ASSERT_EQUAL(GMON_RESP_OK, staNetConnBacklogPush(&utest_backlog, utestBacklogMsg(idx)));
+    TEST_ASSERT_EQUAL(3, utest_bfile.num_entries);
+    TEST_ASSERT_EQUAL(3, utest_backlog.stats.num_spilled);
+    TEST_ASSERT_EQUAL(num_pushed, staNetConnBacklogCount(&utest_backlog));
+    TEST_ASSERT_EQUAL(num_pushed, utest_backlog.stats.peak);
+    // spilled messages are older, drained first
+    for (idx = 0; idx < num_pushed; idx++)
+        utestAssertPopSeq(idx);
+    TEST_ASSERT_EQUAL(0, staNetConnBacklogCount(&utest_backlog));
+    TEST_ASSERT_EQUAL(0, utest_backlog.stats.num_dropped);
+}
+
+TEST(NetConnBacklogSpill, StorageFull) {
+    unsigned int idx = 0, num_pushed = GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS + 5;
+    utest_backlog.drop_policy = GMON_NETCONN_BACKLOG_DROP_OLDEST;
+    for (idx = 0; idx < num_pushed; idx++)
+        TEST_ASSERT_EQUAL(GMON_RESP_OK, staNetConnBacklogPush(&utest_backlog, utestBacklogMsg(idx)));
+    TEST_ASSERT_EQUAL(2, utest_backlog.stats.num_dropped);
+    TEST_ASSERT_EQUAL(GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS + 3, staNetConnBacklogCount(&utest_backlog));
+    for (idx = 2; idx < num_pushed; idx++)
+        utestAssertPopSeq(idx);
+}
+
+TEST(NetConnBacklogSpill, ReopenStorage) {
+    unsigned int idx = 0, num_pushed = GMON_CFG_NETCONN_BACKLOG_NUM_SLOTS + 2;
+    for (idx = 0; idx < num_pushed; idx++)
+        TEST_ASSERT_EQUAL(GMON_RESP_OK, staNetConnBacklogPush(&utest_backlog, utestBacklogMsg(idx)));
+    // power cycle, messages in RAM slots are lost, spilled ones are still in the storage
+    staNetConnBacklogDeinit(&utest_backlog);
+    UTestBacklogFileClose(&utest_bfile);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, UTestBacklogFileOpen(&utest_bfile, utest_bfile_path, 3));
+    TEST_ASSERT_EQUAL(2, utest_bfile.num_entries);
+    gMonStatus status = staNetConnBacklogInit(&utest_backlog, &utest_backlog_file_ops, &utest_bfile);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, status);
+    TEST_ASSERT_EQUAL(2, staNetConnBacklogCount(&utest_backlog));
+    utestAssertPopSeq(0);
+    utestAssertPopSeq(1);
+    TEST_ASSERT_NULL(staNetConnBacklogPeek(&utest_backlog));
+}
+
+TEST_GROUP_RUNNER(gMonNetConnBacklog) {
+    RUN_TEST_CASE(NetConnBacklog, InvalidArgs);
+    RUN_TEST_CASE(NetConnBacklog, FifoOrder);
+    RUN_TEST_CASE(NetConnBacklog, DropOldest);
+    RUN_TEST_CASE(NetConnBacklog, DropNewest);
+    RUN_TEST_CASE(NetConnBacklogSpill, SpillAndDrain);
+    RUN_TEST_CASE(NetConnBacklogSpill, StorageFull);
+    RUN_TEST_CASE(NetConnBacklogSpill, ReopenStorage);
+}
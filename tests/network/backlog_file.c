@@ -0,0 +1,101 @@
+#include "backlog_file.h"
+
+#define UTEST_BACKLOG_FILE_HDR_SZ (4 + 4 + 2)
+
+static gMonStatus utestBacklogFileWriteHdr(UTestBacklogFile_t *bf) {
+    unsigned char hdr[UTEST_BACKLOG_FILE_HDR_SZ] = {0};
+    XMEMCPY(&hdr[0], &bf->rd_off, 4);
+    XMEMCPY(&hdr[4], &bf->wr_off, 4);
+    XMEMCPY(&hdr[8], &bf->num_entries, 2);
+    if (fseek(bf->fp, 0, SEEK_SET) != 0 || fwrite(hdr, 1, sizeof(hdr), bf->fp) != sizeof(hdr))
+        return GMON_RESP_ERR;
+    bf->nbytes_written += sizeof(hdr);
+    return (fflush(bf->fp) == 0) ? GMON_RESP_OK : GMON_RESP_ERR;
+}
+
+static gMonStatus utestBacklogFileReadLen(UTestBacklogFile_t *bf, unsigned short *len) {
+    if (fseek(bf->fp, bf->rd_off, SEEK_SET) != 0 || fread(len, 1, 2, bf->fp) != 2)
+        return GMON_RESP_ERR;
+    return GMON_RESP_OK;
+}
+
+gMonStatus UTestBacklogFileOpen(UTestBacklogFile_t *bf, const char *path, unsigned short max_entries) {
+    unsigned char hdr[UTEST_BACKLOG_FILE_HDR_SZ] = {0};
+    if (bf == NULL || path == NULL || max_entries == 0)
+        return GMON_RESP_ERRARGS;
+    XMEMSET(bf, 0x00, sizeof(UTestBacklogFile_t));
+    bf->max_entries = max_entries;
+    bf->fp = fopen(path, "r+b");
+    if (bf->fp != NULL && fread(hdr, 1, sizeof(hdr), bf->fp) == sizeof(hdr)) {
+        XMEMCPY(&bf->rd_off, &hdr[0], 4);
+        XMEMCPY(&bf->wr_off, &hdr[4], 4);
+        XMEMCPY(&bf->num_entries, &hdr[8], 2);
+        return GMON_RESP_OK;
+    }
+    if (bf->fp != NULL)
+        fclose(bf->fp);
+    bf->fp = fopen(path, "w+b");
+    if (bf->fp == NULL)
+        return GMON_RESP_ERR;
+    bf->rd_off = bf->wr_off = UTEST_BACKLOG_FILE_HDR_SZ;
+    return utestBacklogFileWriteHdr(bf);
+}
+
+void UTestBacklogFileClose(UTestBacklogFile_t *bf) {
+    if (bf != NULL && bf->fp != NULL) {
+        fclose(bf->fp);
+        bf->fp = NULL;
+    }
+}
+
+static gMonStatus utestBacklogFilePush(void *ctx, const gmonStr_t *msg) {
+    UTestBacklogFile_t *bf = (UTestBacklogFile_t *)ctx;
+    unsigned short      len = msg->nbytes_written;
+    if (bf->num_entries >= bf->max_entries)
+        return GMON_RESP_ERRMEM;
+    if (fseek(bf->fp, bf->wr_off, SEEK_SET) != 0 || fwrite(&len, 1, 2, bf->fp) != 2)
+        return GMON_RESP_ERR;
+    if (fwrite(msg->data, 1, len, bf->fp) != len)
+        return GMON_RESP_ERR;
+    bf->wr_off += 2 + len;
+    bf->nbytes_written += 2 + len;
+    bf->num_entries++;
+    return utestBacklogFileWriteHdr(bf);
+}
+
+static gMonStatus utestBacklogFilePeek(void *ctx, gmonStr_t *out) {
+    UTestBacklogFile_t *bf = (UTestBacklogFile_t *)ctx;
+    unsigned short      len = 0;
+    if (bf->num_entries == 0)
+        return GMON_RESP_SKIP;
+    if (utestBacklogFileReadLen(bf, &len) != GMON_RESP_OK)
+        return GMON_RESP_ERR;
+    out->nbytes_written = len;
+    if (out->data == NULL || out->len < len)
+        return GMON_RESP_ERRMEM;
+    return (fread(out->data, 1, len, bf->fp) == len) ? GMON_RESP_OK : GMON_RESP_ERR;
+}
+
+static gMonStatus utestBacklogFilePop(void *ctx) {
+    UTestBacklogFile_t *bf = (UTestBacklogFile_t *)ctx;
+    unsigned short      len = 0;
+    if (bf->num_entries == 0)
+        return GMON_RESP_SKIP;
+    if (utestBacklogFileReadLen(bf, &len) != GMON_RESP_OK)
+        return GMON_RESP_ERR;
+    bf->num_entries--;
+    // rewind once the file is drained, like erasing a flash sector
+    bf->rd_off = (bf->num_entries == 0) ? UTEST_BACKLOG_FILE_HDR_SZ : (bf->rd_off + 2 + len);
+    if (bf->num_entries == 0)
+        bf->wr_off = UTEST_BACKLOG_FILE_HDR_SZ;
+    return utestBacklogFileWriteHdr(bf);
+}
+
+static unsigned short utestBacklogFileCount(void *ctx) { return ((UTestBacklogFile_t *)ctx)->num_entries; }
+
+const gMonNetBacklogStorage_t utest_backlog_file_ops = {
+    .push = utestBacklogFilePush,
+    .peek = utestBacklogFilePeek,
+    .pop = utestBacklogFilePop,
+    .count = utestBacklogFileCount,
+};
@@ -0,0 +1,25 @@
+#ifndef TEST_GMON_BACKLOG_FILE_H
+#define TEST_GMON_BACKLOG_FILE_H
+
+#include <stdio.h>
+#include "station_include.h"
+
+// File-backed spill storage of network backlog on host, it stands in for external flash. Entries are
+// appended to the file as [2-byte length][payload], and the header at the beginning of the file keeps
+// read / write offsets and number of entries, so the content survives reopening the file.
+typedef struct {
+    FILE          *fp;
+    unsigned int   rd_off;
+    unsigned int   wr_off;
+    unsigned short num_entries;
+    unsigned short max_entries;
+    unsigned int   nbytes_written; // accumulated bytes written to the file, e.g. flash wear
+} UTestBacklogFile_t;
+
+// open (or create) the file, existing entries are kept
+gMonStatus UTestBacklogFileOpen(UTestBacklogFile_t *, const char *path, unsigned short max_entries);
+void       UTestBacklogFileClose(UTestBacklogFile_t *);
+
+extern const gMonNetBacklogStorage_t utest_backlog_file_ops;
+
+#endif // TEST_GMON_BACKLOG_FILE_H
@@ -0,0 +1,254 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include "station_include.h"
+
+// Fleet simulator, a number of independent stations run on a pool of worker threads, each of them logs
+// sensor readings of its own garden and serializes real outbound payload (see outbound.c) at every report
+// cycle, the payload is acknowledged at once. Reports aggregate throughput of payload generation on the
+// host and ingress rate the fleet would bring to the broker. Size of the fleet can be overridden by
+// environment variables FLEETSIM_NUM_STATIONS, FLEETSIM_NUM_THREADS (number of online CPUs by default)
+// and FLEETSIM_NUM_CYCLES (report cycles of each station).
+//
+// A station is owned by one worker for an entire cycle, workers are synchronized at the end of each
+// cycle, so the critical sections (no-op in the mocks) are not required for data of a station.
+
+#define FLEETSIM_DFLT_NUM_STATIONS 200
+#define FLEETSIM_DFLT_NUM_CYCLES   240
+#define FLEETSIM_MAX_THREADS       64
+#define FLEETSIM_REPORT_INTERVAL   GMON_CFG_NETCONN_START_INTERVAL_MS
+
+// per-worker counters, padded to separate cache lines
+typedef struct {
+    unsigned long long nbytes;
+    unsigned int       num_msgs;
+    unsigned int       num_errors;
+    unsigned int       max_payload;
+    unsigned char      padding[64 - sizeof(unsigned long long) - sizeof(unsigned int) * 3];
+} fleetsimWorkerStats_t;
+
+typedef struct {
+    gardenMonitor_t      *stations;
+    unsigned int          num_stations;
+    unsigned int          num_cycles;
+    unsigned int          num_threads;
+    atomic_uint           next_station; // stations are claimed by workers in each cycle
+    unsigned int          cycle;
+    pthread_barrier_t     barrier;
+    fleetsimWorkerStats_t stats[FLEETSIM_MAX_THREADS];
+} fleetsimCtx_t;
+
+typedef struct {
+    fleetsimCtx_t *ctx;
+    unsigned int   worker_id;
+} fleetsimWorker_t;
+
+static unsigned int fleetsimEnvUInt(const char *name, unsigned int dflt) {
+    const char *value = getenv(name);
+    return (value == NULL) ? dflt : (unsigned int)strtoul(value, NULL, 10);
+}
+
+static double fleetsimWallSec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// readings vary with the station and the cycle, so payload of each station looks different
+static unsigned int fleetsimSensorValue(gmonEventType_t type, unsigned int sid, unsigned int cycle) {
+    switch (type) {
+    case GMON_EVENT_SOIL_MOISTURE_UPDATED:
+        return 400 + (sid * 37 + cycle * 13) % 624;
+    case GMON_EVENT_LIGHTNESS_UPDATED:
+    default:
+        return 100 + (sid * 7 + cycle * 29) % 900;
+    }
+}
+
+// same as sensor reading tasks followed by data log task, all readings of the cycle are logged at once
+static gMonStatus fleetsimLogSensors(gardenMonitor_t *gmon, unsigned int sid, unsigned int cycle) {
+    gmonEventType_t types[3] = {
+        GMON_EVENT_SOIL_MOISTURE_UPDATED, GMON_EVENT_AIR_TEMP_UPDATED, GMON_EVENT_LIGHTNESS_UPDATED
+    };
+    gmonSensorRecord_t *records[3] = {
+        &gmon->latest_logs.soilmoist, &gmon->latest_logs.aircond, &gmon->latest_logs.light
+    };
+    unsigned char num_items[3] = {
+        gmon->sensors.soil_moist.super.num_items, gmon->sensors.air_temp.num_items,
+        gmon->sensors.light.num_items
+    };
+    unsigned int now_ms = cycle * FLEETSIM_REPORT_INTERVAL + (sid % 1000);
+    for (unsigned short idx = 0; idx < 3; idx++) {
+        gmonEvent_t *evt = staAllocSensorEvent(&gmon->sensors.event, types[idx], num_items[idx]);
+        gmonEvent_t *discarded = NULL;
+        if (evt == NULL)
+            return GMON_RESP_ERRMEM;
+        evt->curr_ticks = now_ms % GMON_NUM_MILLISECONDS_PER_DAY;
+        evt->curr_days = now_ms / GMON_NUM_MILLISECONDS_PER_DAY;
+        for (unsigned char jdx = 0; jdx < num_items[idx]; jdx++) {
+            if (types[idx] == GMON_EVENT_AIR_TEMP_UPDATED) {
+                ((gmonAirCond_t *)evt->data)[jdx] = (gmonAirCond_t){
+                    .temporature = 18.0f + (float)((sid + cycle + jdx) % 20) * 0.5f,
+                    .humidity = 40.0f + (float)((sid * 3 + jdx) % 50),
+                };
+            } else {
+                ((unsigned int *)evt->data)[jdx] = fleetsimSensorValue(types[idx], sid + jdx, cycle);
+            }
+        }
+        discarded = staUpdateLastRecord(records[idx], evt);
+        if (discarded)
+            staFreeSensorEvent(&gmon->sensors.event, discarded);
+    }
+    return GMON_RESP_OK;
+}
+
+// one report cycle of a station, same sequence as network handler task with the broker always reachable
+static void
+fleetsimStationCycle(gardenMonitor_t *gmon, unsigned int sid, fleetsimCtx_t *ctx, unsigned int wid) {
+    fleetsimWorkerStats_t      *stats = &ctx->stats[wid];
+    gmonAppMsgOutflightResult_t result = {0};
+    if (fleetsimLogSensors(gmon, sid, ctx->cycle) != GMON_RESP_OK ||
+        staAppMsgReallocBuffer(gmon) != GMON_RESP_OK) {
+        stats->num_errors++;
+        return;
+    }
+    staAppMsgOutDetachRecords(gmon);
+    result = staGetAppMsgOutflightDetached(gmon);
+    staAppMsgOutResetDetachedRecords(gmon);
+    if (result.status != GMON_RESP_OK || result.msg == NULL || result.msg->nbytes_written == 0) {
+        stats->num_errors++;
+        return;
+    }
+    staAppMsgOutAcked(gmon);
+    stats->num_msgs++;
+    stats->nbytes += result.msg->nbytes_written;
+    if (stats->max_payload < result.msg->nbytes_written)
+        stats->max_payload = result.msg->nbytes_written;
+}
+
+static void *fleetsimWorkerFn(void *arg) {
+    fleetsimWorker_t *worker = (fleetsimWorker_t *)arg;
+    fleetsimCtx_t    *ctx = worker->ctx;
+    unsigned int      sid = 0;
+    while (1) {
+        // all workers wait here until the next cycle starts, or the fleet stops
+        pthread_barrier_wait(&ctx->barrier);
+        if (ctx->cycle >= ctx->num_cycles)
+            break;
+        while ((sid = atomic_fetch_add_explicit(&ctx->next_station, 1, memory_order_relaxed)) <
+               ctx->num_stations)
+            fleetsimStationCycle(&ctx->stations[sid], sid, ctx, worker->worker_id);
+        pthread_barrier_wait(&ctx->barrier);
+    }
+    return NULL;
+}
+
+static gMonStatus fleetsimStationInit(gardenMonitor_t *gmon) {
+    gMonStatus status = stationIOinit(gmon);
+    if (status != GMON_RESP_OK)
+        return status;
+    staActuatorInitGenericPump(&gmon->actuator.pump);
+    staActuatorInitGenericFan(&gmon->actuator.fan);
+    staActuatorInitGenericBulb(&gmon->actuator.bulb);
+    // display is left out, OLED emulator in the mocks is shared by entire process
+    return staAppMsgInit(gmon);
+}
+
+static void fleetsimReport(fleetsimCtx_t *ctx, double wall_sec) {
+    unsigned long long nbytes = 0;
+    unsigned int       num_msgs = 0, num_errors = 0, max_payload = 0, idx = 0;
+    for (idx = 0; idx < ctx->num_threads; idx++) {
+        nbytes += ctx->stats[idx].nbytes;
+        num_msgs += ctx->stats[idx].num_msgs;
+        num_errors += ctx->stats[idx].num_errors;
+        if (max_payload < ctx->stats[idx].max_payload)
+            max_payload = ctx->stats[idx].max_payload;
+    }
+    double avg_payload = (num_msgs == 0) ? 0 : (double)nbytes / num_msgs;
+    double interval_sec = (double)FLEETSIM_REPORT_INTERVAL / 1000;
+    printf(
+        "[fleetsim] %u stations, %u cycles, %u worker threads, report interval %.0f sec\n", ctx->num_stations,
+        ctx->num_cycles, ctx->num_threads, interval_sec
+    );
+    printf(
+        "[fleetsim] payload: %u messages, %llu bytes, avg %.1f bytes, max %u bytes, %u errors\n", num_msgs,
+        nbytes, avg_payload, max_payload, num_errors
+    );
+    printf(
+        "[fleetsim] host generation: %.3f sec wall time, %.0f msgs/s, %.2f MB/s\n", wall_sec,
+        num_msgs / wall_sec, (double)nbytes / wall_sec / 1e6
+    );
+    printf(
+        "[fleetsim] broker ingress of the fleet: %.2f msgs/s, %.0f bytes/s\n",
+        ctx->num_stations / interval_sec, ctx->num_stations * avg_payload / interval_sec
+    );
+}
+
+int main(void) {
+    static fleetsimCtx_t ctx;
+    fleetsimWorker_t     workers[FLEETSIM_MAX_THREADS];
+    pthread_t            threads[FLEETSIM_MAX_THREADS];
+    long                 num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned int         idx = 0, num_msgs = 0;
+    double               start_sec = 0;
+    gMonStatus           status = GMON_RESP_OK;
+    int                  ret = 0;
+
+    ctx.num_stations = fleetsimEnvUInt("FLEETSIM_NUM_STATIONS", FLEETSIM_DFLT_NUM_STATIONS);
+    ctx.num_cycles = fleetsimEnvUInt("FLEETSIM_NUM_CYCLES", FLEETSIM_DFLT_NUM_CYCLES);
+    ctx.num_threads = fleetsimEnvUInt("FLEETSIM_NUM_THREADS", (num_cpus > 0) ? (unsigned int)num_cpus : 1);
+    if (ctx.num_threads == 0)
+        ctx.num_threads = 1;
+    if (ctx.num_threads > FLEETSIM_MAX_THREADS)
+        ctx.num_threads = FLEETSIM_MAX_THREADS;
+    if (ctx.num_stations == 0)
+        ctx.num_stations = 1;
+    ctx.stations = XCALLOC(sizeof(gardenMonitor_t), ctx.num_stations);
+    XASSERT(ctx.stations != NULL);
+    for (idx = 0; idx < ctx.num_stations; idx++) {
+        status = fleetsimStationInit(&ctx.stations[idx]);
+        XASSERT(status == GMON_RESP_OK);
+    }
+
+    // main thread takes part in barrier only to start each cycle and collect the stats
+    pthread_barrier_init(&ctx.barrier, NULL, ctx.num_threads + 1);
+    for (idx = 0; idx < ctx.num_threads; idx++) {
+        workers[idx] = (fleetsimWorker_t){.ctx = &ctx, .worker_id = idx};
+        ret = pthread_create(&threads[idx], NULL, fleetsimWorkerFn, &workers[idx]);
+        XASSERT(ret == 0);
+    }
+    start_sec = fleetsimWallSec();
+    for (ctx.cycle = 0; ctx.cycle < ctx.num_cycles; ctx.cycle++) {
+        atomic_store_explicit(&ctx.next_station, 0, memory_order_relaxed);
+        pthread_barrier_wait(&ctx.barrier); // start the cycle
+        pthread_barrier_wait(&ctx.barrier); // all stations completed the cycle
+    }
+    pthread_barrier_wait(&ctx.barrier); // release the workers
+    for (idx = 0; idx < ctx.num_threads; idx++)
+        pthread_join(threads[idx], NULL);
+    fleetsimReport(&ctx, fleetsimWallSec() - start_sec);
+    ret = 0;
+
+    // sanity check, every station publishes once per cycle
+    for (idx = 0; idx < ctx.num_threads; idx++) {
+        num_msgs += ctx.stats[idx].num_msgs;
+        if (ctx.stats[idx].num_errors > 0)
+            ret = 1;
+    }
+    if (num_msgs != ctx.num_stations * ctx.num_cycles) {
+        fprintf(
+            stderr, "[fleetsim] %u of %u messages generated\n", num_msgs, ctx.num_stations * ctx.num_cycles
+        );
+        ret = 1;
+    }
+    pthread_barrier_destroy(&ctx.barrier);
+    for (idx = 0; idx < ctx.num_stations; idx++) {
+        staAppMsgDeinit(&ctx.stations[idx]);
+        stationIOdeinit(&ctx.stations[idx]);
+    }
+    XMEMFREE(ctx.stations);
+    return ret;
+}
@@ -0,0 +1,267 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "station_include.h"
+#include "mqtt_fake.h"
+
+// MQTT client of this station (src/network/mqtt_client.c) running on top of in-process broker,
+// see mqtt_fake.h
+
+#define UTEST_MQTTC_MSG_BUF_SZ 128
+
+static gMonNet_t     utest_mqttc_net;
+static gMonArena_t   utest_mqttc_arena = {0}; // objects are allocated from heap
+static unsigned char utest_mqttc_buf[UTEST_MQTTC_MSG_BUF_SZ];
+static gmonStr_t     utest_mqttc_msg = {.len = UTEST_MQTTC_MSG_BUF_SZ, .data = utest_mqttc_buf};
+static unsigned char utest_mqttc_ctrl_buf[UTEST_MQTTC_MSG_BUF_SZ];
+static gmonStr_t     utest_mqttc_ctrl = {.len = UTEST_MQTTC_MSG_BUF_SZ, .data = utest_mqttc_ctrl_buf};
+
+static const UTestNetFakeLink_t utest_mqttc_link = {
+    .rtt_ms = 80,
+    .bytes_per_sec = 11520,
+    .tls_handshake_rtts = 2,
+    .tls_handshake_bytes = 3600,
+    .tls_record_overhead = 29,
+    .recv_max = 3,
+    .outage_from_ms = 600000,
+    .outage_until_ms = 660000,
+};
+
+static unsigned int utestMqttcNow(void) { return stationSysGetTickCount() * GMON_NUM_MILLISECONDS_PER_TICK; }
+
+static gmonStr_t *utestMqttcLogMsg(const char *json) {
+    utest_mqttc_msg.nbytes_written = XSTRLEN(json);
+    XMEMCPY(utest_mqttc_buf, json, utest_mqttc_msg.nbytes_written);
+    return &utest_mqttc_msg;
+}
+
+TEST_GROUP(NetConnMqttClient);
+
+TEST_SETUP(NetConnMqttClient) {
+    setMockTickCount(0);
+    UTestNetFakeSetup(&utest_mqttc_link);
+    XMEMSET(&utest_mqttc_net, 0x00, sizeof(gMonNet_t));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnInit(&utest_mqttc_net, &utest_mqttc_arena));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staNetConnPubWinInit(&utest_mqttc_net.pub_win));
+    XMEMSET(utest_mqttc_buf, 0x00, UTEST_MQTTC_MSG_BUF_SZ);
+    XMEMSET(utest_mqttc_ctrl_buf, 0x00, UTEST_MQTTC_MSG_BUF_SZ);
+    utest_mqttc_ctrl.nbytes_written = 0;
+}
+
+TEST_TEAR_DOWN(NetConnMqttClient) {
+    staNetConnPubWinDeinit(&utest_mqttc_net.pub_win);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnDeinit(&utest_mqttc_net, &utest_mqttc_arena));
+}
+
+TEST(NetConnMqttClient, EstablishAndClose) {
+    const UTestNetFakeStats_t *stats = UTestNetFakeGetStats();
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnEstablish(&utest_mqttc_net));
+    TEST_ASSERT_EQUAL(1, stats->num_connect);
+    TEST_ASSERT_EQUAL(0, stats->clean_session);
+    // receive maximum in CONNACK limits number of messages in flight
+    TEST_ASSERT_EQUAL_UINT16(utest_mqttc_link.recv_max, utest_mqttc_net.pub_win.window);
+    TEST_ASSERT_GREATER_THAN(0, stats->bytes_tx);
+    TEST_ASSERT_GREATER_THAN(0, stats->connect_time_ms);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnPing(&utest_mqttc_net));
+    TEST_ASSERT_EQUAL(1, stats->num_ping);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnClose(&utest_mqttc_net));
+    // connection is closed, the ping waits until command timeout
+    TEST_ASSERT_EQUAL(GMON_RESP_ERR_CONN, stationNetConnPing(&utest_mqttc_net));
+}
+
+TEST(NetConnMqttClient, EstablishInOutage) {
+    const UTestNetFakeStats_t *stats = UTestNetFakeGetStats();
+    setMockTickCount(utest_mqttc_link.outage_from_ms / GMON_NUM_MILLISECONDS_PER_TICK);
+    TEST_ASSERT_EQUAL(GMON_RESP_ERR_CONN, stationNetConnEstablish(&utest_mqttc_net));
+    TEST_ASSERT_EQUAL(0, stats->num_connect);
+    TEST_ASSERT_EQUAL(1, stats->num_connect_fail);
+}
+
+// payload, topic and properties of the message are encoded to the PUBLISH packet on the wire
+TEST(NetConnMqttClient, SendLogMessage) {
+    const UTestNetFakePublish_t *pub = UTestNetFakeGetLastPublish();
+    const char                  *json = "{\"soilmoist\":[{\"ticks\":12,\"days\":3,\"value\":702}]}";
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnEstablish(&utest_mqttc_net));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnSend(&utest_mqttc_net, utestMqttcLogMsg(json)));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, utest_mqttc_net.status.sent);
+    TEST_ASSERT_EQUAL_STRING(GMON_CFG_MQTT_TOPIC_LOG, pub->topic);
+    TEST_ASSERT_EQUAL(XSTRLEN(json), pub->payload_len);
+    TEST_ASSERT_EQUAL_MEMORY(json, pub->payload, pub->payload_len);
+    TEST_ASSERT_EQUAL(1, pub->qos);
+    TEST_ASSERT_EQUAL(0, pub->dup);
+    TEST_ASSERT_NOT_EQUAL(0, pub->pkt_id);
+    TEST_ASSERT_NOT_EQUAL(0, pub->topic_alias);
+    TEST_ASSERT_EQUAL((utest_mqttc_net.interval_ms << 1) / 1000, pub->expiry_sec);
+    TEST_ASSERT_EQUAL(1, UTestNetFakeGetStats()->num_publish);
+    TEST_ASSERT_EQUAL(GMON_RESP_ERRARGS, stationNetConnSend(&utest_mqttc_net, NULL));
+}
+
+// the message expires after two reporting intervals, adaptive reporting can stretch the interval
+TEST(NetConnMqttClient, ExpiryFollowsReportInterval) {
+    const UTestNetFakePublish_t *pub = UTestNetFakeGetLastPublish();
+    unsigned int                 expect_sec = (utest_mqttc_net.interval_ms << 1) / 1000;
+#ifdef GMON_CFG_NETCONN_ADAPTIVE_INTERVAL
+    // readings stayed stable, the interval was stretched to the maximum
+    utest_mqttc_net.adaptive.interval_ms = GMON_CFG_NETCONN_ADAPTIVE_MAX_INTERVAL_MS;
+    expect_sec = (GMON_CFG_NETCONN_ADAPTIVE_MAX_INTERVAL_MS << 1) / 1000;
+#else
+    // left from previous session, only the interval set by remote user is used
+    utest_mqttc_net.adaptive.interval_ms = utest_mqttc_net.interval_ms << 2;
+#endif
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnEstablish(&utest_mqttc_net));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnSend(&utest_mqttc_net, utestMqttcLogMsg("{\"seq\":1}")));
+    TEST_ASSERT_EQUAL(expect_sec, pub->expiry_sec);
+    TEST_ASSERT_EQUAL(
+        GMON_RESP_OK, stationNetConnPublish(
+                          &utest_mqttc_net, utestMqttcLogMsg("{\"seq\":2}"),
+                          stationNetConnReservePktId(&utest_mqttc_net), 0
+                      )
+    );
+    TEST_ASSERT_EQUAL(expect_sec, pub->expiry_sec);
+}
+
+#ifdef GMON_CFG_MQTT_PIPELINED_PUBLISH
+// several messages are published before their PUBACKs are collected in order
+TEST(NetConnMqttClient, PublishPipelined) {
+    const UTestNetFakePublish_t *pub = UTestNetFakeGetLastPublish();
+    const UTestNetFakeStats_t   *stats = UTestNetFakeGetStats();
+    unsigned short               pkt_ids[3] = {0}, idx = 0;
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnEstablish(&utest_mqttc_net));
+    for (idx = 0; idx < 3; idx++) {
+        pkt_ids[idx] = stationNetConnReservePktId(&utest_mqttc_net);
+        TEST_ASSERT_NOT_EQUAL(0, pkt_ids[idx]);
+        TEST_ASSERT_EQUAL(
+            GMON_RESP_OK,
+            stationNetConnPublish(&utest_mqttc_net, utestMqttcLogMsg("{\"seq\":1}"), pkt_ids[idx], 0)
+        );
+        TEST_ASSERT_EQUAL_UINT16(pkt_ids[idx], pub->pkt_id);
+    }
+    TEST_ASSERT_EQUAL(3, stats->max_inflight);
+    for (idx = 0; idx < 3; idx++) {
+        TEST_ASSERT_EQUAL(
+            GMON_RESP_OK, stationNetConnWaitPubAck(&utest_mqttc_net, pkt_ids[idx], &utest_mqttc_ctrl)
+        );
+    }
+    // retransmission after reconnection
+    TEST_ASSERT_EQUAL(
+        GMON_RESP_OK, stationNetConnPublish(&utest_mqttc_net, utestMqttcLogMsg("{\"seq\":1}"), pkt_ids[2], 1)
+    );
+    TEST_ASSERT_EQUAL(1, pub->dup);
+    TEST_ASSERT_EQUAL(1, stats->num_publish_dup);
+    // PUBACK of other packet never arrives, the connection is regarded as broken
+    TEST_ASSERT_EQUAL(
+        GMON_RESP_ERR_CONN, stationNetConnWaitPubAck(&utest_mqttc_net, pkt_ids[0], &utest_mqttc_ctrl)
+    );
+    TEST_ASSERT_EQUAL(GMON_RESP_ERR_CONN, utest_mqttc_net.status.sent);
+}
+
+// packet IDs reserved for pipelined messages are never taken by the commands sent by MQTT library
+TEST(NetConnMqttClient, ReservedPktIdUnique) {
+    const UTestNetFakePublish_t *pub = UTestNetFakeGetLastPublish();
+    unsigned short               reserved = 0;
+    TEST_ASSERT_EQUAL(0, stationNetConnReservePktId(NULL));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnEstablish(&utest_mqttc_net));
+    reserved = stationNetConnReservePktId(&utest_mqttc_net);
+    TEST_ASSERT_EQUAL(
+        GMON_RESP_OK, stationNetConnPublish(&utest_mqttc_net, utestMqttcLogMsg("{\"seq\":1}"), reserved, 0)
+    );
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnWaitPubAck(&utest_mqttc_net, reserved, &utest_mqttc_ctrl));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnSend(&utest_mqttc_net, utestMqttcLogMsg("{\"seq\":2}")));
+    TEST_ASSERT_NOT_EQUAL(reserved, pub->pkt_id);
+    TEST_ASSERT_NOT_EQUAL(reserved, stationNetConnReservePktId(&utest_mqttc_net));
+}
+
+// control message forwarded by the broker before the PUBACK is handed to the caller, not dropped
+TEST(NetConnMqttClient, CtrlMsgDuringPubAck) {
+    const char    *json = "{\"actuators\":{\"pump\":{\"threshold\":934}}}";
+    unsigned short pkt_id = 0;
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnEstablish(&utest_mqttc_net));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnSubscribe(&utest_mqttc_net));
+    pkt_id = stationNetConnReservePktId(&utest_mqttc_net);
+    TEST_ASSERT_EQUAL(
+        GMON_RESP_OK, stationNetConnPublish(&utest_mqttc_net, utestMqttcLogMsg("{\"seq\":1}"), pkt_id, 0)
+    );
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, UTestNetFakeScheduleCtrlMsg(utestMqttcNow() + 1, json));
+    TEST_ASSERT_EQUAL(GMON_RESP_ERRARGS, stationNetConnWaitPubAck(&utest_mqttc_net, pkt_id, NULL));
+    TEST_ASSERT_EQUAL(GMON_RESP_SKIP, stationNetConnWaitPubAck(&utest_mqttc_net, pkt_id, &utest_mqttc_ctrl));
+    TEST_ASSERT_EQUAL(XSTRLEN(json), utest_mqttc_ctrl.nbytes_written);
+    TEST_ASSERT_EQUAL_MEMORY(json, utest_mqttc_ctrl_buf, utest_mqttc_ctrl.nbytes_written);
+    TEST_ASSERT_EQUAL(1, UTestNetFakeGetStats()->num_ctrl_delivered);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, utest_mqttc_net.status.recv);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnWaitPubAck(&utest_mqttc_net, pkt_id, &utest_mqttc_ctrl));
+}
+#else
+// each message is acknowledged before the next one is published, packet ID on the wire is assigned by
+// the library
+TEST(NetConnMqttClient, PublishAckedInPlace) {
+    const UTestNetFakePublish_t *pub = UTestNetFakeGetLastPublish();
+    const UTestNetFakeStats_t   *stats = UTestNetFakeGetStats();
+    unsigned short               labels[2] = {0};
+    TEST_ASSERT_EQUAL(0, stationNetConnReservePktId(NULL));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnEstablish(&utest_mqttc_net));
+    labels[0] = stationNetConnReservePktId(&utest_mqttc_net);
+    labels[1] = stationNetConnReservePktId(&utest_mqttc_net);
+    TEST_ASSERT_NOT_EQUAL(0, labels[0]);
+    TEST_ASSERT_NOT_EQUAL(labels[0], labels[1]);
+    TEST_ASSERT_EQUAL(
+        GMON_RESP_OK, stationNetConnPublish(&utest_mqttc_net, utestMqttcLogMsg("{\"seq\":1}"), labels[0], 0)
+    );
+    TEST_ASSERT_EQUAL(0, pub->dup);
+    TEST_ASSERT_NOT_EQUAL(0, pub->pkt_id);
+    // retransmission after reconnection
+    TEST_ASSERT_EQUAL(
+        GMON_RESP_OK, stationNetConnPublish(&utest_mqttc_net, utestMqttcLogMsg("{\"seq\":1}"), labels[1], 1)
+    );
+    TEST_ASSERT_EQUAL(1, pub->dup);
+    TEST_ASSERT_EQUAL(2, stats->num_publish);
+    TEST_ASSERT_EQUAL(1, stats->max_inflight);
+    TEST_ASSERT_EQUAL(GMON_RESP_ERRARGS, stationNetConnWaitPubAck(&utest_mqttc_net, labels[0], NULL));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnWaitPubAck(&utest_mqttc_net, labels[0], &utest_mqttc_ctrl));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnWaitPubAck(&utest_mqttc_net, labels[1], &utest_mqttc_ctrl));
+}
+#endif // end of GMON_CFG_MQTT_PIPELINED_PUBLISH
+
+TEST(NetConnMqttClient, PollCtrlMsg) {
+    const char  *json = "{\"actuators\":{\"pump\":{\"threshold\":934}}}";
+    unsigned int start_ms = 0;
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, UTestNetFakeScheduleCtrlMsg(2000, json));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnEstablish(&utest_mqttc_net));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnSubscribe(&utest_mqttc_net));
+    // nothing arrives within the timeout
+    start_ms = utestMqttcNow();
+    TEST_ASSERT_EQUAL(GMON_RESP_SKIP, stationNetConnPoll(&utest_mqttc_net, &utest_mqttc_msg, 10));
+    TEST_ASSERT_GREATER_OR_EQUAL(start_ms + 10, utestMqttcNow());
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnPoll(&utest_mqttc_net, &utest_mqttc_msg, 5000));
+    TEST_ASSERT_EQUAL(XSTRLEN(json), utest_mqttc_msg.nbytes_written);
+    TEST_ASSERT_EQUAL_MEMORY(json, utest_mqttc_buf, utest_mqttc_msg.nbytes_written);
+    TEST_ASSERT_EQUAL(1, UTestNetFakeGetStats()->num_ctrl_delivered);
+    TEST_ASSERT_EQUAL(GMON_RESP_SKIP, stationNetConnPoll(&utest_mqttc_net, &utest_mqttc_msg, 10));
+}
+
+// subscribe, wait for retained control message, then unsubscribe in the same call
+TEST(NetConnMqttClient, RecvCtrlMsg) {
+    const char *json = "{\"actuators\":{\"fan\":{\"threshold\":35}}}";
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnEstablish(&utest_mqttc_net));
+    TEST_ASSERT_EQUAL(GMON_RESP_TIMEOUT, stationNetConnRecv(&utest_mqttc_net, &utest_mqttc_msg));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, UTestNetFakeScheduleCtrlMsg(utestMqttcNow() + 100, json));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnRecv(&utest_mqttc_net, &utest_mqttc_msg));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, utest_mqttc_net.status.recv);
+    TEST_ASSERT_EQUAL_MEMORY(json, utest_mqttc_buf, XSTRLEN(json));
+    // the subscription is gone
+    TEST_ASSERT_EQUAL(GMON_RESP_ERR_CONN, stationNetConnPoll(&utest_mqttc_net, &utest_mqttc_msg, 10));
+}
+
+TEST_GROUP_RUNNER(gMonNetConnMqttClient) {
+    RUN_TEST_CASE(NetConnMqttClient, EstablishAndClose);
+    RUN_TEST_CASE(NetConnMqttClient, EstablishInOutage);
+    RUN_TEST_CASE(NetConnMqttClient, SendLogMessage);
+    RUN_TEST_CASE(NetConnMqttClient, ExpiryFollowsReportInterval);
+#ifdef GMON_CFG_MQTT_PIPELINED_PUBLISH
+    RUN_TEST_CASE(NetConnMqttClient, PublishPipelined);
+    RUN_TEST_CASE(NetConnMqttClient, ReservedPktIdUnique);
+    RUN_TEST_CASE(NetConnMqttClient, CtrlMsgDuringPubAck);
+#else
+    RUN_TEST_CASE(NetConnMqttClient, PublishAckedInPlace);
+#endif
+    RUN_TEST_CASE(NetConnMqttClient, PollCtrlMsg);
+    RUN_TEST_CASE(NetConnMqttClient, RecvCtrlMsg);
+}
@@ -0,0 +1,594 @@
+#include "mqtt_include.h"
+#include "mqtt_fake.h"
+
+#define UTEST_NETFAKE_MAX_CTRL_MSGS   32
+#define UTEST_NETFAKE_MAX_INFLIGHT    16
+#define UTEST_NETFAKE_CMD_TIMEOUT_MS  5000 // same as command timeout of MQTT client
+#define UTEST_NETFAKE_BROKER_USERNAME "garden-station"
+#define UTEST_NETFAKE_BROKER_PASSWORD "0123456789abcdef"
+#define UTEST_NETFAKE_STRLEN(s)       (sizeof(s) - 1)
+
+typedef struct {
+    unsigned int at_ms;
+    const char  *json;
+} UTestNetFakeCtrlMsg_t;
+
+// PUBACK on its way back to the station
+typedef struct {
+    unsigned int   sent_ms;
+    unsigned int   ack_at_ms;
+    unsigned short pkt_id;
+} UTestNetFakePubAck_t;
+
+typedef struct {
+    UTestNetFakeLink_t    link;
+    UTestNetFakeStats_t   stats;
+    UTestNetFakePublish_t last_publish;
+    UTestNetFakeCtrlMsg_t ctrl_msgs[UTEST_NETFAKE_MAX_CTRL_MSGS];
+    unsigned short        num_ctrl_msgs;
+    unsigned short        num_ctrl_delivered;
+    UTestNetFakePubAck_t  pubacks[UTEST_NETFAKE_MAX_INFLIGHT];
+    unsigned char         num_pubacks;
+    unsigned char         connected  : 1;
+    unsigned char         subscribed : 1;
+    unsigned int          connect_start_ms;
+    // state of the library
+    word16                lib_next_pkt_id;
+    byte                  lib_rx_payload[MQTT_RECV_PKT_MAXBYTES];
+    byte                  in_send_publish;
+} UTestNetFakeBroker_t;
+
+static UTestNetFakeBroker_t netfake_broker;
+
+static mqttStr_t netfake_username = {
+    .len = UTEST_NETFAKE_STRLEN(UTEST_NETFAKE_BROKER_USERNAME),
+    .data = (byte *)UTEST_NETFAKE_BROKER_USERNAME,
+};
+static mqttStr_t netfake_password = {
+    .len = UTEST_NETFAKE_STRLEN(UTEST_NETFAKE_BROKER_PASSWORD),
+    .data = (byte *)UTEST_NETFAKE_BROKER_PASSWORD,
+};
+
+// ---- size of MQTT v5 control packets, fixed header + variable header + payload ----
+static unsigned int mqttFakeVarIntSz(unsigned int value) {
+    return (value < 0x80) ? 1 : (value < 0x4000) ? 2 : (value < 0x200000) ? 3 : 4;
+}
+
+static unsigned int mqttFakePktSz(unsigned int remain_len) {
+    return 1 + mqttFakeVarIntSz(remain_len) + remain_len + netfake_broker.link.tls_record_overhead;
+}
+
+static int mqttFakePropSz(mqttPropertyType type) {
+    switch (type) {
+    case MQTT_PROP_MSG_EXPIRY_INTVL:
+    case MQTT_PROP_MAX_PKT_SIZE:
+        return 1 + 4;
+    case MQTT_PROP_RECV_MAX:
+    case MQTT_PROP_TOPIC_ALIAS_MAX:
+    case MQTT_PROP_TOPIC_ALIAS:
+        return 1 + 2;
+    default:
+        return MQTT_RESP_ERR_PROP;
+    }
+}
+
+static int mqttFakePropsLen(mqttProp_t *props) {
+    int total = 0, sz = 0;
+    for (mqttProp_t *curr = props; curr != NULL; curr = curr->next) {
+        sz = mqttFakePropSz(curr->type);
+        if (sz < 0)
+            return sz;
+        total += sz;
+    }
+    return total;
+}
+
+static unsigned int mqttFakeConnectSz(mqttConn_t *conn) {
+    int          props_len = mqttFakePropsLen(conn->props);
+    unsigned int remain_len = 10 + mqttFakeVarIntSz(props_len) + props_len;
+    remain_len += 2 + conn->client_id.len;
+    if (conn->username.data != NULL)
+        remain_len += 2 + conn->username.len;
+    if (conn->password.data != NULL)
+        remain_len += 2 + conn->password.len;
+    return mqttFakePktSz(remain_len);
+}
+
+static unsigned int mqttFakeSubscribeSz(mqttPktSubs_t *subs, uint8_t unsubscribe) {
+    unsigned int props_len = 0, remain_len = 2;
+    for (word16 idx = 0; idx < subs->topic_cnt; idx++) {
+        remain_len += 2 + subs->topics[idx].filter.len + (unsubscribe ? 0 : 1);
+        if (!unsubscribe && subs->topics[idx].sub_id > 0) // subscription identifier
+            props_len = 1 + mqttFakeVarIntSz(subs->topics[idx].sub_id);
+    }
+    return mqttFakePktSz(remain_len + mqttFakeVarIntSz(props_len) + props_len);
+}
+
+static unsigned int mqttFakeCtrlPublishSz(unsigned int payload_len) {
+    unsigned int topic_len = UTEST_NETFAKE_STRLEN(GMON_CFG_MQTT_TOPIC_USR_CTRL);
+    return mqttFakePktSz(2 + topic_len + 2 + 1 + payload_len);
+}
+
+// ---- link model, time spent on each exchange is added to system tick ----
+static unsigned int mqttFakeNow(void) { return stationSysGetTickCount() * GMON_NUM_MILLISECONDS_PER_TICK; }
+
+static uint8_t mqttFakeInOutage(void) {
+    unsigned int now_ms = mqttFakeNow();
+    return (now_ms >= netfake_broker.link.outage_from_ms) && (now_ms < netfake_broker.link.outage_until_ms);
+}
+
+static void mqttFakeElapse(unsigned int time_ms) {
+    setMockTickCount(g_mock_tick_count + time_ms / GMON_NUM_MILLISECONDS_PER_TICK);
+}
+
+static unsigned int mqttFakeExchange(unsigned int nbytes_tx, unsigned int nbytes_rx, unsigned int num_rtts) {
+    unsigned int bps = (netfake_broker.link.bytes_per_sec == 0) ? 1 : netfake_broker.link.bytes_per_sec;
+    unsigned int cost_ms =
+        num_rtts * netfake_broker.link.rtt_ms + (unsigned int)((nbytes_tx + nbytes_rx) * 1000ULL / bps);
+    netfake_broker.stats.bytes_tx += nbytes_tx;
+    netfake_broker.stats.bytes_rx += nbytes_rx;
+    netfake_broker.stats.link_busy_ms += cost_ms;
+    mqttFakeElapse(cost_ms);
+    return cost_ms;
+}
+
+// station waits until command timeout, then regards the connection as broken
+static mqttRespStatus mqttFakeLinkBroken(void) {
+    netfake_broker.stats.link_busy_ms += UTEST_NETFAKE_CMD_TIMEOUT_MS;
+    mqttFakeElapse(UTEST_NETFAKE_CMD_TIMEOUT_MS);
+    netfake_broker.connected = 0;
+    netfake_broker.subscribed = 0;
+    netfake_broker.num_pubacks = 0;
+    return MQTT_RESP_ERR_CONN;
+}
+
+static uint8_t mqttFakeLinkUp(void) { return netfake_broker.connected && !mqttFakeInOutage(); }
+
+// deliver the oldest control message published by remote user before `deadline_ms`
+static mqttRespStatus mqttFakeDeliverCtrlMsg(mqttMsg_t *msg_out, unsigned int deadline_ms) {
+    UTestNetFakeCtrlMsg_t *msg = NULL;
+    unsigned int           now_ms = mqttFakeNow(), latency = 0, payload_len = 0;
+    if (netfake_broker.num_ctrl_delivered >= netfake_broker.num_ctrl_msgs)
+        return MQTT_RESP_TIMEOUT;
+    msg = &netfake_broker.ctrl_msgs[netfake_broker.num_ctrl_delivered];
+    if ((int)(msg->at_ms - deadline_ms) > 0)
+        return MQTT_RESP_TIMEOUT;
+    if ((int)(msg->at_ms - now_ms) > 0) // wait until remote user publishes the message
+        mqttFakeElapse(msg->at_ms - now_ms);
+    payload_len = XMIN(XSTRLEN(msg->json), sizeof(netfake_broker.lib_rx_payload));
+    // broker forwards the message, the station responds with PUBACK
+    mqttFakeExchange(4 + netfake_broker.link.tls_record_overhead, 0, 0);
+    mqttFakeExchange(0, mqttFakeCtrlPublishSz(payload_len), 0);
+    mqttFakeElapse(netfake_broker.link.rtt_ms >> 1);
+    XMEMCPY(netfake_broker.lib_rx_payload, msg->json, payload_len);
+    XMEMSET(msg_out, 0x00, sizeof(mqttMsg_t));
+    msg_out->topic.data = (byte *)GMON_CFG_MQTT_TOPIC_USR_CTRL;
+    msg_out->topic.len = UTEST_NETFAKE_STRLEN(GMON_CFG_MQTT_TOPIC_USR_CTRL);
+    msg_out->qos = MQTT_QOS_1;
+    msg_out->buff = netfake_broker.lib_rx_payload;
+    msg_out->app_data_len = payload_len;
+    latency = mqttFakeNow() - msg->at_ms;
+    netfake_broker.stats.ctrl_latency_ms += latency;
+    if (netfake_broker.stats.max_ctrl_latency_ms < latency)
+        netfake_broker.stats.max_ctrl_latency_ms = latency;
+    netfake_broker.stats.num_ctrl_delivered++;
+    netfake_broker.num_ctrl_delivered++;
+    return MQTT_RESP_OK;
+}
+
+// PUBACKs are sent back in the same order as the PUBLISH packets received
+static mqttRespStatus mqttFakeRecvPubAck(mqttPktPubResp_t *pubresp, word16 pkt_id) {
+    UTestNetFakePubAck_t *puback = &netfake_broker.pubacks[0];
+    unsigned int          now_ms = 0, cost_ms = 0;
+    if (!mqttFakeLinkUp() || netfake_broker.num_pubacks == 0 || puback->pkt_id != pkt_id)
+        return mqttFakeLinkBroken();
+    now_ms = mqttFakeNow();
+    if ((int)(puback->ack_at_ms - now_ms) > 0) {
+        netfake_broker.stats.link_busy_ms += puback->ack_at_ms - now_ms;
+        mqttFakeElapse(puback->ack_at_ms - now_ms);
+    }
+    mqttFakeExchange(0, mqttFakePktSz(2), 0);
+    cost_ms = mqttFakeNow() - puback->sent_ms;
+    netfake_broker.stats.publish_time_ms += cost_ms;
+    if (netfake_broker.stats.max_publish_ms < cost_ms)
+        netfake_broker.stats.max_publish_ms = cost_ms;
+    netfake_broker.num_pubacks--;
+    for (unsigned char idx = 0; idx < netfake_broker.num_pubacks; idx++)
+        netfake_broker.pubacks[idx] = netfake_broker.pubacks[idx + 1];
+    XMEMSET(pubresp, 0x00, sizeof(mqttPktPubResp_t));
+    pubresp->packet_id = pkt_id;
+    pubresp->reason_code = MQTT_REASON_SUCCESS;
+    return MQTT_RESP_OK;
+}
+
+// ---- broker side, decode PUBLISH packet received from the station ----
+static int mqttFakeDecodeVarInt(const byte *buf, word32 buf_len, word32 *value) {
+    word32 idx = 0, mul = 1;
+    *value = 0;
+    do {
+        if (idx >= buf_len || idx >= 4)
+            return MQTT_RESP_MALFORMED_DATA;
+        *value += (buf[idx] & 0x7f) * mul;
+        mul <<= 7;
+    } while (buf[idx++] & 0x80);
+    return (int)idx;
+}
+
+static mqttRespStatus mqttFakeBrokerRecvPublish(const byte *buf, word32 buf_len) {
+    UTestNetFakePublish_t *rec = &netfake_broker.last_publish;
+    word32                 remain_len = 0, props_len = 0, topic_len = 0, pos = 0, end = 0, props_end = 0;
+    int                    nbytes = mqttFakeDecodeVarInt(&buf[1], buf_len - 1, &remain_len);
+    if (nbytes < 0 || (1 + nbytes + remain_len) != buf_len)
+        return MQTT_RESP_MALFORMED_DATA;
+    XMEMSET(rec, 0x00, sizeof(UTestNetFakePublish_t));
+    rec->retain = buf[0] & 0x1;
+    rec->qos = (buf[0] >> 1) & 0x3;
+    rec->dup = (buf[0] >> 3) & 0x1;
+    pos = 1 + nbytes;
+    end = buf_len;
+    topic_len = ((word32)buf[pos] << 8) | buf[pos + 1];
+    pos += 2;
+    if ((pos + topic_len) > end || topic_len >= sizeof(rec->topic))
+        return MQTT_RESP_MALFORMED_DATA;
+    XMEMCPY(rec->topic, &buf[pos], topic_len);
+    pos += topic_len;
+    if (rec->qos > MQTT_QOS_0) {
+        rec->pkt_id = ((word16)buf[pos] << 8) | buf[pos + 1];
+        pos += 2;
+    }
+    nbytes = mqttFakeDecodeVarInt(&buf[pos], end - pos, &props_len);
+    if (nbytes < 0)
+        return MQTT_RESP_MALFORMED_DATA;
+    pos += nbytes;
+    for (props_end = pos + props_len; pos < props_end;) {
+        switch (buf[pos]) {
+        case MQTT_PROP_MSG_EXPIRY_INTVL:
+            rec->expiry_sec = ((word32)buf[pos + 1] << 24) | ((word32)buf[pos + 2] << 16) |
+                              ((word32)buf[pos + 3] << 8) | buf[pos + 4];
+            pos += 5;
+            break;
+        case MQTT_PROP_TOPIC_ALIAS:
+            rec->topic_alias = ((word16)buf[pos + 1] << 8) | buf[pos + 2];
+            pos += 3;
+            break;
+        default:
+            return MQTT_RESP_ERR_PROP;
+        }
+    }
+    if (pos != props_end || pos > end)
+        return MQTT_RESP_MALFORMED_DATA;
+    rec->payload_len = end - pos;
+    XMEMCPY(rec->payload, &buf[pos], XMIN(rec->payload_len, sizeof(rec->payload)));
+    return MQTT_RESP_OK;
+}
+
+void UTestNetFakeSetup(const UTestNetFakeLink_t *link) {
+    XMEMSET(&netfake_broker, 0, sizeof(UTestNetFakeBroker_t));
+    netfake_broker.link = *link;
+}
+
+gMonStatus UTestNetFakeScheduleCtrlMsg(unsigned int at_ms, const char *json) {
+    if (json == NULL || netfake_broker.num_ctrl_msgs >= UTEST_NETFAKE_MAX_CTRL_MSGS)
+        return GMON_RESP_ERRARGS;
+    if (netfake_broker.num_ctrl_msgs > 0) { // keep messages ordered by publish time
+        if (netfake_broker.ctrl_msgs[netfake_broker.num_ctrl_msgs - 1].at_ms > at_ms)
+            return GMON_RESP_ERRARGS;
+    }
+    netfake_broker.ctrl_msgs[netfake_broker.num_ctrl_msgs].at_ms = at_ms;
+    netfake_broker.ctrl_msgs[netfake_broker.num_ctrl_msgs].json = json;
+    netfake_broker.num_ctrl_msgs++;
+    return GMON_RESP_OK;
+}
+
+const UTestNetFakeStats_t *UTestNetFakeGetStats(void) { return &netfake_broker.stats; }
+
+const UTestNetFakePublish_t *UTestNetFakeGetLastPublish(void) { return &netfake_broker.last_publish; }
+
+// ---- mqtt-client library API used by src/network/mqtt_client.c, see mqtt_lib/mqtt_include.h ----
+mqttRespStatus mqttClientInit(mqttCtx_t **mctx, int cmd_timeout_ms) {
+    mqttCtx_t *out = NULL;
+    if (mctx == NULL)
+        return MQTT_RESP_ERRARGS;
+    out = (mqttCtx_t *)XCALLOC(1, sizeof(mqttCtx_t) + MQTT_SEND_PKT_MAXBYTES);
+    if (out == NULL)
+        return MQTT_RESP_ERRMEM;
+    out->tx_buf = (byte *)out + sizeof(mqttCtx_t);
+    out->tx_buf_len = MQTT_SEND_PKT_MAXBYTES;
+    out->cmd_timeout_ms = cmd_timeout_ms;
+    *mctx = out;
+    return MQTT_RESP_OK;
+}
+
+mqttRespStatus mqttClientDeinit(mqttCtx_t *mctx) {
+    if (mctx == NULL)
+        return MQTT_RESP_ERRARGS;
+    XMEMFREE(mctx);
+    return MQTT_RESP_OK;
+}
+
+// random bit generator is only needed by TLS handshake, which is modelled by the link
+mqttRespStatus mqttDRBGinit(mqttDRBG_t **drbg) {
+    if (drbg == NULL)
+        return MQTT_RESP_ERRARGS;
+    *drbg = (mqttDRBG_t *)&netfake_broker;
+    return MQTT_RESP_OK;
+}
+
+void mqttDRBGdeinit(mqttDRBG_t *drbg) { (void)drbg; }
+
+mqttRespStatus mqttSysNetInit(void) { return MQTT_RESP_OK; }
+
+mqttRespStatus mqttSysNetDeInit(void) { return MQTT_RESP_OK; }
+
+mqttRespStatus mqttAuthGetBrokerLoginInfo(mqttStr_t **username, mqttStr_t **password) {
+    if (username == NULL || password == NULL)
+        return MQTT_RESP_ERRARGS;
+    *username = &netfake_username;
+    *password = &netfake_password;
+    return MQTT_RESP_OK;
+}
+
+void mqttModifyReadMsgTimeout(mqttCtx_t *mctx, int new_timeout_ms) {
+    if (mctx != NULL)
+        mctx->cmd_timeout_ms = new_timeout_ms;
+}
+
+// reason codes less than 0x80 indicate success
+mqttRespStatus mqttChkReasonCode(byte reason_code) {
+    return (reason_code < MQTT_REASON_UNSPECIFIED_ERR) ? MQTT_RESP_OK : MQTT_RESP_ERR;
+}
+
+void mqttPropertyDel(mqttProp_t *head) {
+    mqttProp_t *next = NULL;
+    for (; head != NULL; head = next) {
+        next = head->next;
+        XMEMFREE(head);
+    }
+}
+
+// TCP handshake followed by TLS handshake, most of handshake bytes come from server certificate chain
+mqttRespStatus mqttNetconnStart(mqttCtx_t *mctx) {
+    unsigned int tls_bytes_tx = netfake_broker.link.tls_handshake_bytes >> 2;
+    if (mctx == NULL)
+        return MQTT_RESP_ERRARGS;
+    netfake_broker.connect_start_ms = mqttFakeNow();
+    if (mqttFakeInOutage()) {
+        netfake_broker.stats.num_connect_fail++;
+        return mqttFakeLinkBroken();
+    }
+    mqttFakeExchange(0, 0, 1);
+    mqttFakeExchange(
+        tls_bytes_tx, netfake_broker.link.tls_handshake_bytes - tls_bytes_tx,
+        netfake_broker.link.tls_handshake_rtts
+    );
+    return MQTT_RESP_OK;
+}
+
+mqttRespStatus mqttNetconnStop(mqttCtx_t *mctx) {
+    if (mctx == NULL)
+        return MQTT_RESP_ERRARGS;
+    netfake_broker.connected = 0;
+    netfake_broker.subscribed = 0;
+    netfake_broker.num_pubacks = 0;
+    return MQTT_RESP_OK;
+}
+
+mqttRespStatus mqttSendConnect(mqttCtx_t *mctx, mqttPktHeadConnack_t **connack_out) {
+    mqttPktHeadConnack_t *connack = NULL;
+    static mqttProp_t     connack_recv_max;
+    if (mctx == NULL || connack_out == NULL)
+        return MQTT_RESP_ERRARGS;
+    *connack_out = NULL;
+    if (mqttFakeInOutage())
+        return mqttFakeLinkBroken();
+    mqttFakeExchange(mqttFakeConnectSz(&mctx->send_pkt.conn), mqttFakePktSz(3), 1);
+    netfake_broker.stats.keep_alive_sec = mctx->send_pkt.conn.keep_alive_sec;
+    netfake_broker.stats.clean_session = mctx->send_pkt.conn.flgs.clean_session;
+    netfake_broker.connected = 1;
+    netfake_broker.num_pubacks = 0;
+    netfake_broker.stats.num_connect++;
+    netfake_broker.stats.connect_time_ms += mqttFakeNow() - netfake_broker.connect_start_ms;
+    connack = &mctx->recv_pkt.connack;
+    XMEMSET(connack, 0x00, sizeof(mqttPktHeadConnack_t));
+    connack->reason_code = MQTT_REASON_SUCCESS;
+    if (netfake_broker.link.recv_max > 0) {
+        connack_recv_max.type = MQTT_PROP_RECV_MAX;
+        connack_recv_max.body.u16 = (word16)netfake_broker.link.recv_max;
+        connack_recv_max.next = NULL;
+        connack->props = &connack_recv_max;
+    }
+    *connack_out = connack;
+    return MQTT_RESP_OK;
+}
+
+mqttRespStatus mqttSendDisconnect(mqttCtx_t *mctx) {
+    if (mctx == NULL)
+        return MQTT_RESP_ERRARGS;
+    if (netfake_broker.connected)
+        mqttFakeExchange(mqttFakePktSz(2), 0, 0); // then TCP connection is closed
+    return MQTT_RESP_OK;
+}
+
+int mqttEncodePktPublish(byte *tx_buf, word32 buf_len, mqttMsg_t *msg) {
+    word32 remain_len = 0, pos = 0, value = 0;
+    int    props_len = 0;
+    if (tx_buf == NULL || msg == NULL || msg->topic.data == NULL)
+        return MQTT_RESP_ERRARGS;
+    if (msg->buff == NULL && msg->app_data_len > 0)
+        return MQTT_RESP_ERRARGS;
+    props_len = mqttFakePropsLen(msg->props);
+    if (props_len < 0)
+        return props_len;
+    remain_len = 2 + msg->topic.len + ((msg->qos > MQTT_QOS_0) ? 2 : 0);
+    remain_len += mqttFakeVarIntSz(props_len) + props_len + msg->app_data_len;
+    if ((1 + mqttFakeVarIntSz(remain_len) + remain_len) > buf_len)
+        return MQTT_RESP_ERR_EXCEED_PKT_SZ;
+    tx_buf[pos++] = (MQTT_PACKET_TYPE_PUBLISH << 4) | ((msg->duplicate & 0x1) << 3) |
+                    ((msg->qos & 0x3) << 1) | (msg->retain & 0x1);
+    for (value = remain_len; value >= 0x80; value >>= 7)
+        tx_buf[pos++] = (value & 0x7f) | 0x80;
+    tx_buf[pos++] = value;
+    tx_buf[pos++] = msg->topic.len >> 8;
+    tx_buf[pos++] = msg->topic.len & 0xff;
+    XMEMCPY(&tx_buf[pos], msg->topic.data, msg->topic.len);
+    pos += msg->topic.len;
+    if (msg->qos > MQTT_QOS_0) {
+        tx_buf[pos++] = msg->packet_id >> 8;
+        tx_buf[pos++] = msg->packet_id & 0xff;
+    }
+    tx_buf[pos++] = props_len; // less than 0x80 for the properties supported here
+    for (mqttProp_t *curr = msg->props; curr != NULL; curr = curr->next) {
+        tx_buf[pos++] = curr->type;
+        if (mqttFakePropSz(curr->type) == 5) {
+            tx_buf[pos++] = curr->body.u32 >> 24;
+            tx_buf[pos++] = (curr->body.u32 >> 16) & 0xff;
+            tx_buf[pos++] = (curr->body.u32 >> 8) & 0xff;
+            tx_buf[pos++] = curr->body.u32 & 0xff;
+        } else {
+            tx_buf[pos++] = curr->body.u16 >> 8;
+            tx_buf[pos++] = curr->body.u16 & 0xff;
+        }
+    }
+    if (msg->app_data_len > 0)
+        XMEMCPY(&tx_buf[pos], msg->buff, msg->app_data_len);
+    pos += msg->app_data_len;
+    return (int)pos;
+}
+
+// only PUBLISH packet is written through this function, the broker decodes it from raw bytes, then
+// sends PUBACK back one round trip later
+int mqttPktWrite(mqttCtx_t *mctx, byte *buf, word32 buf_len) {
+    UTestNetFakePubAck_t *puback = NULL;
+    mqttRespStatus        status = MQTT_RESP_OK;
+    if (mctx == NULL || buf == NULL || buf_len < 2)
+        return MQTT_RESP_ERRARGS;
+    if ((buf[0] >> 4) != MQTT_PACKET_TYPE_PUBLISH)
+        return MQTT_RESP_ERR_CTRL_PKT_TYPE;
+    if (!mqttFakeLinkUp())
+        return mqttFakeLinkBroken();
+    // the client must not exceed receive maximum of the broker
+    if (netfake_broker.num_pubacks >= UTEST_NETFAKE_MAX_INFLIGHT ||
+        (netfake_broker.link.recv_max > 0 && netfake_broker.num_pubacks >= netfake_broker.link.recv_max))
+        return mqttFakeLinkBroken();
+    status = mqttFakeBrokerRecvPublish(buf, buf_len);
+    if (status != MQTT_RESP_OK)
+        return status;
+    if (netfake_broker.last_publish.qos > MQTT_QOS_0) {
+        puback = &netfake_broker.pubacks[netfake_broker.num_pubacks++];
+        puback->pkt_id = netfake_broker.last_publish.pkt_id;
+        puback->sent_ms = mqttFakeNow();
+    }
+    mqttFakeExchange(buf_len + netfake_broker.link.tls_record_overhead, 0, 0);
+    if (puback != NULL)
+        puback->ack_at_ms = mqttFakeNow() + netfake_broker.link.rtt_ms;
+    netfake_broker.stats.num_publish++;
+    if (netfake_broker.last_publish.dup)
+        netfake_broker.stats.num_publish_dup++;
+    if (netfake_broker.stats.max_inflight < netfake_broker.num_pubacks)
+        netfake_broker.stats.max_inflight = netfake_broker.num_pubacks;
+    return (int)buf_len;
+}
+
+mqttRespStatus
+mqttClientWaitPkt(mqttCtx_t *mctx, mqttCtrlPktType wait_cmd, word16 wait_packet_id, void **pp_recv_out) {
+    mqttRespStatus status = MQTT_RESP_OK;
+    if (mctx == NULL)
+        return MQTT_RESP_ERRARGS;
+    if (pp_recv_out != NULL)
+        *pp_recv_out = NULL;
+    switch (wait_cmd) {
+    case MQTT_PACKET_TYPE_PUBACK:
+        // control message forwarded by the broker before the PUBACK, mqttSendPublish() leaves it in the
+        // receive buffer for the next read
+        if (!netfake_broker.in_send_publish && netfake_broker.subscribed && netfake_broker.num_pubacks > 0 &&
+            mqttFakeLinkUp()) {
+            status = mqttFakeDeliverCtrlMsg(&mctx->recv_pkt.pub_msg, netfake_broker.pubacks[0].ack_at_ms);
+            if (status == MQTT_RESP_OK) {
+                if (pp_recv_out != NULL)
+                    *pp_recv_out = &mctx->recv_pkt.pub_msg;
+                return MQTT_RESP_ERR_CTRL_PKT_TYPE;
+            }
+        }
+        status = mqttFakeRecvPubAck(&mctx->recv_pkt.pub_resp, wait_packet_id);
+        if (status == MQTT_RESP_OK && pp_recv_out != NULL)
+            *pp_recv_out = &mctx->recv_pkt.pub_resp;
+        break;
+    case MQTT_PACKET_TYPE_PUBLISH:
+        if (!mqttFakeLinkUp() || !netfake_broker.subscribed)
+            return mqttFakeLinkBroken();
+        status = mqttFakeDeliverCtrlMsg(&mctx->recv_pkt.pub_msg, mqttFakeNow() + mctx->cmd_timeout_ms);
+        if (status == MQTT_RESP_TIMEOUT)
+            mqttFakeElapse(mctx->cmd_timeout_ms);
+        else if (pp_recv_out != NULL)
+            *pp_recv_out = &mctx->recv_pkt.pub_msg;
+        break;
+    default:
+        status = MQTT_RESP_ERR_CTRL_PKT_TYPE;
+        break;
+    }
+    return status;
+}
+
+word16 mqttGetPktID(void) {
+    if (++netfake_broker.lib_next_pkt_id == 0)
+        netfake_broker.lib_next_pkt_id = 1;
+    return netfake_broker.lib_next_pkt_id;
+}
+
+mqttRespStatus mqttSendPublish(mqttCtx_t *mctx, mqttPktPubResp_t **pubresp_out) {
+    mqttMsg_t     *msg = NULL;
+    mqttRespStatus status = MQTT_RESP_OK;
+    int            pkt_len = 0;
+    if (mctx == NULL)
+        return MQTT_RESP_ERRARGS;
+    msg = &mctx->send_pkt.pub_msg;
+    if (msg->qos > MQTT_QOS_0) {
+        msg->packet_id = mqttGetPktID();
+    }
+    pkt_len = mqttEncodePktPublish(mctx->tx_buf, mctx->tx_buf_len, msg);
+    if (pkt_len > 0)
+        pkt_len = mqttPktWrite(mctx, mctx->tx_buf, pkt_len);
+    if (pkt_len < 0)
+        return (mqttRespStatus)pkt_len;
+    if (msg->qos == MQTT_QOS_0)
+        return MQTT_RESP_OK;
+    netfake_broker.in_send_publish = 1;
+    status = mqttClientWaitPkt(mctx, MQTT_PACKET_TYPE_PUBACK, msg->packet_id, (void **)pubresp_out);
+    netfake_broker.in_send_publish = 0;
+    return status;
+}
+
+static mqttRespStatus
+mqttFakeSendSubscribe(mqttCtx_t *mctx, mqttPktSuback_t **suback_out, uint8_t unsubscribe) {
+    mqttPktSuback_t *suback = NULL;
+    if (mctx == NULL || suback_out == NULL)
+        return MQTT_RESP_ERRARGS;
+    *suback_out = NULL;
+    if (!mqttFakeLinkUp())
+        return mqttFakeLinkBroken();
+    mqttFakeExchange(mqttFakeSubscribeSz(&mctx->send_pkt.subs, unsubscribe), mqttFakePktSz(4), 1);
+    netfake_broker.subscribed = !unsubscribe;
+    suback = &mctx->recv_pkt.suback;
+    XMEMSET(suback, 0x00, sizeof(mqttPktSuback_t));
+    suback->return_codes[0] = MQTT_REASON_SUCCESS;
+    *suback_out = suback;
+    return MQTT_RESP_OK;
+}
+
+mqttRespStatus mqttSendSubscribe(mqttCtx_t *mctx, mqttPktSuback_t **suback_out) {
+    return mqttFakeSendSubscribe(mctx, suback_out, 0);
+}
+
+mqttRespStatus mqttSendUnsubscribe(mqttCtx_t *mctx, mqttPktSuback_t **unsuback_out) {
+    return mqttFakeSendSubscribe(mctx, unsuback_out, 1);
+}
+
+mqttRespStatus mqttSendPingReq(mqttCtx_t *mctx) {
+    if (mctx == NULL)
+        return MQTT_RESP_ERRARGS;
+    if (!mqttFakeLinkUp())
+        return mqttFakeLinkBroken();
+    mqttFakeExchange(mqttFakePktSz(0), mqttFakePktSz(0), 1); // PINGREQ, PINGRESP
+    netfake_broker.stats.num_ping++;
+    return MQTT_RESP_OK;
+}
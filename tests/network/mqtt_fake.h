@@ -0,0 +1,63 @@
+#ifndef TEST_GMON_MQTT_FAKE_H
+#define TEST_GMON_MQTT_FAKE_H
+
+#include "station_include.h"
+
+// In-process stand-in of MQTT broker and network link, it implements the mqtt-client library API
+// (see mqtt_lib/mqtt_include.h) underneath src/network/mqtt_client.c, so the MQTT client of this station
+// and the network handler task can run on Linux. Time spent on the link is modelled from round trip
+// time and throughput, then added to the mocked system tick, sizes of MQTT v5 control packets the
+// client sends / receives are counted as bytes on the wire. PUBLISH packets are encoded to raw bytes
+// and decoded again by the broker.
+typedef struct {
+    unsigned int rtt_ms;              // round trip time between the station and the broker
+    unsigned int bytes_per_sec;       // throughput of the link, e.g. UART to external wifi module
+    unsigned int tls_handshake_rtts;  // number of round trips for TLS handshake
+    unsigned int tls_handshake_bytes; // bytes exchanged in TLS handshake including certificates
+    unsigned int tls_record_overhead; // bytes added to each MQTT packet by TLS record layer
+    unsigned int recv_max;            // receive maximum announced in CONNACK, 0 means not announced
+    // broker is unreachable within this period (in milliseconds of system tick)
+    unsigned int outage_from_ms;
+    unsigned int outage_until_ms;
+} UTestNetFakeLink_t;
+
+typedef struct {
+    unsigned int       num_connect;
+    unsigned int       num_connect_fail;
+    unsigned int       num_publish;
+    unsigned int       num_publish_dup; // retransmitted with DUP flag after reconnection
+    unsigned int       max_inflight;    // QoS 1 messages published without PUBACK at the same time
+    unsigned int       num_ping;
+    unsigned int       keep_alive_sec; // in latest CONNECT packet
+    unsigned char      clean_session;
+    unsigned int       num_ctrl_delivered;
+    unsigned int       max_publish_ms;
+    unsigned int       max_ctrl_latency_ms;
+    unsigned long long connect_time_ms;
+    unsigned long long publish_time_ms;
+    unsigned long long ctrl_latency_ms; // from remote user publishing control message to station receiving it
+    unsigned long long link_busy_ms;    // time the radio has to stay awake for network traffic
+    unsigned long long bytes_tx;
+    unsigned long long bytes_rx;
+} UTestNetFakeStats_t;
+
+// latest PUBLISH packet decoded by the broker
+typedef struct {
+    char           topic[64];
+    unsigned char  payload[1024]; // truncated if the message is longer
+    unsigned int   payload_len;
+    unsigned int   expiry_sec;
+    unsigned short topic_alias;
+    unsigned short pkt_id;
+    unsigned char  qos;
+    unsigned char  dup;
+    unsigned char  retain;
+} UTestNetFakePublish_t;
+
+void UTestNetFakeSetup(const UTestNetFakeLink_t *);
+// remote user publishes control message (retained) to the broker at given time
+gMonStatus                 UTestNetFakeScheduleCtrlMsg(unsigned int at_ms, const char *json);
+const UTestNetFakeStats_t   *UTestNetFakeGetStats(void);
+const UTestNetFakePublish_t *UTestNetFakeGetLastPublish(void);
+
+#endif // TEST_GMON_MQTT_FAKE_H
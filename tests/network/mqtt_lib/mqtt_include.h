@@ -0,0 +1,224 @@
+#ifndef TEST_GMON_MQTT_LIB_INCLUDE_H
+#define TEST_GMON_MQTT_LIB_INCLUDE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Host stand-in of the headers of external mqtt-client library, only types and functions used by
+// src/network/mqtt_client.c are declared, with the same names and semantics as the library. They are
+// implemented in tests/network/mqtt_fake.c on top of in-process broker and link model, so the MQTT
+// client of this station can be built and tested on host without the AT parser of wifi module.
+
+#ifndef XMIN
+    #define XMIN(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+
+#define MQTT_CONN_PROTOCOL_LEVEL   5
+#define MQTT_DEFAULT_KEEPALIVE_SEC 60
+#define MQTT_RECV_PKT_MAXBYTES     0x400
+#define MQTT_SEND_PKT_MAXBYTES     0x800
+#define MQTT_MAX_NUM_TOPICS        1
+
+typedef uint8_t  byte;
+typedef uint16_t word16;
+typedef uint32_t word32;
+
+typedef enum {
+    MQTT_RESP_OK = 0,
+    MQTT_RESP_ERR = -1,
+    MQTT_RESP_ERRARGS = -2,
+    MQTT_RESP_ERRMEM = -3,
+    MQTT_RESP_TIMEOUT = -4,
+    MQTT_RESP_ERR_SECURE_CONN = -5,
+    MQTT_RESP_MALFORMED_DATA = -6,
+    MQTT_RESP_ERR_EXCEED_PKT_SZ = -7,
+    MQTT_RESP_ERR_CTRL_PKT_TYPE = -8,
+    MQTT_RESP_ERR_CTRL_PKT_ID = -9,
+    MQTT_RESP_ERR_PROP = -10,
+    MQTT_RESP_ERR_PROP_REPEAT = -11,
+    MQTT_RESP_ERR_INTEGRITY = -12,
+    MQTT_RESP_INVALID_TOPIC = -13,
+    MQTT_RESP_ERR_CONN = -14,
+} mqttRespStatus;
+
+typedef enum {
+    MQTT_QOS_0 = 0,
+    MQTT_QOS_1 = 1,
+    MQTT_QOS_2 = 2,
+} mqttQoS;
+
+typedef enum {
+    MQTT_PACKET_TYPE_CONNECT = 1,
+    MQTT_PACKET_TYPE_CONNACK = 2,
+    MQTT_PACKET_TYPE_PUBLISH = 3,
+    MQTT_PACKET_TYPE_PUBACK = 4,
+    MQTT_PACKET_TYPE_SUBSCRIBE = 8,
+    MQTT_PACKET_TYPE_SUBACK = 9,
+    MQTT_PACKET_TYPE_UNSUBSCRIBE = 10,
+    MQTT_PACKET_TYPE_UNSUBACK = 11,
+    MQTT_PACKET_TYPE_PINGREQ = 12,
+    MQTT_PACKET_TYPE_PINGRESP = 13,
+    MQTT_PACKET_TYPE_DISCONNECT = 14,
+} mqttCtrlPktType;
+
+typedef enum {
+    MQTT_PROP_NONE = 0x00,
+    MQTT_PROP_MSG_EXPIRY_INTVL = 0x02,
+    MQTT_PROP_RECV_MAX = 0x21,
+    MQTT_PROP_TOPIC_ALIAS_MAX = 0x22,
+    MQTT_PROP_TOPIC_ALIAS = 0x23,
+    MQTT_PROP_MAX_PKT_SIZE = 0x27,
+} mqttPropertyType;
+
+typedef enum {
+    MQTT_REASON_SUCCESS = 0x00,
+    MQTT_REASON_NORMAL_DISCONNECTION = 0x00,
+    MQTT_REASON_UNSPECIFIED_ERR = 0x80,
+    MQTT_REASON_SERVER_UNAVAILABLE = 0x88,
+    MQTT_REASON_QUOTA_EXCEEDED = 0x97,
+} mqttReasonCode;
+
+typedef struct {
+    word16 len;
+    byte  *data;
+} mqttStr_t;
+
+typedef union {
+    byte      u8;
+    word16    u16;
+    word32    u32;
+    mqttStr_t str;
+} mqttPropBody_t;
+
+typedef struct __mqttProp {
+    struct __mqttProp *next;
+    mqttPropBody_t     body;
+    mqttPropertyType   type;
+} mqttProp_t;
+
+typedef struct {
+    mqttStr_t filter;
+    mqttQoS   qos;
+    byte      reason_code;
+    word32    sub_id;
+    word16    alias;
+} mqttTopic_t;
+
+typedef struct {
+    mqttProp_t *props;
+    mqttStr_t   topic;
+    byte       *buff; // application data
+    word32      app_data_len;
+    word16      packet_id;
+    mqttQoS     qos;
+    byte        retain;
+    byte        duplicate;
+} mqttMsg_t;
+
+typedef struct {
+    mqttProp_t *props;
+    mqttStr_t   client_id;
+    mqttStr_t   username;
+    mqttStr_t   password;
+    mqttMsg_t   lwt_msg;
+    word16      keep_alive_sec;
+    byte        protocol_lvl;
+    struct {
+        byte clean_session : 1;
+        byte will_enable   : 1;
+    } flgs;
+} mqttConn_t;
+
+typedef struct {
+    mqttProp_t *props;
+    byte        reason_code;
+} mqttPktDisconn_t;
+
+typedef struct {
+    mqttProp_t  *props;
+    mqttTopic_t *topics;
+    word16       topic_cnt;
+    word16       packet_id;
+} mqttPktSubs_t;
+
+typedef mqttPktSubs_t mqttPktUnsubs_t;
+
+typedef struct {
+    mqttProp_t *props;
+    byte        flags;
+    byte        reason_code;
+} mqttPktHeadConnack_t;
+
+typedef struct {
+    mqttProp_t *props;
+    word16      packet_id;
+    byte        reason_code;
+} mqttPktPubResp_t;
+
+typedef struct {
+    mqttProp_t *props;
+    byte        return_codes[MQTT_MAX_NUM_TOPICS];
+    word16      packet_id;
+} mqttPktSuback_t;
+
+typedef struct __mqttDRBG mqttDRBG_t;
+
+typedef struct {
+    byte       *tx_buf;
+    word32      tx_buf_len;
+    mqttDRBG_t *drbg;
+    int         cmd_timeout_ms;
+    union {
+        mqttConn_t       conn;
+        mqttMsg_t        pub_msg;
+        mqttPktSubs_t    subs;
+        mqttPktUnsubs_t  unsubs;
+        mqttPktDisconn_t disconn;
+    } send_pkt;
+    union {
+        mqttPktHeadConnack_t connack;
+        mqttMsg_t            pub_msg;
+        mqttPktPubResp_t     pub_resp;
+        mqttPktSuback_t      suback;
+    } recv_pkt;
+    struct {
+        byte reason_code;
+    } err_info;
+} mqttCtx_t;
+
+mqttRespStatus mqttClientInit(mqttCtx_t **mctx, int cmd_timeout_ms);
+mqttRespStatus mqttClientDeinit(mqttCtx_t *mctx);
+mqttRespStatus mqttDRBGinit(mqttDRBG_t **drbg);
+void           mqttDRBGdeinit(mqttDRBG_t *drbg);
+mqttRespStatus mqttSysNetInit(void);
+mqttRespStatus mqttSysNetDeInit(void);
+mqttRespStatus mqttNetconnStart(mqttCtx_t *mctx);
+mqttRespStatus mqttNetconnStop(mqttCtx_t *mctx);
+mqttRespStatus mqttAuthGetBrokerLoginInfo(mqttStr_t **username, mqttStr_t **password);
+void           mqttModifyReadMsgTimeout(mqttCtx_t *mctx, int new_timeout_ms);
+mqttRespStatus mqttChkReasonCode(byte reason_code);
+void           mqttPropertyDel(mqttProp_t *head);
+
+// send a command packet, then wait for its response from the broker if there is one
+mqttRespStatus mqttSendConnect(mqttCtx_t *mctx, mqttPktHeadConnack_t **connack_out);
+mqttRespStatus mqttSendDisconnect(mqttCtx_t *mctx);
+mqttRespStatus mqttSendPublish(mqttCtx_t *mctx, mqttPktPubResp_t **pubresp_out);
+mqttRespStatus mqttSendSubscribe(mqttCtx_t *mctx, mqttPktSuback_t **suback_out);
+mqttRespStatus mqttSendUnsubscribe(mqttCtx_t *mctx, mqttPktSuback_t **unsuback_out);
+mqttRespStatus mqttSendPingReq(mqttCtx_t *mctx);
+
+// read packets from the broker until the one with given type (and packet ID if non-zero) arrives
+mqttRespStatus
+mqttClientWaitPkt(mqttCtx_t *mctx, mqttCtrlPktType wait_cmd, word16 wait_packet_id, void **pp_recv_out);
+
+// Functions and behaviour below are used only if `GMON_CFG_MQTT_PIPELINED_PUBLISH` is enabled, the
+// library build linked to the firmware has to provide them :
+// * `mqttClientWaitPkt()` acknowledges PUBLISH packet which arrives while waiting for other packet
+//   type, returns MQTT_RESP_ERR_CTRL_PKT_TYPE and `pp_recv_out` points to the message.
+// * packet ID for next command sent by the library or the application, never 0
+word16 mqttGetPktID(void);
+// * low-level encoder and transport, return number of bytes encoded / written, or negative error code
+int mqttEncodePktPublish(byte *tx_buf, word32 buf_len, mqttMsg_t *msg);
+int mqttPktWrite(mqttCtx_t *mctx, byte *buf, word32 buf_len);
+
+#endif // TEST_GMON_MQTT_LIB_INCLUDE_H
@@ -0,0 +1,305 @@
+#include <stdlib.h>
+#include "station_include.h"
+#include "oled_emu.h"
+#include "mqtt_fake.h"
+#include "backlog_file.h"
+
+// End-to-end benchmark of network handler task on host, the task runs against in-process MQTT broker
+// stand-in (see mqtt_fake.h) in virtual time, sensor logs are published periodically and remote user
+// updates actuator thresholds from time to time, the broker is unreachable for a while in the middle.
+// Link parameters can be overridden by environment variables NETBENCH_RTT_MS, NETBENCH_BYTES_PER_SEC,
+// and NETBENCH_RECV_MAX (receive maximum of the broker, which limits log messages in flight).
+
+#define NETBENCH_DURATION_MS     (2 * 60 * 60 * 1000)
+#define NETBENCH_LOG_INTERVAL_MS (60 * 1000)
+#define NETBENCH_CTRL_PERIOD_MS  (7 * 60 * 1000 + 1234)
+#define NETBENCH_OUTAGE_FROM_MS  (40 * 60 * 1000)
+#define NETBENCH_OUTAGE_UNTIL_MS (46 * 60 * 1000)
+#define NETBENCH_SPILL_PATH      "/tmp/gmon_netbench_backlog.bin"
+#define NETBENCH_SPILL_CAPACITY  16
+
+static const char *netbench_ctrl_msgs[] = {
+    "{\"actuators\":{\"pump\":{\"threshold\":934}}}",
+    "{\"actuators\":{\"pump\":{\"threshold\":1019},\"fan\":{\"threshold\":35}}}",
+    "{\"actuators\":{\"pump\":{\"threshold\":881},\"bulb\":{\"threshold\":521}}}",
+};
+#define NETBENCH_NUM_CTRL_MSG_TYPES (sizeof(netbench_ctrl_msgs) / sizeof(const char *))
+
+static gardenMonitor_t    netbench_gmon;
+static UTestBacklogFile_t netbench_spill;
+// same as the station on target board, see src/station.c
+static uint64_t netbench_arena_mem[(GMON_CFG_INIT_ARENA_NBYTES + 7) >> 3];
+
+static unsigned int netbenchNow(void) { return stationSysGetTickCount() * GMON_NUM_MILLISECONDS_PER_TICK; }
+
+#ifdef GMON_CFG_NETCONN_PERSISTENT
+static void netbenchDelayMs(unsigned int time_ms) {
+    setMockTickCount(g_mock_tick_count + time_ms / GMON_NUM_MILLISECONDS_PER_TICK);
+}
+#endif
+
+static unsigned int netbenchEnvUInt(const char *name, unsigned int dflt) {
+    const char *value = getenv(name);
+    return (value == NULL) ? dflt : (unsigned int)strtoul(value, NULL, 10);
+}
+
+// soil dries out for a few minutes every 20 minutes (pump is turned on), and it gets hot during the
+// outage (fan is turned on), readings are stable otherwise.
+static unsigned int netbenchSensorValue(gmonEventType_t type, unsigned int minute) {
+    switch (type) {
+    case GMON_EVENT_SOIL_MOISTURE_UPDATED:
+        return ((minute % 20) >= 15 && (minute % 20) < 18) ? 1023 : (700 + (minute % 3));
+    case GMON_EVENT_AIR_TEMP_UPDATED:
+        return (minute >= 42 && minute < 60) ? 55 : (30 + (minute & 1));
+    case GMON_EVENT_LIGHTNESS_UPDATED:
+    default:
+        return 300 + (minute % 5);
+    }
+}
+
+// same as sensor reading tasks followed by data log task, events are referenced by sensor records
+// until next publish. Aggregation in actuator tasks is simplified, returns number of actuators which
+// changed state.
+static unsigned int netbenchLogSensors(gardenMonitor_t *gmon, unsigned int seq) {
+    gmonEventType_t types[3] = {
+        GMON_EVENT_SOIL_MOISTURE_UPDATED, GMON_EVENT_AIR_TEMP_UPDATED, GMON_EVENT_LIGHTNESS_UPDATED
+    };
+    gmonSensorRecord_t *records[3] = {
+        &gmon->latest_logs.soilmoist, &gmon->latest_logs.aircond, &gmon->latest_logs.light
+    };
+    gMonActuator_t    *devs[3] = {&gmon->actuator.pump, &gmon->actuator.fan, &gmon->actuator.bulb};
+    gMonActuatorStatus next_status = GMON_OUT_DEV_STATUS_OFF;
+    unsigned int       now_ms = netbenchNow(), value = 0, num_changed = 0;
+    for (unsigned short idx = 0; idx < 3; idx++) {
+        gmonEvent_t *evt = staAllocSensorEvent(&gmon->sensors.event, types[idx], 1), *discarded = NULL;
+        XASSERT(evt != NULL);
+        evt->curr_ticks = now_ms % GMON_NUM_MILLISECONDS_PER_DAY;
+        evt->curr_days = now_ms / GMON_NUM_MILLISECONDS_PER_DAY;
+        value = netbenchSensorValue(types[idx], seq);
+        if (types[idx] == GMON_EVENT_AIR_TEMP_UPDATED)
+            *(gmonAirCond_t *)evt->data = (gmonAirCond_t){.temporature = (float)value, .humidity = 70.2f};
+        else
+            *(unsigned int *)evt->data = value;
+        discarded = staUpdateLastRecord(records[idx], evt);
+        if (discarded)
+            staFreeSensorEvent(&gmon->sensors.event, discarded);
+        devs[idx]->ema.last_aggregated = (int)value;
+        next_status = ((int)value > devs[idx]->threshold && types[idx] != GMON_EVENT_LIGHTNESS_UPDATED)
+                          ? GMON_OUT_DEV_STATUS_ON
+                          : GMON_OUT_DEV_STATUS_OFF;
+        // paused by network handler task, still working
+        if ((devs[idx]->status == GMON_OUT_DEV_STATUS_OFF) != (next_status == GMON_OUT_DEV_STATUS_OFF))
+            num_changed++;
+        devs[idx]->status = next_status;
+    }
+    return num_changed;
+}
+
+// actuator state changes, and how long it takes to publish them
+typedef struct {
+    unsigned int       num_changes;
+    unsigned int       changed_at_ms; // 0 means no pending change
+    unsigned int       max_latency_ms;
+    unsigned long long latency_ms;
+} netbenchAlerts_t;
+
+static void netbenchReport(
+    const UTestNetFakeStats_t *stats, gardenMonitor_t *gmon, unsigned int num_iterations,
+    unsigned int cleared_ms, netbenchAlerts_t *alerts
+) {
+    gMonNet_t          *net_handle = &gmon->netconn;
+    gMonNetBacklog_t   *bl = &net_handle->backlog;
+    gMonNetPubWindow_t *pw = &net_handle->pub_win;
+    unsigned int num_cycles = (stats->num_publish == 0) ? 1 : stats->num_publish;
+    unsigned int num_connect = (stats->num_connect == 0) ? 1 : stats->num_connect;
+    unsigned int num_ctrl = (stats->num_ctrl_delivered == 0) ? 1 : stats->num_ctrl_delivered;
+#ifdef GMON_CFG_NETCONN_PERSISTENT
+    printf("[netbench] mode: persistent session, keep-alive %d sec\n", GMON_CFG_NETCONN_KEEPALIVE_SEC);
+#else
+    printf("[netbench] mode: connect per cycle\n");
+#endif
+    printf("[netbench] virtual time: %u sec, iterations: %u\n", netbenchNow() / 1000, num_iterations);
+    printf(
+        "[netbench] connect: %u succeeded, %u failed, avg %llu ms\n", stats->num_connect,
+        stats->num_connect_fail, stats->connect_time_ms / num_connect
+    );
+    printf(
+        "[netbench] publish: %u messages, avg latency %llu ms, max %u ms\n", stats->num_publish,
+        stats->publish_time_ms / num_cycles, stats->max_publish_ms
+    );
+    printf(
+        "[netbench] user control: %u received, avg latency %llu ms, max %u ms\n", stats->num_ctrl_delivered,
+        stats->ctrl_latency_ms / num_ctrl, stats->max_ctrl_latency_ms
+    );
+    printf(
+        "[netbench] on the wire: tx %llu bytes, rx %llu bytes, %llu bytes per cycle, %u pings\n",
+        stats->bytes_tx, stats->bytes_rx, (stats->bytes_tx + stats->bytes_rx) / num_cycles, stats->num_ping
+    );
+    printf(
+        "[netbench] link busy: %llu ms, %llu ms per cycle\n", stats->link_busy_ms,
+        stats->link_busy_ms / num_cycles
+    );
+    printf(
+        "[netbench] backlog: %u queued, %u spilled (%u bytes to storage), %u drained, %u dropped, peak %u, "
+        "%u left\n",
+        bl->stats.num_queued, bl->stats.num_spilled, netbench_spill.nbytes_written, bl->stats.num_drained,
+        bl->stats.num_dropped, bl->stats.peak, staNetConnBacklogCount(bl)
+    );
+    printf(
+        "[netbench] publish window: %u, max %u in flight, %u retransmitted, backlog cleared %u ms after "
+        "the outage\n",
+        pw->window, stats->max_inflight, stats->num_publish_dup, cleared_ms
+    );
+    printf(
+        "[netbench] alerts: %u actuator changes out of the outage, avg latency %llu ms, max %u ms, "
+        "%u early reports, interval now %u ms\n",
+        alerts->num_changes, alerts->latency_ms / ((alerts->num_changes == 0) ? 1 : alerts->num_changes),
+        alerts->max_latency_ms, net_handle->adaptive.num_early, net_handle->adaptive.interval_ms
+    );
+    printf("[netbench] init arena: %u of %u bytes used\n", gmon->arena.used, gmon->arena.len);
+#ifdef GMON_CFG_APPMSG_REPORT_BY_EXCEPTION
+    printf(
+        "[netbench] report by exception: %u full messages, %u sensor types / actuators left out\n",
+        gmon->rawmsg.deadband.stats.num_full, gmon->rawmsg.deadband.stats.num_omitted
+    );
+#endif
+}
+
+int main(void) {
+    const UTestNetFakeStats_t *stats = UTestNetFakeGetStats();
+    // external wifi module wired through UART at 115200 bps, TLS 1.2 with AES-GCM
+    UTestNetFakeLink_t link = {
+        .rtt_ms = netbenchEnvUInt("NETBENCH_RTT_MS", 80),
+        .bytes_per_sec = netbenchEnvUInt("NETBENCH_BYTES_PER_SEC", 11520),
+        .tls_handshake_rtts = 2,
+        .tls_handshake_bytes = 3600,
+        .tls_record_overhead = 29,
+        .recv_max = netbenchEnvUInt("NETBENCH_RECV_MAX", 0),
+        .outage_from_ms = NETBENCH_OUTAGE_FROM_MS,
+        .outage_until_ms = NETBENCH_OUTAGE_UNTIL_MS,
+    };
+    unsigned int num_iterations = 0, num_ctrl_msgs = 0, num_logs = 0, num_cycles = 0, at_ms = 0;
+    unsigned int cleared_ms = 0, num_published = 0, latency_ms = 0;
+    netbenchAlerts_t alerts = {0};
+    gMonStatus   status = GMON_RESP_OK;
+    int          ret = 0;
+
+    setMockTickCount(0);
+    UTestOLEDemuReset();
+    UTestNetFakeSetup(&link);
+    for (at_ms = NETBENCH_CTRL_PERIOD_MS; at_ms < NETBENCH_DURATION_MS; at_ms += NETBENCH_CTRL_PERIOD_MS) {
+        const char *json = netbench_ctrl_msgs[num_ctrl_msgs % NETBENCH_NUM_CTRL_MSG_TYPES];
+        status = UTestNetFakeScheduleCtrlMsg(at_ms, json);
+        XASSERT(status == GMON_RESP_OK);
+        num_ctrl_msgs++;
+    }
+    status = staArenaInit(&netbench_gmon.arena, netbench_arena_mem, sizeof(netbench_arena_mem));
+    XASSERT(status == GMON_RESP_OK);
+    status = stationIOinit(&netbench_gmon);
+    XASSERT(status == GMON_RESP_OK);
+    netbench_gmon.sensors.soil_moist.super.num_items = 1;
+    netbench_gmon.sensors.air_temp.num_items = 1;
+    netbench_gmon.sensors.light.num_items = 1;
+    staActuatorInitGenericPump(&netbench_gmon.actuator.pump);
+    staActuatorInitGenericFan(&netbench_gmon.actuator.fan);
+    staActuatorInitGenericBulb(&netbench_gmon.actuator.bulb);
+    status = staAppMsgInit(&netbench_gmon);
+    XASSERT(status == GMON_RESP_OK);
+    status = staDisplayInit(&netbench_gmon);
+    XASSERT(status == GMON_RESP_OK);
+    status = stationNetConnInit(&netbench_gmon.netconn, &netbench_gmon.arena);
+    XASSERT(status == GMON_RESP_OK);
+    remove(NETBENCH_SPILL_PATH);
+    status = UTestBacklogFileOpen(&netbench_spill, NETBENCH_SPILL_PATH, NETBENCH_SPILL_CAPACITY);
+    XASSERT(status == GMON_RESP_OK);
+    status = staNetConnBacklogInit(&netbench_gmon.netconn.backlog, &utest_backlog_file_ops, &netbench_spill);
+    XASSERT(status == GMON_RESP_OK);
+    status = staNetConnPubWinInit(&netbench_gmon.netconn.pub_win);
+    XASSERT(status == GMON_RESP_OK);
+
+#ifndef GMON_CFG_NETCONN_PERSISTENT
+    unsigned int wake_ms = netbenchNow();
+#endif
+    // same as the loop in stationNetConnHandlerTaskFn(), except delay function advances virtual time
+    stationNetConnHandlerStart(&netbench_gmon.netconn);
+    while (netbenchNow() < NETBENCH_DURATION_MS) {
+#ifdef GMON_CFG_NETCONN_PERSISTENT
+        if (!netbench_gmon.netconn.session.connected)
+            netbenchDelayMs(GMON_CFG_NETCONN_POLL_INTERVAL_MS);
+#else
+        stationSysDelayUntilMs(&wake_ms, staNetConnCheckIntervalMs(&netbench_gmon.netconn));
+#endif
+        for (; (num_logs * NETBENCH_LOG_INTERVAL_MS) <= netbenchNow(); num_logs++) {
+            if (netbenchLogSensors(&netbench_gmon, num_logs) > 0 && alerts.changed_at_ms == 0 &&
+                (netbenchNow() < NETBENCH_OUTAGE_FROM_MS || netbenchNow() >= NETBENCH_OUTAGE_UNTIL_MS)) {
+                alerts.changed_at_ms = netbenchNow();
+                alerts.num_changes++;
+            }
+        }
+#ifndef GMON_CFG_NETCONN_PERSISTENT
+        if (!staNetConnReportDue(&netbench_gmon, netbenchNow()))
+            continue;
+#endif
+        num_published = stats->num_publish;
+        stationNetConnHandlerIteration(&netbench_gmon);
+        num_iterations++;
+        if (alerts.changed_at_ms != 0 && stats->num_publish > num_published) {
+            latency_ms = netbenchNow() - alerts.changed_at_ms;
+            alerts.latency_ms += latency_ms;
+            if (alerts.max_latency_ms < latency_ms)
+                alerts.max_latency_ms = latency_ms;
+            alerts.changed_at_ms = 0;
+        }
+        if (cleared_ms == 0 && netbenchNow() > NETBENCH_OUTAGE_UNTIL_MS &&
+            staNetConnBacklogCount(&netbench_gmon.netconn.backlog) == 0 &&
+            staNetConnPubWinCount(&netbench_gmon.netconn.pub_win) == 0)
+            cleared_ms = netbenchNow() - NETBENCH_OUTAGE_UNTIL_MS;
+    }
+    netbenchReport(stats, &netbench_gmon, num_iterations, cleared_ms, &alerts);
+
+    // sanity check, most of cycles out of the outage are published (reconnection may be delayed by
+    // backoff), control messages published during the outage reach the station after reconnection
+    num_cycles = (NETBENCH_DURATION_MS - (NETBENCH_OUTAGE_UNTIL_MS - NETBENCH_OUTAGE_FROM_MS)) /
+                 netbench_gmon.netconn.interval_ms;
+#ifdef GMON_CFG_NETCONN_ADAPTIVE_INTERVAL
+    // fewer messages while readings are stable, but actuator changes are reported without delay
+    num_cycles = NETBENCH_DURATION_MS / GMON_CFG_NETCONN_ADAPTIVE_MAX_INTERVAL_MS;
+    if (alerts.num_changes == 0 || alerts.changed_at_ms != 0 ||
+        alerts.max_latency_ms > (GMON_CFG_NETCONN_ADAPTIVE_MIN_GAP_MS << 1) + 5000) {
+        fprintf(stderr, "[netbench] actuator changes not reported in time\n");
+        ret = 1;
+    }
+#endif
+    if ((stats->num_publish * 10) < (num_cycles * 9)) {
+        fprintf(stderr, "[netbench] %u of %u messages published\n", stats->num_publish, num_cycles);
+        ret = 1;
+    }
+    if ((stats->num_ctrl_delivered + 1) < num_ctrl_msgs) {
+        fprintf(
+            stderr, "[netbench] %u of %u control messages lost\n", num_ctrl_msgs - stats->num_ctrl_delivered,
+            num_ctrl_msgs
+        );
+        ret = 1;
+    }
+    // log messages generated during the outage are forwarded after reconnection
+    gMonNetBacklog_t *bl = &netbench_gmon.netconn.backlog;
+    if (bl->stats.num_dropped > 0 || bl->stats.num_queued == 0 || staNetConnBacklogCount(bl) > 0 ||
+        staNetConnPubWinCount(&netbench_gmon.netconn.pub_win) > 0) {
+        fprintf(stderr, "[netbench] log messages not forwarded after the outage\n");
+        ret = 1;
+    }
+    if (stats->num_connect_fail == 0 || stats->bytes_tx == 0 || stats->bytes_rx == 0) {
+        fprintf(stderr, "[netbench] network traffic not modelled\n");
+        ret = 1;
+    }
+    staNetConnPubWinDeinit(&netbench_gmon.netconn.pub_win);
+    staNetConnBacklogDeinit(&netbench_gmon.netconn.backlog);
+    UTestBacklogFileClose(&netbench_spill);
+    remove(NETBENCH_SPILL_PATH);
+    stationNetConnDeinit(&netbench_gmon.netconn, &netbench_gmon.arena);
+    staDisplayDeInit(&netbench_gmon);
+    staAppMsgDeinit(&netbench_gmon);
+    stationIOdeinit(&netbench_gmon);
+    staArenaReset(&netbench_gmon.arena);
+    return ret;
+}
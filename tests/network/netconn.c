@@ -0,0 +1,88 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "station_include.h"
+#include "mqtt_fake.h"
+
+// network handler task running against in-process broker, see mqtt_fake.h
+
+static gardenMonitor_t utest_netconn_gmon;
+static uint64_t        utest_netconn_arena_mem[(GMON_CFG_INIT_ARENA_NBYTES + 7) >> 3];
+
+static const UTestNetFakeLink_t utest_netconn_link = {
+    .rtt_ms = 80,
+    .bytes_per_sec = 11520,
+    .tls_handshake_rtts = 2,
+    .tls_handshake_bytes = 3600,
+    .tls_record_overhead = 29,
+};
+
+static void utestNetConnLogSensor(gardenMonitor_t *gmon, unsigned int value) {
+    gmonEvent_t *evt = staAllocSensorEvent(&gmon->sensors.event, GMON_EVENT_SOIL_MOISTURE_UPDATED, 1);
+    gmonEvent_t *discarded = NULL;
+    TEST_ASSERT_NOT_NULL(evt);
+    *(unsigned int *)evt->data = value;
+    discarded = staUpdateLastRecord(&gmon->latest_logs.soilmoist, evt);
+    if (discarded)
+        staFreeSensorEvent(&gmon->sensors.event, discarded);
+}
+
+TEST_GROUP(NetConnHandler);
+
+TEST_SETUP(NetConnHandler) {
+    gardenMonitor_t *gmon = &utest_netconn_gmon;
+    setMockTickCount(0);
+    UTestNetFakeSetup(&utest_netconn_link);
+    XMEMSET(gmon, 0x00, sizeof(gardenMonitor_t));
+    TEST_ASSERT_EQUAL(
+        GMON_RESP_OK, staArenaInit(&gmon->arena, utest_netconn_arena_mem, sizeof(utest_netconn_arena_mem))
+    );
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationIOinit(gmon));
+    gmon->sensors.soil_moist.super.num_items = 1;
+    staActuatorInitGenericPump(&gmon->actuator.pump);
+    staActuatorInitGenericFan(&gmon->actuator.fan);
+    staActuatorInitGenericBulb(&gmon->actuator.bulb);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staAppMsgInit(gmon));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staDisplayInit(gmon));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnInit(&gmon->netconn, &gmon->arena));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staNetConnBacklogInit(&gmon->netconn.backlog, NULL, NULL));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staNetConnPubWinInit(&gmon->netconn.pub_win));
+}
+
+TEST_TEAR_DOWN(NetConnHandler) {
+    gardenMonitor_t *gmon = &utest_netconn_gmon;
+    staNetConnPubWinDeinit(&gmon->netconn.pub_win);
+    staNetConnBacklogDeinit(&gmon->netconn.backlog);
+    stationNetConnDeinit(&gmon->netconn, &gmon->arena);
+    staDisplayDeInit(gmon);
+    staAppMsgDeinit(gmon);
+    stationIOdeinit(gmon);
+    staArenaReset(&gmon->arena);
+}
+
+// outflight and inflight messages share the same buffer, the log message must reach the broker before
+// the buffer is cleared for control message from remote user
+TEST(NetConnHandler, PublishedPayloadIntact) {
+    gardenMonitor_t             *gmon = &utest_netconn_gmon;
+    const UTestNetFakePublish_t *pub = UTestNetFakeGetLastPublish();
+    const char                  *ctrl_json = "{\"actuators\":{\"pump\":{\"threshold\":934}}}";
+    unsigned int                 idx = 0;
+    stationNetConnHandlerStart(&gmon->netconn);
+    utestNetConnLogSensor(gmon, 702);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, UTestNetFakeScheduleCtrlMsg(gmon->netconn.interval_ms + 10, ctrl_json));
+    // report is due after one interval
+    setMockTickCount(gmon->netconn.interval_ms / GMON_NUM_MILLISECONDS_PER_TICK);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, stationNetConnHandlerIteration(gmon));
+    TEST_ASSERT_EQUAL(1, UTestNetFakeGetStats()->num_publish);
+    TEST_ASSERT_EQUAL_STRING(GMON_CFG_MQTT_TOPIC_LOG, pub->topic);
+    TEST_ASSERT_GREATER_THAN(2, pub->payload_len);
+    TEST_ASSERT_EQUAL_UINT8('{', pub->payload[0]);
+    for (idx = 0; idx < pub->payload_len && pub->payload[idx] != 0; idx++)
+        ;
+    TEST_ASSERT_EQUAL_UINT8('}', pub->payload[idx - 1]);
+    TEST_ASSERT_NOT_NULL(strstr((const char *)pub->payload, "702"));
+    // control message received in the same cycle is applied
+    TEST_ASSERT_EQUAL(1, UTestNetFakeGetStats()->num_ctrl_delivered);
+    TEST_ASSERT_EQUAL(934, gmon->actuator.pump.threshold);
+}
+
+TEST_GROUP_RUNNER(gMonNetConnHandler) { RUN_TEST_CASE(NetConnHandler, PublishedPayloadIntact); }
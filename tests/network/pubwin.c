@@ -0,0 +1,119 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "station_include.h"
+
+#define UTEST_PUBWIN_MSG_BUF_SZ 32
+
+static gMonNetPubWindow_t utest_pubwin;
+static unsigned char      utest_msg_buf[UTEST_PUBWIN_MSG_BUF_SZ];
+
+static gmonStr_t *utestPubWinMsg(unsigned int seq) {
+    static gmonStr_t msg = {.len = UTEST_PUBWIN_MSG_BUF_SZ, .data = utest_msg_buf};
+    msg.nbytes_written = snprintf((char *)utest_msg_buf, UTEST_PUBWIN_MSG_BUF_SZ, "{\"seq\":%u}", seq);
+    return &msg;
+}
+
+// publish all entries added to the window, return number of them
+static unsigned char utestPubWinSendAll(void) {
+    unsigned char num_sent = 0;
+    while (staNetConnPubWinNextUnsent(&utest_pubwin) != NULL) {
+        staNetConnPubWinMarkSent(&utest_pubwin);
+        num_sent++;
+    }
+    return num_sent;
+}
+
+TEST_GROUP(NetConnPubWindow);
+
+TEST_SETUP(NetConnPubWindow) { TEST_ASSERT_EQUAL(GMON_RESP_OK, staNetConnPubWinInit(&utest_pubwin)); }
+
+TEST_TEAR_DOWN(NetConnPubWindow) { staNetConnPubWinDeinit(&utest_pubwin); }
+
+TEST(NetConnPubWindow, AckInOrder) {
+    gMonNetPubWinEntry_t *entry = NULL;
+    unsigned short        pkt_ids[GMON_CFG_NETCONN_PUB_WINDOW_SZ] = {0};
+    unsigned int          idx = 0;
+    for (idx = 0; idx < GMON_CFG_NETCONN_PUB_WINDOW_SZ; idx++) {
+        entry = staNetConnPubWinAdd(&utest_pubwin, utestPubWinMsg(idx), idx + 1);
+        TEST_ASSERT_NOT_NULL(entry);
+        TEST_ASSERT_NOT_EQUAL(0, entry->pkt_id);
+        TEST_ASSERT_EQUAL(0, entry->dup);
+        pkt_ids[idx] = entry->pkt_id;
+    }
+    TEST_ASSERT_NULL(staNetConnPubWinAdd(&utest_pubwin, utestPubWinMsg(idx), idx + 1));
+    // nothing is waiting for PUBACK before published
+    TEST_ASSERT_NULL(staNetConnPubWinOldest(&utest_pubwin));
+    TEST_ASSERT_EQUAL(GMON_CFG_NETCONN_PUB_WINDOW_SZ, utestPubWinSendAll());
+    TEST_ASSERT_EQUAL(GMON_CFG_NETCONN_PUB_WINDOW_SZ, staNetConnPubWinCount(&utest_pubwin));
+    if (GMON_CFG_NETCONN_PUB_WINDOW_SZ > 1)
+        TEST_ASSERT_EQUAL(GMON_RESP_INVALID_REQ, staNetConnPubWinAck(&utest_pubwin, pkt_ids[1]));
+    for (idx = 0; idx < GMON_CFG_NETCONN_PUB_WINDOW_SZ; idx++) {
+        entry = staNetConnPubWinOldest(&utest_pubwin);
+        TEST_ASSERT_NOT_NULL(entry);
+        TEST_ASSERT_EQUAL_UINT16(pkt_ids[idx], entry->pkt_id);
+        TEST_ASSERT_EQUAL(GMON_RESP_OK, staNetConnPubWinAck(&utest_pubwin, pkt_ids[idx]));
+    }
+    TEST_ASSERT_EQUAL(0, staNetConnPubWinCount(&utest_pubwin));
+    TEST_ASSERT_EQUAL(GMON_RESP_SKIP, staNetConnPubWinAck(&utest_pubwin, pkt_ids[0]));
+    TEST_ASSERT_EQUAL(GMON_CFG_NETCONN_PUB_WINDOW_SZ, utest_pubwin.stats.peak);
+}
+
+TEST(NetConnPubWindow, PeerRecvMax) {
+    staNetConnPubWinSetWindow(&utest_pubwin, 1);
+    TEST_ASSERT_EQUAL(1, utest_pubwin.window);
+    TEST_ASSERT_NOT_NULL(staNetConnPubWinAdd(&utest_pubwin, utestPubWinMsg(0), 1));
+    TEST_ASSERT_NULL(staNetConnPubWinAdd(&utest_pubwin, utestPubWinMsg(1), 2));
+    // not announced, or greater than local window size
+    staNetConnPubWinSetWindow(&utest_pubwin, 0);
+    TEST_ASSERT_EQUAL(GMON_CFG_NETCONN_PUB_WINDOW_SZ, utest_pubwin.window);
+    staNetConnPubWinSetWindow(&utest_pubwin, 0xffff);
+    TEST_ASSERT_EQUAL(GMON_CFG_NETCONN_PUB_WINDOW_SZ, utest_pubwin.window);
+}
+
+TEST(NetConnPubWindow, RewindOnReconnect) {
+    gMonNetPubWinEntry_t *entry = NULL, *first = NULL;
+    unsigned char         num_added = (GMON_CFG_NETCONN_PUB_WINDOW_SZ > 1) ? 2 : 1;
+    first = staNetConnPubWinAdd(&utest_pubwin, utestPubWinMsg(0), 1);
+    TEST_ASSERT_NOT_NULL(first);
+    staNetConnPubWinMarkSent(&utest_pubwin);
+    if (num_added > 1) // added but not published yet when the connection is lost
+        TEST_ASSERT_NOT_NULL(staNetConnPubWinAdd(&utest_pubwin, utestPubWinMsg(1), 2));
+    staNetConnPubWinRewind(&utest_pubwin);
+    TEST_ASSERT_NULL(staNetConnPubWinOldest(&utest_pubwin));
+    TEST_ASSERT_EQUAL(1, utest_pubwin.stats.num_retransmit);
+    // published again with the same packet ID and content, DUP flag only for the one sent before
+    entry = staNetConnPubWinNextUnsent(&utest_pubwin);
+    TEST_ASSERT_EQUAL_PTR(first, entry);
+    TEST_ASSERT_EQUAL(1, entry->dup);
+    TEST_ASSERT_EQUAL_STRING_LEN("{\"seq\":0}", (const char *)entry->msg.data, entry->msg.nbytes_written);
+    staNetConnPubWinMarkSent(&utest_pubwin);
+    if (num_added > 1) {
+        entry = staNetConnPubWinNextUnsent(&utest_pubwin);
+        TEST_ASSERT_NOT_NULL(entry);
+        TEST_ASSERT_EQUAL(0, entry->dup);
+        staNetConnPubWinMarkSent(&utest_pubwin);
+    }
+    TEST_ASSERT_NULL(staNetConnPubWinNextUnsent(&utest_pubwin));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staNetConnPubWinAck(&utest_pubwin, first->pkt_id));
+    TEST_ASSERT_EQUAL(num_added - 1, staNetConnPubWinCount(&utest_pubwin));
+}
+
+// packet IDs are reserved by network stack, the window keeps them as they are
+TEST(NetConnPubWindow, PktIdFromNetStack) {
+    gMonNetPubWinEntry_t *entry = NULL;
+    TEST_ASSERT_NULL(staNetConnPubWinAdd(&utest_pubwin, utestPubWinMsg(0), 0));
+    entry = staNetConnPubWinAdd(&utest_pubwin, utestPubWinMsg(0), 0xffff);
+    TEST_ASSERT_NOT_NULL(entry);
+    TEST_ASSERT_EQUAL_UINT16(0xffff, entry->pkt_id);
+    staNetConnPubWinMarkSent(&utest_pubwin);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staNetConnPubWinAck(&utest_pubwin, 0xffff));
+    entry = staNetConnPubWinAdd(&utest_pubwin, utestPubWinMsg(1), 37);
+    TEST_ASSERT_EQUAL_UINT16(37, entry->pkt_id);
+}
+
+TEST_GROUP_RUNNER(gMonNetConnPubWindow) {
+    RUN_TEST_CASE(NetConnPubWindow, AckInOrder);
+    RUN_TEST_CASE(NetConnPubWindow, PeerRecvMax);
+    RUN_TEST_CASE(NetConnPubWindow, RewindOnReconnect);
+    RUN_TEST_CASE(NetConnPubWindow, PktIdFromNetStack);
+}
@@ -0,0 +1,292 @@
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+#include "oled_emu.h"
+
+// subset of SSD1315 registers which affect the image on the panel, see chapter 10 of SSD1306 spec
+typedef struct {
+    unsigned char gddram[UTEST_OLED_EMU_NUM_PAGES][UTEST_OLED_EMU_WIDTH];
+    uint8_t       dc_pin;
+    uint8_t       addr_mode; // 0: horizontal, 1: vertical, 2: page addressing mode
+    uint8_t       col, col_start, col_end;
+    uint8_t       page, page_start, page_end;
+    uint8_t       start_line;
+    uint8_t       contrast;
+    uint8_t       seg_remap  : 1;
+    uint8_t       com_remap  : 1;
+    uint8_t       inverse    : 1;
+    uint8_t       entire_on  : 1;
+    uint8_t       display_on : 1;
+    // multi-byte command in progress
+    uint8_t cmd;
+    uint8_t num_args_expect;
+    uint8_t num_args_recv;
+    uint8_t args[6];
+} UTestOLEDemu_t;
+
+static UTestOLEDemu_t      oled_emu;
+static UTestOLEDemuStats_t oled_emu_stats;
+// only addresses of these are used to identify the pins
+static uint8_t oled_emu_pin_spi, oled_emu_pin_rst, oled_emu_pin_dc;
+
+static unsigned long long utestOLEDemuNow(void) {
+    struct timespec ts = {0};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+}
+
+static void utestOLEDemuResetRegisters(void) {
+    // GDDRAM content is not affected by hardware reset
+    oled_emu.addr_mode = 2;
+    oled_emu.col = oled_emu.col_start = 0;
+    oled_emu.col_end = UTEST_OLED_EMU_WIDTH - 1;
+    oled_emu.page = oled_emu.page_start = 0;
+    oled_emu.page_end = UTEST_OLED_EMU_NUM_PAGES - 1;
+    oled_emu.start_line = 0;
+    oled_emu.contrast = 0x7F;
+    oled_emu.seg_remap = 0;
+    oled_emu.com_remap = 0;
+    oled_emu.inverse = 0;
+    oled_emu.entire_on = 0;
+    oled_emu.display_on = 0;
+    oled_emu.num_args_expect = 0;
+    oled_emu.num_args_recv = 0;
+}
+
+void UTestOLEDemuReset(void) {
+    XMEMSET(&oled_emu, 0, sizeof(UTestOLEDemu_t));
+    XMEMSET(&oled_emu_stats, 0, sizeof(UTestOLEDemuStats_t));
+    utestOLEDemuResetRegisters();
+}
+
+static uint8_t utestOLEDemuNumCmdArgs(uint8_t cmd) {
+    switch (cmd) {
+    case 0x20: // memory addressing mode
+    case 0x81: // contrast
+    case 0x8D: // charge pump
+    case 0xA8: // multiplex ratio
+    case 0xD3: // display offset
+    case 0xD5: // clock divide ratio
+    case 0xD9: // pre-charge period
+    case 0xDA: // COM pins configuration
+    case 0xDB: // V_comh deselect level
+        return 1;
+    case 0x21: // column address
+    case 0x22: // page address
+    case 0xA3: // vertical scroll area
+        return 2;
+    case 0x29:
+    case 0x2A: // continuous vertical and horizontal scroll
+        return 5;
+    case 0x26:
+    case 0x27: // continuous horizontal scroll
+        return 6;
+    default:
+        return 0;
+    }
+}
+
+static void utestOLEDemuExecCmd(void) {
+    uint8_t cmd = oled_emu.cmd, *args = oled_emu.args;
+    if (cmd <= 0x0F) { // lower nibble of column start address, page addressing mode only
+        if (oled_emu.addr_mode == 2)
+            oled_emu.col = (oled_emu.col & 0xF0) | cmd;
+    } else if (cmd <= 0x1F) { // higher nibble of column start address
+        if (oled_emu.addr_mode == 2)
+            oled_emu.col = ((cmd & 0x7) << 4) | (oled_emu.col & 0x0F);
+    } else if (cmd >= 0x40 && cmd <= 0x7F) {
+        oled_emu.start_line = cmd & 0x3F;
+    } else if (cmd >= 0xB0 && cmd <= 0xB7) { // page start address, page addressing mode only
+        if (oled_emu.addr_mode == 2)
+            oled_emu.page = cmd & 0x7;
+    } else {
+        switch (cmd) {
+        case 0x20:
+            oled_emu.addr_mode = args[0] & 0x3;
+            break;
+        case 0x21:
+            oled_emu.col = oled_emu.col_start = args[0] & 0x7F;
+            oled_emu.col_end = args[1] & 0x7F;
+            break;
+        case 0x22:
+            oled_emu.page = oled_emu.page_start = args[0] & 0x7;
+            oled_emu.page_end = args[1] & 0x7;
+            break;
+        case 0x81:
+            oled_emu.contrast = args[0];
+            break;
+        case 0xA0:
+        case 0xA1:
+            oled_emu.seg_remap = cmd & 0x1;
+            break;
+        case 0xA4:
+        case 0xA5:
+            oled_emu.entire_on = cmd & 0x1;
+            break;
+        case 0xA6:
+        case 0xA7:
+            oled_emu.inverse = cmd & 0x1;
+            break;
+        case 0xAE:
+        case 0xAF:
+            oled_emu.display_on = cmd & 0x1;
+            break;
+        case 0xC0:
+        case 0xC8:
+            oled_emu.com_remap = (cmd >> 3) & 0x1;
+            break;
+        default: // timing, charge pump, scrolling commands do not change the image in this emulator
+            break;
+        }
+    }
+} // end of utestOLEDemuExecCmd
+
+static void utestOLEDemuRecvCmdByte(uint8_t value) {
+    if (oled_emu.num_args_expect > oled_emu.num_args_recv) {
+        oled_emu.args[oled_emu.num_args_recv++] = value;
+    } else {
+        oled_emu.cmd = value;
+        oled_emu.num_args_recv = 0;
+        oled_emu.num_args_expect = utestOLEDemuNumCmdArgs(value);
+    }
+    if (oled_emu.num_args_expect == oled_emu.num_args_recv) {
+        utestOLEDemuExecCmd();
+        oled_emu.num_args_expect = oled_emu.num_args_recv = 0;
+    }
+}
+
+static void utestOLEDemuRecvDataByte(uint8_t value) {
+    uint8_t last_byte = (oled_emu.col == oled_emu.col_end) && (oled_emu.page == oled_emu.page_end);
+    oled_emu.gddram[oled_emu.page][oled_emu.col] = value;
+    switch (oled_emu.addr_mode) {
+    case 0: // horizontal, column first then page
+        if (oled_emu.col < oled_emu.col_end) {
+            oled_emu.col++;
+        } else {
+            oled_emu.col = oled_emu.col_start;
+            oled_emu.page = (oled_emu.page < oled_emu.page_end) ? (oled_emu.page + 1) : oled_emu.page_start;
+        }
+        break;
+    case 1: // vertical, page first then column
+        if (oled_emu.page < oled_emu.page_end) {
+            oled_emu.page++;
+        } else {
+            oled_emu.page = oled_emu.page_start;
+            oled_emu.col = (oled_emu.col < oled_emu.col_end) ? (oled_emu.col + 1) : oled_emu.col_start;
+        }
+        break;
+    default: // page addressing mode, column pointer wraps within current page
+        oled_emu.col = (oled_emu.col < (UTEST_OLED_EMU_WIDTH - 1)) ? (oled_emu.col + 1) : 0;
+        last_byte = (oled_emu.col == 0) && (oled_emu.page == (UTEST_OLED_EMU_NUM_PAGES - 1));
+        break;
+    }
+    if (last_byte) {
+        oled_emu_stats.num_frames++;
+        oled_emu_stats.t_last_frame_ns = utestOLEDemuNow();
+    }
+} // end of utestOLEDemuRecvDataByte
+
+gMonStatus UTestOLEDemuWritePin(void *pinstruct, uint8_t new_state) {
+    if (pinstruct == &oled_emu_pin_dc) {
+        oled_emu.dc_pin = new_state;
+    } else if (pinstruct == &oled_emu_pin_rst) {
+        if (new_state == GMON_PLATFORM_PIN_RESET)
+            utestOLEDemuResetRegisters();
+    }
+    return GMON_RESP_OK;
+}
+
+uint8_t UTestOLEDemuGetPixel(uint16_t x, uint16_t y) {
+    uint16_t col = 0, row = 0;
+    uint8_t  pixel = 0;
+    if (x >= UTEST_OLED_EMU_WIDTH || y >= UTEST_OLED_EMU_HEIGHT || !oled_emu.display_on)
+        return 0;
+    if (oled_emu.entire_on)
+        return 1;
+    // the display driver configures segment re-map (0xA1) and reverse COM scan (0xC8) together, which
+    // is regarded as upright orientation of the panel, so RAM column 0 / row 0 appears at top-left.
+    col = oled_emu.seg_remap ? x : (UTEST_OLED_EMU_WIDTH - 1 - x);
+    row = oled_emu.com_remap ? y : (UTEST_OLED_EMU_HEIGHT - 1 - y);
+    row = (row + oled_emu.start_line) % UTEST_OLED_EMU_HEIGHT;
+    pixel = (oled_emu.gddram[row >> 3][col] >> (row & 0x7)) & 0x1;
+    return pixel ^ oled_emu.inverse;
+}
+
+uint8_t UTestOLEDemuDisplayOn(void) { return oled_emu.display_on; }
+
+int UTestOLEDemuDumpPGM(const char *path) {
+    unsigned char line[UTEST_OLED_EMU_WIDTH];
+    uint16_t      x = 0, y = 0;
+    int           nwrite = 0;
+    FILE         *fp = fopen(path, "wb");
+    if (fp == NULL)
+        return -1;
+    nwrite = fprintf(fp, "P5\n%d %d\n255\n", UTEST_OLED_EMU_WIDTH, UTEST_OLED_EMU_HEIGHT);
+    for (y = 0; y < UTEST_OLED_EMU_HEIGHT && nwrite > 0; y++) {
+        for (x = 0; x < UTEST_OLED_EMU_WIDTH; x++)
+            line[x] = UTestOLEDemuGetPixel(x, y) ? 0xFF : 0x00;
+        if (fwrite(line, 1, UTEST_OLED_EMU_WIDTH, fp) != UTEST_OLED_EMU_WIDTH)
+            nwrite = -1;
+        else
+            nwrite += UTEST_OLED_EMU_WIDTH;
+    }
+    fclose(fp);
+    return nwrite;
+}
+
+void UTestOLEDemuBenchStart(void) {
+    XMEMSET(&oled_emu_stats, 0, sizeof(UTestOLEDemuStats_t));
+    oled_emu_stats.t_start_ns = utestOLEDemuNow();
+}
+
+const UTestOLEDemuStats_t *UTestOLEDemuGetStats(void) { return &oled_emu_stats; }
+
+double UTestOLEDemuBenchFPS(void) {
+    unsigned long long elapsed = oled_emu_stats.t_last_frame_ns - oled_emu_stats.t_start_ns;
+    if (oled_emu_stats.num_frames == 0 || oled_emu_stats.t_last_frame_ns <= oled_emu_stats.t_start_ns)
+        return 0.0;
+    return (double)oled_emu_stats.num_frames * 1e9 / (double)elapsed;
+}
+
+void UTestOLEDemuBenchReport(FILE *out, const char *label) {
+    const UTestOLEDemuStats_t *s = &oled_emu_stats;
+    unsigned int               frames = (s->num_frames == 0) ? 1 : s->num_frames;
+    fprintf(
+        out,
+        "[oled-bench] %s: frames=%u, transfers=%u, cmd_bytes=%u, data_bytes=%u, bytes/frame=%u, fps=%.1f\n",
+        label, s->num_frames, s->num_transfers, s->nbytes_cmd, s->nbytes_data,
+        (s->nbytes_cmd + s->nbytes_data) / frames, UTestOLEDemuBenchFPS()
+    );
+}
+
+// ---- platform functions used by display driver, backed by the emulator ----
+gMonStatus staDisplayPlatformInit(uint8_t comm_protocal_id, void **pinstruct) {
+    if (comm_protocal_id != GMON_PLATFORM_DISPLAY_SPI || pinstruct == NULL)
+        return GMON_RESP_ERRARGS;
+    *pinstruct = &oled_emu_pin_spi;
+    return GMON_RESP_OK;
+}
+
+gMonStatus staDisplayPlatformDeinit(void *pinstruct) {
+    return (pinstruct == &oled_emu_pin_spi) ? GMON_RESP_OK : GMON_RESP_ERRARGS;
+}
+
+void *staPlatformiGetDisplayRstPin(void) { return &oled_emu_pin_rst; }
+
+void *staPlatformiGetDisplayDataCmdPin(void) { return &oled_emu_pin_dc; }
+
+gMonStatus staPlatformSPItransmit(void *pinstruct, unsigned char *pData, unsigned short sz) {
+    unsigned short idx = 0;
+    if (pinstruct != &oled_emu_pin_spi || pData == NULL || sz == 0)
+        return GMON_RESP_ERRARGS;
+    oled_emu_stats.num_transfers++;
+    if (oled_emu.dc_pin == GMON_PLATFORM_PIN_RESET) {
+        oled_emu_stats.nbytes_cmd += sz;
+        for (idx = 0; idx < sz; idx++)
+            utestOLEDemuRecvCmdByte(pData[idx]);
+    } else {
+        oled_emu_stats.nbytes_data += sz;
+        for (idx = 0; idx < sz; idx++)
+            utestOLEDemuRecvDataByte(pData[idx]);
+    }
+    return GMON_RESP_OK;
+}
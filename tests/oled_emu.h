@@ -0,0 +1,39 @@
+#ifndef TEST_GMON_OLED_EMU_H
+#define TEST_GMON_OLED_EMU_H
+
+#include <stdio.h>
+#include "station_include.h"
+
+// Host-side emulator of SSD1315 OLED controller (SPI 4-wire mode), it decodes the command / data
+// stream sent by the display driver into GDDRAM, then the content can be examined pixel by pixel
+// or dumped as PGM image for golden tests.
+#define UTEST_OLED_EMU_WIDTH     128
+#define UTEST_OLED_EMU_HEIGHT    64
+#define UTEST_OLED_EMU_NUM_PAGES (UTEST_OLED_EMU_HEIGHT >> 3)
+
+typedef struct {
+    unsigned int       nbytes_cmd;    // bytes sent while D/C pin is low
+    unsigned int       nbytes_data;   // bytes written to GDDRAM
+    unsigned int       num_transfers; // number of SPI transactions
+    unsigned int       num_frames;    // number of times the last GDDRAM byte was written
+    unsigned long long t_start_ns;
+    unsigned long long t_last_frame_ns;
+} UTestOLEDemuStats_t;
+
+// power-on reset, clear GDDRAM, internal registers and statistics
+void       UTestOLEDemuReset(void);
+// called by mocked GPIO write function, track state of D/C pin and RST pin of the controller
+gMonStatus UTestOLEDemuWritePin(void *pinstruct, uint8_t new_state);
+// pixel as seen on the panel, segment / COM remap, inverse display and display ON/OFF applied
+uint8_t    UTestOLEDemuGetPixel(uint16_t x, uint16_t y);
+uint8_t    UTestOLEDemuDisplayOn(void);
+// write current panel image to binary PGM (P5) file, return number of bytes written, or -1 on error
+int        UTestOLEDemuDumpPGM(const char *path);
+
+// benchmark mode, reset all counters and start timing from now on
+void                       UTestOLEDemuBenchStart(void);
+const UTestOLEDemuStats_t *UTestOLEDemuGetStats(void);
+double                     UTestOLEDemuBenchFPS(void);
+void                       UTestOLEDemuBenchReport(FILE *out, const char *label);
+
+#endif // TEST_GMON_OLED_EMU_H
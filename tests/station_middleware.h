@@ -27,9 +27,13 @@ extern "C" {
 
 // Mock FreeRTOS-specific functions for host
 #define stationSysDelayMs(time_ms) (void)(time_ms)
+#define stationSysDelayUntilMs(prev_wake_ms, period_ms) UTestSysDelayUntilMs(prev_wake_ms, period_ms)
 #define stationSysEnterCritical()
 #define stationSysExitCritical()
 #define stationSysGetTickCount()  UTestSysGetTickCount()
+#define stationSysGetTaskStackFree(task) UTestSysGetTaskStackFree(task)
+#define stationSysGetHeapFree()          g_mock_heap_free
+#define stationSysGetHeapMinFree()       g_mock_heap_min_free
 #define configASSERT(x) assert(x)
 #define staSysMsgBoxCreate(length)  UTestSysMsgBoxCreate(length)
 #define staSysMsgBoxDelete(msgbuf)  UTestSysMsgBoxDelete(msgbuf)
@@ -65,6 +69,8 @@ typedef struct {
 } mock_msg_queue_t;
 
 extern uint32_t g_mock_tick_count;
+extern unsigned int g_mock_heap_free;
+extern unsigned int g_mock_heap_min_free;
 
 stationSysMsgbox_t UTestSysMsgBoxCreate(size_t length);
 void       UTestSysMsgBoxDelete(stationSysMsgbox_t *msgbuf_ptr);
@@ -72,7 +78,9 @@ gMonStatus UTestSysMsgBoxGet(stationSysMsgbox_t msgbuf, void **msg, uint32_t blo
 gMonStatus UTestSysMsgBoxPut(stationSysMsgbox_t msgbuf, void  *msg, uint32_t block_time);
 
 uint32_t UTestSysGetTickCount(void);
+unsigned int UTestSysGetTaskStackFree(stationSysTask_t task);
 void setMockTickCount(uint32_t count);
+gMonStatus UTestSysDelayUntilMs(unsigned int *prev_wake_ms, unsigned int period_ms);
 
 #ifdef __cplusplus
 }
@@ -11,6 +11,11 @@ extern "C" {
 #define GMON_PLATFORM_PIN_RESET 0
 #define GMON_PLATFORM_PIN_SET   1
 
+#define GMON_PLATFORM_DISPLAY_SPI 1
+
+// one signal pin for each air sensor, same as the STM32 board
+#define GMON_PLATFORM_NUM_AIR_SENSOR_PINS 3
+
 gMonStatus staSensorPlatformInitSoilMoist(gMonSensorMeta_t *);
 gMonStatus staSensorPlatformDeInitSoilMoist(gMonSensorMeta_t *);
 gMonStatus staPlatformReadSoilMoistSensor(gMonSensorMeta_t *, gmonSensorSample_t *) ;
@@ -21,10 +26,26 @@ gMonStatus staPlatformReadLightSensor(gMonSensorMeta_t *, gmonSensorSample_t *ou
 
 gMonStatus staSensorPlatformInitAirTemp(gMonSensorMeta_t *);
 gMonStatus staSensorPlatformDeInitAirTemp(gMonSensorMeta_t *);
-gMonStatus staPlatformMeasurePulse(void *pinstruct, uint8_t *direction, uint16_t *us);
+gMonStatus
+staPlatformCaptureEdges(void *pinstruct, uint16_t *edges_us, uint16_t num_edges, uint16_t timeout_ms);
+gMonStatus staPlatformCaptureEdgesMulti(
+    void **pinstructs, uint8_t num_pins, uint16_t *edges_us, uint16_t num_edges, uint16_t timeout_ms,
+    gMonStatus *pin_status
+);
+// edge capture is fed with recorded waveform of each pin, NULL pin clears all of them, see tests/mocks.c
+void UTestPlatformSetCapturedEdges(void *pinstruct, const uint16_t *edges_us, uint16_t num_edges);
+// `nth` capture on the pin after its edges are set times out without any edge
+void UTestPlatformFailCapture(void *pinstruct, unsigned char nth);
 gMonStatus staPlatformPinSetDirection(void *pinstruct, uint8_t direction);
 gMonStatus staPlatformWritePin(void *pinstruct, uint8_t new_state);
 
+// display platform functions are backed by OLED emulator, see tests/oled_emu.c
+gMonStatus staDisplayPlatformInit(uint8_t comm_protocal_id, void **pinstruct);
+gMonStatus staDisplayPlatformDeinit(void *pinstruct);
+gMonStatus staPlatformSPItransmit(void *pinstruct, unsigned char *pData, unsigned short sz);
+void      *staPlatformiGetDisplayRstPin(void);
+void      *staPlatformiGetDisplayDataCmdPin(void);
+
 gMonStatus stationSysDelayUs(unsigned short time_us);
 
 #ifdef __cplusplus
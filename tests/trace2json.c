@@ -0,0 +1,122 @@
+#include <stdlib.h>
+#include "station_include.h"
+
+// Convert trace rings dumped from stations (see station_trace.h) to Chrome trace JSON, which can be
+// opened in Perfetto UI or chrome://tracing. Each dump file becomes a process in the trace, tasks are
+// shown as its threads. Timestamps are unwrapped from 32-bit microseconds, end events whose begin events
+// have been overwritten in the ring are left out.
+//
+// Usage: trace2json.out <dump file> [more dump files ...] > trace.json
+
+// separator printed ahead of each trace event
+static const char *trace2json_sep = "\n";
+
+typedef struct {
+    unsigned char depth[GMON_TRACE_NUM_TASKS]; // number of open duration events in each task
+    uint64_t      ts_us;
+    uint32_t      prev_ts_us;
+    unsigned int  num_events;
+} trace2jsonState_t;
+
+static gMonTraceRing_t *trace2jsonLoad(const char *path) {
+    gMonTraceRing_t  hdr = {0};
+    gMonTraceRing_t *ring = NULL;
+    FILE            *fp = fopen(path, "rb");
+    long             nbytes = 0;
+    if (fp == NULL) {
+        fprintf(stderr, "[trace2json] failed to open %s\n", path);
+        return NULL;
+    }
+    fseek(fp, 0, SEEK_END);
+    nbytes = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    if (nbytes < (long)sizeof(gMonTraceRing_t) || fread(&hdr, sizeof(gMonTraceRing_t), 1, fp) != 1 ||
+        hdr.magic != GMON_TRACE_RING_MAGIC || hdr.version != GMON_TRACE_RING_VERSION ||
+        staTraceRingDumpSize(&hdr) > (unsigned long)nbytes) {
+        fprintf(stderr, "[trace2json] %s is not a trace ring of version %d\n", path, GMON_TRACE_RING_VERSION);
+        goto done;
+    }
+    ring = XMALLOC(staTraceRingDumpSize(&hdr));
+    XASSERT(ring != NULL);
+    fseek(fp, 0, SEEK_SET);
+    if (fread(ring, staTraceRingDumpSize(&hdr), 1, fp) != 1) {
+        fprintf(stderr, "[trace2json] failed to read %s\n", path);
+        XMEMFREE(ring);
+        ring = NULL;
+    }
+done:
+    fclose(fp);
+    return ring;
+}
+
+static void trace2jsonEmit(trace2jsonState_t *st, unsigned int pid, const gmonTraceEntry_t *entry) {
+    const char *name = staTraceEventName(entry->event_id);
+    char        phase = staTraceEventPhase(entry->event_id);
+    if (name == NULL || staTraceTaskName(entry->task_id) == NULL)
+        return;
+    // entries recorded by different tasks may be slightly out of order
+    st->ts_us += (int64_t)(int32_t)(entry->ts_us - st->prev_ts_us);
+    st->prev_ts_us = entry->ts_us;
+    if (phase == 'B') {
+        st->depth[entry->task_id]++;
+    } else if (phase == 'E') {
+        if (st->depth[entry->task_id] == 0)
+            return;
+        st->depth[entry->task_id]--;
+    }
+    printf(
+        "%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%llu,\"pid\":%u,\"tid\":%u,%s\"args\":{\"arg\":%d}}",
+        trace2json_sep, name, phase, (unsigned long long)st->ts_us, pid, entry->task_id,
+        (phase == 'i') ? "\"s\":\"t\"," : "", entry->arg
+    );
+    st->num_events++;
+}
+
+static gMonStatus trace2jsonConvert(const char *path, unsigned int pid) {
+    trace2jsonState_t st = {0};
+    gMonTraceRing_t  *ring = trace2jsonLoad(path);
+    gmonTraceEntry_t *entries = NULL;
+    unsigned int      num_entries = 0, idx = 0;
+    if (ring == NULL)
+        return GMON_RESP_ERR;
+    entries = XMALLOC(sizeof(gmonTraceEntry_t) * ring->capacity);
+    XASSERT(entries != NULL);
+    num_entries = staTraceRingSnapshot(ring, entries, ring->capacity);
+    printf(
+        "%s{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":0,\"args\":{\"name\":\"%s\"}}",
+        trace2json_sep, pid, path
+    );
+    trace2json_sep = ",\n";
+    for (idx = 1; idx < GMON_TRACE_NUM_TASKS; idx++) {
+        printf(
+            "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+            trace2json_sep, pid, idx, staTraceTaskName(idx)
+        );
+    }
+    if (num_entries > 0)
+        st.ts_us = st.prev_ts_us = entries[0].ts_us;
+    for (idx = 0; idx < num_entries; idx++)
+        trace2jsonEmit(&st, pid, &entries[idx]);
+    fprintf(
+        stderr, "[trace2json] %s: %u entries recorded, %u in the ring, %u events exported\n", path,
+        atomic_load(&ring->head), num_entries, st.num_events
+    );
+    XMEMFREE(entries);
+    XMEMFREE(ring);
+    return GMON_RESP_OK;
+}
+
+int main(int argc, char **argv) {
+    int ret = 0;
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <dump file> [more dump files ...] > trace.json\n", argv[0]);
+        return 1;
+    }
+    printf("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    for (int idx = 1; idx < argc; idx++) {
+        if (trace2jsonConvert(argv[idx], (unsigned int)idx) != GMON_RESP_OK)
+            ret = 1;
+    }
+    printf("\n]}\n");
+    return ret;
+}
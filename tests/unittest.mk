@@ -11,14 +11,21 @@ UNITY_SRC = \
 
 TEST_BUILD_DIR = $(BUILD_DIR_TOP)/utest
 
-TEST_SRC = tests/mocks.c tests/entry.c tests/app_msg/inbound.c tests/app_msg/outbound.c \
+TEST_SRC = tests/mocks.c tests/oled_emu.c tests/entry.c tests/app_msg/inbound.c tests/app_msg/outbound.c \
 		   tests/util_str_proc.c tests/IO/actuator.c tests/IO/sensor_event.c \
-		   tests/IO/display.c tests/IO/sensor_sample.c tests/IO/soilsensor.c \
-		   tests/util_stats.c
-
-APP_SRC = src/util.c src/app_msg/outbound.c src/app_msg/inbound.c src/app_msg/misc.c \
-		  src/IO/sensor_event.c src/IO/actuator.c src/IO/display.c src/IO/sensor_sample.c \
-		  src/IO/soilsensor.c src/IO/LDR.c src/IO/DHT11.c
+		   tests/IO/display.c tests/IO/oled_ssd1315.c tests/IO/sensor_sample.c tests/IO/soilsensor.c \
+		   tests/IO/sensor_sched.c tests/IO/dht11.c \
+		   tests/util_stats.c tests/util_trace.c tests/util_critsect.c tests/util_evt_latency.c \
+		   tests/util_prof_scope.c tests/util_arena.c \
+		   tests/network/backlog.c tests/network/backlog_file.c tests/network/pubwin.c tests/network/adaptive.c \
+		   tests/network/mqtt_fake.c tests/network/mqtt_client.c tests/network/netconn.c \
+		   src/netconn.c src/network/mqtt_client.c
+
+APP_SRC = src/util.c src/trace.c src/profile.c src/evt_latency.c src/app_msg/outbound.c \
+		  src/app_msg/misc.c src/IO/sensor_event.c src/IO/actuator.c src/IO/display.c src/IO/sensor_sample.c \
+		  src/IO/soilsensor.c src/IO/LDR.c src/IO/DHT11.c \
+		  src/IO/display/SSD1315_OLED.c src/IO/display/textfonts.c src/netconn_backlog.c src/netconn_pubwin.c \
+		  src/netconn_adaptive.c src/sensor_pipeline.c src/sensor_sched.c src/app_msg/inbound.c
 
 # All source files for the test executable
 ALL_TEST_SOURCES = $(APP_SRC) $(TEST_SRC) $(UNITY_SRC) $(JSMN_SRC)
@@ -30,9 +37,16 @@ TEST_OBJS = $(patsubst %.c, $(TEST_BUILD_DIR)/%.o, $(ALL_TEST_SOURCES))
 TEST_CFLAGS = -Wall -Wextra -std=c2x -g -O0
 TEST_CFLAGS += -I$(MONT_STATION_PROJ_HOME)/include
 TEST_CFLAGS += -I$(MONT_STATION_PROJ_HOME)/tests
+# host stand-in of mqtt-client library headers, implemented in tests/network/mqtt_fake.c
+TEST_CFLAGS += -I$(MONT_STATION_PROJ_HOME)/tests/network/mqtt_lib
 TEST_CFLAGS += -I$(UNITY_ROOT)/src -I$(UNITY_ROOT)/extras/fixture/src
 TEST_CFLAGS += -I$(JSMN_ROOT)
 TEST_CFLAGS += -DUNITY_EXCLUDE_SETJMP_H  -DUNITY_EXCLUDE_MATH_H  -DUNITY_FIXTURE_NO_EXTRAS
+TEST_CFLAGS += $(TEST_EXTRA_C_DEFS)
+
+# opt-in options of station_config.h turned on in `make test_opt`, the same unit tests are built with
+# them to another directory
+TEST_OPT_C_DEFS = -DGMON_CFG_MQTT_PIPELINED_PUBLISH -DGMON_CFG_APPMSG_SYS_HEALTH
 
 # Linker flags
 TEST_LDFLAGS = -lm
@@ -40,18 +54,74 @@ TEST_LDFLAGS = -lm
 # Target executable name
 TEST_EXE = $(TEST_BUILD_DIR)/utest.out
 
-.PHONY: test test_clean
+# end-to-end benchmark of network handler task against in-process MQTT broker stand-in
+NETBENCH_SRC = $(APP_SRC) src/netconn.c src/network/mqtt_client.c tests/mocks.c tests/oled_emu.c \
+			   tests/network/mqtt_fake.c tests/network/backlog_file.c tests/network/netbench.c
+
+NETBENCH_OBJS = $(patsubst %.c, $(TEST_BUILD_DIR)/%.o, $(NETBENCH_SRC))
+
+NETBENCH_EXE = $(TEST_BUILD_DIR)/netbench.out
+
+# many independent stations generating outbound payloads on a pool of host threads
+FLEETSIM_SRC = $(APP_SRC) tests/mocks.c tests/oled_emu.c tests/network/fleetsim.c
+
+FLEETSIM_OBJS = $(patsubst %.c, $(TEST_BUILD_DIR)/%.o, $(FLEETSIM_SRC))
+
+FLEETSIM_EXE = $(TEST_BUILD_DIR)/fleetsim.out
+
+# convert trace rings dumped from stations to Chrome trace JSON
+TRACE2JSON_SRC = $(APP_SRC) tests/mocks.c tests/oled_emu.c tests/trace2json.c
+
+TRACE2JSON_OBJS = $(patsubst %.c, $(TEST_BUILD_DIR)/%.o, $(TRACE2JSON_SRC))
+
+TRACE2JSON_EXE = $(TEST_BUILD_DIR)/trace2json.out
+
+TRACE_DUMP ?= $(BUILD_DIR_TOP)/trace.bin
+TRACE_JSON ?= $(BUILD_DIR_TOP)/trace.json
+
+.PHONY: test test_opt test_clean netbench fleetsim trace2json
 
 # Test build rule
 test: $(TEST_BUILD_DIR) $(TEST_EXE)
 	@echo "Running unit tests..."
 	@$(TEST_EXE)
 
+test_opt:
+	@$(MAKE) --no-print-directory test TEST_BUILD_DIR=$(BUILD_DIR_TOP)/utest_opt \
+		TEST_EXTRA_C_DEFS="$(TEST_OPT_C_DEFS)"
+
 $(TEST_EXE): $(TEST_OBJS)
 	@mkdir -p $(@D)
 	@$(CC) $(TEST_OBJS) -o $@ $(TEST_LDFLAGS)
 	@echo "Unit test executable built: $@"
 
+netbench: $(TEST_BUILD_DIR) $(NETBENCH_EXE)
+	@echo "Running network benchmark..."
+	@$(NETBENCH_EXE)
+
+$(NETBENCH_EXE): $(NETBENCH_OBJS)
+	@mkdir -p $(@D)
+	@$(CC) $(NETBENCH_OBJS) -o $@ $(TEST_LDFLAGS)
+	@echo "Network benchmark executable built: $@"
+
+fleetsim: $(TEST_BUILD_DIR) $(FLEETSIM_EXE)
+	@echo "Running fleet simulator..."
+	@$(FLEETSIM_EXE)
+
+$(FLEETSIM_EXE): $(FLEETSIM_OBJS)
+	@mkdir -p $(@D)
+	@$(CC) $(FLEETSIM_OBJS) -o $@ $(TEST_LDFLAGS) -pthread
+	@echo "Fleet simulator executable built: $@"
+
+trace2json: $(TEST_BUILD_DIR) $(TRACE2JSON_EXE)
+	@$(TRACE2JSON_EXE) $(TRACE_DUMP) > $(TRACE_JSON)
+	@echo "Chrome trace written: $(TRACE_JSON)"
+
+$(TRACE2JSON_EXE): $(TRACE2JSON_OBJS)
+	@mkdir -p $(@D)
+	@$(CC) $(TRACE2JSON_OBJS) -o $@ $(TEST_LDFLAGS)
+	@echo "Trace converter executable built: $@"
+
 $(TEST_BUILD_DIR)/%.o: %.c
 	@mkdir -p $(dir $@)
 	@$(CC) $(TEST_CFLAGS) -c $< -o $@
@@ -63,4 +133,4 @@ $(TEST_BUILD_DIR):
 # Clean rules
 test_clean:
 	@echo "Cleaning unit test build artifacts..."
-	@$(RM) -r $(TEST_BUILD_DIR)
+	@$(RM) -r $(TEST_BUILD_DIR) $(BUILD_DIR_TOP)/utest_opt
@@ -0,0 +1,72 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "station_include.h"
+
+#define UTEST_ARENA_NBYTES 64
+
+static uint64_t    utest_arena_mem[UTEST_ARENA_NBYTES >> 3];
+static gMonArena_t utest_arena;
+
+TEST_GROUP(InitArena);
+
+TEST_SETUP(InitArena) {
+    XMEMSET(utest_arena_mem, 0xa5, sizeof(utest_arena_mem));
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staArenaInit(&utest_arena, utest_arena_mem, sizeof(utest_arena_mem)));
+}
+
+TEST_TEAR_DOWN(InitArena) { XMEMSET(&utest_arena, 0x00, sizeof(gMonArena_t)); }
+
+TEST(InitArena, AllocInOrder) {
+    unsigned char *p0 = NULL, *p1 = NULL, *p2 = NULL;
+    p0 = staArenaCalloc(&utest_arena, 3, sizeof(char));
+    p1 = staArenaCalloc(&utest_arena, 2, sizeof(uint32_t));
+    TEST_ASSERT_EQUAL_PTR(utest_arena_mem, p0);
+    // every object is aligned, padding is counted as used
+    TEST_ASSERT_EQUAL_PTR(&utest_arena_mem[1], p1);
+    TEST_ASSERT_EQUAL(GMON_ARENA_ALIGN + 2 * sizeof(uint32_t), utest_arena.used);
+    for (unsigned int idx = 0; idx < 3; idx++)
+        TEST_ASSERT_EQUAL(0, p0[idx]);
+    for (unsigned int idx = 0; idx < 2 * sizeof(uint32_t); idx++)
+        TEST_ASSERT_EQUAL(0, p1[idx]);
+    // exhausted, the objects allocated so far are kept
+    TEST_ASSERT_NULL(staArenaCalloc(&utest_arena, 1, UTEST_ARENA_NBYTES - utest_arena.used + 1));
+    TEST_ASSERT_EQUAL(GMON_ARENA_ALIGN + 2 * sizeof(uint32_t), utest_arena.used);
+    p2 = staArenaCalloc(&utest_arena, 1, UTEST_ARENA_NBYTES - utest_arena.used);
+    TEST_ASSERT_EQUAL_PTR(&utest_arena_mem[2], p2);
+    TEST_ASSERT_EQUAL(UTEST_ARENA_NBYTES, utest_arena.used);
+    TEST_ASSERT_NULL(staArenaCalloc(&utest_arena, 1, 1));
+    TEST_ASSERT_NULL(staArenaCalloc(&utest_arena, 0, 4));
+    TEST_ASSERT_NULL(staArenaCalloc(&utest_arena, 0x10000, 0x10000));
+    TEST_ASSERT_NULL(staArenaCalloc(NULL, 1, 4));
+    // released all at once
+    staArenaFree(&utest_arena, p1);
+    TEST_ASSERT_EQUAL(UTEST_ARENA_NBYTES, utest_arena.used);
+    staArenaReset(&utest_arena);
+    TEST_ASSERT_EQUAL(0, utest_arena.used);
+    TEST_ASSERT_EQUAL_PTR(p0, staArenaCalloc(&utest_arena, 1, 1));
+}
+
+TEST(InitArena, FallbackToHeap) {
+    gMonArena_t    no_region = {0};
+    unsigned char *p0 = staArenaCalloc(&no_region, 4, sizeof(uint32_t));
+    TEST_ASSERT_NOT_NULL(p0);
+    TEST_ASSERT_EQUAL(0, no_region.used);
+    for (unsigned int idx = 0; idx < 4 * sizeof(uint32_t); idx++)
+        TEST_ASSERT_EQUAL(0, p0[idx]);
+    staArenaFree(&no_region, p0);
+    // memory out of the region returns to heap
+    p0 = staArenaCalloc(&no_region, 1, 8);
+    staArenaFree(&utest_arena, p0);
+    staArenaFree(&utest_arena, NULL);
+    TEST_ASSERT_EQUAL(0, utest_arena.used);
+    TEST_ASSERT_EQUAL(GMON_RESP_ERRARGS, staArenaInit(NULL, utest_arena_mem, sizeof(utest_arena_mem)));
+    TEST_ASSERT_EQUAL(GMON_RESP_ERRARGS, staArenaInit(&no_region, NULL, sizeof(utest_arena_mem)));
+    // region not aligned
+    unsigned char *unaligned = (unsigned char *)utest_arena_mem + 1;
+    TEST_ASSERT_EQUAL(GMON_RESP_ERRARGS, staArenaInit(&no_region, unaligned, UTEST_ARENA_NBYTES - 1));
+}
+
+TEST_GROUP_RUNNER(gMonInitArena) {
+    RUN_TEST_CASE(InitArena, AllocInOrder);
+    RUN_TEST_CASE(InitArena, FallbackToHeap);
+}
@@ -0,0 +1,120 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "station_include.h"
+
+#define UTEST_CRITSECT_NUM_SITES 3
+
+// without cycle counter in mock middleware, 1 tick is counted as 1000 cycles (1 cycle per microsecond)
+#define UTEST_CRITSECT_TICK_NS (GMON_NUM_MILLISECONDS_PER_TICK * 1000000)
+
+static gMonProfSite_t utest_critsect_sites[UTEST_CRITSECT_NUM_SITES] = {
+    {.func = "utestSiteOuter", .line = 10},
+    {.func = "utestSiteInner", .line = 20},
+    {.func = "utestSiteIdle", .line = 30},
+};
+
+static gMonProfStat_t utest_critsect_stats[UTEST_CRITSECT_NUM_SITES + 2];
+
+static void utestCritSectRun(gMonProfSite_t *site, uint32_t num_ticks) {
+    staCritSectProfEnter(site);
+    setMockTickCount(g_mock_tick_count + num_ticks);
+    staCritSectProfExit();
+}
+
+TEST_GROUP(CritSectProf);
+
+TEST_SETUP(CritSectProf) {
+    setMockTickCount(0);
+    staCritSectProfReset();
+}
+
+TEST_TEAR_DOWN(CritSectProf) {
+    setMockTickCount(0);
+    staCritSectProfReset();
+}
+
+TEST(CritSectProf, MaxAvgCount) {
+    unsigned int num_sites = 0;
+    utestCritSectRun(&utest_critsect_sites[0], 3);
+    utestCritSectRun(&utest_critsect_sites[0], 7);
+    utestCritSectRun(&utest_critsect_sites[0], 2);
+    TEST_ASSERT_EQUAL(1, utest_critsect_sites[0].registered);
+    num_sites = staCritSectProfReport(utest_critsect_stats, UTEST_CRITSECT_NUM_SITES);
+    TEST_ASSERT_EQUAL(1, num_sites);
+    TEST_ASSERT_EQUAL_STRING("utestSiteOuter", utest_critsect_stats[0].func);
+    TEST_ASSERT_EQUAL(10, utest_critsect_stats[0].line);
+    TEST_ASSERT_EQUAL(3, utest_critsect_stats[0].count);
+    TEST_ASSERT_EQUAL(7 * UTEST_CRITSECT_TICK_NS, utest_critsect_stats[0].max_ns);
+    TEST_ASSERT_EQUAL(4 * UTEST_CRITSECT_TICK_NS, utest_critsect_stats[0].avg_ns);
+    // counter wraps around within the critical section
+    staCritSectProfReset();
+    setMockTickCount(0xffffffff / (GMON_NUM_MILLISECONDS_PER_TICK * 1000));
+    utestCritSectRun(&utest_critsect_sites[0], 5);
+    num_sites = staCritSectProfReport(utest_critsect_stats, UTEST_CRITSECT_NUM_SITES);
+    TEST_ASSERT_EQUAL(1, num_sites);
+    TEST_ASSERT_EQUAL(5 * UTEST_CRITSECT_TICK_NS, utest_critsect_stats[0].max_ns);
+}
+
+TEST(CritSectProf, Nested) {
+    unsigned int num_sites = 0;
+    staCritSectProfEnter(&utest_critsect_sites[0]);
+    setMockTickCount(g_mock_tick_count + 1);
+    utestCritSectRun(&utest_critsect_sites[1], 2);
+    utestCritSectRun(&utest_critsect_sites[1], 4);
+    setMockTickCount(g_mock_tick_count + 3);
+    staCritSectProfExit();
+    num_sites = staCritSectProfReport(utest_critsect_stats, UTEST_CRITSECT_NUM_SITES);
+    TEST_ASSERT_EQUAL(2, num_sites);
+    // outer one includes time spent in inner ones
+    TEST_ASSERT_EQUAL_STRING("utestSiteOuter", utest_critsect_stats[0].func);
+    TEST_ASSERT_EQUAL(1, utest_critsect_stats[0].count);
+    TEST_ASSERT_EQUAL(10 * UTEST_CRITSECT_TICK_NS, utest_critsect_stats[0].max_ns);
+    TEST_ASSERT_EQUAL_STRING("utestSiteInner", utest_critsect_stats[1].func);
+    TEST_ASSERT_EQUAL(2, utest_critsect_stats[1].count);
+    TEST_ASSERT_EQUAL(4 * UTEST_CRITSECT_TICK_NS, utest_critsect_stats[1].max_ns);
+    TEST_ASSERT_EQUAL(3 * UTEST_CRITSECT_TICK_NS, utest_critsect_stats[1].avg_ns);
+    // too deep to be recorded, but still balanced
+    staCritSectProfReset();
+    for (unsigned int idx = 0; idx <= GMON_CRITSECT_PROF_MAX_NESTING; idx++)
+        staCritSectProfEnter(&utest_critsect_sites[idx == GMON_CRITSECT_PROF_MAX_NESTING ? 2 : 1]);
+    setMockTickCount(g_mock_tick_count + 1);
+    for (unsigned int idx = 0; idx <= GMON_CRITSECT_PROF_MAX_NESTING; idx++)
+        staCritSectProfExit();
+    TEST_ASSERT_EQUAL(0, utest_critsect_sites[2].count);
+    TEST_ASSERT_EQUAL(GMON_CRITSECT_PROF_MAX_NESTING, utest_critsect_sites[1].count);
+    // unbalanced exit is ignored
+    staCritSectProfExit();
+    utestCritSectRun(&utest_critsect_sites[0], 1);
+    TEST_ASSERT_EQUAL(1, utest_critsect_sites[0].count);
+}
+
+TEST(CritSectProf, ReportLongestFirst) {
+    unsigned int num_sites = 0;
+    utestCritSectRun(&utest_critsect_sites[2], 1);
+    utestCritSectRun(&utest_critsect_sites[0], 6);
+    utestCritSectRun(&utest_critsect_sites[1], 9);
+    num_sites = staCritSectProfReport(utest_critsect_stats, UTEST_CRITSECT_NUM_SITES + 2);
+    TEST_ASSERT_EQUAL(3, num_sites);
+    TEST_ASSERT_EQUAL(9 * UTEST_CRITSECT_TICK_NS, utest_critsect_stats[0].max_ns);
+    TEST_ASSERT_EQUAL(6 * UTEST_CRITSECT_TICK_NS, utest_critsect_stats[1].max_ns);
+    TEST_ASSERT_EQUAL(1 * UTEST_CRITSECT_TICK_NS, utest_critsect_stats[2].max_ns);
+    // only the longest ones are taken if caller provides fewer slots
+    num_sites = staCritSectProfReport(utest_critsect_stats, 2);
+    TEST_ASSERT_EQUAL(2, num_sites);
+    TEST_ASSERT_EQUAL_STRING("utestSiteInner", utest_critsect_stats[0].func);
+    TEST_ASSERT_EQUAL_STRING("utestSiteOuter", utest_critsect_stats[1].func);
+    TEST_ASSERT_EQUAL(0, staCritSectProfReport(NULL, 2));
+    TEST_ASSERT_EQUAL(0, staCritSectProfReport(utest_critsect_stats, 0));
+    // sites not entered since reset are left out
+    staCritSectProfReset();
+    utestCritSectRun(&utest_critsect_sites[2], 2);
+    num_sites = staCritSectProfReport(utest_critsect_stats, UTEST_CRITSECT_NUM_SITES);
+    TEST_ASSERT_EQUAL(1, num_sites);
+    TEST_ASSERT_EQUAL_STRING("utestSiteIdle", utest_critsect_stats[0].func);
+}
+
+TEST_GROUP_RUNNER(gMonCritSectProf) {
+    RUN_TEST_CASE(CritSectProf, MaxAvgCount);
+    RUN_TEST_CASE(CritSectProf, Nested);
+    RUN_TEST_CASE(CritSectProf, ReportLongestFirst);
+}
@@ -0,0 +1,105 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "station_include.h"
+
+static gMonEvtLatencyHist_t utest_latency_hist;
+static gMonEvtLatencyStat_t utest_latency_stat;
+
+TEST_GROUP(EvtLatency);
+
+TEST_SETUP(EvtLatency) {
+    setMockTickCount(0);
+    XMEMSET(&utest_latency_hist, 0x00, sizeof(gMonEvtLatencyHist_t));
+}
+
+TEST_TEAR_DOWN(EvtLatency) { setMockTickCount(0); }
+
+TEST(EvtLatency, Log2Buckets) {
+    unsigned short *counts = utest_latency_hist.counts[GMON_EVT_STAGE_LOGGED];
+    staEvtLatencyAdd(&utest_latency_hist, GMON_EVT_STAGE_LOGGED, 0);
+    staEvtLatencyAdd(&utest_latency_hist, GMON_EVT_STAGE_LOGGED, 1);
+    staEvtLatencyAdd(&utest_latency_hist, GMON_EVT_STAGE_LOGGED, 2);
+    staEvtLatencyAdd(&utest_latency_hist, GMON_EVT_STAGE_LOGGED, 3);
+    staEvtLatencyAdd(&utest_latency_hist, GMON_EVT_STAGE_LOGGED, 1023);
+    staEvtLatencyAdd(&utest_latency_hist, GMON_EVT_STAGE_LOGGED, 1024);
+    TEST_ASSERT_EQUAL(1, counts[0]);
+    TEST_ASSERT_EQUAL(1, counts[1]);
+    TEST_ASSERT_EQUAL(2, counts[2]);
+    TEST_ASSERT_EQUAL(1, counts[10]);
+    TEST_ASSERT_EQUAL(1, counts[11]);
+    TEST_ASSERT_EQUAL(1024, utest_latency_hist.max_ms[GMON_EVT_STAGE_LOGGED]);
+    // the last bucket counts anything longer
+    staEvtLatencyAdd(&utest_latency_hist, GMON_EVT_STAGE_LOGGED, 0xffffffff);
+    TEST_ASSERT_EQUAL(1, counts[GMON_EVT_LATENCY_NUM_BUCKETS - 1]);
+    // saturated count
+    counts[0] = 0xffff;
+    staEvtLatencyAdd(&utest_latency_hist, GMON_EVT_STAGE_LOGGED, 0);
+    TEST_ASSERT_EQUAL(0xffff, counts[0]);
+    TEST_ASSERT_EQUAL(0, utest_latency_hist.counts[GMON_EVT_STAGE_DETECT][0]);
+}
+
+TEST(EvtLatency, Summary) {
+    unsigned int latency_ms[5] = {5, 40, 70, 90, 3000};
+    for (unsigned int idx = 0; idx < 5; idx++)
+        staEvtLatencyAdd(&utest_latency_hist, GMON_EVT_STAGE_SERIALIZED, latency_ms[idx]);
+    staEvtLatencyAdd(&utest_latency_hist, GMON_EVT_STAGE_ACKED, 6);
+    staEvtLatencySummary(&utest_latency_hist, &utest_latency_stat);
+    TEST_ASSERT_EQUAL(5, utest_latency_stat.num_events);
+    // median 70 ms falls in bucket [64, 128)
+    TEST_ASSERT_EQUAL(128, utest_latency_stat.p50_ms[GMON_EVT_STAGE_SERIALIZED]);
+    TEST_ASSERT_EQUAL(3000, utest_latency_stat.max_ms[GMON_EVT_STAGE_SERIALIZED]);
+    // upper bound of the bucket is limited to the maximum
+    TEST_ASSERT_EQUAL(6, utest_latency_stat.p50_ms[GMON_EVT_STAGE_ACKED]);
+    TEST_ASSERT_EQUAL(6, utest_latency_stat.max_ms[GMON_EVT_STAGE_ACKED]);
+    // empty histogram
+    TEST_ASSERT_EQUAL(0, utest_latency_stat.p50_ms[GMON_EVT_STAGE_DETECT]);
+    TEST_ASSERT_EQUAL(0, utest_latency_stat.max_ms[GMON_EVT_STAGE_DETECT]);
+}
+
+#ifdef GMON_CFG_ENABLE_EVENT_LATENCY
+TEST(EvtLatency, StampStages) {
+    gmonEvent_t evt = {0};
+    staEvtLatencyBegin(&evt, 100, 104);
+    TEST_ASSERT_EQUAL(100, evt.acquired_ms);
+    TEST_ASSERT_EQUAL(4, evt.stage_ms[GMON_EVT_STAGE_DETECT]);
+    setMockTickCount(110 / GMON_NUM_MILLISECONDS_PER_TICK);
+    staEvtLatencyStamp(&evt, GMON_EVT_STAGE_AGGREGATE);
+    TEST_ASSERT_EQUAL(10, evt.stage_ms[GMON_EVT_STAGE_AGGREGATE]);
+    // saturated
+    setMockTickCount((100 + 0x10000) / GMON_NUM_MILLISECONDS_PER_TICK);
+    staEvtLatencyStamp(&evt, GMON_EVT_STAGE_LOGGED);
+    TEST_ASSERT_EQUAL(0xffff, evt.stage_ms[GMON_EVT_STAGE_LOGGED]);
+}
+
+TEST(EvtLatency, AckOldestEvent) {
+    gMonEvtLatency_t   lat = {0};
+    gmonEvent_t        evts[2] = {{.acquired_ms = 500}, {.acquired_ms = 300}};
+    gmonEvent_t       *refs[3] = {&evts[0], NULL, &evts[1]};
+    gmonSensorRecord_t rec = {.events = refs, .num_refs = 3};
+    staEvtLatencyOnSerialized(&lat, GMON_APPMSG_ITEM_LIGHT, &rec, 800);
+    TEST_ASSERT_EQUAL(300, lat.oldest_unacked_ms[GMON_APPMSG_ITEM_LIGHT]);
+    TEST_ASSERT_EQUAL(500, lat.hist[GMON_APPMSG_ITEM_LIGHT].max_ms[GMON_EVT_STAGE_SERIALIZED]);
+    // the events serialized later are not older than the first one waiting for acknowledgement
+    evts[1].acquired_ms = 900;
+    staEvtLatencyOnSerialized(&lat, GMON_APPMSG_ITEM_LIGHT, &rec, 1000);
+    TEST_ASSERT_EQUAL(300, lat.oldest_unacked_ms[GMON_APPMSG_ITEM_LIGHT]);
+    staEvtLatencyReset(&lat);
+    staEvtLatencyOnAcked(&lat, 1300);
+    staEvtLatencyOnAcked(&lat, 1400);
+    staEvtLatencySummary(&lat.hist[GMON_APPMSG_ITEM_LIGHT], &utest_latency_stat);
+    TEST_ASSERT_EQUAL(0, utest_latency_stat.num_events);
+    TEST_ASSERT_EQUAL(1000, utest_latency_stat.max_ms[GMON_EVT_STAGE_ACKED]);
+    TEST_ASSERT_EQUAL(1, lat.hist[GMON_APPMSG_ITEM_LIGHT].counts[GMON_EVT_STAGE_ACKED][10]);
+    TEST_ASSERT_EQUAL(0, lat.hist[GMON_APPMSG_ITEM_SOILMOIST].max_ms[GMON_EVT_STAGE_ACKED]);
+    TEST_ASSERT_EQUAL(0, lat.unacked);
+}
+#endif // end of GMON_CFG_ENABLE_EVENT_LATENCY
+
+TEST_GROUP_RUNNER(gMonEvtLatency) {
+    RUN_TEST_CASE(EvtLatency, Log2Buckets);
+    RUN_TEST_CASE(EvtLatency, Summary);
+#ifdef GMON_CFG_ENABLE_EVENT_LATENCY
+    RUN_TEST_CASE(EvtLatency, StampStages);
+    RUN_TEST_CASE(EvtLatency, AckOldestEvent);
+#endif
+}
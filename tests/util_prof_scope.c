@@ -0,0 +1,140 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "station_include.h"
+
+#define UTEST_PROF_SCOPE_NUM_SITES 3
+
+// without cycle counter in mock middleware, 1 tick is counted as 1000 cycles (1 cycle per microsecond)
+#define UTEST_PROF_SCOPE_TICK_NS (GMON_NUM_MILLISECONDS_PER_TICK * 1000000)
+
+static gMonProfSite_t utest_prof_scope_sites[UTEST_PROF_SCOPE_NUM_SITES] = {
+    {.func = "utestFuncOuter", .line = 10},
+    {.func = "utestFuncInner", .line = 20},
+    {.func = "utestFuncIdle", .line = 30},
+};
+
+static gMonProfStat_t utest_prof_scope_stats[UTEST_PROF_SCOPE_NUM_SITES];
+
+static void utestProfScopeRun(gMonProfSite_t *site, uint32_t num_ticks) {
+    gMonProfScope_t scope = staProfScopeBegin(site);
+    setMockTickCount(g_mock_tick_count + num_ticks);
+    staProfScopeEnd(&scope);
+}
+
+#ifdef GMON_CFG_ENABLE_PROF_SCOPE
+static int utestProfScopeMarked(uint32_t num_ticks) {
+    GMON_PROF_SCOPE();
+    setMockTickCount(g_mock_tick_count + num_ticks);
+    if (num_ticks > 4)
+        return -1;
+    return 0;
+}
+#endif
+
+TEST_GROUP(ProfScope);
+
+TEST_SETUP(ProfScope) {
+    setMockTickCount(0);
+    staProfScopeReset();
+}
+
+TEST_TEAR_DOWN(ProfScope) {
+    setMockTickCount(0);
+    staProfScopeReset();
+}
+
+TEST(ProfScope, MaxAvgCount) {
+    unsigned int num_sites = 0;
+    TEST_ASSERT_EQUAL(0, staProfScopeReport(utest_prof_scope_stats, UTEST_PROF_SCOPE_NUM_SITES));
+    utestProfScopeRun(&utest_prof_scope_sites[0], 5);
+    utestProfScopeRun(&utest_prof_scope_sites[0], 1);
+    utestProfScopeRun(&utest_prof_scope_sites[0], 3);
+    TEST_ASSERT_EQUAL(1, utest_prof_scope_sites[0].registered);
+    TEST_ASSERT_EQUAL_PTR(&utest_prof_scope_sites[0], gmon_prof_scope_sites);
+    num_sites = staProfScopeReport(utest_prof_scope_stats, UTEST_PROF_SCOPE_NUM_SITES);
+    TEST_ASSERT_EQUAL(1, num_sites);
+    TEST_ASSERT_EQUAL_STRING("utestFuncOuter", utest_prof_scope_stats[0].func);
+    TEST_ASSERT_EQUAL(10, utest_prof_scope_stats[0].line);
+    TEST_ASSERT_EQUAL(3, utest_prof_scope_stats[0].count);
+    TEST_ASSERT_EQUAL(5 * UTEST_PROF_SCOPE_TICK_NS, utest_prof_scope_stats[0].max_ns);
+    TEST_ASSERT_EQUAL(3 * UTEST_PROF_SCOPE_TICK_NS, utest_prof_scope_stats[0].avg_ns);
+    // registered only once
+    utestProfScopeRun(&utest_prof_scope_sites[0], 1);
+    TEST_ASSERT_EQUAL_PTR(&utest_prof_scope_sites[0], gmon_prof_scope_sites);
+    TEST_ASSERT_EQUAL(4, utest_prof_scope_sites[0].count);
+    // counter wraps around within the scope
+    staProfScopeReset();
+    setMockTickCount(0xffffffff / (GMON_NUM_MILLISECONDS_PER_TICK * 1000));
+    utestProfScopeRun(&utest_prof_scope_sites[0], 2);
+    num_sites = staProfScopeReport(utest_prof_scope_stats, UTEST_PROF_SCOPE_NUM_SITES);
+    TEST_ASSERT_EQUAL(1, num_sites);
+    TEST_ASSERT_EQUAL(1, utest_prof_scope_stats[0].count);
+    TEST_ASSERT_EQUAL(2 * UTEST_PROF_SCOPE_TICK_NS, utest_prof_scope_stats[0].max_ns);
+}
+
+TEST(ProfScope, NestedLongestFirst) {
+    unsigned int    num_sites = 0;
+    gMonProfScope_t outer = staProfScopeBegin(&utest_prof_scope_sites[0]);
+    utestProfScopeRun(&utest_prof_scope_sites[1], 2);
+    utestProfScopeRun(&utest_prof_scope_sites[1], 6);
+    setMockTickCount(g_mock_tick_count + 1);
+    staProfScopeEnd(&outer);
+    utestProfScopeRun(&utest_prof_scope_sites[2], 1);
+    num_sites = staProfScopeReport(utest_prof_scope_stats, UTEST_PROF_SCOPE_NUM_SITES);
+    TEST_ASSERT_EQUAL(3, num_sites);
+    // outer one includes time spent in inner ones
+    TEST_ASSERT_EQUAL_STRING("utestFuncOuter", utest_prof_scope_stats[0].func);
+    TEST_ASSERT_EQUAL(9 * UTEST_PROF_SCOPE_TICK_NS, utest_prof_scope_stats[0].max_ns);
+    TEST_ASSERT_EQUAL_STRING("utestFuncInner", utest_prof_scope_stats[1].func);
+    TEST_ASSERT_EQUAL(2, utest_prof_scope_stats[1].count);
+    TEST_ASSERT_EQUAL(6 * UTEST_PROF_SCOPE_TICK_NS, utest_prof_scope_stats[1].max_ns);
+    TEST_ASSERT_EQUAL(4 * UTEST_PROF_SCOPE_TICK_NS, utest_prof_scope_stats[1].avg_ns);
+    TEST_ASSERT_EQUAL_STRING("utestFuncIdle", utest_prof_scope_stats[2].func);
+    // only the longest ones are taken if caller provides fewer slots
+    TEST_ASSERT_EQUAL(1, staProfScopeReport(utest_prof_scope_stats, 1));
+    TEST_ASSERT_EQUAL_STRING("utestFuncOuter", utest_prof_scope_stats[0].func);
+    TEST_ASSERT_EQUAL(0, staProfScopeReport(NULL, 1));
+    // functions not called since reset are left out
+    staProfScopeReset();
+    utestProfScopeRun(&utest_prof_scope_sites[1], 1);
+    num_sites = staProfScopeReport(utest_prof_scope_stats, UTEST_PROF_SCOPE_NUM_SITES);
+    TEST_ASSERT_EQUAL(1, num_sites);
+    TEST_ASSERT_EQUAL_STRING("utestFuncInner", utest_prof_scope_stats[0].func);
+}
+
+// total cycles exceed 32 bits, carried to upper half
+TEST(ProfScope, TotalCyclesCarry) {
+    const uint32_t num_ticks = 4000 / GMON_NUM_MILLISECONDS_PER_TICK;
+    unsigned int   idx = 0;
+    for (idx = 0; idx < 1100; idx++)
+        utestProfScopeRun(&utest_prof_scope_sites[2], num_ticks);
+    TEST_ASSERT_EQUAL(1, atomic_load(&utest_prof_scope_sites[2].total_cycles_hi));
+    TEST_ASSERT_EQUAL(1, staProfScopeReport(utest_prof_scope_stats, UTEST_PROF_SCOPE_NUM_SITES));
+    TEST_ASSERT_EQUAL(1100, utest_prof_scope_stats[0].count);
+    TEST_ASSERT_EQUAL(num_ticks * UTEST_PROF_SCOPE_TICK_NS, utest_prof_scope_stats[0].max_ns);
+    TEST_ASSERT_EQUAL(num_ticks * UTEST_PROF_SCOPE_TICK_NS, utest_prof_scope_stats[0].avg_ns);
+}
+
+#ifdef GMON_CFG_ENABLE_PROF_SCOPE
+TEST(ProfScope, MarkedFunction) {
+    unsigned int num_sites = 0;
+    TEST_ASSERT_EQUAL(0, utestProfScopeMarked(3));
+    // scope ends at any return statement
+    TEST_ASSERT_EQUAL(-1, utestProfScopeMarked(7));
+    num_sites = staProfScopeReport(utest_prof_scope_stats, UTEST_PROF_SCOPE_NUM_SITES);
+    TEST_ASSERT_EQUAL(1, num_sites);
+    TEST_ASSERT_EQUAL_STRING("utestProfScopeMarked", utest_prof_scope_stats[0].func);
+    TEST_ASSERT_EQUAL(2, utest_prof_scope_stats[0].count);
+    TEST_ASSERT_EQUAL(7 * UTEST_PROF_SCOPE_TICK_NS, utest_prof_scope_stats[0].max_ns);
+    TEST_ASSERT_EQUAL(5 * UTEST_PROF_SCOPE_TICK_NS, utest_prof_scope_stats[0].avg_ns);
+}
+#endif // end of GMON_CFG_ENABLE_PROF_SCOPE
+
+TEST_GROUP_RUNNER(gMonProfScope) {
+    RUN_TEST_CASE(ProfScope, MaxAvgCount);
+    RUN_TEST_CASE(ProfScope, NestedLongestFirst);
+    RUN_TEST_CASE(ProfScope, TotalCyclesCarry);
+#ifdef GMON_CFG_ENABLE_PROF_SCOPE
+    RUN_TEST_CASE(ProfScope, MarkedFunction);
+#endif
+}
@@ -661,8 +661,52 @@ TEST(MedianAbsDeviation, ComplexScenario) {
     TEST_ASSERT_EQUAL(49, staMedianAbsDeviation(median, list, len));
 }
 
+TEST_GROUP(NextWakeup);
+
+TEST_SETUP(NextWakeup) { setMockTickCount(0); }
+
+TEST_TEAR_DOWN(NextWakeup) { setMockTickCount(0); }
+
+TEST(NextWakeup, AbsolutePeriod) {
+    unsigned int wake_ms = 1000;
+    // caller spent 120 ms after last wakeup
+    TEST_ASSERT_EQUAL_UINT32(380, staNextWakeupMs(&wake_ms, 500, 1120));
+    TEST_ASSERT_EQUAL_UINT32(1500, wake_ms);
+    // late but still within the period, next wakeup keeps the phase
+    TEST_ASSERT_EQUAL_UINT32(0, staNextWakeupMs(&wake_ms, 500, 2300));
+    TEST_ASSERT_EQUAL_UINT32(2000, wake_ms);
+    TEST_ASSERT_EQUAL_UINT32(200, staNextWakeupMs(&wake_ms, 500, 2300));
+    TEST_ASSERT_EQUAL_UINT32(2500, wake_ms);
+    // behind by whole period, missed wakeups are skipped
+    TEST_ASSERT_EQUAL_UINT32(0, staNextWakeupMs(&wake_ms, 500, 4100));
+    TEST_ASSERT_EQUAL_UINT32(4100, wake_ms);
+    // tick counter wraps around
+    wake_ms = 0xfffffe00;
+    TEST_ASSERT_EQUAL_UINT32(0x300, staNextWakeupMs(&wake_ms, 0x400, 0xfffffef0 + 0x10));
+    TEST_ASSERT_EQUAL_UINT32(0x200, wake_ms);
+}
+
+TEST(NextWakeup, EvenlySpacedTicks) {
+    gmonTick_t   tick = {0};
+    unsigned int wake_ms = 0, idx = 0, prev_ticks = 0, curr_ticks = 0;
+    const unsigned int period_ms = 2000, expect_ticks = period_ms / GMON_NUM_MILLISECONDS_PER_TICK;
+    for (idx = 0; idx < 10; idx++) {
+        TEST_ASSERT_EQUAL(GMON_RESP_OK, stationSysDelayUntilMs(&wake_ms, period_ms));
+        curr_ticks = stationGetTicksPerDay(&tick);
+        if (idx > 0)
+            TEST_ASSERT_EQUAL_UINT32(expect_ticks, curr_ticks - prev_ticks);
+        prev_ticks = curr_ticks;
+        // processing time varies in each period
+        setMockTickCount(g_mock_tick_count + (idx * 37) % 300);
+    }
+    TEST_ASSERT_EQUAL_UINT32(period_ms * 10, wake_ms);
+    TEST_ASSERT_EQUAL(GMON_RESP_ERRARGS, stationSysDelayUntilMs(NULL, period_ms));
+}
+
 TEST_GROUP_RUNNER(gMonUtilityStatistical) {
     RUN_TEST_CASE(AbsInt, Int32Ok);
+    RUN_TEST_CASE(NextWakeup, AbsolutePeriod);
+    RUN_TEST_CASE(NextWakeup, EvenlySpacedTicks);
 
     RUN_TEST_CASE(PartitionIntArray, EmptyArray);
     RUN_TEST_CASE(PartitionIntArray, SingleElementArray);
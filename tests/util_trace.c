@@ -0,0 +1,165 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "station_include.h"
+
+#define UTEST_TRACE_CAPACITY 8
+
+static uint32_t         utest_trace_mem[GMON_TRACE_RING_NWORDS(UTEST_TRACE_CAPACITY)];
+static gMonTraceRing_t *utest_trace_ring = (gMonTraceRing_t *)utest_trace_mem;
+static gmonTraceEntry_t utest_trace_out[UTEST_TRACE_CAPACITY << 1];
+
+TEST_GROUP(TraceRing);
+
+TEST_SETUP(TraceRing) {
+    setMockTickCount(0);
+    TEST_ASSERT_EQUAL(GMON_RESP_OK, staTraceRingInit(utest_trace_ring, sizeof(utest_trace_mem)));
+}
+
+TEST_TEAR_DOWN(TraceRing) { setMockTickCount(0); }
+
+TEST(TraceRing, InitCapacity) {
+    TEST_ASSERT_EQUAL_HEX32(GMON_TRACE_RING_MAGIC, utest_trace_ring->magic);
+    TEST_ASSERT_EQUAL(GMON_TRACE_RING_VERSION, utest_trace_ring->version);
+    TEST_ASSERT_EQUAL(UTEST_TRACE_CAPACITY, utest_trace_ring->capacity);
+    TEST_ASSERT_EQUAL(
+        sizeof(gMonTraceRing_t) + sizeof(gmonTraceEntry_t) * UTEST_TRACE_CAPACITY,
+        staTraceRingDumpSize(utest_trace_ring)
+    );
+    // capacity is rounded down to power of 2
+    TEST_ASSERT_EQUAL(
+        GMON_RESP_OK, staTraceRingInit(utest_trace_ring, sizeof(utest_trace_mem) - sizeof(gmonTraceEntry_t))
+    );
+    TEST_ASSERT_EQUAL(UTEST_TRACE_CAPACITY >> 1, utest_trace_ring->capacity);
+    TEST_ASSERT_EQUAL(GMON_RESP_ERRARGS, staTraceRingInit(utest_trace_ring, sizeof(gMonTraceRing_t)));
+    TEST_ASSERT_EQUAL(GMON_RESP_ERRARGS, staTraceRingInit(NULL, sizeof(utest_trace_mem)));
+    // nothing is recorded to uninitialized ring
+    utest_trace_ring->magic = 0;
+    staTraceRingRecord(utest_trace_ring, GMON_TRACE_TASK_SENSOR, GMON_TRACE_EVT_SENSOR_NOTIFY, 1);
+    TEST_ASSERT_EQUAL(0, atomic_load(&utest_trace_ring->head));
+    TEST_ASSERT_EQUAL(0, staTraceRingSnapshot(utest_trace_ring, utest_trace_out, UTEST_TRACE_CAPACITY));
+    TEST_ASSERT_EQUAL(0, staTraceRingDumpSize(utest_trace_ring));
+}
+
+TEST(TraceRing, RecordInOrder) {
+    unsigned int idx = 0, num_entries = 0;
+    for (idx = 0; idx < 5; idx++) {
+        setMockTickCount(idx * 3);
+        staTraceRingRecord(
+            utest_trace_ring, GMON_TRACE_TASK_NETCONN, GMON_TRACE_EVT_NETCONN_BEGIN + (idx & 1), -(int)idx
+        );
+    }
+    num_entries = staTraceRingSnapshot(utest_trace_ring, utest_trace_out, UTEST_TRACE_CAPACITY);
+    TEST_ASSERT_EQUAL(5, num_entries);
+    for (idx = 0; idx < num_entries; idx++) {
+        TEST_ASSERT_EQUAL(idx + 1, utest_trace_out[idx].seq);
+        TEST_ASSERT_EQUAL(idx * 3 * GMON_NUM_MILLISECONDS_PER_TICK * 1000, utest_trace_out[idx].ts_us);
+        TEST_ASSERT_EQUAL(GMON_TRACE_TASK_NETCONN, utest_trace_out[idx].task_id);
+        TEST_ASSERT_EQUAL(GMON_TRACE_EVT_NETCONN_BEGIN + (idx & 1), utest_trace_out[idx].event_id);
+        TEST_ASSERT_EQUAL(-(int)idx, utest_trace_out[idx].arg);
+    }
+    // caller may take fewer entries, from the oldest
+    TEST_ASSERT_EQUAL(2, staTraceRingSnapshot(utest_trace_ring, utest_trace_out, 2));
+    TEST_ASSERT_EQUAL(1, utest_trace_out[0].seq);
+    TEST_ASSERT_EQUAL(2, utest_trace_out[1].seq);
+}
+
+TEST(TraceRing, OverwriteOldest) {
+    unsigned int idx = 0, num_entries = 0, num_recorded = UTEST_TRACE_CAPACITY * 2 + 3;
+    for (idx = 0; idx < num_recorded; idx++)
+        staTraceRingRecord(
+            utest_trace_ring, GMON_TRACE_TASK_DISPLAY, GMON_TRACE_EVT_DISPLAY_REFRESH_BEGIN, (int16_t)idx
+        );
+    TEST_ASSERT_EQUAL(num_recorded, atomic_load(&utest_trace_ring->head));
+    num_entries = staTraceRingSnapshot(utest_trace_ring, utest_trace_out, UTEST_TRACE_CAPACITY << 1);
+    TEST_ASSERT_EQUAL(UTEST_TRACE_CAPACITY, num_entries);
+    for (idx = 0; idx < num_entries; idx++) {
+        TEST_ASSERT_EQUAL(num_recorded - UTEST_TRACE_CAPACITY + idx + 1, utest_trace_out[idx].seq);
+        TEST_ASSERT_EQUAL(num_recorded - UTEST_TRACE_CAPACITY + idx, utest_trace_out[idx].arg);
+    }
+}
+
+TEST(TraceRing, SkipSlotBeingWritten) {
+    unsigned int idx = 0;
+    for (idx = 0; idx < 4; idx++)
+        staTraceRingRecord(utest_trace_ring, GMON_TRACE_TASK_DATALOG, GMON_TRACE_EVT_DATALOG_BEGIN, idx);
+    // a writer claimed next slot, but has not published it yet
+    atomic_fetch_add(&utest_trace_ring->head, 1);
+    utest_trace_ring->entries[4].seq = 0;
+    utest_trace_ring->entries[1].seq = 0;
+    TEST_ASSERT_EQUAL(3, staTraceRingSnapshot(utest_trace_ring, utest_trace_out, UTEST_TRACE_CAPACITY));
+    TEST_ASSERT_EQUAL(1, utest_trace_out[0].seq);
+    TEST_ASSERT_EQUAL(3, utest_trace_out[1].seq);
+    TEST_ASSERT_EQUAL(4, utest_trace_out[2].seq);
+}
+
+TEST(TraceRing, EventNames) {
+    for (uint8_t id = 1; id < GMON_TRACE_NUM_TASKS; id++)
+        TEST_ASSERT_NOT_NULL(staTraceTaskName(id));
+    for (uint8_t id = 1; id < GMON_TRACE_NUM_EVENTS; id++)
+        TEST_ASSERT_NOT_NULL(staTraceEventName(id));
+    TEST_ASSERT_NULL(staTraceTaskName(0));
+    TEST_ASSERT_NULL(staTraceTaskName(GMON_TRACE_NUM_TASKS));
+    TEST_ASSERT_NULL(staTraceEventName(GMON_TRACE_NUM_EVENTS));
+    // every duration event is closed by the next event ID with the same name
+    TEST_ASSERT_EQUAL('B', staTraceEventPhase(GMON_TRACE_EVT_NETCONN_BEGIN));
+    TEST_ASSERT_EQUAL('E', staTraceEventPhase(GMON_TRACE_EVT_NETCONN_END));
+    TEST_ASSERT_EQUAL('i', staTraceEventPhase(GMON_TRACE_EVT_SENSOR_NOTIFY));
+    for (uint8_t id = 1; id < GMON_TRACE_NUM_EVENTS; id++) {
+        if (staTraceEventPhase(id) == 'B') {
+            TEST_ASSERT_EQUAL('E', staTraceEventPhase(id + 1));
+            TEST_ASSERT_EQUAL_STRING(staTraceEventName(id), staTraceEventName(id + 1));
+        }
+    }
+}
+
+TEST(TraceRing, CyclesToUsWrapAround) {
+    const unsigned int cycles_per_us = 180;
+    const uint64_t     wrap = 0x100000000ULL;
+    TEST_ASSERT_EQUAL_UINT32(0x10000000U / cycles_per_us, staTraceCyclesToUs(0x10000000U, cycles_per_us));
+    TEST_ASSERT_EQUAL_UINT32(0x90000000U / cycles_per_us, staTraceCyclesToUs(0x90000000U, cycles_per_us));
+    // counter read by preempted writer before the top bit flipped
+    TEST_ASSERT_EQUAL_UINT32(0x7ffffff0U / cycles_per_us, staTraceCyclesToUs(0x7ffffff0U, cycles_per_us));
+    // counter wrapped around, timestamp keeps increasing
+    TEST_ASSERT_EQUAL_UINT32(
+        (uint32_t)((wrap + 0x10000000U) / cycles_per_us), staTraceCyclesToUs(0x10000000U, cycles_per_us)
+    );
+    TEST_ASSERT_EQUAL_UINT32(
+        (uint32_t)((wrap + 0x90000000U) / cycles_per_us), staTraceCyclesToUs(0x90000000U, cycles_per_us)
+    );
+    TEST_ASSERT_EQUAL_UINT32(
+        (uint32_t)((wrap + 0xf0000000U) / cycles_per_us), staTraceCyclesToUs(0xf0000000U, cycles_per_us)
+    );
+    TEST_ASSERT_EQUAL_UINT32(
+        (uint32_t)((wrap * 2 + 0x200U) / cycles_per_us), staTraceCyclesToUs(0x200U, cycles_per_us)
+    );
+}
+
+// nothing is traced for longer than a quarter of the counter period, the wraps are still counted
+// from the counter sampled by periodic task
+TEST(TraceRing, CyclesTrackPeriodic) {
+    const unsigned int cycles_per_us = 16; // the counter period in microseconds is integer
+    const uint32_t     period_us = (uint32_t)(0x100000000ULL / cycles_per_us);
+    uint32_t           start_us = staTraceCyclesToUs(0x10000000U, cycles_per_us);
+    staTraceCyclesTrack(0x50000000U);
+    staTraceCyclesTrack(0x90000000U);
+    staTraceCyclesTrack(0xd0000000U);
+    TEST_ASSERT_EQUAL_UINT32(
+        period_us + 0x10000000U / cycles_per_us, staTraceCyclesToUs(0x20000000U, cycles_per_us) - start_us
+    );
+    // the limit : without sampling, the first timestamp after the top bit flipped is taken late, in the
+    // last quarter of the half, so it is regarded as stale and lands one period too early.
+    start_us = staTraceCyclesToUs(0x30000000U, cycles_per_us);
+    TEST_ASSERT_EQUAL_UINT32(
+        0xc0000000U / cycles_per_us - period_us, staTraceCyclesToUs(0xf0000000U, cycles_per_us) - start_us
+    );
+}
+
+TEST_GROUP_RUNNER(gMonTraceRing) {
+    RUN_TEST_CASE(TraceRing, InitCapacity);
+    RUN_TEST_CASE(TraceRing, RecordInOrder);
+    RUN_TEST_CASE(TraceRing, OverwriteOldest);
+    RUN_TEST_CASE(TraceRing, SkipSlotBeingWritten);
+    RUN_TEST_CASE(TraceRing, EventNames);
+    RUN_TEST_CASE(TraceRing, CyclesToUsWrapAround);
+    RUN_TEST_CASE(TraceRing, CyclesTrackPeriodic);
+}